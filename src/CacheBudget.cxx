@@ -0,0 +1,369 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_DEFINE_STATIC (cacheBudget);
+
+// Constants.
+/// The bytes that the documents' caches can use together by default.
+static const gsize DEFAULT_LIMIT = 48 * 1024 * 1024;
+
+// Forward declarations.
+static gsize getDocumentsSize (GQueue *documents);
+static gsize getReleasableSize (GQueue *documents);
+static gsize releaseDocuments (GQueue *documents, gsize size);
+
+CacheBudget *CacheBudget::m_Budget = NULL;
+
+///
+/// @brief Constructs a new CacheBudget object.
+///
+CacheBudget::CacheBudget ()
+{
+    m_Documents = g_queue_new ();
+    m_Limit = DEFAULT_LIMIT;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by CacheBudget.
+///
+/// The documents are not deleted, as they don't belong to the budget.
+///
+CacheBudget::~CacheBudget ()
+{
+    g_queue_free (m_Documents);
+}
+
+///
+/// @brief Destroys the budget.
+///
+void
+CacheBudget::destroy ()
+{
+    delete m_Budget;
+    m_Budget = NULL;
+}
+
+///
+/// @brief Gets the budget.
+///
+/// The first time this function is called creates the budget.
+///
+/// @return The reference to the budget.
+///
+CacheBudget &
+CacheBudget::getBudget ()
+{
+    G_LOCK (cacheBudget);
+    if ( NULL == m_Budget )
+    {
+        m_Budget = new CacheBudget ();
+    }
+    G_UNLOCK (cacheBudget);
+
+    g_assert (NULL != m_Budget && "The cache budget is NULL.");
+    return *m_Budget;
+}
+
+///
+/// @brief Tells that a document is the one being read.
+///
+/// The document will be the last to release its cached images.
+///
+/// @param document The document whose tab was selected.
+///
+void
+CacheBudget::activate (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to activate a NULL document.");
+
+    G_LOCK (cacheBudget);
+    if ( g_queue_remove (m_Documents, document) )
+    {
+        g_queue_push_head (m_Documents, document);
+    }
+    G_UNLOCK (cacheBudget);
+}
+
+///
+/// @brief Adds an open document to the budget.
+///
+/// The document is added as the least recently active, until
+/// activate() is called for it.
+///
+/// @param document The document to add.
+///
+void
+CacheBudget::add (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to add a NULL document.");
+
+    G_LOCK (cacheBudget);
+    g_queue_push_tail (m_Documents, document);
+    G_UNLOCK (cacheBudget);
+}
+
+///
+/// @brief Copies the list of open documents.
+///
+/// The documents are called through the copy once the budget's lock is
+/// released, as they may call back into the budget.
+///
+/// @return The open documents, from the most to the least recently
+///         active, as IDocument. It must be freed with g_queue_free().
+///
+GQueue *
+CacheBudget::copyDocuments ()
+{
+    G_LOCK (cacheBudget);
+    GQueue *documents = g_queue_copy (m_Documents);
+    G_UNLOCK (cacheBudget);
+
+    return documents;
+}
+
+///
+/// @brief Gets the bytes that the documents' caches can use together.
+///
+/// @return The budget's limit in bytes.
+///
+gsize
+CacheBudget::getLimit ()
+{
+    return m_Limit;
+}
+
+///
+/// @brief Gets the number of documents in the budget.
+///
+/// @return How many documents are open.
+///
+guint
+CacheBudget::getNumDocuments ()
+{
+    G_LOCK (cacheBudget);
+    guint numDocuments = g_queue_get_length (m_Documents);
+    G_UNLOCK (cacheBudget);
+
+    return numDocuments;
+}
+
+///
+/// @brief Gets the bytes that the documents' caches use.
+///
+/// @return The size of all documents' cached images.
+///
+gsize
+CacheBudget::getSize ()
+{
+    GQueue *documents = copyDocuments ();
+    gsize size = getDocumentsSize (documents);
+    g_queue_free (documents);
+
+    return size;
+}
+
+///
+/// @brief Tells all documents that the system is running out of memory.
+///
+/// Each document notifies its observers, so the views can free what
+/// they don't need.
+///
+void
+CacheBudget::notifyLowMemory ()
+{
+    GQueue *documents = copyDocuments ();
+    for ( GList *item = g_queue_peek_head_link (documents) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocument *document = (IDocument *)item->data;
+        document->notifyLowMemory ();
+    }
+    g_queue_free (documents);
+}
+
+///
+/// @brief Deletes cached images to free memory.
+///
+/// The documents release their images from the least to the most
+/// recently active, until at least @a size bytes are freed or all
+/// caches are empty.
+///
+/// @param size The bytes to free.
+///
+/// @return The bytes freed.
+///
+gsize
+CacheBudget::release (gsize size)
+{
+    GQueue *documents = copyDocuments ();
+    gsize released = releaseDocuments (documents, size);
+    g_queue_free (documents);
+
+    return released;
+}
+
+///
+/// @brief Deletes the pages that all documents rendered in advance.
+///
+/// @return The bytes freed.
+///
+gsize
+CacheBudget::releasePrefetchedPages ()
+{
+    gsize released = 0;
+    GQueue *documents = copyDocuments ();
+    for ( GList *item = g_queue_peek_head_link (documents) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocument *document = (IDocument *)item->data;
+        released += document->releasePrefetchedPages ();
+    }
+    g_queue_free (documents);
+
+    return released;
+}
+
+///
+/// @brief Removes a document from the budget.
+///
+/// @param document The document being deleted.
+///
+void
+CacheBudget::remove (IDocument *document)
+{
+    G_LOCK (cacheBudget);
+    g_queue_remove (m_Documents, document);
+    G_UNLOCK (cacheBudget);
+}
+
+///
+/// @brief Sets the bytes that the documents' caches can use together.
+///
+/// The caches are trimmed to the new limit.
+///
+/// @param limit The budget's new limit in bytes.
+///
+void
+CacheBudget::setLimit (gsize limit)
+{
+    m_Limit = limit;
+    trim ();
+}
+
+///
+/// @brief Deletes cached images until the caches fit in the limit.
+///
+/// Only the images that can be released count against the limit: the
+/// rendered pages that the active document keeps could take it over
+/// the limit by themselves, and the documents would then release
+/// their other images each time a page is rendered.
+///
+/// This must be called after a document adds an image to its caches.
+///
+void
+CacheBudget::trim ()
+{
+    GQueue *documents = copyDocuments ();
+    gsize size = getReleasableSize (documents);
+    if ( size > m_Limit )
+    {
+        releaseDocuments (documents, size - m_Limit);
+    }
+    g_queue_free (documents);
+}
+
+///
+/// @brief Adds up the bytes that the documents' caches use.
+///
+/// @param documents The documents to add up, as IDocument.
+///
+/// @return The size of all documents' cached images.
+///
+gsize
+getDocumentsSize (GQueue *documents)
+{
+    gsize size = 0;
+    for ( GList *item = g_queue_peek_head_link (documents) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocument *document = (IDocument *)item->data;
+        size += document->getCacheSize ();
+    }
+
+    return size;
+}
+
+///
+/// @brief Adds up the bytes that releaseDocuments() can free.
+///
+/// @param documents The documents, from the most to the least recently
+///                  active, as IDocument.
+///
+/// @return The size of the images that the documents can release.
+///
+gsize
+getReleasableSize (GQueue *documents)
+{
+    gsize size = 0;
+    GList *active = g_queue_peek_head_link (documents);
+    for ( GList *item = active ; NULL != item ; item = g_list_next (item) )
+    {
+        IDocument *document = (IDocument *)item->data;
+        size += document->getReleasableCacheSize (active != item);
+    }
+
+    return size;
+}
+
+///
+/// @brief Makes the least recently active documents free memory.
+///
+/// The documents in the background also delete their rendered pages
+/// other than the current, before the active document deletes any
+/// image. The active document keeps all its rendered pages.
+///
+/// @param documents The documents, from the most to the least recently
+///                  active, as IDocument.
+/// @param size The bytes to free.
+///
+/// @return The bytes freed.
+///
+gsize
+releaseDocuments (GQueue *documents, gsize size)
+{
+    gsize released = 0;
+    GList *active = g_queue_peek_head_link (documents);
+    for ( GList *item = g_queue_peek_tail_link (documents) ;
+          NULL != item && released < size ; item = g_list_previous (item) )
+    {
+        IDocument *document = (IDocument *)item->data;
+        released += document->releaseCache (size - released,
+                                             active != item);
+    }
+
+    return released;
+}
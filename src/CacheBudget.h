@@ -0,0 +1,85 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__CACHE_BUDGET_H__)
+#define __CACHE_BUDGET_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocument;
+
+    ///
+    /// @class CacheBudget
+    /// @brief The memory that the caches of all open documents share.
+    ///
+    /// Each document keeps its compressed pages and thumbnails within its
+    /// own budget, but with several documents open in the same process
+    /// they can add up to too much. The budget counts them and the pages
+    /// each document keeps rendered. When the documents' caches use more
+    /// than the limit, the documents that were least recently active
+    /// release their cached images first, their rendered pages included,
+    /// so the document being read keeps its own for as long as possible.
+    /// It never releases its rendered pages, so they don't count against
+    /// the limit.
+    ///
+    /// The documents are called outside of the budget's lock, so they
+    /// and their observers can call back into the budget.
+    ///
+    /// Like Config, there is a single instance that can be destroyed
+    /// with CacheBudget::destroy(), mostly for testing.
+    ///
+    class CacheBudget
+    {
+        public:
+            static void destroy (void);
+            static CacheBudget &getBudget (void);
+
+            void activate (IDocument *document);
+            void add (IDocument *document);
+            gsize getLimit (void);
+            guint getNumDocuments (void);
+            gsize getSize (void);
+            void notifyLowMemory (void);
+            gsize release (gsize size);
+            gsize releasePrefetchedPages (void);
+            void remove (IDocument *document);
+            void setLimit (gsize limit);
+            void trim (void);
+
+        protected:
+            /// The only instance.
+            static CacheBudget *m_Budget;
+            /// @brief The open documents, from the most to the least
+            /// recently active.
+            GQueue *m_Documents;
+            /// The bytes that the documents' caches can use together.
+            gsize m_Limit;
+
+            CacheBudget (void);
+            ~CacheBudget (void);
+
+            GQueue *copyDocuments (void);
+    };
+}
+
+#endif // !__CACHE_BUDGET_H__
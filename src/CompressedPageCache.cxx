@@ -0,0 +1,550 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <string.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static guchar *compressImage (DocumentPage *pageImage, gsize *size);
+static guchar *compressRow (const guint32 *pixels, gint numPixels,
+                            guchar *output);
+static DocumentPage *decompressImage (const guchar *data, gsize size,
+                                      gint width, gint height);
+static gboolean decompressRow (const guchar **input, const guchar *end,
+                               guint32 *pixels, gint numPixels);
+
+// Constants.
+/// The row is equal to the previous row.
+static const guchar ROW_REPEAT = 0;
+/// The row has a single colour, stored after the row's tag.
+static const guchar ROW_FILL = 1;
+/// The row is stored as packets of runs and literal pixels.
+static const guchar ROW_PACKETS = 2;
+/// @brief The flag of a packet's header that tells the packet is a
+/// single pixel repeated.
+static const guchar PACKET_RUN = 0x80;
+/// The maximum pixels of a packet.
+static const gint PACKET_MAX_PIXELS = 128;
+
+///
+/// @brief A compressed page's image in the cache.
+///
+typedef struct
+{
+    /// The number of the image's page.
+    gint pageNum;
+    /// The image's width.
+    gint width;
+    /// The image's height.
+    gint height;
+    /// The compressed image.
+    guchar *data;
+    /// The bytes of the compressed image.
+    gsize size;
+    /// The bytes the image uses uncompressed.
+    gsize rawSize;
+} CompressedPageEntry;
+
+///
+/// @brief Constructs a new empty cache.
+///
+/// @param budget The maximum bytes that the compressed images can use.
+///
+CompressedPageCache::CompressedPageCache (gsize budget)
+{
+    m_Budget = budget;
+    m_DecodeTime = 0;
+    m_NumDecodes = 0;
+    m_Order = g_queue_new ();
+    m_Pages = g_hash_table_new (g_direct_hash, g_direct_equal);
+    m_RawSize = 0;
+    m_Size = 0;
+}
+
+///
+/// @brief Deletes all cached images.
+///
+CompressedPageCache::~CompressedPageCache ()
+{
+    clear ();
+    g_queue_free (m_Order);
+    g_hash_table_destroy (m_Pages);
+}
+
+///
+/// @brief Adds a page's image to the cache.
+///
+/// The image that @a pageNum had already is replaced. Then the least
+/// recently added images are deleted until the cache fits in its budget,
+/// but the new image is always kept.
+///
+/// Only images with 32 bits pixels are compressed, the others are not
+/// added.
+///
+/// @param pageNum The number of the image's page.
+/// @param pageImage The image to compress. The cache doesn't take its
+///                  ownership.
+///
+void
+CompressedPageCache::add (gint pageNum, DocumentPage *pageImage)
+{
+    g_assert (NULL != pageImage && "Tried to add a NULL page image.");
+
+    remove (pageNum);
+    if ( 0 != pageImage->getRowStride () % sizeof (guint32) )
+    {
+        return;
+    }
+
+    CompressedPageEntry *entry = g_new (CompressedPageEntry, 1);
+    entry->pageNum = pageNum;
+    entry->width = pageImage->getWidth ();
+    entry->height = pageImage->getHeight ();
+    entry->data = compressImage (pageImage, &entry->size);
+    entry->rawSize = pageImage->getRowStride () * pageImage->getHeight ();
+    g_queue_push_head (m_Order, entry);
+    g_hash_table_insert (m_Pages, GINT_TO_POINTER (pageNum),
+                         g_queue_peek_head_link (m_Order));
+    m_RawSize += entry->rawSize;
+    m_Size += entry->size;
+
+    while ( m_Size > m_Budget && 1 < g_queue_get_length (m_Order) )
+    {
+        removeLink (g_queue_peek_tail_link (m_Order));
+    }
+}
+
+///
+/// @brief Deletes all cached images.
+///
+void
+CompressedPageCache::clear ()
+{
+    while ( !g_queue_is_empty (m_Order) )
+    {
+        removeLink (g_queue_peek_head_link (m_Order));
+    }
+}
+
+///
+/// @brief Gets the maximum bytes the compressed images can use.
+///
+/// @return The cache's budget in bytes.
+///
+gsize
+CompressedPageCache::getBudget ()
+{
+    return m_Budget;
+}
+
+///
+/// @brief Gets how much the cached images are compressed.
+///
+/// @return The bytes the cached images would use uncompressed divided
+///         by the bytes they use, or 0 if the cache is empty.
+///
+gdouble
+CompressedPageCache::getCompressionRatio ()
+{
+    if ( 0 == m_Size )
+    {
+        return 0.0;
+    }
+    return (gdouble)m_RawSize / (gdouble)m_Size;
+}
+
+///
+/// @brief Gets how long it takes to decompress an image.
+///
+/// @return The average milliseconds that take() spent decompressing
+///         an image, or 0 if no image was decompressed yet.
+///
+gdouble
+CompressedPageCache::getDecodeTime ()
+{
+    if ( 0 == m_NumDecodes )
+    {
+        return 0.0;
+    }
+    return m_DecodeTime / 1000.0 / m_NumDecodes;
+}
+
+///
+/// @brief Gets the number of cached images.
+///
+/// @return How many pages have their image in the cache.
+///
+guint
+CompressedPageCache::getNumPages ()
+{
+    return g_queue_get_length (m_Order);
+}
+
+///
+/// @brief Gets the pages that have their image in the cache.
+///
+/// @return The list of page numbers, stored with GINT_TO_POINTER(), in
+///         no particular order. The list must be freed with g_list_free().
+///
+GList *
+CompressedPageCache::getPageNumbers ()
+{
+    return g_hash_table_get_keys (m_Pages);
+}
+
+///
+/// @brief Gets the bytes that the compressed images use.
+///
+/// @return The size of all cached images.
+///
+gsize
+CompressedPageCache::getSize ()
+{
+    return m_Size;
+}
+
+///
+/// @brief Deletes images to free memory.
+///
+/// The least recently added images are deleted until at least @a size
+/// bytes are freed or the cache is empty.
+///
+/// @param size The bytes to free.
+///
+/// @return The bytes freed.
+///
+gsize
+CompressedPageCache::release (gsize size)
+{
+    gsize oldSize = m_Size;
+    while ( oldSize - m_Size < size && !g_queue_is_empty (m_Order) )
+    {
+        removeLink (g_queue_peek_tail_link (m_Order));
+    }
+
+    return oldSize - m_Size;
+}
+
+///
+/// @brief Deletes a page's image from the cache.
+///
+/// @param pageNum The number of the page to delete its image.
+///
+void
+CompressedPageCache::remove (gint pageNum)
+{
+    GList *link = (GList *)g_hash_table_lookup (m_Pages,
+                                                GINT_TO_POINTER (pageNum));
+    if ( NULL != link )
+    {
+        removeLink (link);
+    }
+}
+
+///
+/// @brief Takes a page's image out of the cache.
+///
+/// @param pageNum The number of the page to get its image.
+///
+/// @return The decompressed image, that must be deleted when no longer
+///         needed, or NULL if the page has no image in the cache.
+///
+DocumentPage *
+CompressedPageCache::take (gint pageNum)
+{
+    GList *link = (GList *)g_hash_table_lookup (m_Pages,
+                                                GINT_TO_POINTER (pageNum));
+    if ( NULL == link )
+    {
+        return NULL;
+    }
+
+    CompressedPageEntry *entry = (CompressedPageEntry *)link->data;
+    gint64 startTime = g_get_monotonic_time ();
+    DocumentPage *pageImage = decompressImage (entry->data, entry->size,
+                                               entry->width, entry->height);
+    m_DecodeTime += g_get_monotonic_time () - startTime;
+    m_NumDecodes++;
+    removeLink (link);
+
+    return pageImage;
+}
+
+///
+/// @brief Deletes a cached image.
+///
+/// @param link The image's link in m_Order.
+///
+void
+CompressedPageCache::removeLink (GList *link)
+{
+    CompressedPageEntry *entry = (CompressedPageEntry *)link->data;
+    g_hash_table_remove (m_Pages, GINT_TO_POINTER (entry->pageNum));
+    g_queue_delete_link (m_Order, link);
+    m_RawSize -= entry->rawSize;
+    m_Size -= entry->size;
+    g_free (entry->data);
+    g_free (entry);
+}
+
+///
+/// @brief Compresses a page's image.
+///
+/// Each row starts with a tag that tells whether the row is equal to
+/// the previous, has a single colour or is stored as packets. Each
+/// packet has a header byte with the number of pixels minus one and,
+/// when PACKET_RUN is set, a pixel to repeat; otherwise the literal
+/// pixels follow.
+///
+/// @param pageImage The image to compress. Its row stride must be a
+///                  multiple of 4 bytes.
+/// @param size The output location to save the compressed size.
+///
+/// @return The compressed image, to free with g_free().
+///
+guchar *
+compressImage (DocumentPage *pageImage, gsize *size)
+{
+    gint height = pageImage->getHeight ();
+    gint rowStride = pageImage->getRowStride ();
+    gint numPixels = rowStride / sizeof (guint32);
+    // The packets only take more than the pixels when there are
+    // literal pixels longer than a packet, and at the row's end.
+    gsize maxSize = (gsize)height *
+                    (rowStride + numPixels / PACKET_MAX_PIXELS + 3);
+    guchar *compressed = g_new (guchar, maxSize);
+    guchar *output = compressed;
+
+    const guchar *data = pageImage->getData ();
+    for ( gint y = 0 ; y < height ; y++ )
+    {
+        const guchar *row = data + y * rowStride;
+        if ( 0 < y && 0 == memcmp (row, row - rowStride, rowStride) )
+        {
+            *output++ = ROW_REPEAT;
+            continue;
+        }
+
+        const guint32 *pixels = (const guint32 *)row;
+        gint fill = 1;
+        while ( fill < numPixels && pixels[fill] == pixels[0] )
+        {
+            fill++;
+        }
+        if ( fill == numPixels )
+        {
+            *output++ = ROW_FILL;
+            memcpy (output, pixels, sizeof (guint32));
+            output += sizeof (guint32);
+        }
+        else
+        {
+            *output++ = ROW_PACKETS;
+            output = compressRow (pixels, numPixels, output);
+        }
+    }
+
+    *size = output - compressed;
+    return (guchar *)g_realloc (compressed, *size);
+}
+
+///
+/// @brief Compresses a row of pixels as packets.
+///
+/// Two or more equal pixels are stored as a run. The rest are stored
+/// as literal pixels, up to the next run.
+///
+/// @param pixels The row's pixels.
+/// @param numPixels The number of pixels in @a pixels.
+/// @param output The buffer to write the packets to.
+///
+/// @return The position of @a output after the packets.
+///
+guchar *
+compressRow (const guint32 *pixels, gint numPixels, guchar *output)
+{
+    gint x = 0;
+    while ( x < numPixels )
+    {
+        gint run = 1;
+        while ( x + run < numPixels && run < PACKET_MAX_PIXELS &&
+                pixels[x + run] == pixels[x] )
+        {
+            run++;
+        }
+
+        if ( 1 < run )
+        {
+            *output++ = PACKET_RUN | (run - 1);
+            memcpy (output, &pixels[x], sizeof (guint32));
+            output += sizeof (guint32);
+            x += run;
+        }
+        else
+        {
+            gint literal = 1;
+            while ( x + literal < numPixels &&
+                    literal < PACKET_MAX_PIXELS &&
+                    ( x + literal + 1 == numPixels ||
+                      pixels[x + literal] != pixels[x + literal + 1] ) )
+            {
+                literal++;
+            }
+            *output++ = literal - 1;
+            memcpy (output, &pixels[x], literal * sizeof (guint32));
+            output += literal * sizeof (guint32);
+            x += literal;
+        }
+    }
+
+    return output;
+}
+
+///
+/// @brief Decompresses a page's image.
+///
+/// @param data The image compressed by compressImage().
+/// @param size The bytes of @a data.
+/// @param width The image's width.
+/// @param height The image's height.
+///
+/// @return The decompressed image, or NULL if @a data is not valid.
+///
+DocumentPage *
+decompressImage (const guchar *data, gsize size, gint width, gint height)
+{
+    DocumentPage *pageImage = new DocumentPage ();
+    if ( !pageImage->newPage (width, height) )
+    {
+        delete pageImage;
+        return NULL;
+    }
+
+    gint rowStride = pageImage->getRowStride ();
+    gint numPixels = rowStride / sizeof (guint32);
+    guchar *output = pageImage->getData ();
+    const guchar *input = data;
+    const guchar *end = data + size;
+    gboolean valid = TRUE;
+    for ( gint y = 0 ; y < height && valid ; y++ )
+    {
+        guchar *row = output + y * rowStride;
+        guint32 *pixels = (guint32 *)row;
+        if ( input >= end )
+        {
+            valid = FALSE;
+            continue;
+        }
+        guchar tag = *input++;
+        if ( ROW_REPEAT == tag )
+        {
+            valid = 0 < y;
+            if ( valid )
+            {
+                memcpy (row, row - rowStride, rowStride);
+            }
+        }
+        else if ( ROW_FILL == tag )
+        {
+            valid = sizeof (guint32) <= (gsize)(end - input);
+            if ( valid )
+            {
+                guint32 pixel;
+                memcpy (&pixel, input, sizeof (guint32));
+                input += sizeof (guint32);
+                for ( gint x = 0 ; x < numPixels ; x++ )
+                {
+                    pixels[x] = pixel;
+                }
+            }
+        }
+        else
+        {
+            valid = ROW_PACKETS == tag &&
+                    decompressRow (&input, end, pixels, numPixels);
+        }
+    }
+
+    if ( !valid || input != end )
+    {
+        g_warning ("Invalid compressed image.");
+        delete pageImage;
+        return NULL;
+    }
+
+    return pageImage;
+}
+
+///
+/// @brief Decompresses a row of pixels stored as packets.
+///
+/// @param input The position of the row's packets. It's moved past them.
+/// @param end The end of the compressed image.
+/// @param pixels The row's pixels to write.
+/// @param numPixels The number of pixels in @a pixels.
+///
+/// @return TRUE if the packets were valid, FALSE otherwise.
+///
+gboolean
+decompressRow (const guchar **input, const guchar *end, guint32 *pixels,
+               gint numPixels)
+{
+    const guchar *packet = *input;
+    gint x = 0;
+    while ( x < numPixels )
+    {
+        if ( packet >= end )
+        {
+            return FALSE;
+        }
+        guchar header = *packet++;
+        gint count = (header & ~PACKET_RUN) + 1;
+        gsize packetSize = sizeof (guint32) *
+                           ( 0 != (header & PACKET_RUN) ? 1 : count );
+        if ( x + count > numPixels || packetSize > (gsize)(end - packet) )
+        {
+            return FALSE;
+        }
+
+        if ( 0 != (header & PACKET_RUN) )
+        {
+            guint32 pixel;
+            memcpy (&pixel, packet, sizeof (guint32));
+            for ( gint run = 0 ; run < count ; run++ )
+            {
+                pixels[x + run] = pixel;
+            }
+        }
+        else
+        {
+            memcpy (&pixels[x], packet, packetSize);
+        }
+        packet += packetSize;
+        x += count;
+    }
+    *input = packet;
+
+    return TRUE;
+}
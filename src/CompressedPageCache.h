@@ -0,0 +1,81 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__COMPRESSED_PAGE_CACHE_H__)
+#define __COMPRESSED_PAGE_CACHE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentPage;
+
+    ///
+    /// @class CompressedPageCache
+    /// @brief The compressed images of the pages dropped from the cache.
+    ///
+    /// When a rendered page is dropped from the document's cache, its
+    /// image is kept here compressed, so going back to the page doesn't
+    /// need to render it again. The images are compressed with a run
+    /// length encoding that stores the rows equal to the previous or
+    /// of a single colour in a few bytes, as most pages are largely
+    /// white. When a new image doesn't fit in the budget, the images
+    /// that were least recently added are deleted.
+    ///
+    class CompressedPageCache
+    {
+        public:
+            CompressedPageCache (gsize budget);
+            ~CompressedPageCache (void);
+
+            void add (gint pageNum, DocumentPage *pageImage);
+            void clear (void);
+            gsize getBudget (void);
+            gdouble getCompressionRatio (void);
+            gdouble getDecodeTime (void);
+            guint getNumPages (void);
+            GList *getPageNumbers (void);
+            gsize getSize (void);
+            gsize release (gsize size);
+            void remove (gint pageNum);
+            DocumentPage *take (gint pageNum);
+
+        protected:
+            /// The maximum bytes that the compressed images can use.
+            gsize m_Budget;
+            /// The microseconds spent decompressing images.
+            gint64 m_DecodeTime;
+            /// The number of images decompressed.
+            guint m_NumDecodes;
+            /// @brief The cached images, as CompressedPageEntry, from the
+            /// most to the least recently added.
+            GQueue *m_Order;
+            /// The link in m_Order of each cached page number.
+            GHashTable *m_Pages;
+            /// The bytes that the cached images use uncompressed.
+            gsize m_RawSize;
+            /// The bytes that the cached images use compressed.
+            gsize m_Size;
+
+            void removeLink (GList *link);
+    };
+}
+
+#endif // !__COMPRESSED_PAGE_CACHE_H__
@@ -27,6 +27,8 @@
 using namespace ePDFView;
 
 // Constants
+static const gboolean DEFAULT_AUTO_RELOAD = TRUE;
+static const gint DEFAULT_DISK_CACHE_SIZE = 64;
 static const gchar *DEFAULT_EXTERNAL_BROWSER_COMMAND_LINE = "x-www-browser %s";
 static const gchar *DEFAULT_EXTERNAL_BACKSEARCH_COMMAND_LINE = "epdfsync -l %p %x %y %f";
 static const gchar *DEFAULT_OPEN_FILE_FOLDER = NULL;
@@ -409,6 +411,30 @@ Config::setSaveFileFolder (const gchar *folder)
     g_key_file_set_string (m_Values, "save dialog", "folder", folder);
 }
 
+///
+/// @brief Saves if reload the document when its file changes.
+///
+/// @param reload TRUE to reload the document when its file changes,
+///               FALSE otherwise.
+///
+void
+Config::setAutoReload (gboolean reload)
+{
+    g_key_file_set_boolean (m_Values, "document", "autoReload", reload);
+}
+
+///
+/// @brief Saves the size of the disk cache.
+///
+/// @param size The maximum megabytes that the cached thumbnails and pages
+///             can use on disk, or 0 to not cache them on disk.
+///
+void
+Config::setDiskCacheSize (gint size)
+{
+    g_key_file_set_integer (m_Values, "document", "diskCacheSize", size);
+}
+
 /// krogan custom edit
 /// @brief Save if show the menu bar.
 ///
@@ -507,6 +533,31 @@ Config::setZoomToWidth (gboolean activate)
     g_key_file_set_boolean (m_Values, "main window", "zoomToWidth", activate);
 }
 
+///
+/// @brief Gets the size of the disk cache.
+///
+/// @return The maximum megabytes that the cached thumbnails and pages
+///         can use on disk, or 0 to not cache them on disk.
+///
+gint
+Config::getDiskCacheSize ()
+{
+    return MAX (0, getInteger ("document", "diskCacheSize",
+                               DEFAULT_DISK_CACHE_SIZE));
+}
+
+///
+/// @brief Gets if reload the document when its file changes.
+///
+/// @return TRUE if the document should be reloaded when its file
+///         changes, FALSE otherwise.
+///
+gboolean
+Config::autoReload ()
+{
+    return getBoolean ("document", "autoReload", DEFAULT_AUTO_RELOAD);
+}
+
 ///krogan custom edit
 /// @brief Gets if show the menu bar.
 ///
@@ -73,6 +73,8 @@ namespace ePDFView
 
             ~Config (void);
 
+            gboolean autoReload (void);
+            gint getDiskCacheSize (void);
             gchar *getExternalBrowserCommandLine (void);
 			gchar *getExternalBacksearchCommandLine (void);
             gchar *getOpenFileFolder (void);
@@ -88,6 +90,8 @@ namespace ePDFView
             gboolean zoomToFit (void);
             gboolean zoomToWidth (void);
             void save(void);
+            void setAutoReload (gboolean reload);
+            void setDiskCacheSize (gint size);
             void setExternalBrowserCommandLine (const gchar *commandLine);
 			void setExternalBacksearchCommandLine (const gchar *commandLine);
 			void setOpenFileFolder (const gchar *folder);
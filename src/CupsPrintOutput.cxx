@@ -0,0 +1,152 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <cups/cups.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief Constructs a new CupsPrintOutput object.
+///
+CupsPrintOutput::CupsPrintOutput ():
+    IPrintOutput ()
+{
+    m_JobId = 0;
+    m_PrinterName = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by CupsPrintOutput.
+///
+CupsPrintOutput::~CupsPrintOutput ()
+{
+    g_free (m_PrinterName);
+}
+
+///
+/// @brief Creates the print job and starts its document.
+///
+/// @param printerName The name of the printer to print to.
+/// @param title The print job's title.
+/// @param numOptions The number of options in @a options.
+/// @param options The print job's options.
+/// @param error Location to store the error occurring or NULL to ignore
+///              errors.
+///
+/// @return TRUE if the job could be started, FALSE otherwise.
+///
+gboolean
+CupsPrintOutput::begin (const gchar *printerName, const gchar *title,
+                        gint numOptions, cups_option_t *options,
+                        GError **error)
+{
+    g_free (m_PrinterName);
+    m_PrinterName = g_strdup (printerName);
+
+    m_JobId = cupsCreateJob (CUPS_HTTP_DEFAULT, printerName, title,
+                             numOptions, options);
+    if ( 0 == m_JobId )
+    {
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorBadPrinter,
+                     _("Failed to print to '%s'.\n%s\n"), printerName,
+                     cupsLastErrorString ());
+        return FALSE;
+    }
+
+    if ( HTTP_STATUS_CONTINUE !=
+         cupsStartDocument (CUPS_HTTP_DEFAULT, printerName, m_JobId, title,
+                            CUPS_FORMAT_POSTSCRIPT, 1) )
+    {
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorPrinting,
+                     _("Failed to print to '%s'.\n%s\n"), printerName,
+                     cupsLastErrorString ());
+        cancel ();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+///
+/// @brief Cancels the started print job.
+///
+void
+CupsPrintOutput::cancel ()
+{
+    if ( 0 != m_JobId )
+    {
+        cupsCancelJob2 (CUPS_HTTP_DEFAULT, m_PrinterName, m_JobId, 0);
+        m_JobId = 0;
+    }
+}
+
+///
+/// @brief Ends the job's document and waits for the server's response.
+///
+/// @param error Location to store the error occurring or NULL to ignore
+///              errors.
+///
+/// @return TRUE if the printer accepted the job, FALSE otherwise.
+///
+gboolean
+CupsPrintOutput::finish (GError **error)
+{
+    if ( IPP_STATUS_ERROR_BAD_REQUEST <=
+         cupsFinishDocument (CUPS_HTTP_DEFAULT, m_PrinterName) )
+    {
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorPrinting,
+                     _("Failed to print to '%s'.\n%s\n"), m_PrinterName,
+                     cupsLastErrorString ());
+        m_JobId = 0;
+        return FALSE;
+    }
+    m_JobId = 0;
+
+    return TRUE;
+}
+
+///
+/// @brief Sends the next part of the job's document to the server.
+///
+/// @param data The data to send.
+/// @param length The bytes of @a data.
+/// @param error Location to store the error occurring or NULL to ignore
+///              errors.
+///
+/// @return TRUE if all @a data could be sent, FALSE otherwise.
+///
+gboolean
+CupsPrintOutput::write (const gchar *data, gsize length, GError **error)
+{
+    if ( HTTP_STATUS_CONTINUE !=
+         cupsWriteRequestData (CUPS_HTTP_DEFAULT, data, length) )
+    {
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorPrinting,
+                     _("Failed to print to '%s'.\n%s\n"), m_PrinterName,
+                     cupsLastErrorString ());
+        return FALSE;
+    }
+
+    return TRUE;
+}
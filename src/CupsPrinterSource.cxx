@@ -0,0 +1,349 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <cups/cups.h>
+#include <cups/ipp.h>
+#include <cups/ppd.h>
+#include <locale.h>
+#include <unistd.h>
+#include "epdfview.h"
+
+#if (CUPS_VERSION_MAJOR > 1) || (CUPS_VERSION_MINOR > 5)
+#define HAVE_CUPS_1_6 1
+#endif
+
+#ifndef HAVE_CUPS_1_6
+inline int ippGetInteger (ipp_attribute_t *attr, int element)
+{
+    return (attr->values[element].integer);
+}
+
+inline const char * ippGetString (ipp_attribute_t *attr,
+                                  int             element,
+                                  const char      **language /*UNUSED*/)
+{
+    return (attr->values[element].string.text);
+}
+
+inline int ippSetOperation (ipp_t *ipp, ipp_op_t op)
+{
+  if (!ipp)
+    return (0);
+  ipp->request.op.operation_id = op;
+  return (1);
+}
+
+inline int ippSetRequestId (ipp_t *ipp, int request_id)
+{
+    if (!ipp)
+        return (0);
+    ipp->request.any.request_id = request_id;
+    return (1);
+}
+#endif
+
+using namespace ePDFView;
+
+// Forward declarations.
+static void addChoices (PrinterOptions *options, PrinterOptionType option,
+                        ppd_file_t *printerPPD, const gchar *optionName,
+                        const gchar *defaultText, const gchar *defaultValue);
+static void splitPrinterName (const gchar *printerAndInstanceNames,
+                              gchar **printerName, gchar **instanceName);
+
+///
+/// @brief Constructs a new CupsPrinterSource object.
+///
+CupsPrinterSource::CupsPrinterSource ():
+    IPrinterSource ()
+{
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by CupsPrinterSource.
+///
+CupsPrinterSource::~CupsPrinterSource ()
+{
+}
+
+///
+/// @brief Gets a printer's number of jobs, state and location.
+///
+/// The state and location are requested with an IPP request to the
+/// server.
+///
+void
+CupsPrinterSource::getPrinterAttributes (const gchar *printerAndInstanceNames,
+                                         gint *numJobs, gchar **state,
+                                         gchar **location)
+{
+    g_assert (NULL != numJobs && "Tried to save the number of jobs to NULL.");
+    g_assert (NULL != state && "Tried to save the state to NULL.");
+    g_assert (NULL != location && "Tried to save the location to NULL.");
+
+    *state = NULL;
+    *location = NULL;
+
+    gchar *printerName = NULL;
+    gchar *instanceName = NULL;
+    splitPrinterName (printerAndInstanceNames, &printerName, &instanceName);
+
+    // Get the number of jobs the printer currently has.
+    cups_job_t *destinationJobs;
+    *numJobs = cupsGetJobs (&destinationJobs, printerName, 1, 0);
+    cupsFreeJobs (*numJobs, destinationJobs);
+
+    // The attributes to request from the server.
+    const gchar *attributesToRequest[] =
+    {
+        "printer-state",
+        "printer-location"
+    };
+
+#if (CUPS_VERSION_MAJOR > 1) || (CUPS_VERSION_MINOR >= 7)
+    http_t *http = httpConnect2(cupsServer(), ippPort(), NULL, AF_UNSPEC, HTTP_ENCRYPTION_IF_REQUESTED, 1, 30000, NULL);
+#else
+    http_t *http = httpConnect (cupsServer (), ippPort ());
+#endif
+    if ( NULL == http )
+    {
+        g_free (printerName);
+        g_free (instanceName);
+        return;
+    }
+
+    ipp_t *request = ippNew ();
+
+    ippSetOperation(request, IPP_GET_PRINTER_ATTRIBUTES);
+    ippSetRequestId(request, 1);
+
+    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_CHARSET,
+                  "attributes-charset", NULL, "utf-8");
+    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_LANGUAGE,
+                  "attributes-natural-language", NULL,
+                  setlocale (LC_MESSAGES, NULL));
+    ippAddStrings (request, IPP_TAG_OPERATION, IPP_TAG_KEYWORD,
+                   "requested-attributes", G_N_ELEMENTS (attributesToRequest),
+                   NULL, attributesToRequest);
+    gchar *uri = g_strdup_printf ("ipp://localhost/printers/%s", printerName);
+    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_URI,
+                  "printer-uri", NULL, uri);
+
+    ipp_t *answer = cupsDoRequest (http, request, "/");
+    if ( NULL != answer )
+    {
+        // Get the state.
+        ipp_attribute_t *printerState =
+            ippFindAttribute (answer, "printer-state", IPP_TAG_ZERO);
+        if ( NULL != printerState )
+        {
+            switch (ippGetInteger (printerState, 0))
+            {
+                case IPP_PRINTER_IDLE:
+                    *state = g_strdup (_("Idle"));
+                    break;
+                case IPP_PRINTER_STOPPED:
+                    *state = g_strdup (_("Stopped"));
+                    break;
+                case IPP_PRINTER_PROCESSING:
+                    *state = g_strdup (_("Processing"));
+                    break;
+                default:
+                    *state = g_strdup (_("Unknown"));
+                    break;
+            }
+        }
+
+        // Get the location.
+        ipp_attribute_t *printerLocation =
+            ippFindAttribute (answer, "printer-location", IPP_TAG_ZERO);
+        if ( NULL != printerLocation )
+        {
+            *location = g_strdup (ippGetString (printerLocation, 0, NULL));
+        }
+
+        ippDelete (answer);
+    }
+
+    httpClose (http);
+    g_free (uri);
+    g_free (printerName);
+    g_free (instanceName);
+}
+
+///
+/// @brief Reads the printer's options from its PPD.
+///
+/// The options that the printer's destination sets are marked as the
+/// options' defaults.
+///
+PrinterOptions *
+CupsPrinterSource::getPrinterOptions (const gchar *printerAndInstanceNames)
+{
+    gchar *printerName = NULL;
+    gchar *instanceName = NULL;
+    splitPrinterName (printerAndInstanceNames, &printerName, &instanceName);
+
+    PrinterOptions *options = NULL;
+    cups_dest_t *destinations;
+    gint numDestinations = cupsGetDests (&destinations);
+    cups_dest_t *destination = cupsGetDest (printerName, instanceName,
+                                            numDestinations, destinations);
+    if ( NULL != destination )
+    {
+        const gchar *printerPPDName = cupsGetPPD (printerName);
+        if ( NULL != printerPPDName )
+        {
+            ppd_file_t *printerPPD = ppdOpenFile (printerPPDName);
+            if ( NULL != printerPPD )
+            {
+                ppdMarkDefaults (printerPPD);
+                cupsMarkOptions (printerPPD, destination->num_options,
+                                 destination->options);
+
+                options = new PrinterOptions ();
+                addChoices (options, PRINTER_OPTION_PAGE_SIZE, printerPPD,
+                            "PageSize", _("A4"), "A4");
+                addChoices (options, PRINTER_OPTION_RESOLUTION, printerPPD,
+                            "Resolution", _("300 DPI"), "300x300dpi");
+                addChoices (options, PRINTER_OPTION_COLOR_MODEL, printerPPD,
+                            "ColorModel", _("Grayscale"), "Gray");
+                for ( int currentSize = 0 ;
+                      currentSize < printerPPD->num_sizes ;
+                      ++currentSize )
+                {
+                    ppd_size_t *size = &printerPPD->sizes[currentSize];
+                    options->addPageSize (size->name, size->width,
+                                          size->length);
+                }
+                ppdClose (printerPPD);
+            }
+            unlink (printerPPDName);
+        }
+    }
+    cupsFreeDests (numDestinations, destinations);
+    g_free (printerName);
+    g_free (instanceName);
+
+    return options;
+}
+
+///
+/// @brief Gets the CUPS destinations.
+///
+gchar **
+CupsPrinterSource::getPrinters (gint *defaultPrinter)
+{
+    g_assert (NULL != defaultPrinter &&
+              "Tried to save the default printer to NULL.");
+
+    cups_dest_t *destinations;
+    int numDestinations = cupsGetDests (&destinations);
+    gchar **printers = g_new0 (gchar *, numDestinations + 1);
+    *defaultPrinter = -1;
+
+    for ( int currentDestination = 0 ; currentDestination < numDestinations ;
+          ++currentDestination )
+    {
+        // Get the printer name and the local instance, if it has any.
+        if ( NULL != destinations[currentDestination].instance )
+        {
+            printers[currentDestination] = g_strdup_printf ("%s/%s",
+                    destinations[currentDestination].name,
+                    destinations[currentDestination].instance );
+        }
+        else
+        {
+            printers[currentDestination] =
+                g_strdup (destinations[currentDestination].name);
+        }
+        if ( -1 == *defaultPrinter &&
+             destinations[currentDestination].is_default )
+        {
+            *defaultPrinter = currentDestination;
+        }
+    }
+    cupsFreeDests (numDestinations, destinations);
+
+    return printers;
+}
+
+///
+/// @brief Adds the choices of a PPD's option.
+///
+/// @param options The options to add the choices to.
+/// @param option The option to add the choices to.
+/// @param printerPPD The PPD to read the choices from.
+/// @param optionName The option's name in @a printerPPD.
+/// @param defaultText The text of the choice to add if @a printerPPD
+///                    doesn't have the option.
+/// @param defaultValue The value of the choice to add if @a printerPPD
+///                     doesn't have the option.
+///
+void
+addChoices (PrinterOptions *options, PrinterOptionType option,
+            ppd_file_t *printerPPD, const gchar *optionName,
+            const gchar *defaultText, const gchar *defaultValue)
+{
+    ppd_option_t *ppdOption = ppdFindOption (printerPPD, optionName);
+    if ( NULL == ppdOption )
+    {
+        options->addChoice (option, defaultText, defaultValue, TRUE);
+        return;
+    }
+
+    ppd_choice_t *choice = ppdOption->choices;
+    for ( int currentChoice = 0 ; currentChoice < ppdOption->num_choices ;
+          ++currentChoice, ++choice )
+    {
+        options->addChoice (option, _(choice->text), choice->choice,
+                            choice->marked);
+    }
+}
+
+///
+/// @brief Splits a printer's name from its instance's.
+///
+/// @param printerAndInstanceNames The printer's name, with its instance
+///                                after a slash, if it has any.
+/// @param printerName The output location to save the printer's name to.
+/// @param instanceName The output location to save the instance's name to,
+///                     or NULL if there is no instance.
+///
+void
+splitPrinterName (const gchar *printerAndInstanceNames, gchar **printerName,
+                  gchar **instanceName)
+{
+    const gchar *slashPosition = g_strrstr (printerAndInstanceNames, "/");
+    if ( NULL != slashPosition )
+    {
+        *printerName = g_strndup (printerAndInstanceNames,
+                                  slashPosition - printerAndInstanceNames);
+        *instanceName = g_strdup (slashPosition + 1);
+    }
+    else
+    {
+        *printerName = g_strdup (printerAndInstanceNames);
+        *instanceName = NULL;
+    }
+}
@@ -0,0 +1,49 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__CUPS_PRINTER_SOURCE_H__)
+#define __CUPS_PRINTER_SOURCE_H__
+
+namespace ePDFView
+{
+    ///
+    /// @class CupsPrinterSource
+    /// @brief Gets the printers from CUPS.
+    ///
+    /// Each query connects to the CUPS server, that on sites with
+    /// many queues or remote printers can take several seconds.
+    ///
+    class CupsPrinterSource: public IPrinterSource
+    {
+        public:
+            CupsPrinterSource (void);
+            ~CupsPrinterSource (void);
+
+            void getPrinterAttributes (const gchar *printerName,
+                                       gint *numJobs, gchar **state,
+                                       gchar **location);
+            PrinterOptions *getPrinterOptions (const gchar *printerName);
+            gchar **getPrinters (gint *defaultPrinter);
+    };
+}
+
+#endif // !__CUPS_PRINTER_SOURCE_H__
@@ -0,0 +1,637 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <string.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_DEFINE_STATIC (diskCache);
+
+// Constants.
+/// The zlib level to compress the images with. Rendered pages are mostly
+/// blank, so the fastest level already makes them several times smaller.
+static const gint COMPRESSION_LEVEL = 1;
+/// The extension of the entries' files.
+static const gchar *ENTRY_EXTENSION = ".cache";
+/// The first bytes of an entry's file, including the format's version.
+static const gchar ENTRY_MAGIC[8] = { 'e', 'P', 'D', 'F', 'C', 'A', '0', '1' };
+/// The maximum width and height of an entry's image.
+static const guint32 ENTRY_MAX_SIZE = 16384;
+/// The bytes read from each end of a file to tell it from other files.
+static const gsize IDENTITY_SAMPLE_SIZE = 64 * 1024;
+/// @brief The seconds after which a temporary file is left over from a
+/// crash, and not another instance still writing it.
+static const gint64 STALE_TEMPORARY_AGE = 60 * 60;
+/// The most that zlib's deflate can make data smaller by.
+static const gsize ZLIB_MAX_RATIO = 1032;
+
+///
+/// @brief The header of an entry's file.
+///
+/// The compressed image's rows follow the header. The values are in the
+/// machine's byte order, as the cache is never shared between machines.
+///
+typedef struct
+{
+    /// Must be ENTRY_MAGIC.
+    gchar magic[8];
+    /// The image's width.
+    guint32 width;
+    /// The image's height.
+    guint32 height;
+    /// The bytes of each of the image's rows.
+    guint32 rowStride;
+    /// The rotation the image was rendered with.
+    gint32 rotation;
+    /// The zoom the image was rendered with.
+    gdouble zoom;
+    /// The bytes of the compressed image.
+    guint32 dataSize;
+    /// Unused, keeps the header's size a multiple of 8.
+    guint32 reserved;
+} DiskCacheHeader;
+
+///
+/// @brief An entry found while pruning the cache.
+///
+typedef struct
+{
+    /// The entry's file name.
+    gchar *fileName;
+    /// The last time the entry was used.
+    gint64 usedTime;
+    /// The size of the entry's file.
+    gsize size;
+} DiskCacheEntry;
+
+// Forward declarations.
+static gint compareEntries (gconstpointer a, gconstpointer b);
+static GBytes *compressImage (const guchar *data, gsize size);
+static gboolean decompressImage (const guchar *data, gsize size,
+                                 guchar *image, gsize imageSize);
+static DocumentPage *readEntry (const gchar *contents, gsize length,
+                                gsize budget, gdouble *zoom,
+                                gint *rotation);
+
+///
+/// @brief Constructs a new disk cache.
+///
+/// The directory is created when the first entry is stored.
+///
+/// @param directory The directory to store the entries to.
+/// @param budget The maximum bytes that the entries can use.
+///
+DiskCache::DiskCache (const gchar *directory, gsize budget)
+{
+    g_assert (NULL != directory && "Tried to use a NULL directory.");
+
+    m_Budget = budget;
+    m_Directory = g_strdup (directory);
+    m_Scanned = FALSE;
+    m_Size = 0;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by DiskCache.
+///
+DiskCache::~DiskCache ()
+{
+    g_free (m_Directory);
+}
+
+///
+/// @brief Gets the key that tells a document's file apart.
+///
+/// The key is a checksum of the file's size, modification time and the
+/// bytes at its start and end. It doesn't depend on the file's name, so
+/// a moved document keeps its entries, but a changed document doesn't
+/// get the entries of its previous version.
+///
+/// @param fileName The document's file name.
+///
+/// @return The document's key, that must be freed with g_free(), or
+///         NULL if the file can't be read.
+///
+gchar *
+DiskCache::getDocumentKey (const gchar *fileName)
+{
+    g_assert (NULL != fileName && "Tried to get the key of a NULL file.");
+
+    GStatBuf info;
+    if ( 0 != g_stat (fileName, &info) || !S_ISREG (info.st_mode) )
+    {
+        return NULL;
+    }
+    GFile *file = g_file_new_for_path (fileName);
+    GFileInputStream *stream = g_file_read (file, NULL, NULL);
+    g_object_unref (file);
+    if ( NULL == stream )
+    {
+        return NULL;
+    }
+
+    GChecksum *checksum = g_checksum_new (G_CHECKSUM_SHA256);
+    guint64 fileSize = (guint64)info.st_size;
+    gint64 modifiedTime = (gint64)info.st_mtime;
+    g_checksum_update (checksum, (const guchar *)&fileSize,
+                       sizeof (fileSize));
+    g_checksum_update (checksum, (const guchar *)&modifiedTime,
+                       sizeof (modifiedTime));
+
+    guchar *sample = g_new (guchar, IDENTITY_SAMPLE_SIZE);
+    gsize sampleSize = 0;
+    gboolean read = g_input_stream_read_all (G_INPUT_STREAM (stream), sample,
+                                             IDENTITY_SAMPLE_SIZE,
+                                             &sampleSize, NULL, NULL);
+    g_checksum_update (checksum, sample, sampleSize);
+    if ( read && fileSize > IDENTITY_SAMPLE_SIZE )
+    {
+        read = g_seekable_seek (G_SEEKABLE (stream),
+                                -(goffset)IDENTITY_SAMPLE_SIZE, G_SEEK_END,
+                                NULL, NULL) &&
+               g_input_stream_read_all (G_INPUT_STREAM (stream), sample,
+                                        IDENTITY_SAMPLE_SIZE, &sampleSize,
+                                        NULL, NULL);
+        g_checksum_update (checksum, sample, sampleSize);
+    }
+    g_free (sample);
+    g_object_unref (stream);
+
+    gchar *key = read ? g_strdup (g_checksum_get_string (checksum)) : NULL;
+    g_checksum_free (checksum);
+
+    return key;
+}
+
+///
+/// @brief Gets the maximum bytes the entries can use.
+///
+/// @return The cache's budget in bytes.
+///
+gsize
+DiskCache::getBudget ()
+{
+    return m_Budget;
+}
+
+///
+/// @brief Gets the cache's directory.
+///
+/// @return The directory where the entries are stored.
+///
+const gchar *
+DiskCache::getDirectory ()
+{
+    return m_Directory;
+}
+
+///
+/// @brief Gets the bytes that the entries use.
+///
+/// @return The size of all entries' files.
+///
+gsize
+DiskCache::getSize ()
+{
+    G_LOCK (diskCache);
+    if ( !m_Scanned )
+    {
+        scan ();
+    }
+    gsize size = m_Size;
+    G_UNLOCK (diskCache);
+
+    return size;
+}
+
+///
+/// @brief Reads an entry's image.
+///
+/// The entry becomes the most recently used. If the entry can't be read
+/// back, because it's truncated, corrupted or from another version, it's
+/// deleted.
+///
+/// @param documentKey The key of the entry's document.
+/// @param name The entry's name.
+/// @param zoom Where to save the zoom the image was stored with.
+/// @param rotation Where to save the rotation the image was stored with.
+///
+/// @return The entry's image, that must be freed by calling delete, or
+///         NULL if there's no such entry.
+///
+DocumentPage *
+DiskCache::lookup (const gchar *documentKey, const gchar *name,
+                   gdouble *zoom, gint *rotation)
+{
+    g_assert (NULL != documentKey && "Tried to look up a NULL key.");
+    g_assert (NULL != name && "Tried to look up a NULL name.");
+
+    gchar *path = getEntryPath (documentKey, name);
+    G_LOCK (diskCache);
+    gchar *contents = NULL;
+    gsize length = 0;
+    DocumentPage *image = NULL;
+    if ( g_file_get_contents (path, &contents, &length, NULL) )
+    {
+        image = readEntry (contents, length, m_Budget, zoom, rotation);
+        if ( NULL != image )
+        {
+            g_utime (path, NULL);
+        }
+        else
+        {
+            g_warning ("Deleted the unreadable cache entry '%s'.", path);
+            if ( 0 == g_unlink (path) && m_Scanned )
+            {
+                m_Size -= MIN (m_Size, length);
+            }
+        }
+        g_free (contents);
+    }
+    G_UNLOCK (diskCache);
+    g_free (path);
+
+    return image;
+}
+
+///
+/// @brief Deletes the least recently used entries over the budget.
+///
+void
+DiskCache::prune ()
+{
+    G_LOCK (diskCache);
+    if ( !m_Scanned )
+    {
+        scan ();
+    }
+    if ( m_Size > m_Budget )
+    {
+        removeOldEntries ();
+    }
+    G_UNLOCK (diskCache);
+}
+
+///
+/// @brief Stores an image in the cache.
+///
+/// The entry that @a documentKey had with @a name already is replaced.
+/// Then, if the cache is over its budget, it's pruned.
+///
+/// @param documentKey The key of the image's document.
+/// @param name The entry's name.
+/// @param image The image to store.
+/// @param zoom The zoom the image was rendered with.
+/// @param rotation The rotation the image was rendered with.
+///
+/// @return TRUE if the image could be stored, FALSE otherwise.
+///
+gboolean
+DiskCache::store (const gchar *documentKey, const gchar *name,
+                  DocumentPage *image, gdouble zoom, gint rotation)
+{
+    g_assert (NULL != documentKey && "Tried to store a NULL key.");
+    g_assert (NULL != name && "Tried to store a NULL name.");
+    g_assert (NULL != image && "Tried to store a NULL image.");
+
+    gsize imageSize = image->getRowStride () * image->getHeight ();
+    GBytes *compressed = compressImage (image->getData (), imageSize);
+    if ( NULL == compressed )
+    {
+        return FALSE;
+    }
+    gsize dataSize = 0;
+    gconstpointer data = g_bytes_get_data (compressed, &dataSize);
+
+    DiskCacheHeader header;
+    memset (&header, 0, sizeof (header));
+    memcpy (header.magic, ENTRY_MAGIC, sizeof (header.magic));
+    header.width = image->getWidth ();
+    header.height = image->getHeight ();
+    header.rowStride = image->getRowStride ();
+    header.rotation = rotation;
+    header.zoom = zoom;
+    header.dataSize = dataSize;
+    gsize length = sizeof (header) + dataSize;
+    gchar *contents = (gchar *)g_malloc (length);
+    memcpy (contents, &header, sizeof (header));
+    memcpy (contents + sizeof (header), data, dataSize);
+    g_bytes_unref (compressed);
+
+    gchar *path = getEntryPath (documentKey, name);
+    G_LOCK (diskCache);
+    if ( !m_Scanned )
+    {
+        scan ();
+    }
+    GStatBuf info;
+    gsize oldLength = 0;
+    if ( 0 == g_stat (path, &info) )
+    {
+        oldLength = info.st_size;
+    }
+    // g_file_set_contents() writes to a temporary file that is then
+    // renamed, so readers either see the old entry or the new one.
+    g_mkdir_with_parents (m_Directory, 0700);
+    gboolean stored = g_file_set_contents (path, contents, length, NULL);
+    if ( stored )
+    {
+        m_Size = m_Size - MIN (m_Size, oldLength) + length;
+        if ( m_Size > m_Budget )
+        {
+            removeOldEntries ();
+        }
+    }
+    G_UNLOCK (diskCache);
+    g_free (path);
+    g_free (contents);
+
+    return stored;
+}
+
+///
+/// @brief Gets the file name of an entry.
+///
+/// @param documentKey The key of the entry's document.
+/// @param name The entry's name.
+///
+/// @return The path to the entry's file. It must be freed with g_free().
+///
+gchar *
+DiskCache::getEntryPath (const gchar *documentKey, const gchar *name)
+{
+    gchar *fileName = g_strconcat (documentKey, "-", name, ENTRY_EXTENSION,
+                                   NULL);
+    gchar *path = g_build_filename (m_Directory, fileName, NULL);
+    g_free (fileName);
+
+    return path;
+}
+
+///
+/// @brief Deletes the least recently used entries until within budget.
+///
+/// The directory is read again, as other instances could have added
+/// entries meanwhile. The cache must be locked.
+///
+void
+DiskCache::removeOldEntries ()
+{
+    GDir *directory = g_dir_open (m_Directory, 0, NULL);
+    if ( NULL == directory )
+    {
+        return;
+    }
+    GArray *entries = g_array_new (FALSE, FALSE, sizeof (DiskCacheEntry));
+    gsize size = 0;
+    const gchar *fileName;
+    while ( NULL != (fileName = g_dir_read_name (directory)) )
+    {
+        gchar *path = g_build_filename (m_Directory, fileName, NULL);
+        GStatBuf info;
+        if ( g_str_has_suffix (fileName, ENTRY_EXTENSION) &&
+             0 == g_stat (path, &info) )
+        {
+            DiskCacheEntry entry;
+            entry.fileName = path;
+            entry.usedTime = (gint64)info.st_mtime;
+            entry.size = info.st_size;
+            g_array_append_val (entries, entry);
+            size += entry.size;
+        }
+        else
+        {
+            g_free (path);
+        }
+    }
+    g_dir_close (directory);
+
+    g_array_sort (entries, compareEntries);
+    for ( guint entryIndex = 0 ; entryIndex < entries->len ; entryIndex++ )
+    {
+        DiskCacheEntry &entry =
+            g_array_index (entries, DiskCacheEntry, entryIndex);
+        if ( size > m_Budget && 0 == g_unlink (entry.fileName) )
+        {
+            size -= entry.size;
+        }
+        g_free (entry.fileName);
+    }
+    g_array_free (entries, TRUE);
+    m_Size = size;
+}
+
+///
+/// @brief Reads the size of the entries in the directory.
+///
+/// The temporary files left over by a crash while writing an entry are
+/// deleted. The cache must be locked.
+///
+void
+DiskCache::scan ()
+{
+    m_Scanned = TRUE;
+    m_Size = 0;
+    GDir *directory = g_dir_open (m_Directory, 0, NULL);
+    if ( NULL == directory )
+    {
+        return;
+    }
+    gint64 now = g_get_real_time () / G_USEC_PER_SEC;
+    const gchar *fileName;
+    while ( NULL != (fileName = g_dir_read_name (directory)) )
+    {
+        gchar *path = g_build_filename (m_Directory, fileName, NULL);
+        GStatBuf info;
+        if ( 0 == g_stat (path, &info) )
+        {
+            if ( g_str_has_suffix (fileName, ENTRY_EXTENSION) )
+            {
+                m_Size += info.st_size;
+            }
+            else if ( NULL != strstr (fileName, ENTRY_EXTENSION) &&
+                      now - (gint64)info.st_mtime > STALE_TEMPORARY_AGE )
+            {
+                g_unlink (path);
+            }
+        }
+        g_free (path);
+    }
+    g_dir_close (directory);
+}
+
+///
+/// @brief Compares when two entries were last used.
+///
+/// @param a The first DiskCacheEntry.
+/// @param b The second DiskCacheEntry.
+///
+/// @return A negative value if @a a was used before @a b, 0 if at the
+///         same time and a positive value otherwise.
+///
+gint
+compareEntries (gconstpointer a, gconstpointer b)
+{
+    gint64 timeA = ((const DiskCacheEntry *)a)->usedTime;
+    gint64 timeB = ((const DiskCacheEntry *)b)->usedTime;
+
+    return timeA < timeB ? -1 : (timeA > timeB ? 1 : 0);
+}
+
+///
+/// @brief Compresses an image's pixels.
+///
+/// @param data The pixels to compress.
+/// @param size The number of bytes of @a data.
+///
+/// @return The compressed pixels or NULL on error.
+///
+GBytes *
+compressImage (const guchar *data, gsize size)
+{
+    GZlibCompressor *compressor =
+        g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB,
+                               COMPRESSION_LEVEL);
+    GOutputStream *memory = g_memory_output_stream_new_resizable ();
+    GOutputStream *stream =
+        g_converter_output_stream_new (memory, G_CONVERTER (compressor));
+    GBytes *compressed = NULL;
+    // Closing the stream closes the memory stream as well.
+    if ( g_output_stream_write_all (stream, data, size, NULL, NULL, NULL) &&
+         g_output_stream_close (stream, NULL, NULL) )
+    {
+        compressed = g_memory_output_stream_steal_as_bytes (
+                G_MEMORY_OUTPUT_STREAM (memory));
+    }
+    g_object_unref (stream);
+    g_object_unref (memory);
+    g_object_unref (compressor);
+
+    return compressed;
+}
+
+///
+/// @brief Decompresses an image's pixels.
+///
+/// The zlib stream has a checksum, so corrupted pixels are detected.
+///
+/// @param data The compressed pixels.
+/// @param size The number of bytes of @a data.
+/// @param image Where to save the pixels.
+/// @param imageSize The number of bytes that the pixels must have.
+///
+/// @return TRUE if @a data had exactly @a imageSize bytes of pixels,
+///         FALSE otherwise.
+///
+gboolean
+decompressImage (const guchar *data, gsize size, guchar *image,
+                 gsize imageSize)
+{
+    GZlibDecompressor *decompressor =
+        g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_ZLIB);
+    GInputStream *memory = g_memory_input_stream_new_from_data (data, size,
+                                                                NULL);
+    GInputStream *stream =
+        g_converter_input_stream_new (memory, G_CONVERTER (decompressor));
+    gsize read = 0;
+    gboolean decompressed =
+        g_input_stream_read_all (stream, image, imageSize, &read, NULL,
+                                 NULL) && read == imageSize;
+    if ( decompressed )
+    {
+        // Reading past the image must find the stream's end.
+        guchar extra;
+        decompressed = g_input_stream_read_all (stream, &extra, 1, &read,
+                                                NULL, NULL) && 0 == read;
+    }
+    g_object_unref (stream);
+    g_object_unref (memory);
+    g_object_unref (decompressor);
+
+    return decompressed;
+}
+
+///
+/// @brief Reads the image of an entry's file.
+///
+/// @param contents The contents of the entry's file.
+/// @param length The number of bytes of @a contents.
+/// @param budget The cache's budget. Larger images are not read.
+/// @param zoom Where to save the zoom the image was stored with.
+/// @param rotation Where to save the rotation the image was stored with.
+///
+/// @return The entry's image, that must be freed by calling delete, or
+///         NULL if @a contents is not a valid entry.
+///
+DocumentPage *
+readEntry (const gchar *contents, gsize length, gsize budget,
+           gdouble *zoom, gint *rotation)
+{
+    DiskCacheHeader header;
+    if ( length < sizeof (header) )
+    {
+        return NULL;
+    }
+    memcpy (&header, contents, sizeof (header));
+    if ( 0 != memcmp (header.magic, ENTRY_MAGIC, sizeof (header.magic)) ||
+         0 == header.width || ENTRY_MAX_SIZE < header.width ||
+         0 == header.height || ENTRY_MAX_SIZE < header.height ||
+         length - sizeof (header) != header.dataSize )
+    {
+        return NULL;
+    }
+    // The image is only allocated when the compressed data could hold it,
+    // so a damaged header can't make it allocate up to 1 GiB.
+    gsize maxImageSize = (gsize)header.width * 4 * header.height;
+    if ( header.rowStride < header.width * 3 ||
+         header.rowStride > header.width * 4 ||
+         maxImageSize > budget ||
+         maxImageSize > (gsize)header.dataSize * ZLIB_MAX_RATIO )
+    {
+        return NULL;
+    }
+
+    DocumentPage *image = new DocumentPage ();
+    image->newPage (header.width, header.height);
+    gsize imageSize = image->getRowStride () * image->getHeight ();
+    if ( (guint32)image->getRowStride () != header.rowStride ||
+         !decompressImage ((const guchar *)contents + sizeof (header),
+                           header.dataSize, image->getData (), imageSize) )
+    {
+        delete image;
+        return NULL;
+    }
+    if ( NULL != zoom )
+    {
+        *zoom = header.zoom;
+    }
+    if ( NULL != rotation )
+    {
+        *rotation = header.rotation;
+    }
+
+    return image;
+}
@@ -0,0 +1,80 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DISK_CACHE_H__)
+#define __DISK_CACHE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentPage;
+
+    ///
+    /// @class DiskCache
+    /// @brief Rendered images kept on disk between sessions.
+    ///
+    /// Each entry is a page's image, like a thumbnail or the first page,
+    /// stored under a document's key, as told by getDocumentKey(), and a
+    /// name. The images are compressed and the entries are written to a
+    /// temporary file that replaces the entry, so a crash never leaves a
+    /// half written entry. Entries that can't be read back are deleted.
+    ///
+    /// When the entries use more than the cache's budget, the least
+    /// recently used ones are deleted.
+    ///
+    class DiskCache
+    {
+        public:
+            DiskCache (const gchar *directory, gsize budget);
+            ~DiskCache (void);
+
+            static gchar *getDocumentKey (const gchar *fileName);
+
+            gsize getBudget (void);
+            const gchar *getDirectory (void);
+            gsize getSize (void);
+            DocumentPage *lookup (const gchar *documentKey,
+                                  const gchar *name, gdouble *zoom,
+                                  gint *rotation);
+            void prune (void);
+            gboolean store (const gchar *documentKey, const gchar *name,
+                            DocumentPage *image, gdouble zoom,
+                            gint rotation);
+
+        protected:
+            /// The maximum bytes that the entries can use.
+            gsize m_Budget;
+            /// The directory where the entries are.
+            gchar *m_Directory;
+            /// Tells if m_Size has been read from the directory.
+            gboolean m_Scanned;
+            /// The bytes that the entries use.
+            gsize m_Size;
+
+            gchar *getEntryPath (const gchar *documentKey,
+                                 const gchar *name);
+            void removeOldEntries (void);
+            void scan (void);
+    };
+}
+
+#endif // !__DISK_CACHE_H__
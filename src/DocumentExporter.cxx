@@ -0,0 +1,1014 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <gettext.h>
+#include <glib-unix.h>
+#include <glib/gstdio.h>
+#include <cairo-pdf.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static gpointer exporter_extract_text (gpointer data);
+static gpointer exporter_render_images (gpointer data);
+static gpointer exporter_write_postscript (gpointer data);
+static gboolean writeAll (gint fd, const gchar *data, gsize length);
+
+// Constants.
+/// The resolution the pages are exported at by default.
+static const gdouble DEFAULT_RESOLUTION = 150.0;
+/// @brief The highest resolution the pages can be exported at, the
+/// document's maximum zoom.
+static const gdouble MAX_RESOLUTION = 576.0;
+/// @brief The lowest resolution the pages can be exported at, the
+/// document's minimum zoom.
+static const gdouble MIN_RESOLUTION = 7.2;
+/// The points in an inch, the unit of the pages' size.
+static const gdouble POINTS_PER_INCH = 72.0;
+/// The bytes read from the pipe on each write of the PostScript file.
+static const gsize POSTSCRIPT_BUFFER_SIZE = 64 * 1024;
+/// The pages of text each thread can extract ahead of the written text.
+static const guint TEXT_PAGES_PER_THREAD = 2;
+
+///
+/// @brief A rendering thread's data.
+///
+typedef struct
+{
+    /// The exporter that started the thread.
+    DocumentExporter *exporter;
+    /// The thread's own copy of the document.
+    IDocument *document;
+    /// The thread.
+    GThread *thread;
+} ExportWorker;
+
+///
+/// @brief Constructs a new DocumentExporter object.
+///
+/// By default all pages are exported as PNG images at 150 DPI, using
+/// as many threads as processors.
+///
+/// @param document The loaded document to export. The exporter doesn't
+///                 take its ownership.
+///
+DocumentExporter::DocumentExporter (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to export a NULL document.");
+
+    m_Cancelled = FALSE;
+    m_Document = document;
+    m_Error = NULL;
+    m_Format = EXPORT_FORMAT_PNG;
+    g_mutex_init (&m_Lock);
+    m_NextPage = 0;
+    m_NextText = 0;
+    m_NumPagesExported = 0;
+    m_NumThreads = g_get_num_processors ();
+    m_OutputFd = -1;
+    m_OutputPattern = NULL;
+    m_Pages = g_array_new (FALSE, FALSE, sizeof (gint));
+    m_PageTexts = NULL;
+    m_ProgressCallback = NULL;
+    m_ProgressData = NULL;
+    m_Resolution = DEFAULT_RESOLUTION;
+    g_cond_init (&m_TextWritten);
+    m_TextWindow = 0;
+}
+
+///
+/// @brief Destroys all dynamically allocated memory for DocumentExporter.
+///
+DocumentExporter::~DocumentExporter ()
+{
+    if ( NULL != m_Error )
+    {
+        g_error_free (m_Error);
+    }
+    g_mutex_clear (&m_Lock);
+    g_cond_clear (&m_TextWritten);
+    g_free (m_OutputPattern);
+    g_array_free (m_Pages, TRUE);
+}
+
+///
+/// @brief Stops the export.
+///
+/// Can be called from any thread. The pages being exported are still
+/// finished, and exportPages() then fails with G_IO_ERROR_CANCELLED.
+///
+void
+DocumentExporter::cancel ()
+{
+    g_mutex_lock (&m_Lock);
+    g_atomic_int_set (&m_Cancelled, TRUE);
+    g_cond_broadcast (&m_TextWritten);
+    g_mutex_unlock (&m_Lock);
+}
+
+///
+/// @brief Exports the pages.
+///
+/// @param error The location to store the error, if any.
+///
+/// @return TRUE if all pages were exported, FALSE otherwise.
+///
+gboolean
+DocumentExporter::exportPages (GError **error)
+{
+    g_assert (NULL != m_OutputPattern && "The output pattern isn't set.");
+
+    if ( 0 == m_Pages->len )
+    {
+        for ( gint pageNum = 1 ; pageNum <= m_Document->getNumPages () ;
+              pageNum++ )
+        {
+            g_array_append_val (m_Pages, pageNum);
+        }
+    }
+    m_NextPage = 0;
+    m_NumPagesExported = 0;
+
+    gboolean exported = FALSE;
+    switch ( m_Format )
+    {
+        case EXPORT_FORMAT_PDF:
+            exported = exportPdf ();
+            break;
+
+        case EXPORT_FORMAT_PS:
+            exported = exportPostscript ();
+            break;
+
+        case EXPORT_FORMAT_TEXT:
+            exported = exportText ();
+            break;
+
+        default:
+            exported = exportImages ();
+    }
+    if ( g_atomic_int_get (&m_Cancelled) )
+    {
+        setError (g_error_new_literal (G_IO_ERROR, G_IO_ERROR_CANCELLED,
+                                       _("The export was cancelled.")));
+        exported = FALSE;
+    }
+    if ( !exported )
+    {
+        g_propagate_error (error, m_Error);
+        m_Error = NULL;
+    }
+
+    return exported;
+}
+
+///
+/// @brief Exports the pages as PNG images.
+///
+/// Each thread renders with its own copy of the document,
+/// because Poppler's documents can't be read from several threads,
+/// and takes the next page to render until there are no more.
+///
+/// @return TRUE if all images were written, FALSE otherwise.
+///
+gboolean
+DocumentExporter::exportImages ()
+{
+    gboolean hasPageNumber = FALSE;
+    g_free (formatFileName (m_OutputPattern, 1, &hasPageNumber));
+    if ( !hasPageNumber && 1 < m_Pages->len )
+    {
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorFileIO,
+                               _("The output name must contain %%d to "
+                                 "export more than one page as images.")));
+        return FALSE;
+    }
+
+    runWorkers (exporter_render_images);
+
+    return NULL == m_Error;
+}
+
+///
+/// @brief Exports the pages to a single PDF file.
+///
+/// Each page keeps its own size.
+///
+/// @return TRUE if the file was written, FALSE otherwise.
+///
+gboolean
+DocumentExporter::exportPdf ()
+{
+    cairo_surface_t *surface =
+        cairo_pdf_surface_create (m_OutputPattern, 1.0, 1.0);
+    for ( guint page = 0 ;
+          page < m_Pages->len && !g_atomic_int_get (&m_Cancelled) &&
+          CAIRO_STATUS_SUCCESS == cairo_surface_status (surface) ;
+          page++ )
+    {
+        gint pageNum = g_array_index (m_Pages, gint, page);
+        gdouble pageWidth;
+        gdouble pageHeight;
+        m_Document->getPageSizeForPage (pageNum, &pageWidth, &pageHeight);
+        cairo_pdf_surface_set_size (surface, pageWidth, pageHeight);
+
+        cairo_t *context = cairo_create (surface);
+        m_Document->renderPageForPrinting (pageNum, context);
+        cairo_show_page (context);
+        cairo_destroy (context);
+        pageExported ();
+    }
+    cairo_surface_finish (surface);
+    cairo_status_t status = cairo_surface_status (surface);
+    cairo_surface_destroy (surface);
+
+    if ( CAIRO_STATUS_SUCCESS != status )
+    {
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorFileIO,
+                               _("Couldn't write '%s': %s"), m_OutputPattern,
+                               cairo_status_to_string (status)));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+///
+/// @brief Exports the pages to a single PostScript file.
+///
+/// Uses the same conversion as printing, so the file is what would
+/// be sent to the printer. The paper size is the first page's.
+///
+/// Poppler doesn't tell whether it could write the file, so it writes
+/// to a pipe from another thread, and this thread copies the pipe to
+/// the file. If writing fails, the rest of the pipe is read without
+/// writing it, so the other thread never waits for a full pipe.
+///
+/// @return TRUE if the file was written, FALSE otherwise.
+///
+gboolean
+DocumentExporter::exportPostscript ()
+{
+    gint fd = g_open (m_OutputPattern, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if ( -1 == fd )
+    {
+        int savedErrno = errno;
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorFileIO,
+                               _("Couldn't write '%s': %s"), m_OutputPattern,
+                               g_strerror (savedErrno)));
+        return FALSE;
+    }
+
+    gint pipeFds[2];
+    GError *error = NULL;
+    if ( !g_unix_open_pipe (pipeFds, FD_CLOEXEC, &error) )
+    {
+        close (fd);
+        setError (error);
+        return FALSE;
+    }
+    m_OutputFd = pipeFds[1];
+    GThread *producer =
+        g_thread_new ("export-ps", exporter_write_postscript, this);
+
+    int savedErrno = 0;
+    gchar *buffer = g_new (gchar, POSTSCRIPT_BUFFER_SIZE);
+    for ( ; ; )
+    {
+        gssize bytesRead = read (pipeFds[0], buffer, POSTSCRIPT_BUFFER_SIZE);
+        if ( 0 > bytesRead && EINTR == errno )
+        {
+            continue;
+        }
+        if ( 0 > bytesRead )
+        {
+            savedErrno = errno;
+            break;
+        }
+        if ( 0 == bytesRead )
+        {
+            break;
+        }
+        if ( 0 == savedErrno && !writeAll (fd, buffer, bytesRead) )
+        {
+            savedErrno = errno;
+        }
+    }
+    g_free (buffer);
+    // Closed before joining, so a failed read can't leave the other
+    // thread waiting for a full pipe.
+    close (pipeFds[0]);
+    g_thread_join (producer);
+    m_OutputFd = -1;
+    if ( 0 != close (fd) && 0 == savedErrno )
+    {
+        savedErrno = errno;
+    }
+
+    if ( 0 != savedErrno )
+    {
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorFileIO,
+                               _("Couldn't write '%s': %s"), m_OutputPattern,
+                               g_strerror (savedErrno)));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+///
+/// @brief Exports the text of the pages to a single file.
+///
+/// Each page's text ends with a new line and a form feed, as
+/// pdftotext does, so the pages can still be told apart.
+///
+/// @return TRUE if the text was written, FALSE otherwise.
+///
+gboolean
+DocumentExporter::exportText ()
+{
+    gboolean toStandardOutput = (0 == g_strcmp0 ("-", m_OutputPattern));
+    if ( toStandardOutput )
+    {
+        m_OutputFd = STDOUT_FILENO;
+    }
+    else
+    {
+        m_OutputFd = g_open (m_OutputPattern, O_WRONLY | O_CREAT | O_TRUNC,
+                             0666);
+    }
+    if ( -1 == m_OutputFd )
+    {
+        int savedErrno = errno;
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorFileIO,
+                               _("Couldn't write '%s': %s"), m_OutputPattern,
+                               g_strerror (savedErrno)));
+        return FALSE;
+    }
+
+    guint numThreads = CLAMP (m_NumThreads, 1, MAX (m_Pages->len, 1));
+    m_TextWindow = numThreads * TEXT_PAGES_PER_THREAD;
+    m_PageTexts = g_new0 (gchar *, m_TextWindow);
+    m_NextText = 0;
+    runWorkers (exporter_extract_text);
+    for ( guint text = 0 ; text < m_TextWindow ; text++ )
+    {
+        g_free (m_PageTexts[text]);
+    }
+    g_free (m_PageTexts);
+    m_PageTexts = NULL;
+
+    if ( !toStandardOutput )
+    {
+        if ( 0 != close (m_OutputFd) )
+        {
+            int savedErrno = errno;
+            setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR,
+                                   DocumentErrorFileIO,
+                                   _("Couldn't write '%s': %s"),
+                                   m_OutputPattern, g_strerror (savedErrno)));
+        }
+        // Don't leave a partial text behind.
+        if ( NULL != m_Error || g_atomic_int_get (&m_Cancelled) )
+        {
+            g_unlink (m_OutputPattern);
+        }
+    }
+    m_OutputFd = -1;
+
+    return NULL == m_Error;
+}
+
+///
+/// @brief Extracts text until there are no more pages.
+///
+/// This is run by each text thread. The thread waits while its next
+/// page is too far ahead of the written text, and writes the text
+/// that is ready in order after each page.
+///
+/// @param document The thread's own copy of the document.
+///
+void
+DocumentExporter::extractText (IDocument *document)
+{
+    while ( TRUE )
+    {
+        guint page = (guint)g_atomic_int_add (&m_NextPage, 1);
+        if ( page >= m_Pages->len )
+        {
+            break;
+        }
+
+        g_mutex_lock (&m_Lock);
+        while ( page >= m_NextText + m_TextWindow && !isStopped () )
+        {
+            g_cond_wait (&m_TextWritten, &m_Lock);
+        }
+        gboolean stopped = isStopped ();
+        g_mutex_unlock (&m_Lock);
+        if ( stopped )
+        {
+            break;
+        }
+
+        gchar *text = document->getPageText (g_array_index (m_Pages, gint,
+                                                            page));
+        g_mutex_lock (&m_Lock);
+        m_PageTexts[page % m_TextWindow] =
+            (NULL != text) ? text : g_strdup ("");
+        writePendingText ();
+        g_cond_broadcast (&m_TextWritten);
+        g_mutex_unlock (&m_Lock);
+    }
+}
+
+///
+/// @brief Formats the file name to write a page to.
+///
+/// @param pattern The output pattern.
+/// @param pageNum The page number to replace "%d" with.
+/// @param hasPageNumber The location to tell if @a pattern has a "%d".
+///                      Can be NULL.
+///
+/// @return The file name, that must be freed with g_free().
+///
+gchar *
+DocumentExporter::formatFileName (const gchar *pattern, gint pageNum,
+                                  gboolean *hasPageNumber)
+{
+    g_assert (NULL != pattern && "Tried to format a NULL pattern.");
+
+    GString *fileName = g_string_new (NULL);
+    gboolean found = FALSE;
+    for ( const gchar *character = pattern ; '\0' != *character ;
+          character++ )
+    {
+        if ( '%' == character[0] && '%' == character[1] )
+        {
+            g_string_append_c (fileName, '%');
+            character++;
+            continue;
+        }
+        if ( '%' == character[0] )
+        {
+            const gchar *conversion = character + 1;
+            while ( g_ascii_isdigit (*conversion) )
+            {
+                conversion++;
+            }
+            if ( 'd' == *conversion )
+            {
+                gint width = atoi (character + 1);
+                g_string_append_printf (fileName, "%0*d", width, pageNum);
+                found = TRUE;
+                character = conversion;
+                continue;
+            }
+        }
+        g_string_append_c (fileName, *character);
+    }
+    if ( NULL != hasPageNumber )
+    {
+        *hasPageNumber = found;
+    }
+
+    return g_string_free (fileName, FALSE);
+}
+
+///
+/// @brief Gets the number of pages exported so far.
+///
+/// @return The number of pages already written.
+///
+guint
+DocumentExporter::getNumPagesExported ()
+{
+    return (guint)g_atomic_int_get (&m_NumPagesExported);
+}
+
+///
+/// @brief Gets the number of threads to render the images with.
+///
+/// @return The maximum number of rendering threads.
+///
+guint
+DocumentExporter::getNumThreads ()
+{
+    return m_NumThreads;
+}
+
+///
+/// @brief Gets the export format with a given name.
+///
+/// @param name The format's name: "png", "pdf", "ps" or "txt".
+/// @param format The location to save the format to.
+///
+/// @return TRUE if @a name is a known format, FALSE otherwise.
+///
+gboolean
+DocumentExporter::parseFormat (const gchar *name, ExportFormat *format)
+{
+    g_assert (NULL != format && "Tried to save the format to NULL.");
+
+    if ( NULL == name )
+    {
+        return FALSE;
+    }
+    if ( 0 == g_ascii_strcasecmp ("txt", name) ||
+         0 == g_ascii_strcasecmp ("text", name) )
+    {
+        *format = EXPORT_FORMAT_TEXT;
+    }
+    else if ( 0 == g_ascii_strcasecmp ("png", name) )
+    {
+        *format = EXPORT_FORMAT_PNG;
+    }
+    else if ( 0 == g_ascii_strcasecmp ("pdf", name) )
+    {
+        *format = EXPORT_FORMAT_PDF;
+    }
+    else if ( 0 == g_ascii_strcasecmp ("ps", name) )
+    {
+        *format = EXPORT_FORMAT_PS;
+    }
+    else
+    {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+///
+/// @brief Tells if the export must stop.
+///
+/// Must be called with m_Lock held.
+///
+/// @return TRUE if the export was cancelled or failed, FALSE otherwise.
+///
+gboolean
+DocumentExporter::isStopped ()
+{
+    return g_atomic_int_get (&m_Cancelled) || NULL != m_Error;
+}
+
+///
+/// @brief Counts an exported page and reports the progress.
+///
+void
+DocumentExporter::pageExported ()
+{
+    guint numPagesExported =
+        (guint)g_atomic_int_add (&m_NumPagesExported, 1) + 1;
+    if ( NULL != m_ProgressCallback )
+    {
+        m_ProgressCallback (numPagesExported, m_Pages->len, m_ProgressData);
+    }
+}
+
+///
+/// @brief Renders and saves images until there are no more pages.
+///
+/// This is run by each rendering thread.
+///
+/// @param document The thread's own copy of the document.
+///
+void
+DocumentExporter::renderImages (IDocument *document)
+{
+    gboolean failed = FALSE;
+    while ( !failed && !g_atomic_int_get (&m_Cancelled) )
+    {
+        guint page = (guint)g_atomic_int_add (&m_NextPage, 1);
+        if ( page >= m_Pages->len )
+        {
+            break;
+        }
+
+        gint pageNum = g_array_index (m_Pages, gint, page);
+        DocumentPage *image = document->renderPage (pageNum);
+        if ( NULL == image )
+        {
+            setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR,
+                                   DocumentErrorBadPageNumber,
+                                   _("Couldn't render page %d."), pageNum));
+            break;
+        }
+
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_data (image->getData (),
+                GDK_COLORSPACE_RGB, image->hasAlpha (), 8,
+                image->getWidth (), image->getHeight (),
+                image->getRowStride (), NULL, NULL);
+        gchar *fileName = formatFileName (m_OutputPattern, pageNum, NULL);
+        GError *error = NULL;
+        if ( gdk_pixbuf_save (pixbuf, fileName, "png", &error, NULL) )
+        {
+            pageExported ();
+        }
+        else
+        {
+            setError (error);
+        }
+        g_free (fileName);
+        g_object_unref (pixbuf);
+        delete image;
+
+        g_mutex_lock (&m_Lock);
+        failed = (NULL != m_Error);
+        g_mutex_unlock (&m_Lock);
+    }
+}
+
+///
+/// @brief Runs the worker threads and waits for them.
+///
+/// Each thread gets its own copy of the document, because
+/// Poppler's documents can't be read from several threads. If a copy
+/// can't be made, no thread runs and the error is kept.
+///
+/// @param func The function the threads run, with its ExportWorker.
+///
+void
+DocumentExporter::runWorkers (GThreadFunc func)
+{
+    guint numThreads = CLAMP (m_NumThreads, 1, MAX (m_Pages->len, 1));
+    ExportWorker *workers = g_new (ExportWorker, numThreads);
+    gboolean copied = TRUE;
+    for ( guint worker = 0 ; worker < numThreads ; worker++ )
+    {
+        workers[worker].exporter = this;
+        workers[worker].document = m_Document->copy ();
+        if ( NULL == workers[worker].document )
+        {
+            copied = FALSE;
+            continue;
+        }
+        workers[worker].document->setZoom (m_Resolution / POINTS_PER_INCH);
+    }
+    if ( !copied )
+    {
+        // No worker runs, so none waits for the pages of a missing one.
+        setError (g_error_new (EPDFVIEW_DOCUMENT_ERROR, DocumentErrorOpenFile,
+                               _("Couldn't read the document '%s' again."),
+                               m_Document->getFileName ()));
+        for ( guint worker = 0 ; worker < numThreads ; worker++ )
+        {
+            delete workers[worker].document;
+        }
+        g_free (workers);
+        return;
+    }
+    for ( guint worker = 0 ; worker < numThreads ; worker++ )
+    {
+        workers[worker].thread = g_thread_new ("export", func,
+                                               &workers[worker]);
+    }
+    for ( guint worker = 0 ; worker < numThreads ; worker++ )
+    {
+        g_thread_join (workers[worker].thread);
+        delete workers[worker].document;
+    }
+    g_free (workers);
+}
+
+///
+/// @brief Keeps the first error found.
+///
+/// Wakes up the threads waiting to extract text, so they stop.
+///
+/// @param error The error found. The exporter takes its ownership.
+///
+void
+DocumentExporter::setError (GError *error)
+{
+    g_mutex_lock (&m_Lock);
+    if ( NULL == m_Error )
+    {
+        m_Error = error;
+    }
+    else
+    {
+        g_error_free (error);
+    }
+    g_cond_broadcast (&m_TextWritten);
+    g_mutex_unlock (&m_Lock);
+}
+
+///
+/// @brief Sets the format to export to.
+///
+/// @param format The export format.
+///
+void
+DocumentExporter::setFormat (ExportFormat format)
+{
+    m_Format = format;
+}
+
+///
+/// @brief Sets the number of threads to render the images with.
+///
+/// @param numThreads The maximum number of rendering threads. 0 uses
+///                   a thread per processor.
+///
+void
+DocumentExporter::setNumThreads (guint numThreads)
+{
+    m_NumThreads = (0 == numThreads) ? g_get_num_processors () : numThreads;
+}
+
+///
+/// @brief Sets the file name to write to.
+///
+/// @param pattern The file name. For images, "%d" is replaced by
+///                each page's number.
+///
+void
+DocumentExporter::setOutputPattern (const gchar *pattern)
+{
+    gchar *oldPattern = m_OutputPattern;
+    m_OutputPattern = g_strdup (pattern);
+    g_free (oldPattern);
+}
+
+///
+/// @brief Sets the pages to export.
+///
+/// The range has the same format as when printing: page numbers or
+/// ranges of pages separated by commas, as in "1-3,5,8-10". The pages
+/// are exported in the given order.
+///
+/// @param range The pages to export.
+/// @param error The location to store the error, if the range is not
+///              valid for the document.
+///
+/// @return TRUE if the range is valid, FALSE otherwise.
+///
+gboolean
+DocumentExporter::setPageRange (const gchar *range, GError **error)
+{
+    g_assert (NULL != range && "Tried to set a NULL range.");
+
+    g_array_set_size (m_Pages, 0);
+    gint numPages = m_Document->getNumPages ();
+    gchar **parts = g_strsplit (range, ",", -1);
+    gboolean valid = (NULL != parts[0]);
+    for ( gchar **part = parts ; valid && NULL != *part ; part++ )
+    {
+        gchar *end = NULL;
+        gint64 firstPage = g_ascii_strtoll (*part, &end, 10);
+        gint64 lastPage = firstPage;
+        if ( '-' == *end )
+        {
+            lastPage = g_ascii_strtoll (end + 1, &end, 10);
+        }
+        valid = ( *part != end && '\0' == *g_strchug (end) &&
+                  1 <= firstPage && firstPage <= lastPage &&
+                  lastPage <= numPages );
+        for ( gint pageNum = (gint)firstPage ;
+              valid && pageNum <= (gint)lastPage ; pageNum++ )
+        {
+            g_array_append_val (m_Pages, pageNum);
+        }
+    }
+    g_strfreev (parts);
+
+    if ( !valid )
+    {
+        g_array_set_size (m_Pages, 0);
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR,
+                     DocumentErrorBadPageNumber,
+                     _("Invalid page range '%s'. The document has %d pages."),
+                     range, numPages);
+    }
+
+    return valid;
+}
+
+///
+/// @brief Sets the function to call after each page is exported.
+///
+/// @param callback The function to call, or NULL.
+/// @param data The data to pass to @a callback.
+///
+void
+DocumentExporter::setProgressCallback (ExportProgressFunc callback,
+                                       gpointer data)
+{
+    m_ProgressCallback = callback;
+    m_ProgressData = data;
+}
+
+///
+/// @brief Sets the resolution to render the images at.
+///
+/// The resolution must be one the document can zoom to, because the
+/// zoom would otherwise be clamped and the images be of another size.
+///
+/// @param dpi The resolution in dots per inch.
+/// @param error The location to store the error, if the resolution is
+///              out of range.
+///
+/// @return TRUE if the resolution is valid, FALSE otherwise.
+///
+gboolean
+DocumentExporter::setResolution (gdouble dpi, GError **error)
+{
+    if ( MIN_RESOLUTION > dpi || MAX_RESOLUTION < dpi )
+    {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                     _("Invalid resolution %g. It must be between %g and "
+                       "%g DPI."), dpi, MIN_RESOLUTION, MAX_RESOLUTION);
+        return FALSE;
+    }
+    m_Resolution = dpi;
+
+    return TRUE;
+}
+
+///
+/// @brief Writes the pages to the PostScript pipe.
+///
+/// This is run by the thread exportPostscript() starts, and closes the
+/// pipe when all pages are written or the export is cancelled.
+///
+void
+DocumentExporter::writePostscript ()
+{
+    gdouble pageWidth = 0.0;
+    gdouble pageHeight = 0.0;
+    if ( 0 < m_Pages->len )
+    {
+        m_Document->getPageSizeForPage (g_array_index (m_Pages, gint, 0),
+                                        &pageWidth, &pageHeight);
+    }
+    // The document closes the pipe at outputPostscriptEnd().
+    m_Document->outputPostscriptBegin (m_OutputFd, m_Pages->len,
+                                       pageWidth, pageHeight);
+    for ( guint page = 0 ;
+          page < m_Pages->len && !g_atomic_int_get (&m_Cancelled) ;
+          page++ )
+    {
+        m_Document->outputPostscriptPage (g_array_index (m_Pages, gint,
+                                                         page));
+        pageExported ();
+    }
+    m_Document->outputPostscriptEnd ();
+}
+
+///
+/// @brief Writes the text of the pages that are next in order.
+///
+/// Must be called with m_Lock held, so the text is written by a single
+/// thread at a time.
+///
+void
+DocumentExporter::writePendingText ()
+{
+    while ( m_NextText < m_Pages->len && !isStopped () )
+    {
+        gchar **slot = &m_PageTexts[m_NextText % m_TextWindow];
+        if ( NULL == *slot )
+        {
+            break;
+        }
+
+        gsize length = strlen (*slot);
+        gboolean written = writeAll (m_OutputFd, *slot, length);
+        if ( written && (0 == length || '\n' != (*slot)[length - 1]) )
+        {
+            written = writeAll (m_OutputFd, "\n", 1);
+        }
+        if ( written )
+        {
+            written = writeAll (m_OutputFd, "\f", 1);
+        }
+        int savedErrno = errno;
+        g_free (*slot);
+        *slot = NULL;
+        if ( !written )
+        {
+            m_Error = g_error_new (EPDFVIEW_DOCUMENT_ERROR,
+                                   DocumentErrorFileIO,
+                                   _("Couldn't write '%s': %s"),
+                                   m_OutputPattern, g_strerror (savedErrno));
+            break;
+        }
+        m_NextText++;
+        pageExported ();
+    }
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief Extracts text from a thread.
+///
+/// @param data The ExportWorker with the thread's document.
+///
+/// @return NULL.
+///
+gpointer
+exporter_extract_text (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    ExportWorker *worker = (ExportWorker *)data;
+    worker->exporter->extractText (worker->document);
+
+    return NULL;
+}
+
+///
+/// @brief Renders images from a thread.
+///
+/// @param data The ExportWorker with the thread's document.
+///
+/// @return NULL.
+///
+gpointer
+exporter_render_images (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    ExportWorker *worker = (ExportWorker *)data;
+    worker->exporter->renderImages (worker->document);
+
+    return NULL;
+}
+
+///
+/// @brief Writes the PostScript file from a thread.
+///
+/// @param data The DocumentExporter to write the pages of.
+///
+/// @return NULL.
+///
+gpointer
+exporter_write_postscript (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    ((DocumentExporter *)data)->writePostscript ();
+
+    return NULL;
+}
+
+///
+/// @brief Writes all bytes to a file descriptor.
+///
+/// @param fd The file descriptor to write to.
+/// @param data The bytes to write.
+/// @param length The number of bytes to write.
+///
+/// @return TRUE if all bytes were written, FALSE otherwise, with errno
+///         set.
+///
+gboolean
+writeAll (gint fd, const gchar *data, gsize length)
+{
+    while ( 0 < length )
+    {
+        gssize written = write (fd, data, length);
+        if ( 0 > written )
+        {
+            if ( EINTR == errno )
+            {
+                continue;
+            }
+            return FALSE;
+        }
+        data += written;
+        length -= written;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,158 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DOCUMENT_EXPORTER_H__)
+#define __DOCUMENT_EXPORTER_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocument;
+
+    ///
+    /// @enum ExportFormat
+    /// @brief The formats the pages can be exported to.
+    ///
+    enum ExportFormat
+    {
+        /// An image file for each page.
+        EXPORT_FORMAT_PNG,
+        /// A single PDF file with all pages.
+        EXPORT_FORMAT_PDF,
+        /// A single PostScript file with all pages.
+        EXPORT_FORMAT_PS,
+        /// A single text file with all pages' text.
+        EXPORT_FORMAT_TEXT
+    };
+
+    ///
+    /// @brief Called after each page is exported.
+    ///
+    /// It's called from the thread that exported the page.
+    ///
+    /// @param numPagesExported The number of pages already exported.
+    /// @param numPagesToExport The number of pages to export.
+    /// @param data The data passed to setProgressCallback().
+    ///
+    typedef void (*ExportProgressFunc) (guint numPagesExported,
+                                        guint numPagesToExport,
+                                        gpointer data);
+
+    ///
+    /// @class DocumentExporter
+    /// @brief Exports a document's pages to files without any window.
+    ///
+    /// The pages are exported as PNG images, rendered in parallel by
+    /// several threads, each with its own copy of the document, or as
+    /// a single PDF or PostScript file, which is written sequentially.
+    ///
+    /// The text is also extracted in parallel, but written in the pages'
+    /// order: a thread only starts a page when it's less than a window
+    /// of pages ahead of the last written page, so only that window's
+    /// text is ever kept in memory.
+    ///
+    /// The output pattern is the file name to write. For images, its
+    /// "%d" is replaced by the page number, optionally zero padded as
+    /// in "%03d", and "%%" by a single "%". The text is written to the
+    /// standard output when the pattern is "-".
+    ///
+    class DocumentExporter
+    {
+        public:
+            DocumentExporter (IDocument *document);
+            ~DocumentExporter (void);
+
+            void cancel (void);
+            gboolean exportPages (GError **error);
+            guint getNumPagesExported (void);
+            guint getNumThreads (void);
+            void setFormat (ExportFormat format);
+            void setNumThreads (guint numThreads);
+            void setOutputPattern (const gchar *pattern);
+            gboolean setPageRange (const gchar *range, GError **error);
+            void setProgressCallback (ExportProgressFunc callback,
+                                      gpointer data);
+            gboolean setResolution (gdouble dpi, GError **error);
+
+            static gchar *formatFileName (const gchar *pattern, gint pageNum,
+                                          gboolean *hasPageNumber);
+            static gboolean parseFormat (const gchar *name,
+                                         ExportFormat *format);
+
+            // Used by the worker threads.
+            void extractText (IDocument *document);
+            void renderImages (IDocument *document);
+            void writePostscript (void);
+
+        protected:
+            /// Tells the threads to stop, read with g_atomic_int_get().
+            volatile gint m_Cancelled;
+            /// The document to export.
+            IDocument *m_Document;
+            /// @brief The first error a worker thread found, or NULL.
+            /// Protected by m_Lock.
+            GError *m_Error;
+            /// The format to export to.
+            ExportFormat m_Format;
+            /// Protects m_Error and the text waiting to be written.
+            GMutex m_Lock;
+            /// The index in m_Pages of the next page to render.
+            volatile gint m_NextPage;
+            /// The index in m_Pages of the next page to write its text.
+            guint m_NextText;
+            /// The number of pages already exported.
+            volatile gint m_NumPagesExported;
+            /// The number of threads to render the images with.
+            guint m_NumThreads;
+            /// The file descriptor the text or the PostScript is written to.
+            gint m_OutputFd;
+            /// The file name pattern to write to.
+            gchar *m_OutputPattern;
+            /// The page numbers to export, in order.
+            GArray *m_Pages;
+            /// @brief The extracted text waiting to be written, indexed
+            /// by the page's index in m_Pages modulo m_TextWindow.
+            gchar **m_PageTexts;
+            /// The function to call after each page is exported, or NULL.
+            ExportProgressFunc m_ProgressCallback;
+            /// The data to pass to m_ProgressCallback.
+            gpointer m_ProgressData;
+            /// The resolution to render the images at, in dots per inch.
+            gdouble m_Resolution;
+            /// Signaled when a page's text is written or the export stops.
+            GCond m_TextWritten;
+            /// The number of pages whose text can be kept in memory.
+            guint m_TextWindow;
+
+            gboolean exportImages (void);
+            gboolean exportPdf (void);
+            gboolean exportPostscript (void);
+            gboolean exportText (void);
+            gboolean isStopped (void);
+            void pageExported (void);
+            void runWorkers (GThreadFunc func);
+            void setError (GError *error);
+            void writePendingText (void);
+    };
+}
+
+#endif // !__DOCUMENT_EXPORTER_H__
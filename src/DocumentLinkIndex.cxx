@@ -0,0 +1,301 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <math.h>
+#include <string.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint MAX_GRID_SIDE = 256;
+
+///
+/// @brief Constructs a new empty DocumentLinkIndex.
+///
+DocumentLinkIndex::DocumentLinkIndex ()
+{
+    m_CellHeight = 1.0;
+    m_CellLinks = NULL;
+    m_CellStart = NULL;
+    m_CellWidth = 1.0;
+    m_Columns = 0;
+    m_Dirty = FALSE;
+    m_Links = g_ptr_array_new ();
+    m_MinX = 0.0;
+    m_MinY = 0.0;
+    m_Rows = 0;
+}
+
+///
+/// @brief Deletes all links and the grid.
+///
+DocumentLinkIndex::~DocumentLinkIndex ()
+{
+    for ( guint linkIndex = 0 ; linkIndex < m_Links->len ; linkIndex++ )
+    {
+        delete (IDocumentLink *)g_ptr_array_index (m_Links, linkIndex);
+    }
+    g_ptr_array_free (m_Links, TRUE);
+    clearGrid ();
+}
+
+///
+/// @brief Adds a new link to the index.
+///
+/// The grid is not rebuilt here, but the next time the index is queried.
+///
+/// @param link The link to add. The DocumentLinkIndex class will delete it.
+///
+void
+DocumentLinkIndex::addLink (IDocumentLink *link)
+{
+    g_assert (NULL != link && "Tried to add a NULL link.");
+
+    g_ptr_array_add (m_Links, link);
+    m_Dirty = TRUE;
+}
+
+///
+/// @brief Builds the grid.
+///
+/// The grid has about as many cells as links, laid out as a square over
+/// the bounding box of all links. Each cell keeps the indices of the
+/// links that overlap it, packed in a single array.
+///
+void
+DocumentLinkIndex::build ()
+{
+    clearGrid ();
+    m_Dirty = FALSE;
+
+    guint numLinks = m_Links->len;
+    if ( 0 == numLinks )
+    {
+        return;
+    }
+
+    gdouble minX = G_MAXDOUBLE;
+    gdouble minY = G_MAXDOUBLE;
+    gdouble maxX = -G_MAXDOUBLE;
+    gdouble maxY = -G_MAXDOUBLE;
+    for ( guint linkIndex = 0 ; linkIndex < numLinks ; linkIndex++ )
+    {
+        IDocumentLink *link =
+            (IDocumentLink *)g_ptr_array_index (m_Links, linkIndex);
+        DocumentRectangle *rect = link->getRectangle ();
+        minX = MIN (minX, MIN (rect->getX1 (), rect->getX2 ()));
+        minY = MIN (minY, MIN (rect->getY1 (), rect->getY2 ()));
+        maxX = MAX (maxX, MAX (rect->getX1 (), rect->getX2 ()));
+        maxY = MAX (maxY, MAX (rect->getY1 (), rect->getY2 ()));
+    }
+    m_MinX = minX;
+    m_MinY = minY;
+
+    gint side = CLAMP ((gint)ceil (sqrt ((gdouble)numLinks)), 1,
+                       MAX_GRID_SIDE);
+    m_Columns = side;
+    m_Rows = side;
+    m_CellWidth = MAX ((maxX - m_MinX) / m_Columns, 1.0);
+    m_CellHeight = MAX ((maxY - m_MinY) / m_Rows, 1.0);
+
+    // First count how many links overlap each cell...
+    guint numCells = m_Columns * m_Rows;
+    m_CellStart = g_new0 (guint, numCells + 1);
+    for ( guint linkIndex = 0 ; linkIndex < numLinks ; linkIndex++ )
+    {
+        IDocumentLink *link =
+            (IDocumentLink *)g_ptr_array_index (m_Links, linkIndex);
+        DocumentRectangle *rect = link->getRectangle ();
+        gint column1, row1, column2, row2;
+        getCellRange (rect->getX1 (), rect->getY1 (),
+                      rect->getX2 (), rect->getY2 (),
+                      &column1, &row1, &column2, &row2);
+        for ( gint row = row1 ; row <= row2 ; row++ )
+        {
+            for ( gint column = column1 ; column <= column2 ; column++ )
+            {
+                m_CellStart[row * m_Columns + column + 1]++;
+            }
+        }
+    }
+    for ( guint cell = 0 ; cell < numCells ; cell++ )
+    {
+        m_CellStart[cell + 1] += m_CellStart[cell];
+    }
+
+    // ... and then fill the cells, in the order the links were added.
+    m_CellLinks = g_new (guint, MAX (m_CellStart[numCells], 1));
+    guint *cellEnd = g_new (guint, numCells);
+    memcpy (cellEnd, m_CellStart, numCells * sizeof (guint));
+    for ( guint linkIndex = 0 ; linkIndex < numLinks ; linkIndex++ )
+    {
+        IDocumentLink *link =
+            (IDocumentLink *)g_ptr_array_index (m_Links, linkIndex);
+        DocumentRectangle *rect = link->getRectangle ();
+        gint column1, row1, column2, row2;
+        getCellRange (rect->getX1 (), rect->getY1 (),
+                      rect->getX2 (), rect->getY2 (),
+                      &column1, &row1, &column2, &row2);
+        for ( gint row = row1 ; row <= row2 ; row++ )
+        {
+            for ( gint column = column1 ; column <= column2 ; column++ )
+            {
+                guint cell = row * m_Columns + column;
+                m_CellLinks[cellEnd[cell]++] = linkIndex;
+            }
+        }
+    }
+    g_free (cellEnd);
+}
+
+///
+/// @brief Frees the grid, but not the links.
+///
+void
+DocumentLinkIndex::clearGrid ()
+{
+    g_free (m_CellLinks);
+    m_CellLinks = NULL;
+    g_free (m_CellStart);
+    m_CellStart = NULL;
+    m_Columns = 0;
+    m_Rows = 0;
+}
+
+///
+/// @brief Gets the range of grid cells an unscaled rectangle overlaps.
+///
+/// Parts of the rectangle outside the grid are clamped to the border cells.
+///
+/// @param x1 The X coordinate of one of the rectangle's corners.
+/// @param y1 The Y coordinate of one of the rectangle's corners.
+/// @param x2 The X coordinate of the opposite corner.
+/// @param y2 The Y coordinate of the opposite corner.
+/// @param column1 The location to save the first overlapped column.
+/// @param row1 The location to save the first overlapped row.
+/// @param column2 The location to save the last overlapped column.
+/// @param row2 The location to save the last overlapped row.
+///
+void
+DocumentLinkIndex::getCellRange (gdouble x1, gdouble y1,
+                                 gdouble x2, gdouble y2,
+                                 gint *column1, gint *row1,
+                                 gint *column2, gint *row2)
+{
+    *column1 = CLAMP ((gint)floor ((MIN (x1, x2) - m_MinX) / m_CellWidth),
+                      0, m_Columns - 1);
+    *row1 = CLAMP ((gint)floor ((MIN (y1, y2) - m_MinY) / m_CellHeight),
+                   0, m_Rows - 1);
+    *column2 = CLAMP ((gint)floor ((MAX (x1, x2) - m_MinX) / m_CellWidth),
+                      0, m_Columns - 1);
+    *row2 = CLAMP ((gint)floor ((MAX (y1, y2) - m_MinY) / m_CellHeight),
+                   0, m_Rows - 1);
+}
+
+///
+/// @brief Gets the link for a given position.
+///
+/// Only the links that overlap the grid cells under the position are
+/// checked. If more than one link is under the position, the last
+/// added wins.
+///
+/// @param x The X coordinate of the position, in pixels.
+/// @param y The Y coordinate of the position, in pixels.
+/// @param scale The scale the page is shown at.
+///
+/// @return The link under the position (x, y) or NULL if no link exists.
+///
+IDocumentLink *
+DocumentLinkIndex::getLinkAtPosition (gint x, gint y, gdouble scale)
+{
+    g_assert (0.0 < scale && "Tried to get a link with an invalid scale.");
+
+    if ( m_Dirty )
+    {
+        build ();
+    }
+    if ( NULL == m_CellStart )
+    {
+        return NULL;
+    }
+
+    // The unscaled area that the pixel (x, y) covers.
+    gdouble x1 = x / scale;
+    gdouble y1 = y / scale;
+    gdouble x2 = (x + 1) / scale;
+    gdouble y2 = (y + 1) / scale;
+    if ( x2 < m_MinX || y2 < m_MinY ||
+         x1 > m_MinX + m_Columns * m_CellWidth ||
+         y1 > m_MinY + m_Rows * m_CellHeight )
+    {
+        return NULL;
+    }
+
+    gint column1, row1, column2, row2;
+    getCellRange (x1, y1, x2, y2, &column1, &row1, &column2, &row2);
+    gint foundIndex = -1;
+    for ( gint row = row1 ; row <= row2 ; row++ )
+    {
+        for ( gint column = column1 ; column <= column2 ; column++ )
+        {
+            guint cell = row * m_Columns + column;
+            // The cell's links are sorted by index, so look from the end
+            // and stop at the first match or at an already beaten link.
+            for ( guint entry = m_CellStart[cell + 1] ;
+                  entry > m_CellStart[cell] ;
+                  entry-- )
+            {
+                gint linkIndex = (gint)m_CellLinks[entry - 1];
+                if ( linkIndex <= foundIndex )
+                {
+                    break;
+                }
+                IDocumentLink *link =
+                    (IDocumentLink *)g_ptr_array_index (m_Links, linkIndex);
+                if ( link->positionIsOver (x, y, scale) )
+                {
+                    foundIndex = linkIndex;
+                    break;
+                }
+            }
+        }
+    }
+
+    if ( 0 > foundIndex )
+    {
+        return NULL;
+    }
+    return (IDocumentLink *)g_ptr_array_index (m_Links, foundIndex);
+}
+
+///
+/// @brief Gets the number of links in the index.
+///
+/// @return The number of links added to the index.
+///
+guint
+DocumentLinkIndex::getNumLinks ()
+{
+    return m_Links->len;
+}
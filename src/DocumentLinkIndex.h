@@ -0,0 +1,87 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DOCUMENT_LINK_INDEX_H__)
+#define __DOCUMENT_LINK_INDEX_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocumentLink;
+
+    ///
+    /// @class DocumentLinkIndex
+    /// @brief A spatial index of the links of a single page.
+    ///
+    /// The links are bucketed in a uniform grid that covers the bounding
+    /// box of all links. Looking up the link under a position only checks
+    /// the links that overlap the grid cells the position falls in, instead
+    /// of every link of the page.
+    ///
+    /// The links are in unscaled page coordinates, so the same index is
+    /// valid for any zoom level and the scale is given when querying.
+    ///
+    /// The grid is built the first time it is queried after adding links.
+    ///
+    class DocumentLinkIndex
+    {
+        public:
+            DocumentLinkIndex (void);
+            ~DocumentLinkIndex (void);
+
+            void addLink (IDocumentLink *link);
+            IDocumentLink *getLinkAtPosition (gint x, gint y, gdouble scale);
+            guint getNumLinks (void);
+
+        protected:
+            /// The number of grid cells in a row.
+            gint m_Columns;
+            /// @brief The start of each cell's links in m_CellLinks.
+            /// It has a last extra element with the total number of
+            /// entries in m_CellLinks.
+            guint *m_CellStart;
+            /// The height of a single grid cell.
+            gdouble m_CellHeight;
+            /// The indices in m_Links of the links that overlap each cell.
+            guint *m_CellLinks;
+            /// The width of a single grid cell.
+            gdouble m_CellWidth;
+            /// Tells if links were added after the grid was built.
+            gboolean m_Dirty;
+            /// The links of the page, in the order they were added.
+            GPtrArray *m_Links;
+            /// The X coordinate of the grid's top-left corner.
+            gdouble m_MinX;
+            /// The Y coordinate of the grid's top-left corner.
+            gdouble m_MinY;
+            /// The number of grid cells in a column.
+            gint m_Rows;
+
+            void build (void);
+            void clearGrid (void);
+            void getCellRange (gdouble x1, gdouble y1, gdouble x2, gdouble y2,
+                               gint *column1, gint *row1,
+                               gint *column2, gint *row2);
+    };
+}
+
+#endif // !__DOCUMENT_LINK_INDEX_H__
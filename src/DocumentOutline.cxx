@@ -25,8 +25,10 @@
 
 using namespace ePDFView;
 
+G_LOCK_DEFINE_STATIC (outlineChildren);
+
 // Forward declarations.
-static void deleteChild (gpointer child, gpointer userData);
+static void deleteChild (gpointer child);
 
 ///
 /// @brief Constructs a new DocumentOutline.
@@ -34,9 +36,11 @@ static void deleteChild (gpointer child, gpointer userData);
 DocumentOutline::DocumentOutline ()
 {
     m_Destination = 1;
-    m_Children = NULL;
-    m_LastReturnedChild = NULL;
+    m_Children = g_ptr_array_new_with_free_func (deleteChild);
+    m_ChildrenLoaded = FALSE;
+    m_LastReturnedChild = -1;
     m_Parent = NULL;
+    m_Position = 0;
     m_Title = NULL;
 }
 
@@ -48,8 +52,7 @@ DocumentOutline::~DocumentOutline ()
     m_Parent = NULL;
     g_free (m_Title);
     /// Delete the children.
-    g_list_foreach (m_Children, deleteChild, NULL);
-    g_list_free (m_Children);
+    g_ptr_array_free (m_Children, TRUE);
 }
 
 ///
@@ -60,7 +63,49 @@ DocumentOutline::~DocumentOutline ()
 void
 DocumentOutline::addChild (DocumentOutline *child)
 {
-    m_Children = g_list_append (m_Children, child);
+    child->m_Position = m_Children->len;
+    g_ptr_array_add (m_Children, child);
+}
+
+///
+/// @brief Makes sure the outline's children have been loaded.
+///
+/// The first time the children are needed, loadChildren() is called to
+/// read them. The outline can be shared by the view and the jobs, so
+/// this is done while holding a lock.
+///
+void
+DocumentOutline::checkChildrenLoaded ()
+{
+    G_LOCK (outlineChildren);
+    if ( !m_ChildrenLoaded )
+    {
+        m_ChildrenLoaded = TRUE;
+        loadChildren ();
+    }
+    G_UNLOCK (outlineChildren);
+}
+
+///
+/// @brief Gets an outline's child.
+///
+/// Unlike getFirstChild() and getNextChild(), this doesn't change which
+/// is the next child to return, so it can be used by the views.
+///
+/// @param index The child's index, starting from 0.
+///
+/// @return The child at @a index or NULL if the outline has no such
+///         child.
+///
+DocumentOutline *
+DocumentOutline::getChild (gint index)
+{
+    checkChildrenLoaded ();
+    if ( 0 <= index && (guint)index < m_Children->len )
+    {
+        return (DocumentOutline *)g_ptr_array_index (m_Children, index);
+    }
+    return NULL;
 }
 
 ///
@@ -90,12 +135,8 @@ DocumentOutline::getDestinationPage ()
 DocumentOutline *
 DocumentOutline::getFirstChild ()
 {
-    m_LastReturnedChild = g_list_first (m_Children);
-    if ( NULL != m_LastReturnedChild )
-    {
-        return (DocumentOutline *)m_LastReturnedChild->data;
-    }
-    return NULL;
+    m_LastReturnedChild = 0;
+    return getChild (m_LastReturnedChild);
 }
 
 ///
@@ -109,12 +150,13 @@ DocumentOutline::getFirstChild ()
 DocumentOutline *
 DocumentOutline::getNextChild ()
 {
-    m_LastReturnedChild = g_list_next (m_LastReturnedChild);
-    if ( NULL != m_LastReturnedChild )
+    if ( 0 > m_LastReturnedChild ||
+         (guint)m_LastReturnedChild >= m_Children->len )
     {
-        return (DocumentOutline *)m_LastReturnedChild->data;
+        return NULL;
     }
-    return NULL;
+    m_LastReturnedChild++;
+    return getChild (m_LastReturnedChild);
 }
 
 ///
@@ -125,7 +167,32 @@ DocumentOutline::getNextChild ()
 gint
 DocumentOutline::getNumChildren ()
 {
-    return g_list_length (m_Children);
+    checkChildrenLoaded ();
+    return m_Children->len;
+}
+
+///
+/// @brief Gets the outline's parent.
+///
+/// @return The outline item this is a child of, or NULL if it's the
+///         root outline item or its parent wasn't set.
+///
+DocumentOutline *
+DocumentOutline::getParent ()
+{
+    return m_Parent;
+}
+
+///
+/// @brief Gets the outline's position among its parent's children.
+///
+/// @return The index to pass to the parent's getChild() to get this
+///         outline.
+///
+gint
+DocumentOutline::getPosition ()
+{
+    return m_Position;
 }
 
 ///
@@ -144,6 +211,33 @@ DocumentOutline::getTitle ()
     return m_Title;
 }
 
+///
+/// @brief Tells if the outline has children.
+///
+/// Derived classes that load their children lazily should tell it
+/// without loading them, so the views can show which items can be
+/// expanded.
+///
+/// @return TRUE if the outline has at least a child, FALSE otherwise.
+///
+gboolean
+DocumentOutline::hasChildren ()
+{
+    return 0 < getNumChildren ();
+}
+
+///
+/// @brief Reads the outline's children.
+///
+/// This is called the first time the children are needed. By default
+/// the children are all added with addChild() beforehand, so it does
+/// nothing.
+///
+void
+DocumentOutline::loadChildren ()
+{
+}
+
 ///
 /// @brief Sets the outline item's destination.
 ///
@@ -161,7 +255,7 @@ DocumentOutline::setDestination (gint destination)
 ///
 /// @brief Sets the item's parent.
 ///
-/// This is currently not used.
+/// The views use it to find the rows of an item's parents.
 ///
 /// @param parent The outline item's parent.
 ///
@@ -189,14 +283,12 @@ DocumentOutline::setTitle (const gchar *title)
 /// @brief Deletes an outline item's child.
 ///
 /// This function is called by the destructor to delete all children in
-/// the m_Children list.
+/// the m_Children array.
 ///
-/// @param child The data element in the list's item.
-/// @param userData The data passed to the g_list_foreach() function.
-///                 Currently unused.
+/// @param child The data element in the array's item.
 ///
 void
-deleteChild (gpointer child, gpointer userData)
+deleteChild (gpointer child)
 {
     g_assert ( NULL != child && "An outline's child is NULL!");
     
@@ -38,34 +38,50 @@ namespace ePDFView
     /// top level DocumentOutline, that is only used as a container for all 
     /// other DocumentOutline objects.
     ///
+    /// Derived classes can read a node's children the first time they are
+    /// asked for by overriding loadChildren(), so documents with huge
+    /// outlines only read the levels that are actually shown.
+    ///
     class DocumentOutline
     {
         public:
             DocumentOutline (void);
-            ~DocumentOutline (void);
+            virtual ~DocumentOutline (void);
 
             void addChild (DocumentOutline *child);
+            DocumentOutline *getChild (gint index);
             gint getDestinationPage (void);
             DocumentOutline *getFirstChild (void);
             DocumentOutline *getNextChild (void);
             gint getNumChildren (void);
+            DocumentOutline *getParent (void);
+            gint getPosition (void);
             const gchar *getTitle (void);
+            virtual gboolean hasChildren (void);
             void setParent (DocumentOutline *parent);
             void setTitle (const gchar *title);
             void setDestination (gint destination);
 
         protected:
-            /// The list of this outline's children.
-            GList *m_Children;
+            /// The array of this outline's children.
+            GPtrArray *m_Children;
+            /// Tells if loadChildren() has already been called.
+            gboolean m_ChildrenLoaded;
             /// The page number this outline points to.
             gint m_Destination;
             /// @brief This is used to know which child to return when calling
-            /// the DocumentOutline::getNextChild() function.
-            GList *m_LastReturnedChild;
+            /// the DocumentOutline::getNextChild() function. -1 when no
+            /// child has been returned yet.
+            gint m_LastReturnedChild;
             /// The outline's parent outline.
             DocumentOutline *m_Parent;
+            /// The outline's position among its parent's children.
+            gint m_Position;
             /// The outline's name or title.
             gchar *m_Title;
+
+            void checkChildrenLoaded (void);
+            virtual void loadChildren (void);
     };
 }
 
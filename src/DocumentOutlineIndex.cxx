@@ -0,0 +1,167 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief An outline item in the index.
+///
+typedef struct
+{
+    /// The page the item goes to.
+    gint page;
+    /// The item's position in the outline, walked depth first.
+    guint order;
+    /// The outline item.
+    DocumentOutline *outline;
+} OutlineIndexEntry;
+
+// Forward declarations.
+static gint compareEntries (gconstpointer a, gconstpointer b);
+
+///
+/// @brief Constructs a new DocumentOutlineIndex.
+///
+/// All of the outline's levels are read, so this should be done by a
+/// job and not by the main thread.
+///
+/// @param outline The outline to index. Its items must outlive the index.
+///
+DocumentOutlineIndex::DocumentOutlineIndex (DocumentOutline *outline)
+{
+    g_assert (NULL != outline && "Tried to index a NULL outline.");
+
+    m_Entries = g_array_new (FALSE, FALSE, sizeof (OutlineIndexEntry));
+    addEntries (outline);
+    g_array_sort (m_Entries, compareEntries);
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by DocumentOutlineIndex.
+///
+DocumentOutlineIndex::~DocumentOutlineIndex ()
+{
+    g_array_free (m_Entries, TRUE);
+}
+
+///
+/// @brief Adds an outline's descendants to the index.
+///
+/// @param outline The outline to add its children, recursively.
+///
+void
+DocumentOutlineIndex::addEntries (DocumentOutline *outline)
+{
+    gint numChildren = outline->getNumChildren ();
+    for ( gint childIndex = 0 ; childIndex < numChildren ; childIndex++ )
+    {
+        DocumentOutline *child = outline->getChild (childIndex);
+        OutlineIndexEntry entry;
+        entry.page = child->getDestinationPage ();
+        entry.order = m_Entries->len;
+        entry.outline = child;
+        g_array_append_val (m_Entries, entry);
+        addEntries (child);
+    }
+}
+
+///
+/// @brief Finds the section a page belongs to.
+///
+/// The section is the last outline item, in the outline's order, of the
+/// nearest page at or before @a pageNum that has outline items. When a
+/// chapter and its first section start at the same page, then, the
+/// section is returned.
+///
+/// @param pageNum The page number, starting from 1.
+///
+/// @return The outline item of the section or NULL if no outline item
+///         goes to @a pageNum or any page before it.
+///
+DocumentOutline *
+DocumentOutlineIndex::findSection (gint pageNum)
+{
+    // Find the first entry after pageNum.
+    guint low = 0;
+    guint high = m_Entries->len;
+    while ( low < high )
+    {
+        guint middle = low + (high - low) / 2;
+        if ( g_array_index (m_Entries, OutlineIndexEntry, middle).page <=
+             pageNum )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if ( 0 == low )
+    {
+        return NULL;
+    }
+    return g_array_index (m_Entries, OutlineIndexEntry, low - 1).outline;
+}
+
+///
+/// @brief Gets the number of outline items in the index.
+///
+/// @return The number of outline items, at all levels.
+///
+guint
+DocumentOutlineIndex::getNumEntries ()
+{
+    return m_Entries->len;
+}
+
+///
+/// @brief Compares two index entries.
+///
+/// The entries are sorted by page, and the entries of the same page
+/// keep the outline's order.
+///
+/// @param a The first OutlineIndexEntry to compare.
+/// @param b The second OutlineIndexEntry to compare.
+///
+/// @return A negative value if @a a goes before @a b, a positive value
+///         if it goes after and 0 if they are the same entry.
+///
+gint
+compareEntries (gconstpointer a, gconstpointer b)
+{
+    const OutlineIndexEntry *first = (const OutlineIndexEntry *)a;
+    const OutlineIndexEntry *second = (const OutlineIndexEntry *)b;
+
+    if ( first->page != second->page )
+    {
+        return first->page < second->page ? -1 : 1;
+    }
+    if ( first->order != second->order )
+    {
+        return first->order < second->order ? -1 : 1;
+    }
+    return 0;
+}
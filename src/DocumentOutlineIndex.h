@@ -0,0 +1,57 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__DOCUMENT_OUTLINE_INDEX_H__)
+#define __DOCUMENT_OUTLINE_INDEX_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentOutline;
+
+    ///
+    /// @class DocumentOutlineIndex
+    /// @brief The outline items of a document sorted by destination page.
+    ///
+    /// The whole outline tree is flattened once, after the outline is
+    /// read, into an array sorted by page. Finding the section a page
+    /// belongs to is then a binary search instead of a walk of the whole
+    /// tree, which matters for outlines with tens of thousands of items
+    /// when it is done on every page change.
+    ///
+    class DocumentOutlineIndex
+    {
+        public:
+            DocumentOutlineIndex (DocumentOutline *outline);
+            ~DocumentOutlineIndex (void);
+
+            DocumentOutline *findSection (gint pageNum);
+            guint getNumEntries (void);
+
+        protected:
+            /// The outline's items, as OutlineIndexEntry, sorted by page.
+            GArray *m_Entries;
+
+            void addEntries (DocumentOutline *outline);
+    };
+}
+
+#endif // !__DOCUMENT_OUTLINE_INDEX_H__
@@ -38,7 +38,6 @@ DocumentPage::DocumentPage ()
     m_Data = NULL;
     m_HasSelection = FALSE;
     m_Height = 0;
-    m_LinkList = NULL;
     m_Width = 0;
 }
 
@@ -48,33 +47,11 @@ DocumentPage::DocumentPage ()
 DocumentPage::~DocumentPage ()
 {
     delete[] m_Data;
-    for ( GList *linkItem = g_list_first (m_LinkList) ;
-          NULL != linkItem ;
-          linkItem = g_list_next (linkItem) )
-    {
-        IDocumentLink *link = (IDocumentLink *)linkItem->data;
-        delete link;
-    }
-    g_list_free (m_LinkList);
 
     if(m_Selection)
         cairo_region_destroy(m_Selection);
 }
 
-///
-/// @brief Adds a new link to the page.
-///
-/// When rendering the page, the responsible document will extract the
-/// links from the page and call this function with each links it find.
-/// 
-/// @param link The link to add. The DocumentPage class will delete it.
-///
-void
-DocumentPage::addLink (IDocumentLink *link)
-{
-    m_LinkList = g_list_prepend (m_LinkList, link);
-}
-
 ///
 /// @brief Clears the current selection.
 ///
@@ -115,36 +92,6 @@ DocumentPage::getData ()
     return m_Data;
 }
 
-///
-/// @brief Gets the link for a given position.
-///
-/// This function will get the link whose rectangle is under the position
-/// passed as parameter.
-///
-/// @param x The X coordinate of the link's position.
-/// @param y The Y coordinate of the link's position.
-///
-/// @return The link under the position (x, y) or NULL if no link exists.
-///
-IDocumentLink *
-DocumentPage::getLinkAtPosition (gint x, gint y)
-{
-    IDocumentLink *link = NULL;
-
-    for ( GList *linkItem = g_list_first (m_LinkList) ;
-          NULL != linkItem && NULL == link;
-          linkItem = g_list_next (linkItem) )
-    {
-        IDocumentLink *tmpLink = (IDocumentLink *)linkItem->data;
-        if ( tmpLink->positionIsOver (x, y) )
-        {
-            link = tmpLink;
-        }
-    }
-
-    return link;
-}
-
 ///
 /// @brief Gets the page's height.
 ///
@@ -221,12 +168,17 @@ void
 DocumentPage::invertArea (gint x1, gint y1, gint x2, gint y2)
 {
     gint rowStride = getRowStride ();
+    gint bytesPerPixel = hasAlpha () ? 4 : BYTES_PER_PIXEL;
     guchar *data = getData ();
+    x1 = MAX (x1, 0);
+    y1 = MAX (y1, 0);
+    x2 = MIN (x2, getWidth ());
+    y2 = MIN (y2, getHeight ());
     for ( gint y = y1 ; y < y2 ; y++ )
     {
         for ( gint x = x1 ; x < x2 ; x++ )
         {
-            gint position = y * rowStride + ( x * BYTES_PER_PIXEL );
+            gint position = y * rowStride + ( x * bytesPerPixel );
             data[position + 0] = 255 - data[position + 0];
             data[position + 1] = 255 - data[position + 1];
             data[position + 2] = 255 - data[position + 2];
@@ -305,12 +257,74 @@ DocumentPage::setSelection (DocumentRectangle &selection, gdouble scale)
     m_HasSelection = TRUE;
 }
 
+///
+/// @brief Marks a text selection on the page.
+///
+/// @param region The selection's region, in scaled coordinates. It can
+///               be NULL to remove the selection.
+///
 void
 DocumentPage::setSelection (cairo_region_t *region)
 {
-    clearSelection ();
-    
-    invertRegion (region);
-    
-    m_Selection = cairo_region_copy(region);
+    cairo_region_destroy (updateSelection (region));
+}
+
+///
+/// @brief Changes the text selection on the page.
+///
+/// Only the pixels that change between the previous text selection and
+/// @a region are inverted, so growing a selection while dragging costs
+/// as much as the area that was added or removed.
+///
+/// @param region The selection's region, in scaled coordinates. It can
+///               be NULL to remove the selection.
+///
+/// @return The area of the page whose pixels changed. It must be freed
+///         with cairo_region_destroy().
+///
+cairo_region_t *
+DocumentPage::updateSelection (cairo_region_t *region)
+{
+    cairo_region_t *changed = getChangedArea (m_Selection, region);
+    invertRegion (changed);
+    if ( m_HasSelection )
+    {
+        invertArea (m_SelectionX1, m_SelectionY1, m_SelectionX2, m_SelectionY2);
+        cairo_rectangle_int_t area = { m_SelectionX1, m_SelectionY1,
+                                       m_SelectionX2 - m_SelectionX1,
+                                       m_SelectionY2 - m_SelectionY1 };
+        cairo_region_union_rectangle (changed, &area);
+        m_HasSelection = FALSE;
+    }
+
+    if ( NULL != m_Selection )
+    {
+        cairo_region_destroy (m_Selection);
+    }
+    m_Selection = NULL == region ? NULL : cairo_region_copy (region);
+
+    return changed;
+}
+
+///
+/// @brief Gets the area that differs between two regions.
+///
+/// @param oldRegion The previous region. NULL is the same as empty.
+/// @param newRegion The next region. NULL is the same as empty.
+///
+/// @return The area that is only in one of the two regions. It must be
+///         freed with cairo_region_destroy().
+///
+cairo_region_t *
+DocumentPage::getChangedArea (cairo_region_t *oldRegion,
+                              cairo_region_t *newRegion)
+{
+    cairo_region_t *changed = NULL == oldRegion ? cairo_region_create () :
+                                                  cairo_region_copy (oldRegion);
+    if ( NULL != newRegion )
+    {
+        cairo_region_xor (changed, newRegion);
+    }
+
+    return changed;
 }
@@ -39,17 +39,19 @@ namespace ePDFView
             DocumentPage (void);
             ~DocumentPage (void);
 
-            void addLink (IDocumentLink *link);
             void clearSelection (void);
             guchar *getData (void);
             gint getHeight (void);
-            IDocumentLink *getLinkAtPosition (gint x, gint y);
             gint getRowStride (void);
             gint getWidth (void);
             gboolean hasAlpha (void);
             gboolean newPage (gint width, gint height);
             void setSelection (DocumentRectangle &selection, gdouble scale);
             void setSelection (cairo_region_t *region);
+            cairo_region_t *updateSelection (cairo_region_t *region);
+
+            static cairo_region_t *getChangedArea (cairo_region_t *oldRegion,
+                                                   cairo_region_t *newRegion);
 
         protected:
             /// The page's image.
@@ -68,8 +70,6 @@ namespace ePDFView
             gint m_SelectionY2;
             /// The page's width.
             gint m_Width;
-            /// The list of links from the page.
-            GList *m_LinkList;
             /// Selection region
             cairo_region_t *m_Selection;
             
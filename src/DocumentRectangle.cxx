@@ -41,26 +41,6 @@ DocumentRectangle::DocumentRectangle (gdouble x1, gdouble y1,
     m_Y2 = y2;
 }
 
-///
-/// @brief Constructs a new rectangle as a copy of another rectangle.
-///
-/// @param original The original rectangle to copy.
-///
-DocumentRectangle::DocumentRectangle (DocumentRectangle &original)
-{
-    m_X1 = original.getX1 ();
-    m_X2 = original.getX2 ();
-    m_Y1 = original.getY1 ();
-    m_Y2 = original.getY2 ();
-}
-
-///
-/// @brief Destroys all dynamically allocated memory for DocumentRectangle.
-///
-DocumentRectangle::~DocumentRectangle ()
-{
-}
-
 ///
 /// @brief Gets the top-left corner X coordinates.
 ///
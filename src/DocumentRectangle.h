@@ -33,12 +33,14 @@ namespace ePDFView
     /// It is used as a way to know where are the document's link or the
     /// text that has been searched.
     ///
+    /// It is a plain value type, with the compiler generated copy constructor
+    /// and destructor, so it can be stored by value in contiguous arrays
+    /// (i.e., GArray) instead of allocating each rectangle by itself.
+    ///
     class DocumentRectangle
     {
         public:
             DocumentRectangle (gdouble x1, gdouble y1, gdouble x2, gdouble y2);
-            DocumentRectangle (DocumentRectangle &original);
-            ~DocumentRectangle (void);
 
             gdouble getX1 (void);
             gdouble getX2 (void);
@@ -0,0 +1,273 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <math.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Constants.
+/// How much farther a glyph on another line is than one on the same line.
+static const gdouble LINE_DISTANCE_WEIGHT = 4.0;
+
+///
+/// @brief Constructs a new DocumentTextLayout.
+///
+/// @param text The page's text. The glyphs added later must be one for
+///             each of its characters.
+///
+DocumentTextLayout::DocumentTextLayout (const gchar *text)
+{
+    m_Glyphs = g_array_new (FALSE, FALSE, sizeof (DocumentRectangle));
+    m_Text = g_strdup (NULL != text ? text : "");
+    m_TextLength = g_utf8_strlen (m_Text, -1);
+}
+
+///
+/// @brief Deletes all dynamically allocated memory for DocumentTextLayout.
+///
+DocumentTextLayout::~DocumentTextLayout ()
+{
+    g_array_free (m_Glyphs, TRUE);
+    g_free (m_Text);
+}
+
+///
+/// @brief Adds the next glyph in reading order.
+///
+/// @param x1 The X coordinate of the glyph's top-left corner.
+/// @param y1 The Y coordinate of the glyph's top-left corner.
+/// @param x2 The X coordinate of the glyph's bottom-right corner.
+/// @param y2 The Y coordinate of the glyph's bottom-right corner.
+///
+void
+DocumentTextLayout::addGlyph (gdouble x1, gdouble y1, gdouble x2, gdouble y2)
+{
+    DocumentRectangle glyph (MIN (x1, x2), MIN (y1, y2),
+                             MAX (x1, x2), MAX (y1, y2));
+    g_array_append_val (m_Glyphs, glyph);
+}
+
+///
+/// @brief Gets the text offset of a position.
+///
+/// Looks for the glyph closest to the position, preferring the glyphs
+/// on the same line, and then tells if the position is before or
+/// after the glyph's middle.
+///
+/// @param x The X coordinate of the position, unscaled.
+/// @param y The Y coordinate of the position, unscaled.
+///
+/// @return The offset of the glyph that a selection starting or ending
+///         at (x, y) would start or end at.
+///
+guint
+DocumentTextLayout::getGlyphOffset (gdouble x, gdouble y)
+{
+    guint closest = 0;
+    gdouble closestDistance = G_MAXDOUBLE;
+    for ( guint glyphIndex = 0 ; glyphIndex < m_Glyphs->len ; glyphIndex++ )
+    {
+        DocumentRectangle &glyph =
+            g_array_index (m_Glyphs, DocumentRectangle, glyphIndex);
+        gdouble dx = 0.0;
+        if ( x < glyph.getX1 () )
+        {
+            dx = glyph.getX1 () - x;
+        }
+        else if ( x > glyph.getX2 () )
+        {
+            dx = x - glyph.getX2 ();
+        }
+        gdouble dy = 0.0;
+        if ( y < glyph.getY1 () )
+        {
+            dy = glyph.getY1 () - y;
+        }
+        else if ( y > glyph.getY2 () )
+        {
+            dy = y - glyph.getY2 ();
+        }
+
+        gdouble distance = dx + LINE_DISTANCE_WEIGHT * dy;
+        if ( distance < closestDistance )
+        {
+            closest = glyphIndex;
+            closestDistance = distance;
+            if ( 0.0 == distance )
+            {
+                break;
+            }
+        }
+    }
+
+    DocumentRectangle &glyph =
+        g_array_index (m_Glyphs, DocumentRectangle, closest);
+    if ( x > (glyph.getX1 () + glyph.getX2 ()) / 2.0 )
+    {
+        return closest + 1;
+    }
+    return closest;
+}
+
+///
+/// @brief Gets the number of glyphs of the layout.
+///
+/// @return The number of glyphs added with addGlyph().
+///
+guint
+DocumentTextLayout::getNumGlyphs ()
+{
+    return m_Glyphs->len;
+}
+
+///
+/// @brief Gets the glyphs selected between two positions.
+///
+/// The selection goes, in reading order, from the glyph at the position
+/// where the drag started up to the glyph at the position where it
+/// ended, in either direction.
+///
+/// @param x1 The X coordinate where the selection started, unscaled.
+/// @param y1 The Y coordinate where the selection started, unscaled.
+/// @param x2 The X coordinate where the selection ended, unscaled.
+/// @param y2 The Y coordinate where the selection ended, unscaled.
+/// @param first The location to save the first selected glyph.
+/// @param last The location to save the glyph after the last selected.
+///
+/// @return TRUE if there is at least one glyph selected, FALSE otherwise.
+///
+gboolean
+DocumentTextLayout::getSelectionRange (gdouble x1, gdouble y1,
+                                       gdouble x2, gdouble y2,
+                                       guint *first, guint *last)
+{
+    if ( 0 == m_Glyphs->len )
+    {
+        return FALSE;
+    }
+
+    guint start = getGlyphOffset (x1, y1);
+    guint end = getGlyphOffset (x2, y2);
+    *first = MIN (start, end);
+    *last = MAX (start, end);
+
+    return *first < *last;
+}
+
+///
+/// @brief Gets the area to highlight for a selection.
+///
+/// The consecutive selected glyphs of each line are joined in a single
+/// rectangle.
+///
+/// @param x1 The X coordinate where the selection started, unscaled.
+/// @param y1 The Y coordinate where the selection started, unscaled.
+/// @param x2 The X coordinate where the selection ended, unscaled.
+/// @param y2 The Y coordinate where the selection ended, unscaled.
+/// @param scale The scale the page is shown at.
+///
+/// @return The scaled region of the selected glyphs, which can be empty.
+///         Must be freed with cairo_region_destroy().
+///
+cairo_region_t *
+DocumentTextLayout::getSelectionRegion (gdouble x1, gdouble y1,
+                                        gdouble x2, gdouble y2,
+                                        gdouble scale)
+{
+    cairo_region_t *region = cairo_region_create ();
+    guint first;
+    guint last;
+    if ( !getSelectionRange (x1, y1, x2, y2, &first, &last) )
+    {
+        return region;
+    }
+
+    guint run = first;
+    while ( run < last )
+    {
+        DocumentRectangle &start =
+            g_array_index (m_Glyphs, DocumentRectangle, run);
+        gdouble runX1 = start.getX1 ();
+        gdouble runY1 = start.getY1 ();
+        gdouble runX2 = start.getX2 ();
+        gdouble runY2 = start.getY2 ();
+        guint next = run + 1;
+        for ( ; next < last ; next++ )
+        {
+            DocumentRectangle &glyph =
+                g_array_index (m_Glyphs, DocumentRectangle, next);
+            // A glyph that doesn't share the run's line or that goes
+            // back to the left starts a new run.
+            if ( glyph.getY1 () >= runY2 || glyph.getY2 () <= runY1 ||
+                 glyph.getX1 () < runX1 )
+            {
+                break;
+            }
+            runY1 = MIN (runY1, glyph.getY1 ());
+            runX2 = MAX (runX2, glyph.getX2 ());
+            runY2 = MAX (runY2, glyph.getY2 ());
+        }
+
+        cairo_rectangle_int_t rect;
+        rect.x = (gint)floor (runX1 * scale);
+        rect.y = (gint)floor (runY1 * scale);
+        rect.width = MAX ((gint)ceil (runX2 * scale) - rect.x, 1);
+        rect.height = MAX ((gint)ceil (runY2 * scale) - rect.y, 1);
+        cairo_region_union_rectangle (region, &rect);
+
+        run = next;
+    }
+
+    return region;
+}
+
+///
+/// @brief Gets the text of a selection.
+///
+/// @param x1 The X coordinate where the selection started, unscaled.
+/// @param y1 The Y coordinate where the selection started, unscaled.
+/// @param x2 The X coordinate where the selection ended, unscaled.
+/// @param y2 The Y coordinate where the selection ended, unscaled.
+///
+/// @return The selected text or NULL if nothing is selected. Must be
+///         freed with g_free().
+///
+gchar *
+DocumentTextLayout::getSelectionText (gdouble x1, gdouble y1,
+                                      gdouble x2, gdouble y2)
+{
+    guint first;
+    guint last;
+    if ( !getSelectionRange (x1, y1, x2, y2, &first, &last) )
+    {
+        return NULL;
+    }
+
+    first = MIN (first, m_TextLength);
+    last = MIN (last, m_TextLength);
+    const gchar *start = g_utf8_offset_to_pointer (m_Text, first);
+    const gchar *end = g_utf8_offset_to_pointer (m_Text, last);
+
+    return g_strndup (start, end - start);
+}
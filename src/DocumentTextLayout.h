@@ -0,0 +1,71 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DOCUMENT_TEXT_LAYOUT_H__)
+#define __DOCUMENT_TEXT_LAYOUT_H__
+
+typedef struct _cairo_region cairo_region_t;
+
+namespace ePDFView
+{
+    ///
+    /// @class DocumentTextLayout
+    /// @brief The text and glyph positions of a single page.
+    ///
+    /// The document reads a page's layout only once and then the text
+    /// selection is computed from it, without asking the document again
+    /// for each mouse motion.
+    ///
+    /// The glyphs are kept in reading order, one for each character of
+    /// the page's text, in unscaled page coordinates with the origin at
+    /// the top-left corner.
+    ///
+    class DocumentTextLayout
+    {
+        public:
+            DocumentTextLayout (const gchar *text);
+            ~DocumentTextLayout (void);
+
+            void addGlyph (gdouble x1, gdouble y1, gdouble x2, gdouble y2);
+            guint getNumGlyphs (void);
+            cairo_region_t *getSelectionRegion (gdouble x1, gdouble y1,
+                                                gdouble x2, gdouble y2,
+                                                gdouble scale);
+            gchar *getSelectionText (gdouble x1, gdouble y1,
+                                     gdouble x2, gdouble y2);
+
+        protected:
+            /// The glyph rectangles, as DocumentRectangle.
+            GArray *m_Glyphs;
+            /// The page's text.
+            gchar *m_Text;
+            /// The number of characters in m_Text.
+            guint m_TextLength;
+
+            guint getGlyphOffset (gdouble x, gdouble y);
+            gboolean getSelectionRange (gdouble x1, gdouble y1,
+                                        gdouble x2, gdouble y2,
+                                        guint *first, guint *last);
+    };
+}
+
+#endif // !__DOCUMENT_TEXT_LAYOUT_H__
@@ -27,6 +27,9 @@ using namespace ePDFView;
 G_LOCK_DEFINE_STATIC (cancelJob);
 G_LOCK_DEFINE_STATIC (freeResults);
 
+// Constants.
+static const gint NO_MATCH = -1;
+
 ///
 /// @brief Constructs a new FindPter object.
 ///
@@ -36,7 +39,7 @@ FindPter::FindPter (IDocument *document)
 {
     g_assert (NULL != document && "Tried to set a NULL document.");
 
-    m_CurrentMatch = NULL;
+    m_CurrentMatch = NO_MATCH;
     m_Document = document;
     m_FindPage = 0;
     m_FindResults = NULL;
@@ -89,15 +92,19 @@ FindPter::closeActivated ()
 void
 FindPter::findNextActivated ()
 {
-    m_CurrentMatch = g_list_next (m_CurrentMatch);
-    if ( NULL != m_CurrentMatch )
+    if ( NO_MATCH != m_CurrentMatch && NULL != m_FindResults &&
+         (guint)(m_CurrentMatch + 1) < m_FindResults->len )
     {
-        DocumentRectangle *rect = ((DocumentRectangle *)m_CurrentMatch->data);
+        m_CurrentMatch++;
+        DocumentRectangle *rect = &g_array_index (m_FindResults,
+                                                  DocumentRectangle,
+                                                  m_CurrentMatch);
         m_Document->notifyFindChanged (m_FindPage, rect);
         m_Document->goToPage (m_FindPage);
     }
     else
     {
+        m_CurrentMatch = NO_MATCH;
         G_LOCK (cancelJob);
         if ( NULL != m_Job )
         {
@@ -118,15 +125,18 @@ FindPter::findNextActivated ()
 void
 FindPter::findPreviousActivated ()
 {
-    m_CurrentMatch = g_list_previous (m_CurrentMatch);
-    if ( NULL != m_CurrentMatch )
+    if ( 0 < m_CurrentMatch && NULL != m_FindResults )
     {
-        DocumentRectangle *rect = ((DocumentRectangle *)m_CurrentMatch->data);
+        m_CurrentMatch--;
+        DocumentRectangle *rect = &g_array_index (m_FindResults,
+                                                  DocumentRectangle,
+                                                  m_CurrentMatch);
         m_Document->notifyFindChanged (m_FindPage, rect);
         m_Document->goToPage (m_FindPage);
     }
     else
     {
+        m_CurrentMatch = NO_MATCH;
         G_LOCK (cancelJob);
         if ( NULL != m_Job )
         {
@@ -144,18 +154,19 @@ FindPter::findPreviousActivated ()
 ///
 /// @brief Deletes all saved results.
 ///
+/// The results are stored by value in a single array, so this is just
+/// one free, no matter how many matches the page had.
+///
 void
 FindPter::freeFindResults ()
 {
     G_LOCK (freeResults);
-    for ( GList *item = g_list_first (m_FindResults) ; NULL != item ;
-          item = g_list_next (item) )
+    if ( NULL != m_FindResults )
     {
-        DocumentRectangle *rect = (DocumentRectangle *)item->data;
-        delete rect;
+        g_array_free (m_FindResults, TRUE);
+        m_FindResults = NULL;
     }
-    g_list_free (m_FindResults);
-    m_FindResults = NULL;
+    m_CurrentMatch = NO_MATCH;
     G_UNLOCK (freeResults);
 }
 
@@ -212,13 +223,17 @@ FindPter::notifyFindFinished (gboolean endOfSearch )
 /// @brief The find found results.
 ///
 /// @param pageNum The number of the page that found results.
-/// @param results The results that found.
+/// @param results The array of DocumentRectangle results that found. The
+///                presenter takes ownership of it.
 /// @param direction The direction it was searching pages when found results.
 ///
 void
-FindPter::notifyFindResults (gint pageNum, GList *results, 
+FindPter::notifyFindResults (gint pageNum, GArray *results, 
                              FindDirection direction)
 {
+    g_assert (NULL != results && 0 < results->len &&
+              "Tried to notify empty results.");
+
     m_FindPage = pageNum;
     freeFindResults ();
     G_LOCK (freeResults);
@@ -226,13 +241,15 @@ FindPter::notifyFindResults (gint pageNum, GList *results,
     G_UNLOCK (freeResults);
     if ( FIND_DIRECTION_FORWARDS == direction )
     {
-        m_CurrentMatch = g_list_first (m_FindResults);
+        m_CurrentMatch = 0;
     }
     else
     {
-        m_CurrentMatch = g_list_last (m_FindResults);
+        m_CurrentMatch = m_FindResults->len - 1;
     }
-    DocumentRectangle *rect = (DocumentRectangle *)m_CurrentMatch->data;
+    DocumentRectangle *rect = &g_array_index (m_FindResults,
+                                              DocumentRectangle,
+                                              m_CurrentMatch);
     m_Document->notifyFindChanged (m_FindPage, rect);
     m_Document->goToPage (m_FindPage);
 
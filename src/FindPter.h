@@ -46,20 +46,21 @@ namespace ePDFView
             void findPreviousActivated (void);
             IFindView &getView (void);
             void notifyFindFinished (gboolean endOfSearch);
-            void notifyFindResults (gint pageNum, GList *results,
+            void notifyFindResults (gint pageNum, GArray *results,
                                     FindDirection direction);
             void setView (IFindView *view);
             void textToFindChanged (void);
 
         protected:
-            /// The current selected match from m_FindResults.
-            GList *m_CurrentMatch;
+            /// @brief The index of the current selected match from
+            /// m_FindResults, or -1 when no match is selected.
+            gint m_CurrentMatch;
             /// The document to search to.
             IDocument *m_Document;
             /// The current page that we found something.
             gint m_FindPage;
-            /// The results on m_FindPage.
-            GList *m_FindResults;
+            /// The results on m_FindPage, as an array of DocumentRectangle.
+            GArray *m_FindResults;
             /// The current find job.
             JobFind *m_Job;
             /// The view that the presenter is controlling.
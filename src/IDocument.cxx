@@ -27,8 +27,15 @@
 using namespace ePDFView;
 
 G_LOCK_EXTERN (JobRender);
+G_LOCK_DEFINE_STATIC (compressedPages);
+G_LOCK_DEFINE_STATIC (documentKey);
+G_LOCK_DEFINE_STATIC (outlineIndex);
 G_LOCK_DEFINE_STATIC (pageImage);
+G_LOCK_DEFINE_STATIC (pageLinks);
 G_LOCK_DEFINE_STATIC (pageSearch);
+G_LOCK_DEFINE_STATIC (saveText);
+G_LOCK_DEFINE_STATIC (thumbnails);
+G_LOCK_DEFINE_STATIC (unchangedPages);
 
 // Constants.
 static const gdouble ZOOM_IN_FACTOR = 1.1;  // Smoother zoom steps
@@ -37,9 +44,38 @@ static const gdouble ZOOM_OUT_FACTOR = (1.0 / ZOOM_IN_FACTOR);
 static const gdouble ZOOM_OUT_MIN = 0.1;    // More reasonable min zoom
 static const gdouble ZOOM_OUT_MAX = 0.1;    // Same as ZOOM_OUT_MIN for consistency
 static const guint CACHE_SIZE = 3;
+/// @brief The maximum bytes that the compressed images of the pages
+/// dropped from the cache can use.
+static const gsize COMPRESSED_CACHE_BUDGET = 16 * 1024 * 1024;
+/// The maximum width and height of the pages' thumbnails.
+static const gint THUMBNAIL_SIZE = 128;
+/// The maximum bytes that the pages' thumbnails can use.
+static const gsize THUMBNAIL_CACHE_BUDGET = 8 * 1024 * 1024;
+/// The page whose image is kept in the disk cache to show it on open.
+static const gint PREVIEW_PAGE = 1;
+/// The name in the disk cache of the first page's image.
+static const gchar *PREVIEW_ENTRY_NAME = "page-1";
+/// The name in the disk cache of a thumbnail, by size and page number.
+static const gchar *THUMBNAIL_ENTRY_NAME = "thumbnail-%d-%d";
+
+///
+/// @brief The state of a page's thumbnail queued to render.
+///
+typedef enum
+{
+    /// The thumbnail is queued and shown.
+    ThumbnailWanted = 1,
+    /// The thumbnail is queued, but no longer shown.
+    ThumbnailCancelled
+} ThumbnailState;
 
 /// This is the error domain that will be used to report Document's errors.
 GQuark IDocument::errorQuark = 0;
+/// The cache of rendered images kept between sessions.
+DiskCache *IDocument::m_DiskCache = NULL;
+
+// Forward declarations.
+static DocumentPage *scalePage (DocumentPage *page, gint width, gint height);
 
 ///
 /// @brief Gets the IDocument's error quark.
@@ -130,11 +166,16 @@ IDocument::getErrorMessage (DocumentError errorCode)
 IDocument::IDocument ()
 {
     m_Author = NULL;
+    m_CompressedPages = new CompressedPageCache (COMPRESSED_CACHE_BUDGET);
     m_CreationDate = NULL;
     m_Creator = NULL;
     m_CurrentPage = 0;
+    m_DocumentKey = NULL;
+    m_LoadStartTime = 0;
     m_Observers = NULL;
+    m_NewOutlineIndex = NULL;
     m_Outline = NULL;
+    m_OutlineIndex = NULL;
     m_FileName = NULL;
     m_FindRect = NULL;
     m_FindPage = 0;
@@ -145,18 +186,30 @@ IDocument::IDocument ()
 #else
     m_Linearized = NULL;
 #endif
+    m_MinRenderAge = 0;
     m_ModifiedDate = NULL;
     m_PageCache = NULL;
     m_PageCacheAge = 0;
+    m_PageLinks = g_ptr_array_new ();
     m_PageLayout = PageLayoutUnset;
     m_PageMode = PageModeUnset;
     m_PageNumber = 0;
+    m_PagePreview = NULL;
     m_Password = NULL;
+    m_PreviewRotation = 0;
+    m_PreviewZoom = 0.0;
     m_Producer = NULL;
     m_Rotation = 0;
+    m_SaveTextJob = NULL;
     m_Scale = 1.0f;
     m_Subject = NULL;
+    m_TimeToFirstPage = -1.0;
+    m_Thumbnails = new ThumbnailCache (THUMBNAIL_CACHE_BUDGET);
     m_Title = NULL;
+    m_UnchangedPages = NULL;
+    m_Watched = FALSE;
+    m_WantedThumbnails = g_hash_table_new (g_direct_hash, g_direct_equal);
+    CacheBudget::getBudget ().add (this);
 }
 
 ///
@@ -164,12 +217,24 @@ IDocument::IDocument ()
 ///
 IDocument::~IDocument ()
 {
+    stopJobs ();
+    CacheBudget::getBudget ().remove (this);
     g_list_free (m_Observers);
+    delete m_NewOutlineIndex;
+    delete m_OutlineIndex;
     delete m_Outline;
     delete m_FindRect;
+    clearPageLinks (FALSE);
+    g_ptr_array_free (m_PageLinks, TRUE);
+    setUnchangedPages (NULL);
+    delete m_CompressedPages;
+    delete m_Thumbnails;
+    g_hash_table_destroy (m_WantedThumbnails);
+    delete m_PagePreview;
     g_free (m_Author);
     g_free (m_CreationDate);
     g_free (m_Creator);
+    g_free (m_DocumentKey);
     g_free (m_FileName);
     g_free (m_Format);
     g_free (m_Keywords);
@@ -183,6 +248,30 @@ IDocument::~IDocument ()
     g_free (m_Title);
 }
 
+///
+/// @brief Stops the jobs that use the document.
+///
+/// The queued jobs are removed, the one running is waited for and the
+/// rest won't notify the document anymore. The derived classes must
+/// call it first thing in their destructor, because the running job
+/// may still be using them.
+///
+void
+IDocument::stopJobs ()
+{
+    // A text still being saved must not notify this document anymore,
+    // and mustn't keep the job thread waiting.
+    G_LOCK (saveText);
+    if ( NULL != m_SaveTextJob )
+    {
+        m_SaveTextJob->cancel ();
+        m_SaveTextJob->detachDocument ();
+        m_SaveTextJob = NULL;
+    }
+    G_UNLOCK (saveText);
+    IJob::removeOwner (this);
+}
+
 ///
 /// @brief Attaches a new observer object.
 ///
@@ -284,17 +373,24 @@ IDocument::notifyFindStarted ()
 /// This is called when the JobLoad class is done. It in turn notifies
 /// all attached observers about this situation.
 ///
+/// The first pages are queued to render before reading the outline and
+/// the page sizes, so the first page is shown as soon as possible.
+///
 void
 IDocument::notifyLoad ()
 {
     // Empty the cache to avoid displaying pages from previous file.
     clearCache ();
+    clearPageLinks (FALSE);
+    setUnchangedPages (NULL);
+    clearThumbnails ();
     // Add the two first pages, if they exists, to the cache.
     addPageToCache (1);
     if ( 1 < getNumPages () )
     {
         addPageToCache (2);
     }
+    queueLoadJobs ();
 
     for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
           item = g_list_next (item) )
@@ -316,6 +412,7 @@ IDocument::notifyLoad ()
 void
 IDocument::notifyLoadError (const gchar *fileName, const GError *error)
 {
+    m_LoadStartTime = 0;
     for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
           item = g_list_next (item) )
     {
@@ -348,6 +445,87 @@ IDocument::notifyLoadPassword (const gchar *fileName, gboolean reload,
     }
 }
 
+///
+/// @brief The system is running out of memory.
+///
+/// This is called by MemoryGovernor when the system is critically low
+/// on memory. It notifies all attached observers.
+///
+void
+IDocument::notifyLowMemory ()
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyLowMemory ();
+    }
+}
+
+///
+/// @brief The document's outline has been read.
+///
+/// This is called by the JobLoadOutline class when the outline's first
+/// level is read. The document replaces its outline and then notifies
+/// all attached observers, so they can stop using the old one. The new
+/// outline has no index until notifyOutlineIndexed() is called.
+///
+/// A job still indexing the old outline is waited for, so it's not
+/// deleted while the job reads it.
+///
+/// @param outline The document's new outline. The document takes it.
+///
+void
+IDocument::notifyOutlineLoaded (DocumentOutline *outline)
+{
+    g_assert (NULL != outline && "Tried to set a NULL outline.");
+
+    G_LOCK (outlineIndex);
+    DocumentOutline *oldOutline = m_Outline;
+    m_Outline = outline;
+    delete m_NewOutlineIndex;
+    m_NewOutlineIndex = NULL;
+    G_UNLOCK (outlineIndex);
+    delete m_OutlineIndex;
+    m_OutlineIndex = NULL;
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyOutlineLoaded (outline);
+    }
+    delete oldOutline;
+}
+
+///
+/// @brief The document's outline has been indexed by page.
+///
+/// This is called by the JobIndexOutline class after indexOutline().
+/// The document starts using the new index and notifies all attached
+/// observers, so they can find the current page's section.
+///
+void
+IDocument::notifyOutlineIndexed ()
+{
+    G_LOCK (outlineIndex);
+    DocumentOutlineIndex *index = m_NewOutlineIndex;
+    m_NewOutlineIndex = NULL;
+    G_UNLOCK (outlineIndex);
+    if ( NULL == index )
+    {
+        return;
+    }
+
+    delete m_OutlineIndex;
+    m_OutlineIndex = index;
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyOutlineIndexed ();
+    }
+}
+
 ///
 /// @brief The current page has been changed.
 ///
@@ -387,6 +565,18 @@ IDocument::notifyPageRendered (gint pageNumber, guint32 age,
         delete cachedPage->pageImage;
         cachedPage->pageImage = pageImage;
         G_UNLOCK (pageImage);
+        if ( PREVIEW_PAGE == pageNumber )
+        {
+            cachePagePreview (pageImage);
+        }
+
+        if ( 0 != m_LoadStartTime && getCurrentPageNum () == pageNumber )
+        {
+            m_TimeToFirstPage =
+                (g_get_monotonic_time () - m_LoadStartTime) / 1000.0;
+            m_LoadStartTime = 0;
+        }
+        CacheBudget::getBudget ().trim ();
     }
     else
     {
@@ -430,19 +620,82 @@ IDocument::notifyPageZoomed ()
     }
 }
 
+///
+/// @brief The document has been printed.
+///
+/// This is called when the JobPrint class has sent all pages to the
+/// printer. It in turn notifies all attached observers.
+///
+void
+IDocument::notifyPrint ()
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyPrint ();
+    }
+}
+
+///
+/// @brief The document couldn't be printed.
+///
+/// This is called by the JobPrint class when the printer couldn't
+/// be reached or rejected the job. It in turn notifies all attached
+/// observers.
+///
+/// @param error The error message of why couldn't print the document.
+///
+void
+IDocument::notifyPrintError (const GError *error)
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyPrintError (error);
+    }
+}
+
+///
+/// @brief A page to print has been sent to the printer.
+///
+/// This is called by the JobPrint class after each page is converted.
+/// It in turn notifies all attached observers.
+///
+/// @param numPagesPrinted The number of pages already sent.
+/// @param numPagesToPrint The number of pages to print.
+///
+void
+IDocument::notifyPrintProgress (guint numPagesPrinted, guint numPagesToPrint)
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyPrintProgress (numPagesPrinted, numPagesToPrint);
+    }
+}
+
 ///
 /// @brief The document has been reloaded.
 ///
 /// This is called by the JobLoad class when the document has been reloaded.
 /// It in turns notifies all attached observers about this.
 ///
+/// The pages that didn't change keep their rendered image and links.
+///
 void
 IDocument::notifyReload ()
 {
-    // Refresh the cache.
+    // Refresh the cache. The links could have changed as well.
+    clearPageLinks (TRUE);
     G_LOCK (JobRender);
-    refreshCache ();
+    refreshCache (TRUE);
     G_UNLOCK (JobRender);
+    setUnchangedPages (NULL);
+    clearThumbnails ();
+    queueLoadJobs ();
 
     for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
           item = g_list_next (item) )
@@ -488,6 +741,99 @@ IDocument::notifySaveError (const GError *error)
     }
 }
 
+///
+/// @brief The document's text has been saved.
+///
+/// This is called by the JobSaveText class when all pages' text is
+/// written. It in turn notifies all attached observers.
+///
+void
+IDocument::notifySaveText ()
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifySaveText ();
+    }
+}
+
+///
+/// @brief The document's text couldn't be saved.
+///
+/// This is called by the JobSaveText class when the text couldn't be
+/// extracted or written, or the save was cancelled. It in turn notifies
+/// all attached observers.
+///
+/// @param error The error message of why the text couldn't be saved.
+///
+void
+IDocument::notifySaveTextError (const GError *error)
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifySaveTextError (error);
+    }
+}
+
+///
+/// @brief A page's text has been saved.
+///
+/// This is called by the JobSaveText class after each page is written.
+/// It in turn notifies all attached observers.
+///
+/// @param numPagesSaved The number of pages already written.
+/// @param numPagesToSave The number of pages to write.
+///
+void
+IDocument::notifySaveTextProgress (guint numPagesSaved, guint numPagesToSave)
+{
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifySaveTextProgress (numPagesSaved, numPagesToSave);
+    }
+}
+
+///
+/// @brief A page's thumbnail has been rendered.
+///
+/// This is called by the JobRenderThumbnail class when the thumbnail is
+/// ready. It's added to the thumbnails' cache and all attached observers
+/// are notified.
+///
+/// @param pageNum The number of the thumbnail's page.
+/// @param thumbnail The rendered thumbnail, or NULL if the page couldn't
+///                  be rendered. The document takes its ownership.
+///
+void
+IDocument::notifyThumbnailRendered (gint pageNum, DocumentPage *thumbnail)
+{
+    // A thumbnail no longer queued is from a document since closed.
+    G_LOCK (thumbnails);
+    gboolean queued = g_hash_table_remove (m_WantedThumbnails,
+                                           GINT_TO_POINTER (pageNum));
+    G_UNLOCK (thumbnails);
+    if ( !queued || NULL == thumbnail )
+    {
+        delete thumbnail;
+        return;
+    }
+    m_Thumbnails->add (pageNum, thumbnail);
+
+    for ( GList *item = g_list_first (m_Observers) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver *)item->data;
+        observer->notifyThumbnailRendered (pageNum, thumbnail);
+    }
+    // The observers copied the thumbnail, so it can be deleted now.
+    CacheBudget::getBudget ().trim ();
+}
+
 ///
 /// @brief Loads a file.
 ///
@@ -500,6 +846,8 @@ IDocument::notifySaveError (const GError *error)
 void
 IDocument::load (const gchar *fileName, const gchar *password)
 {
+    m_LoadStartTime = g_get_monotonic_time ();
+    m_TimeToFirstPage = -1.0;
     m_CurrentPage = 1;
     m_Rotation = 0;
     m_Scale = 1.0f;
@@ -543,6 +891,64 @@ IDocument::save (const gchar *fileName)
     IJob::enqueue (job);
 }
 
+///
+/// @brief Saves the text of all pages to a file.
+///
+/// The text is extracted from the background, cancelling the previous
+/// save of the text if still running. The observers are notified of
+/// the progress and when it ends.
+///
+/// @param fileName The name of the text file to write.
+///
+void
+IDocument::saveText (const gchar *fileName)
+{
+    cancelSaveText ();
+
+    JobSaveText *job = new JobSaveText ();
+    job->setDocument (this);
+    job->setFileName (fileName);
+    G_LOCK (saveText);
+    m_SaveTextJob = job;
+    G_UNLOCK (saveText);
+    IJob::enqueue (job);
+}
+
+///
+/// @brief Cancels saving the document's text.
+///
+/// The observers are notified with a G_IO_ERROR_CANCELLED error when
+/// the save stops.
+///
+void
+IDocument::cancelSaveText ()
+{
+    G_LOCK (saveText);
+    if ( NULL != m_SaveTextJob )
+    {
+        m_SaveTextJob->cancel ();
+    }
+    G_UNLOCK (saveText);
+}
+
+///
+/// @brief Forgets a job that saved the document's text.
+///
+/// This is called by the JobSaveText class when it ends.
+///
+/// @param job The job that ended.
+///
+void
+IDocument::removeSaveTextJob (JobSaveText *job)
+{
+    G_LOCK (saveText);
+    if ( job == m_SaveTextJob )
+    {
+        m_SaveTextJob = NULL;
+    }
+    G_UNLOCK (saveText);
+}
+
 ///
 /// @brief Gets the document's title.
 ///
@@ -1022,6 +1428,10 @@ IDocument::getCurrentPage ()
 /// an empty document (i.e., no text or image) using the size that the
 /// page would have it it was rendered.
 ///
+/// If the disk cache has an image of the page from a previous session,
+/// that image is scaled to the page's size instead, so the page shows
+/// at once while it's rendered.
+///
 /// @return An DocumentPage whose image is just a blank page. The caller
 ///         must delete this DocumentPage object.
 ///
@@ -1033,8 +1443,20 @@ IDocument::getEmptyPage ()
     getPageSizeForPage (getCurrentPageNum (), &pageWidth, &pageHeight);
     gint width = MAX((gint) ((pageWidth * getZoom ()) + 0.5), 1);
     gint height = MAX((gint) ((pageHeight * getZoom ()) + 0.5) , 1);
-    DocumentPage *emptyPage = new DocumentPage ();
-    emptyPage->newPage (width, height);
+
+    DocumentPage *emptyPage = NULL;
+    G_LOCK (documentKey);
+    if ( NULL != m_PagePreview && PREVIEW_PAGE == getCurrentPageNum () &&
+         m_PreviewRotation == getRotation () )
+    {
+        emptyPage = scalePage (m_PagePreview, width, height);
+    }
+    G_UNLOCK (documentKey);
+    if ( NULL == emptyPage )
+    {
+        emptyPage = new DocumentPage ();
+        emptyPage->newPage (width, height);
+    }
 
     return emptyPage;
 }
@@ -1065,85 +1487,589 @@ IDocument::getOutline ()
 }
 
 ///
-/// @brief Gets the current page's unscaled size.
+/// @brief Gets the outline's section a page belongs to.
 ///
-/// Retrieves the width and height of the current page before to scale, but
-/// after rotation.
-/// 
-/// @param width The output pointer to save the page's width.
-/// @param height The output pointer to save the page's height.
+/// @param pageNum The page number, starting from 1.
 ///
-void
-IDocument::getPageSize (gdouble *width, gdouble *height)
+/// @return The outline item of the section @a pageNum is in, or NULL
+///         if the page is before any section or the outline hasn't
+///         been read yet.
+///
+DocumentOutline *
+IDocument::getOutlineSection (gint pageNum)
 {
-    getPageSizeForPage (getCurrentPageNum (), width, height);
+    if ( NULL == m_OutlineIndex )
+    {
+        return NULL;
+    }
+    return m_OutlineIndex->findSection (pageNum);
 }
 
 ///
-/// @brief Goes to the document's first page.
+/// @brief Indexes the outline's items by page.
 ///
-/// Changes the current page to be the first page of the
-/// document.
+/// Indexing reads all of the outline's levels, so this is called by
+/// the JobIndexOutline class rather than by the main thread. The index
+/// is used once notifyOutlineIndexed() is called.
 ///
-void
-IDocument::goToFirstPage ()
+/// @param outline The outline to index. If it's no longer the
+///                document's outline, it's not read at all, as it may
+///                have been deleted.
+///
+/// @return TRUE if @a outline was indexed, FALSE if it's no longer the
+///         document's outline.
+///
+gboolean
+IDocument::indexOutline (DocumentOutline *outline)
 {
-    goToPage (1);
+    // The outline isn't replaced nor deleted while it's being indexed.
+    G_LOCK (outlineIndex);
+    gboolean current = ( outline == m_Outline && NULL != outline );
+    if ( current )
+    {
+        delete m_NewOutlineIndex;
+        m_NewOutlineIndex = new DocumentOutlineIndex (outline);
+    }
+    G_UNLOCK (outlineIndex);
+
+    return current;
 }
 
 ///
-/// @brief Goes to the document's last page.
+/// @brief Gets how long the document took to show its first page.
 ///
-/// Changes the current page to be the last page of the
-/// document.
+/// @return The milliseconds from the call to load() until the first
+///         page was rendered, or a negative value if the document
+///         is still loading or was reloaded.
 ///
-void
-IDocument::goToLastPage ()
+gdouble
+IDocument::getTimeToFirstPage ()
 {
-    goToPage (getNumPages ());
+    return m_TimeToFirstPage;
 }
 
 ///
-/// @brief Goes the the document's next page.
+/// @brief Gets how much the pages dropped from the cache are compressed.
 ///
-/// Changes the current page to be the next page. If the current page is
-/// already the last, then it will not change.
+/// @return The bytes the compressed pages would use uncompressed divided
+///         by the bytes they use, or 0 if there are no compressed pages.
 ///
-void
-IDocument::goToNextPage ()
+gdouble
+IDocument::getCacheCompressionRatio ()
 {
-    goToPage (getCurrentPageNum() + 1);
+    G_LOCK (compressedPages);
+    gdouble ratio = m_CompressedPages->getCompressionRatio ();
+    G_UNLOCK (compressedPages);
+
+    return ratio;
 }
 
-// Structure to hold data for async page loading
 ///
-/// @brief Goes to the document's last page.
+/// @brief Gets how long it takes to restore a compressed page.
+///
+/// @return The average milliseconds spent decompressing the image of a
+///         page that was dropped from the cache, or 0 if none was.
+///
+gdouble
+IDocument::getCacheDecodeTime ()
+{
+    G_LOCK (compressedPages);
+    gdouble decodeTime = m_CompressedPages->getDecodeTime ();
+    G_UNLOCK (compressedPages);
+
+    return decodeTime;
+}
 
 ///
-/// @brief Goes to a document page.
+/// @brief Gets the memory used by the cached pages and thumbnails.
 ///
-/// Changes the current page to be the page @a pageNum. If @a pageNum is
-/// greater than the document's last page, then the current page becomes
-/// the last page. If @a pageNum is instead less than the first page (i.e., 
-/// <= 0) then the current page becomes the first (i.e., 1).
+/// Counts the rendered pages as well as the compressed pages, as the
+/// rendered are the largest images a document keeps.
 ///
-/// @param pageNum The page index to go to.
+/// @return The bytes that the cached images use.
 ///
-void
-IDocument::goToPage(gint pageNum)
+gsize
+IDocument::getCacheSize ()
 {
-    // Clamp to valid range and check if different from current
-    pageNum = CLAMP(pageNum, 1, getNumPages());
-    
-    // Only change page if different - this prevents infinite loops
-    if (pageNum != m_CurrentPage) {
-        m_CurrentPage = pageNum;
+    return getRenderedPagesSize (TRUE) + getReleasableCacheSize (FALSE);
+}
 
-        addPageToCache(m_CurrentPage);
-        if (m_CurrentPage > 1) {
-            addPageToCache(m_CurrentPage - 1);
-        }
-        if (m_CurrentPage < getNumPages()) {
+///
+/// @brief Gets the memory that releaseCache() can free.
+///
+/// The current page is never released, and the other rendered pages
+/// only when @a releasePages is TRUE, so they are only counted then.
+///
+/// @param releasePages Whether the rendered pages can be deleted too.
+///
+/// @return The bytes that releaseCache() would free at most.
+///
+gsize
+IDocument::getReleasableCacheSize (gboolean releasePages)
+{
+    gsize size = 0;
+    if ( releasePages )
+    {
+        size += getRenderedPagesSize (FALSE);
+    }
+
+    G_LOCK (compressedPages);
+    size += m_CompressedPages->getSize ();
+    G_UNLOCK (compressedPages);
+
+    return size + m_Thumbnails->getSize ();
+}
+
+///
+/// @brief Gets the memory used by the rendered pages.
+///
+/// @param withCurrent Whether to count the current page.
+///
+/// @return The bytes that the rendered pages' images use.
+///
+gsize
+IDocument::getRenderedPagesSize (gboolean withCurrent)
+{
+    gsize size = 0;
+    G_LOCK (pageSearch);
+    for ( GList *page = g_list_first (m_PageCache) ; NULL != page ;
+          page = g_list_next (page) )
+    {
+        PageCache *cachedPage = (PageCache *)page->data;
+        if ( withCurrent || m_CurrentPage != cachedPage->pageNumber )
+        {
+            G_LOCK (pageImage);
+            if ( NULL != cachedPage->pageImage )
+            {
+                size += cachedPage->pageImage->getRowStride () *
+                        cachedPage->pageImage->getHeight ();
+            }
+            G_UNLOCK (pageImage);
+        }
+    }
+    G_UNLOCK (pageSearch);
+
+    return size;
+}
+
+///
+/// @brief Gets the age that the render jobs must have to run.
+///
+/// The pages dropped from the cache make older render jobs useless, so
+/// JobRender skips them. The caller must hold the JobRender lock.
+///
+/// @return The minimum age of the render jobs of this document.
+///
+guint32
+IDocument::getMinRenderAge ()
+{
+    return m_MinRenderAge;
+}
+
+///
+/// @brief Deletes cached images to free memory.
+///
+/// The compressed pages are deleted first, then, if @a releasePages is
+/// TRUE, the rendered pages other than the current, and the thumbnails
+/// last, as they are shown while the document is open. The current
+/// page is always kept.
+///
+/// @param size The bytes to free.
+/// @param releasePages Whether the rendered pages can be deleted too.
+///
+/// @return The bytes freed.
+///
+gsize
+IDocument::releaseCache (gsize size, gboolean releasePages)
+{
+    G_LOCK (compressedPages);
+    gsize released = m_CompressedPages->release (size);
+    G_UNLOCK (compressedPages);
+    if ( releasePages && released < size )
+    {
+        released += releasePrefetchedPages ();
+    }
+    if ( released < size )
+    {
+        released += m_Thumbnails->release (size - released);
+    }
+
+    return released;
+}
+
+///
+/// @brief Deletes the cached pages other than the current.
+///
+/// The pages next to the current are rendered in advance, so going to
+/// them doesn't wait for the render. When memory is low they are
+/// deleted, and rendered again when they are needed. Their render jobs
+/// still queued drop the image when done.
+///
+/// @return The bytes freed.
+///
+gsize
+IDocument::releasePrefetchedPages ()
+{
+    gsize released = 0;
+    G_LOCK (pageSearch);
+    GList *page = g_list_first (m_PageCache);
+    while ( NULL != page )
+    {
+        GList *nextPage = g_list_next (page);
+        PageCache *cachedPage = (PageCache *)page->data;
+        if ( m_CurrentPage != cachedPage->pageNumber )
+        {
+            G_LOCK (pageImage);
+            if ( NULL != cachedPage->pageImage )
+            {
+                released += cachedPage->pageImage->getRowStride () *
+                            cachedPage->pageImage->getHeight ();
+                delete cachedPage->pageImage;
+            }
+            G_UNLOCK (pageImage);
+            delete cachedPage;
+            m_PageCache = g_list_delete_link (m_PageCache, page);
+        }
+        page = nextPage;
+    }
+    G_UNLOCK (pageSearch);
+
+    return released;
+}
+
+///
+/// @brief Checks if a page didn't change with the last reload.
+///
+/// @param pageNum The number of the page to check.
+///
+/// @return TRUE if the document is being reloaded and the page
+///         @a pageNum has the same contents as before, FALSE otherwise.
+///
+gboolean
+IDocument::isPageUnchanged (gint pageNum)
+{
+    gboolean unchanged = FALSE;
+    G_LOCK (unchangedPages);
+    if ( NULL != m_UnchangedPages )
+    {
+        for ( guint index = 0 ;
+              !unchanged && index < m_UnchangedPages->len ;
+              index++ )
+        {
+            unchanged =
+                ( pageNum == g_array_index (m_UnchangedPages, gint, index) );
+        }
+    }
+    G_UNLOCK (unchangedPages);
+
+    return unchanged;
+}
+
+///
+/// @brief Tells if the document's file is watched to reload it.
+///
+/// @return TRUE if the document must remember what its pages look like
+///         to find the ones unchanged by a reload, FALSE otherwise.
+///
+gboolean
+IDocument::isWatched ()
+{
+    return g_atomic_int_get (&m_Watched);
+}
+
+///
+/// @brief Sets if the document's file is watched to reload it.
+///
+/// Only a watched document remembers what its pages look like, which
+/// costs a small render of each page, from a low priority job. The
+/// pages whose links were already read get theirs now.
+///
+/// @param watched TRUE if the document's file is watched, FALSE
+///                otherwise.
+///
+void
+IDocument::setWatched (gboolean watched)
+{
+    g_atomic_int_set (&m_Watched, watched);
+    if ( !watched )
+    {
+        return;
+    }
+
+    GArray *pages = g_array_new (FALSE, FALSE, sizeof (gint));
+    G_LOCK (pageLinks);
+    for ( guint page = 0 ; page < m_PageLinks->len ; page++ )
+    {
+        if ( NULL != g_ptr_array_index (m_PageLinks, page) )
+        {
+            gint pageNum = page + 1;
+            g_array_append_val (pages, pageNum);
+        }
+    }
+    G_UNLOCK (pageLinks);
+    for ( guint page = 0 ; page < pages->len ; page++ )
+    {
+        queuePageFingerprint (g_array_index (pages, gint, page));
+    }
+    g_array_free (pages, TRUE);
+}
+
+///
+/// @brief Tells if a queued thumbnail must still be rendered.
+///
+/// This is called by the JobRenderThumbnail class before rendering. The
+/// thumbnails that are no longer shown are forgotten instead.
+///
+/// @param pageNum The number of the thumbnail's page.
+///
+/// @return TRUE if the thumbnail must be rendered, FALSE otherwise.
+///
+gboolean
+IDocument::beginThumbnail (gint pageNum)
+{
+    G_LOCK (thumbnails);
+    gboolean wanted = ( ThumbnailWanted ==
+                        GPOINTER_TO_INT (g_hash_table_lookup (
+                            m_WantedThumbnails, GINT_TO_POINTER (pageNum))) );
+    if ( !wanted )
+    {
+        g_hash_table_remove (m_WantedThumbnails, GINT_TO_POINTER (pageNum));
+    }
+    G_UNLOCK (thumbnails);
+
+    return wanted;
+}
+
+///
+/// @brief Tells that a page's thumbnail is no longer shown.
+///
+/// If its render is still queued, it will be skipped.
+///
+/// @param pageNum The number of the thumbnail's page.
+///
+void
+IDocument::cancelThumbnail (gint pageNum)
+{
+    G_LOCK (thumbnails);
+    if ( NULL != g_hash_table_lookup (m_WantedThumbnails,
+                                      GINT_TO_POINTER (pageNum)) )
+    {
+        g_hash_table_insert (m_WantedThumbnails, GINT_TO_POINTER (pageNum),
+                             GINT_TO_POINTER (ThumbnailCancelled));
+    }
+    G_UNLOCK (thumbnails);
+}
+
+///
+/// @brief Deletes all thumbnails and forgets the queued ones.
+///
+void
+IDocument::clearThumbnails ()
+{
+    m_Thumbnails->clear ();
+    G_LOCK (thumbnails);
+    g_hash_table_remove_all (m_WantedThumbnails);
+    G_UNLOCK (thumbnails);
+}
+
+///
+/// @brief Gets a page's thumbnail, if it's already rendered.
+///
+/// @param pageNum The number of the page to get its thumbnail.
+///
+/// @return The page's thumbnail, owned by the document, or NULL if it
+///         isn't rendered. It must be copied, as it can be deleted when
+///         another thumbnail is rendered.
+///
+DocumentPage *
+IDocument::getThumbnail (gint pageNum)
+{
+    return m_Thumbnails->get (pageNum);
+}
+
+///
+/// @brief Gets the size of the pages' thumbnails.
+///
+/// @return The maximum width and height of the thumbnails.
+///
+gint
+IDocument::getThumbnailSize ()
+{
+    return THUMBNAIL_SIZE;
+}
+
+///
+/// @brief Gets a page's thumbnail from the disk cache or renders it.
+///
+/// This is called by the JobRenderThumbnail class. A rendered thumbnail
+/// is stored in the disk cache, so the next time the document is opened
+/// the thumbnail is only read back.
+///
+/// @param pageNum The page to get its thumbnail.
+/// @param size The maximum width and height of the thumbnail.
+///
+/// @return The page's thumbnail or NULL if the page can't be read. The
+///         returned page must be freed by calling delete.
+///
+DocumentPage *
+IDocument::loadThumbnail (gint pageNum, gint size)
+{
+    G_LOCK (documentKey);
+    gchar *key = g_strdup (m_DocumentKey);
+    G_UNLOCK (documentKey);
+    if ( NULL == m_DiskCache || NULL == key )
+    {
+        return renderThumbnail (pageNum, size);
+    }
+
+    gchar *name = g_strdup_printf (THUMBNAIL_ENTRY_NAME, size, pageNum);
+    DocumentPage *thumbnail = m_DiskCache->lookup (key, name, NULL, NULL);
+    if ( NULL == thumbnail )
+    {
+        thumbnail = renderThumbnail (pageNum, size);
+        if ( NULL != thumbnail )
+        {
+            m_DiskCache->store (key, name, thumbnail, 1.0, 0);
+        }
+    }
+    g_free (name);
+    g_free (key);
+
+    return thumbnail;
+}
+
+///
+/// @brief Queues to render a page's thumbnail.
+///
+/// The thumbnail is rendered in background with low priority, so it
+/// never delays a page's render. When done, the observers are notified
+/// by IDocumentObserver::notifyThumbnailRendered().
+///
+/// @param pageNum The number of the page to render its thumbnail.
+///
+void
+IDocument::requestThumbnail (gint pageNum)
+{
+    G_LOCK (thumbnails);
+    gboolean queued = ( NULL != g_hash_table_lookup (
+                            m_WantedThumbnails, GINT_TO_POINTER (pageNum)) );
+    g_hash_table_insert (m_WantedThumbnails, GINT_TO_POINTER (pageNum),
+                         GINT_TO_POINTER (ThumbnailWanted));
+    G_UNLOCK (thumbnails);
+    if ( queued )
+    {
+        return;
+    }
+
+    JobRenderThumbnail *job = new JobRenderThumbnail ();
+    job->setDocument (this);
+    job->setPageNumber (pageNum);
+    job->setSize (THUMBNAIL_SIZE);
+    IJob::enqueueLowPriority (job);
+}
+
+///
+/// @brief Sets the pages that didn't change with a reload.
+///
+/// The derived classes call this from loadFile() when reloading, so
+/// notifyReload() won't render again nor read again the links of these
+/// pages.
+///
+/// @param pages The array of gint page numbers that didn't change, or
+///              NULL. The document takes ownership of the array.
+///
+void
+IDocument::setUnchangedPages (GArray *pages)
+{
+    G_LOCK (unchangedPages);
+    if ( NULL != m_UnchangedPages )
+    {
+        g_array_free (m_UnchangedPages, TRUE);
+    }
+    m_UnchangedPages = pages;
+    G_UNLOCK (unchangedPages);
+}
+
+///
+/// @brief Gets the current page's unscaled size.
+///
+/// Retrieves the width and height of the current page before to scale, but
+/// after rotation.
+/// 
+/// @param width The output pointer to save the page's width.
+/// @param height The output pointer to save the page's height.
+///
+void
+IDocument::getPageSize (gdouble *width, gdouble *height)
+{
+    getPageSizeForPage (getCurrentPageNum (), width, height);
+}
+
+///
+/// @brief Goes to the document's first page.
+///
+/// Changes the current page to be the first page of the
+/// document.
+///
+void
+IDocument::goToFirstPage ()
+{
+    goToPage (1);
+}
+
+///
+/// @brief Goes to the document's last page.
+///
+/// Changes the current page to be the last page of the
+/// document.
+///
+void
+IDocument::goToLastPage ()
+{
+    goToPage (getNumPages ());
+}
+
+///
+/// @brief Goes the the document's next page.
+///
+/// Changes the current page to be the next page. If the current page is
+/// already the last, then it will not change.
+///
+void
+IDocument::goToNextPage ()
+{
+    goToPage (getCurrentPageNum() + 1);
+}
+
+// Structure to hold data for async page loading
+///
+/// @brief Goes to the document's last page.
+
+///
+/// @brief Goes to a document page.
+///
+/// Changes the current page to be the page @a pageNum. If @a pageNum is
+/// greater than the document's last page, then the current page becomes
+/// the last page. If @a pageNum is instead less than the first page (i.e., 
+/// <= 0) then the current page becomes the first (i.e., 1).
+///
+/// @param pageNum The page index to go to.
+///
+void
+IDocument::goToPage(gint pageNum)
+{
+    // Clamp to valid range and check if different from current
+    pageNum = CLAMP(pageNum, 1, getNumPages());
+    
+    // Only change page if different - this prevents infinite loops
+    if (pageNum != m_CurrentPage) {
+        m_CurrentPage = pageNum;
+
+        addPageToCache(m_CurrentPage);
+        if (m_CurrentPage > 1) {
+            addPageToCache(m_CurrentPage - 1);
+        }
+        if (m_CurrentPage < getNumPages()) {
             addPageToCache(m_CurrentPage + 1);
         }
 
@@ -1163,6 +2089,65 @@ IDocument::goToPreviousPage ()
     goToPage (getCurrentPageNum () - 1);
 }
 
+///
+/// @brief Gets the cache of rendered images kept between sessions.
+///
+/// @return The disk cache or NULL if the images are not kept.
+///
+DiskCache *
+IDocument::getDiskCache ()
+{
+    return m_DiskCache;
+}
+
+///
+/// @brief Sets the cache of rendered images kept between sessions.
+///
+/// This is shared by all documents and must be set before loading any.
+///
+/// @param cache The disk cache, owned by the caller, or NULL to not
+///              keep the images.
+///
+void
+IDocument::setDiskCache (DiskCache *cache)
+{
+    m_DiskCache = cache;
+}
+
+///
+/// @brief Finds the loaded document in the disk cache.
+///
+/// This is called by the JobLoad class once the document is loaded. It
+/// reads the document's key and the first page's image that the disk
+/// cache has from a previous session, if any.
+///
+void
+IDocument::openDiskCache ()
+{
+    gchar *key = NULL;
+    DocumentPage *preview = NULL;
+    gdouble zoom = 0.0;
+    gint rotation = 0;
+    if ( NULL != m_DiskCache && NULL != getFileName () )
+    {
+        key = DiskCache::getDocumentKey (getFileName ());
+        if ( NULL != key )
+        {
+            preview = m_DiskCache->lookup (key, PREVIEW_ENTRY_NAME, &zoom,
+                                           &rotation);
+        }
+    }
+
+    G_LOCK (documentKey);
+    g_free (m_DocumentKey);
+    m_DocumentKey = key;
+    delete m_PagePreview;
+    m_PagePreview = preview;
+    m_PreviewRotation = rotation;
+    m_PreviewZoom = NULL != preview ? zoom : 0.0;
+    G_UNLOCK (documentKey);
+}
+
 ///
 /// @brief Gets the current rotation degrees.
 ///
@@ -1188,7 +2173,7 @@ IDocument::setRotation (gint rotation)
     {
         G_LOCK (JobRender);
         m_Rotation = (rotation % 360);
-        refreshCache ();
+        refreshCache (FALSE);
         G_UNLOCK (JobRender);
         notifyPageRotated ();
     }
@@ -1266,7 +2251,7 @@ IDocument::setZoom (gdouble zoom)
     {
         G_LOCK (JobRender);
         m_Scale = CLAMP (zoom, ZOOM_OUT_MAX, ZOOM_IN_MAX);
-        refreshCache ();
+        refreshCache (FALSE);
         G_UNLOCK (JobRender);
         notifyPageZoomed ();
     }
@@ -1420,10 +2405,12 @@ IDocument::zoomToHeight (gint height)
 ///
 /// This function checks if a page is already on the cache. If it is, then
 /// only updates the age and returns. Otherwise adds the page to the cache and
+/// restores its image from the compressed pages or, if it isn't there,
 /// creates a new job for rendering it.
 ///
 /// After adding the new page, if the cache size is larger that it should be,
-/// then this deletes the oldest request from the cache.
+/// then this deletes the oldest request from the cache, keeping its image
+/// compressed.
 ///
 /// @param pageNum The page number to add to the cache.
 ///
@@ -1441,13 +2428,18 @@ IDocument::addPageToCache (gint pageNum)
         cached = new PageCache;
         cached->age = m_PageCacheAge++;
         cached->pageNumber = pageNum;
-        cached->pageImage = NULL;
+        G_LOCK (compressedPages);
+        cached->pageImage = m_CompressedPages->take (pageNum);
+        G_UNLOCK (compressedPages);
 
-        JobRender *job = new JobRender ();
-        job->setAge (cached->age);
-        job->setDocument (this);
-        job->setPageNumber (pageNum);
-        IJob::enqueue (job);
+        if ( NULL == cached->pageImage )
+        {
+            JobRender *job = new JobRender ();
+            job->setAge (cached->age);
+            job->setDocument (this);
+            job->setPageNumber (pageNum);
+            IJob::enqueue (job);
+        }
 
         G_LOCK (pageSearch);
         // Check which cached page to drop.
@@ -1467,9 +2459,17 @@ IDocument::addPageToCache (gint pageNum)
             }
             m_PageCache = g_list_remove_all (m_PageCache, oldestCachedPage);
             G_LOCK (JobRender);
-            JobRender::setMinAge (oldestCachedPage->age);
+            m_MinRenderAge = oldestCachedPage->age;
             G_UNLOCK (JobRender);
             G_LOCK (pageImage);
+            if ( NULL != oldestCachedPage->pageImage )
+            {
+                oldestCachedPage->pageImage->clearSelection ();
+                G_LOCK (compressedPages);
+                m_CompressedPages->add (oldestCachedPage->pageNumber,
+                                        oldestCachedPage->pageImage);
+                G_UNLOCK (compressedPages);
+            }
             delete oldestCachedPage->pageImage;
             G_UNLOCK (pageImage);
             delete oldestCachedPage;            
@@ -1477,6 +2477,7 @@ IDocument::addPageToCache (gint pageNum)
         // Add the page to the cache.
         m_PageCache = g_list_append (m_PageCache, cached);
         G_UNLOCK (pageSearch);
+        CacheBudget::getBudget ().trim ();
     }
     else
     {
@@ -1486,6 +2487,128 @@ IDocument::addPageToCache (gint pageNum)
     }
 }
 
+///
+/// @brief Stores the first page's image in the disk cache.
+///
+/// The image is only stored when the disk cache has none with the
+/// current zoom and rotation, and it's written by a low priority job.
+///
+/// @param pageImage The first page's rendered image.
+///
+void
+IDocument::cachePagePreview (DocumentPage *pageImage)
+{
+    if ( NULL == m_DiskCache )
+    {
+        return;
+    }
+
+    G_LOCK (documentKey);
+    gchar *key = NULL;
+    if ( NULL != m_DocumentKey &&
+         ( getZoom () != m_PreviewZoom ||
+           getRotation () != m_PreviewRotation ) )
+    {
+        key = g_strdup (m_DocumentKey);
+        m_PreviewZoom = getZoom ();
+        m_PreviewRotation = getRotation ();
+    }
+    G_UNLOCK (documentKey);
+    if ( NULL == key )
+    {
+        return;
+    }
+
+    JobCacheImage *job = new JobCacheImage ();
+    job->setCache (m_DiskCache);
+    job->setEntry (key, PREVIEW_ENTRY_NAME);
+    job->setImage (scalePage (pageImage, pageImage->getWidth (),
+                              pageImage->getHeight ()),
+                   getZoom (), getRotation ());
+    IJob::enqueueLowPriority (job);
+    g_free (key);
+}
+
+///
+/// @brief Queues the jobs that read the rest of the loaded document.
+///
+/// The outline and the page sizes are not needed to show the first
+/// page, so they are read after the pages already in the queue. The
+/// index of the previous outline is dropped meanwhile, as it doesn't
+/// match the loaded document.
+///
+void
+IDocument::queueLoadJobs ()
+{
+    G_LOCK (outlineIndex);
+    delete m_NewOutlineIndex;
+    m_NewOutlineIndex = NULL;
+    G_UNLOCK (outlineIndex);
+    delete m_OutlineIndex;
+    m_OutlineIndex = NULL;
+
+    JobLoadOutline *outlineJob = new JobLoadOutline ();
+    outlineJob->setDocument (this);
+    IJob::enqueue (outlineJob);
+
+    JobLoadPageSizes *sizesJob = new JobLoadPageSizes ();
+    sizesJob->setDocument (this);
+    IJob::enqueue (sizesJob);
+}
+
+///
+/// @brief Queues the job that remembers what a page looks like.
+///
+/// @param pageNum The number of the page.
+///
+void
+IDocument::queuePageFingerprint (gint pageNum)
+{
+    JobFingerprintPage *job = new JobFingerprintPage ();
+    job->setDocument (this);
+    job->setPageNumber (pageNum);
+    IJob::enqueueLowPriority (job);
+}
+
+///
+/// @brief Tells if a page has a rendered image cached.
+///
+/// @param pageNum The number of the page to check.
+///
+/// @return TRUE if the page's image is in the cache, even compressed,
+///         FALSE otherwise.
+///
+gboolean
+IDocument::hasPageImage (gint pageNum)
+{
+    gboolean hasImage = FALSE;
+    G_LOCK (pageSearch);
+    for ( GList *page = g_list_first (m_PageCache) ;
+          NULL != page && !hasImage ;
+          page = g_list_next (page) )
+    {
+        PageCache *cachedPage = (PageCache *)page->data;
+        G_LOCK (pageImage);
+        hasImage = ( pageNum == cachedPage->pageNumber &&
+                     NULL != cachedPage->pageImage );
+        G_UNLOCK (pageImage);
+    }
+    G_UNLOCK (pageSearch);
+    if ( hasImage )
+    {
+        return TRUE;
+    }
+
+    G_LOCK (compressedPages);
+    GList *pageNumbers = m_CompressedPages->getPageNumbers ();
+    hasImage = ( NULL != g_list_find (pageNumbers,
+                                      GINT_TO_POINTER (pageNum)) );
+    g_list_free (pageNumbers);
+    G_UNLOCK (compressedPages);
+
+    return hasImage;
+}
+
 ///
 /// @brief Retrieves a page from the cache.
 ///
@@ -1520,8 +2643,14 @@ IDocument::getCachedPage (gint pageNum)
 /// Renders again all requested pages on the cache that had been rendered
 /// already.  This is useful when rotating or zooming.
 ///
+/// The compressed images of the pages that must render again are
+/// deleted as well.
+///
+/// @param onlyChanged TRUE to keep the images of the pages that
+///                    isPageUnchanged() tells, FALSE to render them all.
+///
 void
-IDocument::refreshCache ()
+IDocument::refreshCache (gboolean onlyChanged)
 {
     gint pageCount = g_list_length (m_PageCache);
     guint32 minAge = G_MAXUINT32;
@@ -1530,30 +2659,57 @@ IDocument::refreshCache ()
           page = g_list_next (page) )
     {
         PageCache *cachedPage = (PageCache *)page->data;
-        G_LOCK (pageImage);
-        delete cachedPage->pageImage;
-        G_UNLOCK (pageImage);
-        cachedPage->pageImage = NULL;
         cachedPage->age += pageCount;
         if ( cachedPage->age < minAge )
         {
             minAge = cachedPage->age;
         }
+        if ( onlyChanged && NULL != cachedPage->pageImage &&
+             isPageUnchanged (cachedPage->pageNumber) )
+        {
+            continue;
+        }
+        G_LOCK (pageImage);
+        delete cachedPage->pageImage;
+        G_UNLOCK (pageImage);
+        cachedPage->pageImage = NULL;
         JobRender *job = new JobRender;
         job->setDocument (this);
         job->setPageNumber (cachedPage->pageNumber);
         job->setAge (cachedPage->age);
         IJob::enqueue (job);
     }
-    JobRender::setMinAge (minAge);
+    // The callers hold the JobRender lock.
+    m_MinRenderAge = minAge;
     m_PageCacheAge += pageCount;
+
+    G_LOCK (compressedPages);
+    if ( onlyChanged )
+    {
+        GList *pageNumbers = m_CompressedPages->getPageNumbers ();
+        for ( GList *page = g_list_first (pageNumbers) ; NULL != page ;
+              page = g_list_next (page) )
+        {
+            gint pageNum = GPOINTER_TO_INT (page->data);
+            if ( !isPageUnchanged (pageNum) )
+            {
+                m_CompressedPages->remove (pageNum);
+            }
+        }
+        g_list_free (pageNumbers);
+    }
+    else
+    {
+        m_CompressedPages->clear ();
+    }
+    G_UNLOCK (compressedPages);
 }
 
 ///
 /// @brief Clears the cache.
 ///
-/// Deletes all elements from the cache. This must be done from
-/// the derived classes destructor.
+/// Deletes all elements from the cache, including the compressed images.
+/// This must be done from the derived classes destructor.
 ///
 void
 IDocument::clearCache ()
@@ -1573,6 +2729,10 @@ IDocument::clearCache ()
     g_list_free (m_PageCache);
     m_PageCache = NULL;
     G_UNLOCK (pageSearch);
+
+    G_LOCK (compressedPages);
+    m_CompressedPages->clear ();
+    G_UNLOCK (compressedPages);
 }
 
 ///
@@ -1590,16 +2750,7 @@ IDocument::clearCache ()
 gboolean
 IDocument::hasLinkAtPosition (gint x, gint y)
 {
-    // XXX For now only non rotated pages.
-    if ( 0 == getRotation () )
-    {
-        DocumentPage *page = getCurrentPage ();
-        if ( NULL != page )
-        {
-            return (NULL != page->getLinkAtPosition (x, y));
-        }
-    }
-    return FALSE;
+    return (NULL != getCurrentPageLink (x, y));
 }
 
 ///
@@ -1614,14 +2765,171 @@ IDocument::hasLinkAtPosition (gint x, gint y)
 void
 IDocument::activateLinkAtPosition (gint x, gint y)
 {
-    DocumentPage *page = getCurrentPage ();
+    IDocumentLink *link = getCurrentPageLink (x, y);
+    if ( NULL != link )
+    {
+        link->activate (this);
+    }
+}
+
+///
+/// @brief Gets the current page's link under a given position.
+///
+/// Unlike getCurrentPage(), this doesn't apply nor clear the find
+/// selection, so it never touches the page's pixels and can be called
+/// on every mouse motion. The page's unscaled links are scaled to the
+/// current zoom level on the fly.
+///
+/// @param x The X coordinate of the position to check.
+/// @param y The Y coordinate of the position to check.
+///
+/// @return The link under the position or NULL if there is no link or
+///         the current page's links are not yet loaded.
+///
+IDocumentLink *
+IDocument::getCurrentPageLink (gint x, gint y)
+{
     // XXX For now only non rotated pages.
-    if ( NULL != page && 0 == getRotation () )
+    if ( 0 != getRotation () )
+    {
+        return NULL;
+    }
+
+    IDocumentLink *link = NULL;
+    G_LOCK (pageLinks);
+    if ( 0 < m_CurrentPage && (guint)m_CurrentPage <= m_PageLinks->len )
+    {
+        DocumentLinkIndex *links = (DocumentLinkIndex *)
+            g_ptr_array_index (m_PageLinks, m_CurrentPage - 1);
+        if ( NULL != links )
+        {
+            link = links->getLinkAtPosition (x, y, getZoom ());
+        }
+    }
+    G_UNLOCK (pageLinks);
+
+    return link;
+}
+
+///
+/// @brief Loads the links of a page.
+///
+/// The links are kept unscaled, so they are only loaded once per page
+/// and not each time the page is rendered at a different zoom level.
+/// If the page's links are already loaded, this does nothing.
+///
+/// This is called by JobRender after rendering the page, once the render
+/// lock is released.
+///
+/// @param pageNum The number of the page to load the links of.
+///
+void
+IDocument::loadPageLinks (gint pageNum)
+{
+    g_assert (0 < pageNum && "Tried to load the links of an invalid page.");
+
+    G_LOCK (pageLinks);
+    gboolean loaded = ( (guint)pageNum <= m_PageLinks->len &&
+                        NULL != g_ptr_array_index (m_PageLinks, pageNum - 1) );
+    G_UNLOCK (pageLinks);
+    if ( loaded )
+    {
+        return;
+    }
+
+    DocumentLinkIndex *links = new DocumentLinkIndex ();
+    getPageLinks (pageNum, links);
+
+    G_LOCK (pageLinks);
+    if ( (guint)pageNum > m_PageLinks->len )
+    {
+        g_ptr_array_set_size (m_PageLinks, pageNum);
+    }
+    if ( NULL == g_ptr_array_index (m_PageLinks, pageNum - 1) )
+    {
+        g_ptr_array_index (m_PageLinks, pageNum - 1) = links;
+        links = NULL;
+    }
+    G_UNLOCK (pageLinks);
+    // Someone else already loaded them.
+    delete links;
+
+    // Checked after the links are stored, so if setWatched() doesn't
+    // see them this sees the document as watched.
+    if ( isWatched () )
+    {
+        queuePageFingerprint (pageNum);
+    }
+}
+
+///
+/// @brief Deletes the links of all pages.
+///
+/// This must be done each time the document is loaded or reloaded.
+///
+/// @param onlyChanged TRUE to keep the links of the pages that
+///                    isPageUnchanged() tells, FALSE to delete them all.
+///
+void
+IDocument::clearPageLinks (gboolean onlyChanged)
+{
+    G_LOCK (pageLinks);
+    for ( guint page = 0 ; page < m_PageLinks->len ; page++ )
     {
-        IDocumentLink *link = page->getLinkAtPosition (x, y);
-        if ( NULL != link )
+        if ( onlyChanged && isPageUnchanged (page + 1) )
         {
-            link->activate (this);
+            continue;
         }
+        delete (DocumentLinkIndex *)g_ptr_array_index (m_PageLinks, page);
+        g_ptr_array_index (m_PageLinks, page) = NULL;
     }
+    if ( !onlyChanged )
+    {
+        g_ptr_array_set_size (m_PageLinks, 0);
+    }
+    G_UNLOCK (pageLinks);
+}
+
+///
+/// @brief Scales a page's image.
+///
+/// The pixels are scaled as they are, so this works with any order of
+/// the color components as long as the alpha is last.
+///
+/// @param page The page to scale.
+/// @param width The width of the scaled page.
+/// @param height The height of the scaled page.
+///
+/// @return A new page with the scaled image. The returned page must be
+///         freed by calling delete.
+///
+DocumentPage *
+scalePage (DocumentPage *page, gint width, gint height)
+{
+    DocumentPage *scaledPage = new DocumentPage ();
+    scaledPage->newPage (width, height);
+
+    cairo_surface_t *source =
+        cairo_image_surface_create_for_data (page->getData (),
+                                             CAIRO_FORMAT_ARGB32,
+                                             page->getWidth (),
+                                             page->getHeight (),
+                                             page->getRowStride ());
+    cairo_surface_t *target =
+        cairo_image_surface_create_for_data (scaledPage->getData (),
+                                             CAIRO_FORMAT_ARGB32,
+                                             width, height,
+                                             scaledPage->getRowStride ());
+    cairo_t *context = cairo_create (target);
+    cairo_scale (context, (gdouble)width / page->getWidth (),
+                 (gdouble)height / page->getHeight ());
+    cairo_set_source_surface (context, source, 0, 0);
+    cairo_pattern_set_filter (cairo_get_source (context), CAIRO_FILTER_GOOD);
+    cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+    cairo_paint (context);
+    cairo_destroy (context);
+    cairo_surface_destroy (target);
+    cairo_surface_destroy (source);
+
+    return scaledPage;
 }
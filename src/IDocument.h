@@ -31,7 +31,11 @@ namespace ePDFView
     // Forward declarations.
     class DocumentIndex;
     class IDocumentObserver;
+    class CompressedPageCache;
+    class DiskCache;
     class DocumentPage; 
+    class JobSaveText;
+    class ThumbnailCache;
 
     ///
     /// @brief Defines the possible errors loading a document.
@@ -138,13 +142,14 @@ namespace ePDFView
             virtual ~IDocument (void);
 
             ///
-            /// @brief Makes a copy of the document.
+            /// @brief Makes a copy that can be read from its own thread.
             ///
-            /// This function must make a deep copy of the current document
-            /// and return the result.
+            /// The copy shares with the current document whatever can be
+            /// read from two threads at once, so making it is cheap, but
+            /// it never shares what can't.
             ///
             /// @return A new document class with the same content than the
-            ///         caller document.
+            ///         caller document, or NULL if it couldn't be made.
             ///
             virtual IDocument *copy (void) const = 0;
 
@@ -157,12 +162,24 @@ namespace ePDFView
             /// @param pageNum The number of the page to find the text in.
             /// @param textToFind The text to find in the page.
             ///
-            /// @return The list of positions on the page that the text
-            ///         was found. If the text is not found on the page,
-            ///         then it must result NULL.
+            /// @return An array of DocumentRectangle, stored by value, with
+            ///         the positions on the page that the text was found.
+            ///         If the text is not found on the page, then it must
+            ///         result NULL. The caller owns the array and must free
+            ///         it with g_array_free (results, TRUE).
             ///
-            virtual GList *findTextInPage (gint pageNum, 
-                                           const gchar *textToFind) = 0;
+            virtual GArray *findTextInPage (gint pageNum, 
+                                            const gchar *textToFind) = 0;
+
+            ///
+            /// @brief Gets the text of a single page.
+            ///
+            /// @param pageNum The number of the page to get its text.
+            ///
+            /// @return The page's text in reading order, or NULL if the
+            ///         page has no text. Must be freed with g_free().
+            ///
+            virtual gchar *getPageText (gint pageNum) = 0;
 
             ///
             /// @brief Checks if the document has been loaded.
@@ -193,6 +210,53 @@ namespace ePDFView
                                        const gchar *password,
                                        GError **error) = 0;
 
+            ///
+            /// @brief Reads the document's outline.
+            ///
+            /// This is called in background after the document is loaded,
+            /// once its first pages are queued to render.
+            ///
+            /// @return The new outline, that the caller owns, or NULL if
+            ///         the outline set when loading the document is
+            ///         already complete.
+            ///
+            virtual DocumentOutline *loadOutline (void) = 0;
+
+            ///
+            /// @brief Reads the size of all pages.
+            ///
+            /// This is called in background after the document is loaded,
+            /// once its first pages are queued to render. Until then,
+            /// getPageSizeForPage() must still work, even if slower.
+            ///
+            virtual void loadPageSizes (void) = 0;
+
+            ///
+            /// @brief Remembers what a page looks like.
+            ///
+            /// This is called in background for the pages whose links
+            /// were read while the document is watched. The document
+            /// can keep a fingerprint of the page, to find the pages that
+            /// didn't change when it's reloaded, and must do nothing if
+            /// it already has one.
+            ///
+            /// @param pageNum The number of the page.
+            ///
+            virtual void loadPageFingerprint (gint pageNum) = 0;
+
+            ///
+            /// @brief Gets the links of a page.
+            ///
+            /// The document must add all links of the page @a pageNum to
+            /// @a links, in unscaled page coordinates with the origin at
+            /// the page's top-left corner.
+            ///
+            /// @param pageNum The number of the page to get the links of.
+            /// @param links The index to add the page's links to.
+            ///
+            virtual void getPageLinks (gint pageNum,
+                                       DocumentLinkIndex *links) = 0;
+
             ///
             /// @brief Gets a document's page's unscaled size.
             ///
@@ -209,15 +273,16 @@ namespace ePDFView
             ///
             /// @brief Starts the output to PostScript.
             ///
-            /// This starts a new PostScript file with name @a fileName and
-            /// with @a numPages pages of @a width x @a height.
+            /// This starts a new PostScript output to the file descriptor
+            /// @a fd with @a numPages pages of @a width x @a height.
             ///
-            /// @param fileName The file name to output the postscript code.
+            /// @param fd The file descriptor to write the postscript code
+            ///           to. The document closes it at outputPostscriptEnd().
             /// @param numOfPages The number of pages to output.
             /// @param pageWidth The width of each page.
             /// @param pageHeight The height of each page.
             ///
-            virtual void outputPostscriptBegin (const gchar *fileName,
+            virtual void outputPostscriptBegin (gint fd,
                                                 guint numOfPages,
                                                 gfloat pageWidth,
                                                 gfloat pageHeight) = 0;
@@ -253,6 +318,35 @@ namespace ePDFView
             ///
             virtual DocumentPage *renderPage (gint pageNum) = 0;
 
+            ///
+            /// @brief Renders a document's page for printing.
+            ///
+            /// The page is drawn unscaled and unrotated, with its top left
+            /// corner at the origin of @a context, so the caller can place
+            /// it anywhere on a sheet by setting the context's transformation.
+            ///
+            /// @param pageNum The page number to render.
+            /// @param context The cairo context to draw the page to.
+            ///
+            virtual void renderPageForPrinting (gint pageNum,
+                                                cairo_t *context) = 0;
+
+            ///
+            /// @brief Renders a page's thumbnail.
+            ///
+            /// The thumbnail doesn't depend on the current rotation nor
+            /// scale. If the document has an embedded thumbnail for the
+            /// page, it should be used instead of rendering the page.
+            ///
+            /// @param pageNum The page number to render its thumbnail.
+            /// @param size The maximum width and height of the thumbnail.
+            ///
+            /// @return A DocumentPage with the thumbnail's image, that must
+            ///         be freed by calling delete, or NULL on error.
+            ///
+            virtual DocumentPage *renderThumbnail (gint pageNum,
+                                                   gint size) = 0;
+
             ///
             /// @brief Saves a document's copy to a file.
             ///
@@ -281,14 +375,27 @@ namespace ePDFView
             void notifyLoadError (const gchar *fileName, const GError *error);
             void notifyLoadPassword (const gchar *fileName, gboolean reload,
                                      const GError *error);
+            void notifyLowMemory (void);
+            void notifyOutlineIndexed (void);
+            void notifyOutlineLoaded (DocumentOutline *outline);
             void notifyPageChanged (void);
             void notifyPageRendered (gint pageNumber,
                                      guint32 age, DocumentPage *pageImage);
             void notifyPageRotated (void);
             void notifyPageZoomed (void);
+            void notifyPrint (void);
+            void notifyPrintError (const GError *error);
+            void notifyPrintProgress (guint numPagesPrinted,
+                                      guint numPagesToPrint);
             void notifyReload (void);
             void notifySave (void);
             void notifySaveError (const GError *error);
+            void notifySaveText (void);
+            void notifySaveTextError (const GError *error);
+            void notifySaveTextProgress (guint numPagesSaved,
+                                         guint numPagesToSave);
+            void notifyThumbnailRendered (gint pageNum,
+                                          DocumentPage *thumbnail);
 
             const gchar *getTitle (void);
             void setTitle (gchar *title);
@@ -329,12 +436,40 @@ namespace ePDFView
             DocumentPage *getEmptyPage (void);
             gint getCurrentPageNum (void);
             DocumentOutline *getOutline (void);
+            DocumentOutline *getOutlineSection (gint pageNum);
+            gboolean indexOutline (DocumentOutline *outline);
+            gdouble getTimeToFirstPage (void);
+            gdouble getCacheCompressionRatio (void);
+            gdouble getCacheDecodeTime (void);
+            gsize getCacheSize (void);
+            guint32 getMinRenderAge (void);
+            gsize getReleasableCacheSize (gboolean releasePages);
+            gsize releaseCache (gsize size, gboolean releasePages);
+            gsize releasePrefetchedPages (void);
+            gboolean isPageUnchanged (gint pageNum);
+            gboolean isWatched (void);
+            void setWatched (gboolean watched);
+
+            gboolean beginThumbnail (gint pageNum);
+            void cancelThumbnail (gint pageNum);
+            DocumentPage *getThumbnail (gint pageNum);
+            static gint getThumbnailSize (void);
+            DocumentPage *loadThumbnail (gint pageNum, gint size);
+            void requestThumbnail (gint pageNum);
+
+            static DiskCache *getDiskCache (void);
+            static void setDiskCache (DiskCache *cache);
+            void openDiskCache (void);
 
             void clearCache (void);
+            void loadPageLinks (gint pageNum);
 
             void load (const gchar *fileName, const gchar *password);
             void reload (void);
             void save (const gchar *fileName);
+            void saveText (const gchar *fileName);
+            void cancelSaveText (void);
+            void removeSaveTextJob (JobSaveText *job);
 
             void goToFirstPage (void);
             void goToLastPage (void);
@@ -365,20 +500,39 @@ namespace ePDFView
 
         protected:
             static GQuark errorQuark;
+            /// @brief The cache of rendered images kept between sessions,
+            /// or NULL to not keep them.
+            static DiskCache *m_DiskCache;
             
             IDocument (void);
             void addPageToCache (gint pageNum);
+            void cachePagePreview (DocumentPage *pageImage);
+            void clearThumbnails (void);
+            void clearPageLinks (gboolean onlyChanged);
             PageCache *getCachedPage (gint pageNum);
-            void refreshCache (void);
+            IDocumentLink *getCurrentPageLink (gint x, gint y);
+            gsize getRenderedPagesSize (gboolean withCurrent);
+            gboolean hasPageImage (gint pageNum);
+            void queueLoadJobs (void);
+            void queuePageFingerprint (gint pageNum);
+            void refreshCache (gboolean onlyChanged);
+            void setUnchangedPages (GArray *pages);
+            void stopJobs (void);
 
             /// The document's author.
             gchar *m_Author;
+            /// @brief The compressed images of the pages dropped from
+            /// m_PageCache.
+            CompressedPageCache *m_CompressedPages;
             /// The document's creation date and time.
             gchar *m_CreationDate;
             /// The document's software creator.
             gchar *m_Creator;
             /// The document's currently shown page.
             gint m_CurrentPage;
+            /// @brief The document's key in the disk cache, or NULL if
+            /// not cached.
+            gchar *m_DocumentKey;
             /// The currently selected result from a search.
             DocumentRectangle *m_FindRect;
             /// The page number where IDocument::m_FindRect belongs to.
@@ -395,35 +549,75 @@ namespace ePDFView
 #else
             gchar *m_Linearized;
 #endif
+            /// @brief The age that the render jobs must have to run.
+            /// Protected by the JobRender lock.
+            guint32 m_MinRenderAge;
             /// The document's modification date and time.
             gchar *m_ModifiedDate;
             /// @brief The list of classes that will receive notifications
             /// when the document changes.
             GList *m_Observers;
+            /// @brief The monotonic time when the document started to load,
+            /// or 0 if its first page has already been rendered.
+            gint64 m_LoadStartTime;
+            /// @brief The index of m_Outline built by indexOutline(), until
+            /// notifyOutlineIndexed() uses it.
+            DocumentOutlineIndex *m_NewOutlineIndex;
             /// The document's outline or index.
             DocumentOutline *m_Outline;
+            /// @brief The outline's items sorted by page, or NULL until
+            /// the outline is read.
+            DocumentOutlineIndex *m_OutlineIndex;
             /// The cache of already rendered document's pages.
             GList *m_PageCache;
             /// The age that will get the next page of the cache.
             gint m_PageCacheAge;
+            /// @brief The unscaled links of each page, as DocumentLinkIndex.
+            /// A page's entry is NULL until its links are loaded.
+            GPtrArray *m_PageLinks;
             /// The document's page layout.
             PageLayout m_PageLayout;
             /// The document's page mode.
             PageMode m_PageMode;
             /// The number of pages the document has.
             gint m_PageNumber;
+            /// @brief The first page's image read from the disk cache, or
+            /// NULL if not cached.
+            DocumentPage *m_PagePreview;
+            /// The rotation of the first page's image in the disk cache.
+            gint m_PreviewRotation;
+            /// @brief The zoom of the first page's image in the disk cache,
+            /// or 0 if not cached.
+            gdouble m_PreviewZoom;
             /// The last password used to open the document.
             gchar *m_Password;
             /// The document's software producer.
             gchar *m_Producer;
             /// The document's current rotation in degrees.
             gint m_Rotation;
+            /// @brief The job saving the document's text, or NULL.
+            /// Protected by the saveText lock.
+            JobSaveText *m_SaveTextJob;
             /// The document's current zoom or scale level.
             gdouble m_Scale;
             /// The document's subject.
             gchar *m_Subject;
+            /// @brief The milliseconds from the start of the load until
+            /// the first page was rendered, or negative if not known.
+            gdouble m_TimeToFirstPage;
+            /// The thumbnails already rendered.
+            ThumbnailCache *m_Thumbnails;
             /// The document's title.
             gchar *m_Title;
+            /// @brief The pages that the last reload found unchanged, or
+            /// NULL if the document wasn't reloaded.
+            GArray *m_UnchangedPages;
+            /// @brief Tells if the document's file is watched to reload it,
+            /// read with g_atomic_int_get().
+            volatile gint m_Watched;
+            /// @brief The state, as ThumbnailState, of the thumbnails
+            /// queued to render.
+            GHashTable *m_WantedThumbnails;
     };
 }
 
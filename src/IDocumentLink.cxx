@@ -46,19 +46,34 @@ IDocumentLink::~IDocumentLink ()
     delete m_Rect;
 }
 
+///
+/// @brief Gets the link's rectangle.
+///
+/// @return The rectangle the link covers. Owned by the link.
+///
+DocumentRectangle *
+IDocumentLink::getRectangle ()
+{
+    return m_Rect;
+}
+
 /// @brief Checks if a position is over the link.
 ///
-/// This function just check that the given position (x, y) is either
-/// inside the link's rectangle (i.e., is over the link) or not.
+/// This function just check that the pixel at position (x, y) of the
+/// page shown at @a scale is either over the link's rectangle or not.
 ///
-/// @param x The X coordinate of the position to check.
-/// @param y The Y coordinate of the position to check.
+/// @param x The X coordinate of the position to check, in pixels.
+/// @param y The Y coordinate of the position to check, in pixels.
+/// @param scale The scale the page is shown at.
 ///
 /// @return TRUE if the position is over the link. FALSE otherwise.
 ///
 gboolean
-IDocumentLink::positionIsOver (gint x, gint y)
+IDocumentLink::positionIsOver (gint x, gint y, gdouble scale)
 {
-    return ( (gint)m_Rect->getX1 () <= x && (gint)m_Rect->getY1 () <= y &&
-             (gint)m_Rect->getX2 () >= x && (gint)m_Rect->getY2 () >= y );
+    // The pixel covers from (x, y) up to, but not including, (x+1, y+1).
+    return ( m_Rect->getX1 () * scale < x + 1 &&
+             m_Rect->getY1 () * scale < y + 1 &&
+             m_Rect->getX2 () * scale >= x &&
+             m_Rect->getY2 () * scale >= y );
 }
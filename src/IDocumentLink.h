@@ -32,8 +32,9 @@ namespace ePDFView
     /// @class IDocumentLink
     /// @brief A single link on a page.
     ///
-    /// This class is used by ePDFView::DocumentPage to maintain a list
-    /// of all links that a single page have.
+    /// This class is used by ePDFView::DocumentLinkIndex to maintain a list
+    /// of all links that a single page have. The link's rectangle is in
+    /// unscaled page coordinates, with the origin at the top-left corner.
     ///
     class IDocumentLink
     {
@@ -42,7 +43,8 @@ namespace ePDFView
             virtual ~IDocumentLink (void);
 
             virtual void activate (IDocument *document) = 0;
-            gboolean positionIsOver (gint x, gint y);
+            DocumentRectangle *getRectangle (void);
+            gboolean positionIsOver (gint x, gint y, gdouble scale);
 
         protected:
             /// The link rectangle.
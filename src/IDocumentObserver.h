@@ -100,6 +100,37 @@ namespace ePDFView
                                              gboolean,
                                              const GError *) { }
 
+            ///
+            /// @brief The system is running out of memory.
+            ///
+            /// This function is called by MemoryGovernor when the system
+            /// is critically low on memory, after the documents' caches
+            /// have been released. The observers should free what they
+            /// can build again, like scaled copies of the page.
+            ///
+            virtual void notifyLowMemory (void) { }
+
+            ///
+            /// @brief The document's outline has been read.
+            ///
+            /// This function is called after the document has been
+            /// loaded or reloaded, when its outline has been read in
+            /// background. The previous outline is deleted after this
+            /// call.
+            ///
+            /// @param outline The document's new outline.
+            ///
+            virtual void notifyOutlineLoaded (DocumentOutline *) { }
+
+            ///
+            /// @brief The document's outline has been indexed by page.
+            ///
+            /// This function is called after the outline has been read,
+            /// once its items have been indexed in background. Until then
+            /// IDocument::getOutlineSection() finds no section.
+            ///
+            virtual void notifyOutlineIndexed (void) { }
+
             ///
             /// @brief The current page has been changed.
             ///
@@ -130,6 +161,29 @@ namespace ePDFView
             ///
             virtual void notifyPageZoomed (gdouble) { }
 
+            ///
+            /// @brief The document has been sent to the printer.
+            ///
+            /// This function is called when all pages to print have been
+            /// streamed to the printer and it accepted the job.
+            ///
+            virtual void notifyPrint (void) { }
+
+            ///
+            /// @brief The document couldn't be printed due an error.
+            ///
+            /// @param error The error code and message.
+            ///
+            virtual void notifyPrintError (const GError *) { }
+
+            ///
+            /// @brief A page to print has been sent to the printer.
+            ///
+            /// @param numPagesPrinted The number of pages already sent.
+            /// @param numPagesToPrint The number of pages to print.
+            ///
+            virtual void notifyPrintProgress (guint, guint) { }
+
             ///
             /// @brief The document has been reloaded.
             ///
@@ -157,6 +211,28 @@ namespace ePDFView
             ///
             virtual void notifySaveError (const GError *) { }
 
+            ///
+            /// @brief The document's text has been saved.
+            ///
+            virtual void notifySaveText (void) { }
+
+            ///
+            /// @brief The document's text couldn't be saved.
+            ///
+            /// A cancelled save is notified with G_IO_ERROR_CANCELLED.
+            ///
+            /// @param error The error code and message.
+            ///
+            virtual void notifySaveTextError (const GError *) { }
+
+            ///
+            /// @brief A page's text has been saved.
+            ///
+            /// @param numPagesSaved The number of pages already written.
+            /// @param numPagesToSave The number of pages to write.
+            ///
+            virtual void notifySaveTextProgress (guint, guint) { }
+
             ///
             /// @brief Someone select text in document.
             ///
@@ -167,6 +243,18 @@ namespace ePDFView
             ///
             virtual void notifyTextSelected (const gchar*) { }
 
+            ///
+            /// @brief A page's thumbnail has been rendered.
+            ///
+            /// This function is called when a thumbnail requested by
+            /// IDocument::requestThumbnail() is ready.
+            ///
+            /// @param pageNum The number of the thumbnail's page.
+            /// @param thumbnail The thumbnail's image. It's owned by the
+            ///                  document and must be copied to keep it.
+            ///
+            virtual void notifyThumbnailRendered (gint, DocumentPage *) { }
+
         protected:
             ///
             /// @brief Constructs a new IDocumentObserver object.
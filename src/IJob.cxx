@@ -26,8 +26,35 @@
 
 using namespace ePDFView;
 
+/// The order of the last dispatched job of each priority.
+guint64 IJob::m_DispatchedOrder[2] = { 0, 0 };
 /// The queue of jobs to run in background.
 GAsyncQueue *IJob::m_JobsQueue = NULL;
+/// The jobs that have an owner and weren't deleted yet.
+GHashTable *IJob::m_OwnedJobs = NULL;
+/// Protects the owned jobs and the running owner.
+GMutex IJob::m_OwnedJobsLock;
+/// The number that the next queued job will get.
+guint64 IJob::m_NextSequence = 0;
+/// The order of the last job queued by each owner.
+GHashTable *IJob::m_Owners = NULL;
+/// The owner of the job being run.
+gconstpointer IJob::m_RunningOwner = NULL;
+/// Signaled each time a job finishes running.
+GCond IJob::m_RunningOwnerDone;
+
+///
+/// @brief Destroys all dynamically allocated memory for IJob.
+///
+IJob::~IJob ()
+{
+    if ( NULL != m_Owner && NULL != m_OwnedJobs )
+    {
+        g_mutex_lock (&m_OwnedJobsLock);
+        g_hash_table_remove (m_OwnedJobs, this);
+        g_mutex_unlock (&m_OwnedJobsLock);
+    }
+}
 
 ///
 /// @brief Clears the list of jobs.
@@ -60,11 +87,23 @@ IJob::dispatcher (gpointer data)
 {
     while (true)
     {
-        IJob *job = (IJob *)g_async_queue_pop (m_JobsQueue);
+        g_async_queue_lock (m_JobsQueue);
+        IJob *job = (IJob *)g_async_queue_pop_unlocked (m_JobsQueue);
+        m_DispatchedOrder[job->m_LowPriority ? 1 : 0] = job->m_Order;
+        // Set before unlocking the queue, so removeOwner() either finds
+        // the job queued or waits for it.
+        g_mutex_lock (&m_OwnedJobsLock);
+        m_RunningOwner = job->m_Owner;
+        g_mutex_unlock (&m_OwnedJobsLock);
+        g_async_queue_unlock (m_JobsQueue);
         if ( job->run () )
         {
             delete job;
         }
+        g_mutex_lock (&m_OwnedJobsLock);
+        m_RunningOwner = NULL;
+        g_cond_broadcast (&m_RunningOwnerDone);
+        g_mutex_unlock (&m_OwnedJobsLock);
     }
 #ifdef _WIN32
     _sleep(0);
@@ -86,6 +125,9 @@ IJob::init ()
     // GLib threads are always available in modern versions (>= 2.32)
     // No need to call g_thread_init() or check g_thread_supported()
     m_JobsQueue = g_async_queue_new ();
+    m_Owners = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+                                      g_free);
+    m_OwnedJobs = g_hash_table_new (g_direct_hash, g_direct_equal);
     GError *error = NULL;
     if ( NULL == g_thread_create (IJob::dispatcher, NULL, FALSE, &error) )
     {
@@ -106,5 +148,203 @@ IJob::enqueue (IJob *job)
 {
     g_assert ( NULL != job && "Tried to queue a NULL job.");
 
-    g_async_queue_push (m_JobsQueue, (gpointer)job);
+    job->m_LowPriority = FALSE;
+    push (job);
+}
+
+///
+/// @brief Adds a new job to the queue that runs only when idle.
+///
+/// The job is dispatched after all jobs added with enqueue(), even the
+/// ones added after it. This is meant for jobs that the user doesn't
+/// wait for, like thumbnails, so they never delay a page's render.
+///
+/// @param job The job to add to the queue.
+///
+void
+IJob::enqueueLowPriority (IJob *job)
+{
+    g_assert ( NULL != job && "Tried to queue a NULL job.");
+
+    job->m_LowPriority = TRUE;
+    push (job);
+}
+
+///
+/// @brief Stops the jobs of an owner and forgets it.
+///
+/// The owner's queued jobs are deleted without running, the job being
+/// run for it, if any, is waited for, and the jobs that already ran
+/// but didn't notify yet, or that run on their own threads, are
+/// detached from the document with detachDocument().
+///
+/// This must be called from the main thread, before the owner is
+/// deleted, so no job uses it afterwards and another owner created at
+/// the same address doesn't wait for the jobs it had queued.
+///
+/// @param owner The owner to forget.
+///
+void
+IJob::removeOwner (gconstpointer owner)
+{
+    if ( NULL == m_JobsQueue || NULL == owner )
+    {
+        return;
+    }
+
+    // The queue is sorted, so the jobs kept are pushed back in the order
+    // they are popped.
+    GList *removedJobs = NULL;
+    GList *keptJobs = NULL;
+    g_async_queue_lock (m_JobsQueue);
+    IJob *job = NULL;
+    while ( NULL !=
+            (job = (IJob *)g_async_queue_try_pop_unlocked (m_JobsQueue)) )
+    {
+        if ( owner == job->m_Owner )
+        {
+            removedJobs = g_list_prepend (removedJobs, job);
+        }
+        else
+        {
+            keptJobs = g_list_prepend (keptJobs, job);
+        }
+    }
+    keptJobs = g_list_reverse (keptJobs);
+    for ( GList *item = g_list_first (keptJobs) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        g_async_queue_push_unlocked (m_JobsQueue, item->data);
+    }
+    g_list_free (keptJobs);
+    g_hash_table_remove (m_Owners, owner);
+    g_async_queue_unlock (m_JobsQueue);
+
+    for ( GList *item = g_list_first (removedJobs) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        delete (IJob *)item->data;
+    }
+    g_list_free (removedJobs);
+
+    g_mutex_lock (&m_OwnedJobsLock);
+    while ( owner == m_RunningOwner )
+    {
+        g_cond_wait (&m_RunningOwnerDone, &m_OwnedJobsLock);
+    }
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init (&iter, m_OwnedJobs);
+    while ( g_hash_table_iter_next (&iter, &key, NULL) )
+    {
+        IJob *ownedJob = (IJob *)key;
+        if ( owner == ownedJob->m_Owner )
+        {
+            ownedJob->detachDocument ();
+            ownedJob->m_Owner = NULL;
+            g_hash_table_iter_remove (&iter);
+        }
+    }
+    g_mutex_unlock (&m_OwnedJobsLock);
+}
+
+///
+/// @brief Stops the job from using its document.
+///
+/// Called by removeOwner() for the jobs that outlive their turn in
+/// the queue. Afterwards the job must not use the document, but must
+/// still free itself as it would otherwise.
+///
+void
+IJob::detachDocument ()
+{
+}
+
+///
+/// @brief Sets who queued the job.
+///
+/// The jobs of each owner are dispatched in the order they were
+/// queued, but taking turns with the jobs of the other owners.
+///
+/// @param owner The document that queues the job, or NULL if it
+///              belongs to none.
+///
+void
+IJob::setOwner (gconstpointer owner)
+{
+    if ( NULL == m_OwnedJobs )
+    {
+        m_Owner = owner;
+        return;
+    }
+
+    g_mutex_lock (&m_OwnedJobsLock);
+    if ( NULL != m_Owner )
+    {
+        g_hash_table_remove (m_OwnedJobs, this);
+    }
+    m_Owner = owner;
+    if ( NULL != m_Owner )
+    {
+        g_hash_table_add (m_OwnedJobs, this);
+    }
+    g_mutex_unlock (&m_OwnedJobsLock);
+}
+
+///
+/// @brief Compares the order in which two jobs must be dispatched.
+///
+/// @param a The first job to compare.
+/// @param b The second job to compare.
+/// @param data Unused.
+///
+/// @return A negative value if @a a must be dispatched before @a b, a
+///         positive value otherwise.
+///
+gint
+IJob::compare (gconstpointer a, gconstpointer b, gpointer data)
+{
+    const IJob *jobA = (const IJob *)a;
+    const IJob *jobB = (const IJob *)b;
+    if ( jobA->m_LowPriority != jobB->m_LowPriority )
+    {
+        return jobA->m_LowPriority ? 1 : -1;
+    }
+    if ( jobA->m_Order != jobB->m_Order )
+    {
+        return jobA->m_Order < jobB->m_Order ? -1 : 1;
+    }
+    return jobA->m_Sequence < jobB->m_Sequence ? -1 : 1;
+}
+
+///
+/// @brief Adds a job to the queue, keeping the queue sorted.
+///
+/// The job's order is one more than the last job queued by its owner,
+/// but never less than one more than the last dispatched job. This way
+/// a document that queues many pages can't keep the jobs of the other
+/// documents waiting: each owner gets a job dispatched in turn, while
+/// the jobs of a single owner keep the order they were queued in.
+///
+/// @param job The job to add to the queue.
+///
+void
+IJob::push (IJob *job)
+{
+    gint priority = job->m_LowPriority ? 1 : 0;
+    g_async_queue_lock (m_JobsQueue);
+    guint64 *ownerOrder =
+        (guint64 *)g_hash_table_lookup (m_Owners, job->m_Owner);
+    if ( NULL == ownerOrder )
+    {
+        ownerOrder = g_new0 (guint64, 2);
+        g_hash_table_insert (m_Owners, (gpointer)job->m_Owner, ownerOrder);
+    }
+    guint64 order = MAX (ownerOrder[priority], m_DispatchedOrder[priority]);
+    job->m_Order = order + 1;
+    ownerOrder[priority] = job->m_Order;
+    job->m_Sequence = m_NextSequence++;
+    g_async_queue_push_sorted_unlocked (m_JobsQueue, (gpointer)job,
+                                        IJob::compare, NULL);
+    g_async_queue_unlock (m_JobsQueue);
 }
@@ -44,13 +44,17 @@ namespace ePDFView
     class IJob
     {
         public:
-            /// @brief Destroys all dynamically allocated memory for IJob.
-            virtual ~IJob (void) { }
+            virtual ~IJob (void);
 
             static void clearQueue (void);
             static gpointer dispatcher (gpointer data); 
             static void init (void);
             static void enqueue (IJob *job);
+            static void enqueueLowPriority (IJob *job);
+            static void removeOwner (gconstpointer owner);
+
+            virtual void detachDocument (void);
+            void setOwner (gconstpointer owner);
             
             ///
             /// @brief Runs the job.
@@ -65,10 +69,46 @@ namespace ePDFView
             virtual gboolean run (void) = 0;
             
         protected:
+            /// @brief The order of the last dispatched job of each
+            /// priority, normal first.
+            static guint64 m_DispatchedOrder[2];
+            /// @brief The jobs that have an owner and weren't deleted
+            /// yet, as a set.
+            static GHashTable *m_OwnedJobs;
+            /// Protects m_OwnedJobs and m_RunningOwner.
+            static GMutex m_OwnedJobsLock;
             static GAsyncQueue *m_JobsQueue;
+            /// The number that the next queued job will get.
+            static guint64 m_NextSequence;
+            /// @brief The order of the last job queued by each owner, as
+            /// two guint64, normal priority first.
+            static GHashTable *m_Owners;
+            /// The owner of the job being run, or NULL.
+            static gconstpointer m_RunningOwner;
+            /// Signaled each time a job finishes running.
+            static GCond m_RunningOwnerDone;
+            /// @brief Tells if the job only runs when no other job is
+            /// waiting.
+            gboolean m_LowPriority;
+            /// The order in which the job must be dispatched.
+            guint64 m_Order;
+            /// The document that queued the job, or NULL.
+            gconstpointer m_Owner;
+            /// The number of jobs queued before this one.
+            guint64 m_Sequence;
 
             /// @brief Creates a new IJob object.
-            IJob () { }
+            IJob ()
+            {
+                m_LowPriority = FALSE;
+                m_Order = 0;
+                m_Owner = NULL;
+                m_Sequence = 0;
+            }
+
+            static gint compare (gconstpointer a, gconstpointer b,
+                                 gpointer data);
+            static void push (IJob *job);
     };
 }
 
@@ -160,6 +160,23 @@ namespace ePDFView
             virtual gchar *saveFileDialog (const gchar *lastFolder,
                                            const gchar *fileName) = 0;
 
+            ///
+            /// @brief Shows the dialog to save the document's text.
+            ///
+            /// The view must show a dialog to let the user choose the
+            /// plain text file where to save the text of all pages.
+            ///
+            /// @param lastFolder The last folder used to save a file.
+            /// @param fileName The file name to set as the initial name to
+            ///                 the save dialog.
+            ///
+            /// @return A copy of the file name to save the text to or NULL
+            ///         if the user cancelled the operation. This string will
+            ///         be freed by the presenter.
+            ///
+            virtual gchar *saveTextFileDialog (const gchar *lastFolder,
+                                               const gchar *fileName) = 0;
+
             ///
             /// @brief Changes the sensitivity of the "Find" action.
             ///
@@ -318,6 +335,15 @@ namespace ePDFView
             ///
             virtual void sensitiveSave (gboolean sensitive) = 0;
 
+            ///
+            /// @brief Changes the sensitivity of the "Save Text" action.
+            ///
+            /// @param sensitive Set to TRUE if need to make sensitive (enable)
+            ///                  the action or FALSE to insensitive (disable)
+            ///                  it.
+            ///
+            virtual void sensitiveSaveText (gboolean sensitive) = 0;
+
             ///
             /// @brief Changes the sensitivity of the "Zoom" entry.
             ///
@@ -645,6 +671,60 @@ namespace ePDFView
             ///
             virtual void setOutline (DocumentOutline *outline) = 0;
 
+            ///
+            /// @brief Highlights the outline item of the current section.
+            ///
+            /// The view must select the item in the outline set by
+            /// setOutline(), expanding its parents if needed, but it must
+            /// not call MainPter::outlineActivated() for it.
+            ///
+            /// @param outline The outline item to select, or NULL to
+            ///                clear the selection.
+            ///
+            virtual void selectOutline (DocumentOutline *outline) = 0;
+
+            ///
+            /// @brief Sets the number of pages to show thumbnails of.
+            ///
+            /// The view must show a placeholder for each page in the
+            /// sidebar's thumbnails pane. When a placeholder becomes
+            /// visible it must call MainPter::thumbnailShown() and, once
+            /// scrolled out, MainPter::thumbnailHidden(). When the user
+            /// clicks on a thumbnail, it must call
+            /// MainPter::thumbnailActivated().
+            ///
+            /// @param numPages The number of pages, or 0 to remove all
+            ///                 thumbnails.
+            ///
+            virtual void setThumbnails (gint numPages) = 0;
+
+            ///
+            /// @brief Shows a page's rendered thumbnail.
+            ///
+            /// @param pageNum The number of the thumbnail's page.
+            /// @param thumbnail The thumbnail's image. The view must copy
+            ///                  it, because it's not owned by the view.
+            ///
+            virtual void showThumbnail (gint pageNum,
+                                        DocumentPage *thumbnail) = 0;
+
+            ///
+            /// @brief Highlights the current page's thumbnail.
+            ///
+            /// The view must not call MainPter::thumbnailActivated() for it.
+            ///
+            /// @param pageNum The number of the page to select.
+            ///
+            virtual void selectThumbnail (gint pageNum) = 0;
+
+            ///
+            /// @brief Switches the sidebar to the thumbnails or the outline.
+            ///
+            /// @param show TRUE to show the thumbnails pane, FALSE to show
+            ///             the outline pane.
+            ///
+            virtual void showThumbnails (gboolean show) = 0;
+
             virtual void copyTextToClibboard(const gchar* text) = 0;
             virtual void activePageModeScroll (gboolean active) = 0;
             virtual void activePageModeText (gboolean active) = 0;
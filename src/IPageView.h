@@ -186,6 +186,29 @@ namespace ePDFView
             ///
             virtual void showPage (DocumentPage *page, PageScroll scroll) = 0;
             virtual void tryReShowPage () = 0;
+
+            ///
+            /// @brief Frees the memory that the view can do without.
+            ///
+            /// The presenter calls this when the system is low on memory.
+            /// The view must keep the shown page, but can delete any
+            /// image that it can build again from it.
+            ///
+            virtual void releaseMemory (void) { }
+
+            ///
+            /// @brief Updates part of the shown page.
+            ///
+            /// The presenter calls this when only some pixels of the
+            /// page that is already shown changed, like when a text
+            /// selection grows. The view must copy just the pixels
+            /// inside @a area from @a page instead of the whole image.
+            ///
+            /// @param page The document's page with the changed pixels.
+            /// @param area The area of @a page that changed, in pixels.
+            ///
+            virtual void updatePageArea (DocumentPage *page,
+                                         cairo_region_t *area) = 0;
             
             virtual void setInvertColorToggle (char on) = 0; // krogan
 
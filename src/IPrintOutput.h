@@ -0,0 +1,98 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__IPRINT_OUTPUT_H__)
+#define __IPRINT_OUTPUT_H__
+
+#include <cups/cups.h>
+
+namespace ePDFView
+{
+    ///
+    /// @class IPrintOutput
+    /// @brief Interface for the destinations of a print job's stream.
+    ///
+    /// JobPrint writes the PostScript of the pages to print to an output
+    /// while they are still generated. All functions are called from
+    /// the same thread, that is neither the main nor the jobs' thread.
+    ///
+    class IPrintOutput
+    {
+        public:
+            ///
+            /// @brief Destroys all dynamically allocated memory for
+            ///        IPrintOutput.
+            ///
+            virtual ~IPrintOutput (void) { }
+
+            ///
+            /// @brief Starts a new print job.
+            ///
+            /// @param printerName The name of the printer to print to.
+            /// @param title The print job's title.
+            /// @param numOptions The number of options in @a options.
+            /// @param options The print job's options.
+            /// @param error Location to store the error occurring or NULL
+            ///              to ignore errors.
+            ///
+            /// @return TRUE if the job could be started, FALSE otherwise.
+            ///
+            virtual gboolean begin (const gchar *printerName,
+                                    const gchar *title, gint numOptions,
+                                    cups_option_t *options,
+                                    GError **error) = 0;
+
+            ///
+            /// @brief Cancels the print job started with begin().
+            ///
+            virtual void cancel (void) = 0;
+
+            ///
+            /// @brief Ends the print job's stream.
+            ///
+            /// @param error Location to store the error occurring or NULL
+            ///              to ignore errors.
+            ///
+            /// @return TRUE if the printer accepted the job, FALSE otherwise.
+            ///
+            virtual gboolean finish (GError **error) = 0;
+
+            ///
+            /// @brief Writes the next part of the print job's stream.
+            ///
+            /// @param data The data to write.
+            /// @param length The bytes of @a data.
+            /// @param error Location to store the error occurring or NULL
+            ///              to ignore errors.
+            ///
+            /// @return TRUE if all @a data could be written, FALSE
+            ///         otherwise.
+            ///
+            virtual gboolean write (const gchar *data, gsize length,
+                                    GError **error) = 0;
+
+        protected:
+            /// @brief Creates a new IPrintOutput object.
+            IPrintOutput (void) { }
+    };
+}
+
+#endif // !__IPRINT_OUTPUT_H__
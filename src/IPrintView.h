@@ -282,6 +282,22 @@ namespace ePDFView
             ///
             virtual void sensitivePrintButton (gboolean sensitive) = 0;
 
+            ///
+            /// @brief Changes a printer's state in the list of printers.
+            ///
+            /// The printers are added before their state is known, and
+            /// the presenter calls this function when it arrives.
+            ///
+            /// @param printerIndex The index of the printer to change.
+            /// @param jobs The number of jobs the printer currently has
+            ///             active.
+            /// @param state The current printer's state.
+            /// @param location The printer's location.
+            ///
+            virtual void setPrinterAttributes (guint printerIndex, gint jobs,
+                                               const gchar *state,
+                                               const gchar *location) = 0;
+
 
         protected:
             /// The presenter that controls the view.
@@ -0,0 +1,99 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__IPRINTER_SOURCE_H__)
+#define __IPRINTER_SOURCE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class PrinterOptions;
+
+    ///
+    /// @class IPrinterSource
+    /// @brief Interface for the system's printers.
+    ///
+    /// The print dialog doesn't ask the printing system directly, but
+    /// through a source. The queries can take long, so they are only
+    /// called from the jobs' thread, and the results are kept by
+    /// PrinterCache.
+    ///
+    class IPrinterSource
+    {
+        public:
+            ///
+            /// @brief Destroys all dynamically allocated memory for
+            ///        IPrinterSource.
+            ///
+            virtual ~IPrinterSource (void) { }
+
+            ///
+            /// @brief Gets a printer's current state.
+            ///
+            /// @param printerName The printer's name, with its instance
+            ///                    after a slash, if it has any.
+            /// @param numJobs The output location to save the number of
+            ///                jobs the printer currently has.
+            /// @param state The output location to save the printer's
+            ///              translated state to, or NULL if unknown. It
+            ///              must be freed with g_free().
+            /// @param location The output location to save the printer's
+            ///                 location to, or NULL if unknown. It must
+            ///                 be freed with g_free().
+            ///
+            virtual void getPrinterAttributes (const gchar *printerName,
+                                               gint *numJobs, gchar **state,
+                                               gchar **location) = 0;
+
+            ///
+            /// @brief Gets the choices of a printer's options.
+            ///
+            /// @param printerName The printer's name, with its instance
+            ///                    after a slash, if it has any.
+            ///
+            /// @return The printer's options, that must be deleted when
+            ///         no longer needed, or NULL if the printer doesn't
+            ///         tell.
+            ///
+            virtual PrinterOptions *getPrinterOptions (
+                    const gchar *printerName) = 0;
+
+            ///
+            /// @brief Gets the available printers.
+            ///
+            /// @param defaultPrinter The output location to save the
+            ///                       index of the default printer to, or
+            ///                       -1 if there is no default printer.
+            ///
+            /// @return A NULL terminated array with the names of the
+            ///         printers, with their instance after a slash, if
+            ///         they have any. It must be freed with g_strfreev().
+            ///
+            virtual gchar **getPrinters (gint *defaultPrinter) = 0;
+
+        protected:
+            /// @brief Creates a new IPrinterSource object.
+            IPrinterSource (void) { }
+    };
+}
+
+#endif // !__IPRINTER_SOURCE_H__
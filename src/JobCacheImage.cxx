@@ -0,0 +1,106 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief Constructs a new JobCacheImage object.
+///
+JobCacheImage::JobCacheImage ():
+    IJob ()
+{
+    m_Cache = NULL;
+    m_DocumentKey = NULL;
+    m_Image = NULL;
+    m_Name = NULL;
+    m_Rotation = 0;
+    m_Zoom = 1.0;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobCacheImage.
+///
+JobCacheImage::~JobCacheImage ()
+{
+    g_free (m_DocumentKey);
+    delete m_Image;
+    g_free (m_Name);
+}
+
+///
+/// @brief Stores the image.
+///
+gboolean
+JobCacheImage::run ()
+{
+    g_assert (NULL != m_Cache && "The cache is NULL.");
+    g_assert (NULL != m_Image && "The image is NULL.");
+
+    m_Cache->store (m_DocumentKey, m_Name, m_Image, m_Zoom, m_Rotation);
+    return TRUE;
+}
+
+///
+/// @brief Sets the cache to store the image to.
+///
+/// @param cache The disk cache.
+///
+void
+JobCacheImage::setCache (DiskCache *cache)
+{
+    g_assert (NULL != cache && "Tried to set a NULL cache.");
+
+    m_Cache = cache;
+}
+
+///
+/// @brief Sets the entry to store the image as.
+///
+/// @param documentKey The key of the image's document.
+/// @param name The entry's name.
+///
+void
+JobCacheImage::setEntry (const gchar *documentKey, const gchar *name)
+{
+    g_free (m_DocumentKey);
+    m_DocumentKey = g_strdup (documentKey);
+    g_free (m_Name);
+    m_Name = g_strdup (name);
+}
+
+///
+/// @brief Sets the image to store.
+///
+/// @param image The image to store. The job takes its ownership.
+/// @param zoom The zoom the image was rendered with.
+/// @param rotation The rotation the image was rendered with.
+///
+void
+JobCacheImage::setImage (DocumentPage *image, gdouble zoom, gint rotation)
+{
+    delete m_Image;
+    m_Image = image;
+    m_Zoom = zoom;
+    m_Rotation = rotation;
+}
@@ -0,0 +1,68 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_CACHE_IMAGE_H__)
+#define __JOB_CACHE_IMAGE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DiskCache;
+    class DocumentPage;
+
+    ///
+    /// @class JobCacheImage
+    /// @brief A background job that stores an image in the disk cache.
+    ///
+    /// Compressing and writing an image takes longer than the user
+    /// should wait, so the job is queued with low priority.
+    ///
+    class JobCacheImage: public IJob
+    {
+        public:
+            JobCacheImage (void);
+            ~JobCacheImage (void);
+
+            gboolean run (void);
+
+            void setCache (DiskCache *cache);
+            void setEntry (const gchar *documentKey, const gchar *name);
+            void setImage (DocumentPage *image, gdouble zoom,
+                           gint rotation);
+
+        protected:
+            /// The cache to store the image to.
+            DiskCache *m_Cache;
+            /// The key of the image's document.
+            gchar *m_DocumentKey;
+            /// The image to store.
+            DocumentPage *m_Image;
+            /// The entry's name.
+            gchar *m_Name;
+            /// The rotation the image was rendered with.
+            gint m_Rotation;
+            /// The zoom the image was rendered with.
+            gdouble m_Zoom;
+    };
+}
+
+#endif // !__JOB_CACHE_IMAGE_H__
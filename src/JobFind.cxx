@@ -129,6 +129,18 @@ JobFind::getDirection ()
     return m_Direction;
 }
 
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobFind::detachDocument ()
+{
+    m_Document = NULL;
+}
+
 ///
 /// @brief Gets the document to look for the text at.
 ///
@@ -154,9 +166,12 @@ JobFind::getFindPter ()
 ///
 /// @brief The search's last results.
 ///
-/// @return The list of results from a page.
+/// The job doesn't keep the array: once handed to the FindPter, the
+/// presenter owns it.
+///
+/// @return The array of DocumentRectangle results from a page.
 ///
-GList *
+GArray *
 JobFind::getResults ()
 {
     return m_Results;
@@ -229,8 +244,8 @@ JobFind::run ()
     if ( !canceled )
     {
         gint currentPage = getCurrentPage ();
-        GList *result = getDocument ()->findTextInPage (currentPage,
-                                                        getTextToFind ());
+        GArray *result = getDocument ()->findTextInPage (currentPage,
+                                                         getTextToFind ());
 
         if ( FIND_DIRECTION_FORWARDS == getDirection () )
         {
@@ -299,6 +314,7 @@ JobFind::setDocument (IDocument *document)
     g_assert (NULL != document && "Trying to set a NULL document.");
 
     m_Document = document;
+    setOwner (document);
 }
 
 ///
@@ -321,7 +337,7 @@ JobFind::setFindPter (FindPter *pter)
 /// @param results The results of the search of the text in @a pageNum.
 ///
 void
-JobFind::setResults (gint pageNum, GList *results)
+JobFind::setResults (gint pageNum, GArray *results)
 {
     g_assert (NULL != results && "Tried to set NULL results.");
 
@@ -363,6 +379,12 @@ job_find_end (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobFind *job = (JobFind *)data;
+    if ( NULL == job->getDocument () )
+    {
+        // Nobody is waiting for the results anymore.
+        delete job;
+        return FALSE;
+    }
     gboolean endOfSearch = job->getStartingPage () == job->getCurrentPage ();
     job->dequeue ();
     job->getFindPter ()->notifyFindFinished (endOfSearch);
@@ -383,6 +405,13 @@ job_find_results (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobFind *job = (JobFind *)data;    
+    if ( NULL == job->getDocument () )
+    {
+        // Nobody is waiting for the results anymore.
+        g_array_free (job->getResults (), TRUE);
+        delete job;
+        return FALSE;
+    }
     job->dequeue ();
     job->getFindPter ()->notifyFindResults (job->getResultsPage (),
                                             job->getResults (),
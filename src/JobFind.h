@@ -54,9 +54,10 @@ namespace ePDFView
             void enqueue (void);
             gint getCurrentPage (void);
             FindDirection getDirection (void);
+            void detachDocument (void);
             IDocument *getDocument (void);
             FindPter *getFindPter (void);
-            GList *getResults (void);
+            GArray *getResults (void);
             gint getResultsPage (void);
             gint getStartingPage (void);
             const gchar *getTextToFind (void);
@@ -67,7 +68,7 @@ namespace ePDFView
             void setDirection (FindDirection direction);
             void setDocument (IDocument *document);
             void setFindPter (FindPter *pter);
-            void setResults (gint pageNum, GList *results);
+            void setResults (gint pageNum, GArray *results);
             void setStartingPage (gint pageNum);
             void setTextToFind (const gchar *textToFind);
 
@@ -84,8 +85,8 @@ namespace ePDFView
             gboolean m_Enqueued;
             /// The presenter to tell when a change happens.
             FindPter *m_FindPter;
-            /// The search results of a page.
-            GList *m_Results;
+            /// The search results of a page, as an array of DocumentRectangle.
+            GArray *m_Results;
             /// The page number where m_Results belongs to.
             gint m_ResultsPage;
             /// The starting page of the search.
@@ -0,0 +1,113 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_EXTERN (JobRender);
+
+///
+/// @brief Constructs a new JobFingerprintPage object.
+///
+JobFingerprintPage::JobFingerprintPage ():
+    IJob ()
+{
+    m_Document = NULL;
+    m_PageNumber = 0;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobFingerprintPage.
+///
+JobFingerprintPage::~JobFingerprintPage ()
+{
+}
+
+///
+/// @brief Gets the document to read the page from.
+///
+/// @return The document or NULL if can't process more jobs (test only.)
+///
+IDocument *
+JobFingerprintPage::getDocument ()
+{
+    if ( JobRender::m_CanProcessJobs )
+    {
+        return m_Document;
+    }
+    return NULL;
+}
+
+///
+/// @brief Gets the number of the page to get the fingerprint of.
+///
+/// @return The page's number.
+///
+gint
+JobFingerprintPage::getPageNumber ()
+{
+    return m_PageNumber;
+}
+
+///
+/// @brief Computes the page's fingerprint.
+///
+/// The document keeps the fingerprint by itself, so there is nothing
+/// to notify when done.
+///
+gboolean
+JobFingerprintPage::run ()
+{
+    G_LOCK (JobRender);
+    IDocument *document = getDocument ();
+    G_UNLOCK (JobRender);
+    if ( NULL != document && document->isWatched () )
+    {
+        document->loadPageFingerprint (getPageNumber ());
+    }
+    return TRUE;
+}
+
+///
+/// @brief Sets the document to read the page from.
+///
+/// @param document The document to read the page from.
+///
+void
+JobFingerprintPage::setDocument (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+
+    m_Document = document;
+    setOwner (document);
+}
+
+///
+/// @brief Sets the page to get the fingerprint of.
+///
+/// @param pageNum The number of the page.
+///
+void
+JobFingerprintPage::setPageNumber (gint pageNum)
+{
+    m_PageNumber = pageNum;
+}
@@ -0,0 +1,58 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__JOB_FINGERPRINT_PAGE_H__)
+#define __JOB_FINGERPRINT_PAGE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocument;
+
+    ///
+    /// @class JobFingerprintPage
+    /// @brief A background job that remembers what a page looks like.
+    ///
+    /// The fingerprint lets a reload of a watched document keep the
+    /// cached data of the pages that didn't change. It's only queued
+    /// with low priority, so it never delays a page's render.
+    ///
+    class JobFingerprintPage: public IJob
+    {
+        public:
+            JobFingerprintPage (void);
+            ~JobFingerprintPage (void);
+
+            IDocument *getDocument (void);
+            gint getPageNumber (void);
+            gboolean run (void);
+            void setDocument (IDocument *document);
+            void setPageNumber (gint pageNum);
+
+        protected:
+            /// The document to read the page from.
+            IDocument *m_Document;
+            /// The number of the page to get the fingerprint of.
+            gint m_PageNumber;
+    };
+}
+
+#endif // !__JOB_FINGERPRINT_PAGE_H__
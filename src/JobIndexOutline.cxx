@@ -0,0 +1,138 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_EXTERN (JobRender);
+
+// Forward declarations.
+static gboolean job_index_outline_done (gpointer data);
+
+///
+/// @brief Constructs a new JobIndexOutline object.
+///
+JobIndexOutline::JobIndexOutline ():
+    IJob ()
+{
+    m_Document = NULL;
+    m_Outline = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobIndexOutline.
+///
+/// The outline belongs to the document, and the index too once built.
+///
+JobIndexOutline::~JobIndexOutline ()
+{
+}
+
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobIndexOutline::detachDocument ()
+{
+    m_Document = NULL;
+}
+
+///
+/// @brief Gets the document to index the outline of.
+///
+/// @return The document or NULL if can't process more jobs (test only.)
+///
+IDocument *
+JobIndexOutline::getDocument ()
+{
+    if ( JobRender::m_CanProcessJobs )
+    {
+        return m_Document;
+    }
+    return NULL;
+}
+
+///
+/// @brief Indexes the outline's items by page.
+///
+/// Nothing is done if the document read another outline meanwhile.
+///
+gboolean
+JobIndexOutline::run ()
+{
+    G_LOCK (JobRender);
+    IDocument *document = getDocument ();
+    G_UNLOCK (JobRender);
+    if ( NULL != document && document->indexOutline (m_Outline) )
+    {
+        JOB_NOTIFIER (job_index_outline_done, this);
+        return JOB_DELETE;
+    }
+    return TRUE;
+}
+
+///
+/// @brief Sets the document and the outline to index.
+///
+/// @param document The document to index the outline of.
+/// @param outline The document's outline when the job is queued.
+///
+void
+JobIndexOutline::setDocument (IDocument *document, DocumentOutline *outline)
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+    g_assert (NULL != outline && "Tried to set a NULL outline.");
+
+    m_Document = document;
+    m_Outline = outline;
+    setOwner (document);
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The outline has been indexed.
+///
+/// @param data This parameter holds the JobIndexOutline that finished.
+///
+gboolean
+job_index_outline_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    G_LOCK (JobRender);
+    JobIndexOutline *job = (JobIndexOutline *)data;
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyOutlineIndexed ();
+    }
+    G_UNLOCK (JobRender);
+    JOB_NOTIFIER_END();
+
+    return FALSE;
+}
@@ -0,0 +1,58 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__JOB_INDEX_OUTLINE_H__)
+#define __JOB_INDEX_OUTLINE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentOutline;
+    class IDocument;
+
+    ///
+    /// @class JobIndexOutline
+    /// @brief A background job that indexes a document's outline by page.
+    ///
+    /// Indexing reads all of the outline's levels, so it's done after the
+    /// outline's first level is shown and with a low priority, to not
+    /// delay rendering the pages.
+    ///
+    class JobIndexOutline: public IJob
+    {
+        public:
+            JobIndexOutline (void);
+            ~JobIndexOutline (void);
+
+            void detachDocument (void);
+            IDocument *getDocument (void);
+            gboolean run (void);
+            void setDocument (IDocument *document, DocumentOutline *outline);
+
+        protected:
+            /// The document to index the outline of.
+            IDocument *m_Document;
+            /// The outline to index, if it's still the document's.
+            DocumentOutline *m_Outline;
+    };
+}
+
+#endif // !__JOB_INDEX_OUTLINE_H__
@@ -57,17 +57,28 @@ JobLoad::~JobLoad ()
     g_free (m_Password);
 }
 
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobLoad::detachDocument ()
+{
+    m_Document = NULL;
+}
+
 ///
 /// @brief The document that's loading.
 ///
-/// @return The document that is loading.
+/// @return The document that is loading, or NULL
+///         if it was deleted.
 ///
-IDocument &
+IDocument *
 JobLoad::getDocument ()
 {
-    g_assert (NULL != m_Document && "The document is NULL.");
-
-    return *m_Document;
+    return m_Document;
 }
 
 ///
@@ -121,8 +132,9 @@ gboolean
 JobLoad::run ()
 {
     GError *error = NULL;
-    if ( getDocument ().loadFile (getFileName (), getPassword (), &error) )
+    if ( getDocument ()->loadFile (getFileName (), getPassword (), &error) )
     {
+        getDocument ()->openDiskCache ();
         if ( isReloading () )
         {
             JOB_NOTIFIER (job_reload_done, this);
@@ -159,6 +171,7 @@ JobLoad::setDocument (IDocument *document)
     g_assert ( NULL != document && "Tried to set a NULL document.");
     
     m_Document = document;
+    setOwner (document);
 }
 
 ///
@@ -226,7 +239,11 @@ job_load_done (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobLoad *job = (JobLoad *)data;
-    job->getDocument ().notifyLoad ();
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyLoad ();
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
@@ -246,8 +263,12 @@ job_load_error (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobLoad *job = (JobLoad *)data;
-    job->getDocument ().notifyLoadError (job->getFileName(),
-            job->getError ());
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyLoadError (job->getFileName(),
+                                   job->getError ());
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
@@ -270,9 +291,13 @@ job_load_password (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobLoad *job = (JobLoad *)data;
-    job->getDocument ().notifyLoadPassword (job->getFileName (),
-                                            job->isReloading (),
-                                            job->getError ());
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyLoadPassword (job->getFileName (),
+                                      job->isReloading (),
+                                      job->getError ());
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
@@ -289,7 +314,11 @@ job_reload_done (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobLoad *job = (JobLoad *)data;
-    job->getDocument ().notifyReload ();
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyReload ();
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
@@ -40,7 +40,8 @@ namespace ePDFView
             JobLoad (void);
             ~JobLoad (void);
 
-            IDocument &getDocument (void);
+            void detachDocument (void);
+            IDocument *getDocument (void);
             GError *getError (void);
             const gchar *getFileName (void);
             const gchar *getPassword (void);
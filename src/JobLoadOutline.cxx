@@ -0,0 +1,189 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_EXTERN (JobRender);
+
+// Forward declarations.
+static gboolean job_load_outline_done (gpointer data);
+
+///
+/// @brief Constructs a new JobLoadOutline object.
+///
+JobLoadOutline::JobLoadOutline ():
+    IJob ()
+{
+    m_Document = NULL;
+    m_Outline = NULL;
+    m_ReplacedOutline = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobLoadOutline.
+///
+/// If the document didn't take the outline, it's deleted as well.
+///
+JobLoadOutline::~JobLoadOutline ()
+{
+    delete m_Outline;
+}
+
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobLoadOutline::detachDocument ()
+{
+    m_Document = NULL;
+}
+
+///
+/// @brief Gets the document to read the outline of.
+///
+/// @return The document or NULL if can't process more jobs (test only.)
+///
+IDocument *
+JobLoadOutline::getDocument ()
+{
+    if ( JobRender::m_CanProcessJobs )
+    {
+        return m_Document;
+    }
+    return NULL;
+}
+
+///
+/// @brief Gets the outline read.
+///
+/// @return The document's outline.
+///
+DocumentOutline *
+JobLoadOutline::getOutline ()
+{
+    return m_Outline;
+}
+
+///
+/// @brief Gets the outline that the read outline replaces.
+///
+/// If by the time the outline is handed to the document it doesn't have
+/// this outline anymore, then another document has been loaded meanwhile
+/// and the outline read is no longer valid.
+///
+/// @return The document's outline when the job ran.
+///
+DocumentOutline *
+JobLoadOutline::getReplacedOutline ()
+{
+    return m_ReplacedOutline;
+}
+
+///
+/// @brief Reads the outline's first level.
+///
+/// The deeper levels are read when they are shown or indexed.
+///
+gboolean
+JobLoadOutline::run ()
+{
+    G_LOCK (JobRender);
+    IDocument *document = getDocument ();
+    G_UNLOCK (JobRender);
+    if ( NULL != document )
+    {
+        m_ReplacedOutline = document->getOutline ();
+        m_Outline = document->loadOutline ();
+        if ( NULL != m_Outline )
+        {
+            JOB_NOTIFIER (job_load_outline_done, this);
+            return JOB_DELETE;
+        }
+    }
+    return TRUE;
+}
+
+///
+/// @brief Sets the document to read the outline of.
+///
+/// @param document The document to read the outline of.
+///
+void
+JobLoadOutline::setDocument (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+
+    m_Document = document;
+    setOwner (document);
+}
+
+///
+/// @brief The document took the outline read.
+///
+/// After calling this function the job won't delete the outline.
+///
+void
+JobLoadOutline::takeOutline ()
+{
+    m_Outline = NULL;
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The outline has been read.
+///
+/// The document shows it right away, and its index by page is built
+/// afterwards by a low priority job.
+///
+/// @param data This parameter holds the JobLoadOutline that finished.
+///
+gboolean
+job_load_outline_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    G_LOCK (JobRender);
+    JobLoadOutline *job = (JobLoadOutline *)data;
+    IDocument *document = job->getDocument ();
+    if ( NULL != document &&
+         document->getOutline () == job->getReplacedOutline () )
+    {
+        DocumentOutline *outline = job->getOutline ();
+        document->notifyOutlineLoaded (outline);
+        job->takeOutline ();
+
+        JobIndexOutline *indexJob = new JobIndexOutline ();
+        indexJob->setDocument (document, outline);
+        IJob::enqueueLowPriority (indexJob);
+    }
+    G_UNLOCK (JobRender);
+    JOB_NOTIFIER_END();
+
+    return FALSE;
+}
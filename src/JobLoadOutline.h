@@ -0,0 +1,64 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__JOB_LOAD_OUTLINE_H__)
+#define __JOB_LOAD_OUTLINE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocument;
+
+    ///
+    /// @class JobLoadOutline
+    /// @brief A background job that reads a document's outline.
+    ///
+    /// Reading the outline of a large document takes longer than
+    /// rendering its first page, so it's read after the first pages are
+    /// queued to render. Only its first level is read and handed to the
+    /// document, so it's shown at once, and a JobIndexOutline is then
+    /// queued to index all of its levels by page.
+    ///
+    class JobLoadOutline: public IJob
+    {
+        public:
+            JobLoadOutline (void);
+            ~JobLoadOutline (void);
+
+            void detachDocument (void);
+            IDocument *getDocument (void);
+            DocumentOutline *getOutline (void);
+            DocumentOutline *getReplacedOutline (void);
+            gboolean run (void);
+            void setDocument (IDocument *document);
+            void takeOutline (void);
+
+        protected:
+            /// The document to read the outline of.
+            IDocument *m_Document;
+            /// The outline read, until the document takes it.
+            DocumentOutline *m_Outline;
+            /// The document's outline when the job ran.
+            DocumentOutline *m_ReplacedOutline;
+    };
+}
+
+#endif // !__JOB_LOAD_OUTLINE_H__
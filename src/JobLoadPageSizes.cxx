@@ -0,0 +1,90 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_EXTERN (JobRender);
+
+///
+/// @brief Constructs a new JobLoadPageSizes object.
+///
+JobLoadPageSizes::JobLoadPageSizes ():
+    IJob ()
+{
+    m_Document = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobLoadPageSizes.
+///
+JobLoadPageSizes::~JobLoadPageSizes ()
+{
+}
+
+///
+/// @brief Gets the document to read the page sizes of.
+///
+/// @return The document or NULL if can't process more jobs (test only.)
+///
+IDocument *
+JobLoadPageSizes::getDocument ()
+{
+    if ( JobRender::m_CanProcessJobs )
+    {
+        return m_Document;
+    }
+    return NULL;
+}
+
+///
+/// @brief Reads the page sizes.
+///
+/// The document keeps the sizes by itself, so there is nothing to
+/// notify when done.
+///
+gboolean
+JobLoadPageSizes::run ()
+{
+    G_LOCK (JobRender);
+    IDocument *document = getDocument ();
+    G_UNLOCK (JobRender);
+    if ( NULL != document )
+    {
+        document->loadPageSizes ();
+    }
+    return TRUE;
+}
+
+///
+/// @brief Sets the document to read the page sizes of.
+///
+/// @param document The document to read the page sizes of.
+///
+void
+JobLoadPageSizes::setDocument (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+
+    m_Document = document;
+    setOwner (document);
+}
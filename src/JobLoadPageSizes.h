@@ -0,0 +1,53 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__JOB_LOAD_PAGE_SIZES_H__)
+#define __JOB_LOAD_PAGE_SIZES_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IDocument;
+
+    ///
+    /// @class JobLoadPageSizes
+    /// @brief A background job that reads the size of every page.
+    ///
+    /// The sizes are read after the first pages are queued to render,
+    /// so opening a document doesn't wait for them.
+    ///
+    class JobLoadPageSizes: public IJob
+    {
+        public:
+            JobLoadPageSizes (void);
+            ~JobLoadPageSizes (void);
+
+            IDocument *getDocument (void);
+            gboolean run (void);
+            void setDocument (IDocument *document);
+
+        protected:
+            /// The document to read the page sizes of.
+            IDocument *m_Document;
+    };
+}
+
+#endif // !__JOB_LOAD_PAGE_SIZES_H__
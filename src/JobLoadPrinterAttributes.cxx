@@ -0,0 +1,166 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static gboolean job_load_printer_attributes_done (gpointer data);
+
+///
+/// @brief Constructs a new JobLoadPrinterAttributes object.
+///
+JobLoadPrinterAttributes::JobLoadPrinterAttributes ():
+    IJob ()
+{
+    m_Location = NULL;
+    m_NumJobs = 0;
+    m_PrinterName = NULL;
+    m_Source = NULL;
+    m_State = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by
+///        JobLoadPrinterAttributes.
+///
+JobLoadPrinterAttributes::~JobLoadPrinterAttributes ()
+{
+    g_free (m_Location);
+    g_free (m_PrinterName);
+    g_free (m_State);
+}
+
+///
+/// @brief Gets the number of jobs the printer has.
+///
+/// @return The number of jobs.
+///
+gint
+JobLoadPrinterAttributes::getNumJobs ()
+{
+    return m_NumJobs;
+}
+
+///
+/// @brief Gets the name of the printer to get its state.
+///
+/// @return The printer's name.
+///
+const gchar *
+JobLoadPrinterAttributes::getPrinterName ()
+{
+    return m_PrinterName;
+}
+
+///
+/// @brief Gets the printer's state.
+///
+gboolean
+JobLoadPrinterAttributes::run ()
+{
+    g_assert (NULL != m_Source && "The printers' source is NULL.");
+
+    m_Source->getPrinterAttributes (m_PrinterName, &m_NumJobs, &m_State,
+                                    &m_Location);
+    JOB_NOTIFIER (job_load_printer_attributes_done, this);
+
+    return JOB_DELETE;
+}
+
+///
+/// @brief Sets the name of the printer to get its state.
+///
+/// @param printerName The printer's name.
+///
+void
+JobLoadPrinterAttributes::setPrinterName (const gchar *printerName)
+{
+    g_free (m_PrinterName);
+    m_PrinterName = g_strdup (printerName);
+}
+
+///
+/// @brief Sets where to get the state from.
+///
+/// @param source The printers' source.
+///
+void
+JobLoadPrinterAttributes::setSource (IPrinterSource *source)
+{
+    g_assert (NULL != source && "Tried to set a NULL source.");
+
+    m_Source = source;
+}
+
+///
+/// @brief Takes the printer's location.
+///
+/// @return The location, that the caller must free, or NULL.
+///
+gchar *
+JobLoadPrinterAttributes::takeLocation ()
+{
+    gchar *location = m_Location;
+    m_Location = NULL;
+    return location;
+}
+
+///
+/// @brief Takes the printer's state.
+///
+/// @return The state, that the caller must free, or NULL.
+///
+gchar *
+JobLoadPrinterAttributes::takeState ()
+{
+    gchar *state = m_State;
+    m_State = NULL;
+    return state;
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The printer's state has been got.
+///
+/// @param data This parameter holds the JobLoadPrinterAttributes that
+///             finished.
+///
+gboolean
+job_load_printer_attributes_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobLoadPrinterAttributes *job = (JobLoadPrinterAttributes *)data;
+    gchar *state = job->takeState ();
+    PrinterCache::getCache ().setAttributes (job->getPrinterName (),
+                                             job->getNumJobs (), state,
+                                             job->takeLocation ());
+    JOB_NOTIFIER_END();
+
+    return FALSE;
+}
@@ -0,0 +1,65 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_LOAD_PRINTER_ATTRIBUTES_H__)
+#define __JOB_LOAD_PRINTER_ATTRIBUTES_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IPrinterSource;
+
+    ///
+    /// @class JobLoadPrinterAttributes
+    /// @brief A background job that gets a printer's state.
+    ///
+    /// The state is handed to the PrinterCache when done.
+    ///
+    class JobLoadPrinterAttributes: public IJob
+    {
+        public:
+            JobLoadPrinterAttributes (void);
+            ~JobLoadPrinterAttributes (void);
+
+            gint getNumJobs (void);
+            const gchar *getPrinterName (void);
+            gboolean run (void);
+            void setPrinterName (const gchar *printerName);
+            void setSource (IPrinterSource *source);
+            gchar *takeLocation (void);
+            gchar *takeState (void);
+
+        protected:
+            /// The printer's location, until the cache takes it.
+            gchar *m_Location;
+            /// The number of jobs the printer has.
+            gint m_NumJobs;
+            /// The name of the printer to get its state.
+            gchar *m_PrinterName;
+            /// Where to get the state from.
+            IPrinterSource *m_Source;
+            /// The printer's state, until the cache takes it.
+            gchar *m_State;
+    };
+}
+
+#endif // !__JOB_LOAD_PRINTER_ATTRIBUTES_H__
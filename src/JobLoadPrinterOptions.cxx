@@ -0,0 +1,136 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static gboolean job_load_printer_options_done (gpointer data);
+
+///
+/// @brief Constructs a new JobLoadPrinterOptions object.
+///
+JobLoadPrinterOptions::JobLoadPrinterOptions ():
+    IJob ()
+{
+    m_Options = NULL;
+    m_PrinterName = NULL;
+    m_Source = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by
+///        JobLoadPrinterOptions.
+///
+JobLoadPrinterOptions::~JobLoadPrinterOptions ()
+{
+    delete m_Options;
+    g_free (m_PrinterName);
+}
+
+///
+/// @brief Gets the name of the printer to read its options.
+///
+/// @return The printer's name.
+///
+const gchar *
+JobLoadPrinterOptions::getPrinterName ()
+{
+    return m_PrinterName;
+}
+
+///
+/// @brief Reads the printer's options.
+///
+gboolean
+JobLoadPrinterOptions::run ()
+{
+    g_assert (NULL != m_Source && "The printers' source is NULL.");
+
+    m_Options = m_Source->getPrinterOptions (m_PrinterName);
+    JOB_NOTIFIER (job_load_printer_options_done, this);
+
+    return JOB_DELETE;
+}
+
+///
+/// @brief Sets the name of the printer to read its options.
+///
+/// @param printerName The printer's name.
+///
+void
+JobLoadPrinterOptions::setPrinterName (const gchar *printerName)
+{
+    g_free (m_PrinterName);
+    m_PrinterName = g_strdup (printerName);
+}
+
+///
+/// @brief Sets where to read the options from.
+///
+/// @param source The printers' source.
+///
+void
+JobLoadPrinterOptions::setSource (IPrinterSource *source)
+{
+    g_assert (NULL != source && "Tried to set a NULL source.");
+
+    m_Source = source;
+}
+
+///
+/// @brief Takes the printer's options.
+///
+/// @return The options, that the caller must delete, or NULL.
+///
+PrinterOptions *
+JobLoadPrinterOptions::takeOptions ()
+{
+    PrinterOptions *options = m_Options;
+    m_Options = NULL;
+    return options;
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The printer's options have been read.
+///
+/// @param data This parameter holds the JobLoadPrinterOptions that
+///             finished.
+///
+gboolean
+job_load_printer_options_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobLoadPrinterOptions *job = (JobLoadPrinterOptions *)data;
+    PrinterCache::getCache ().setOptions (job->getPrinterName (),
+                                          job->takeOptions ());
+    JOB_NOTIFIER_END();
+
+    return FALSE;
+}
@@ -0,0 +1,60 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_LOAD_PRINTER_OPTIONS_H__)
+#define __JOB_LOAD_PRINTER_OPTIONS_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IPrinterSource;
+    class PrinterOptions;
+
+    ///
+    /// @class JobLoadPrinterOptions
+    /// @brief A background job that reads a printer's options.
+    ///
+    /// The options are handed to the PrinterCache when done.
+    ///
+    class JobLoadPrinterOptions: public IJob
+    {
+        public:
+            JobLoadPrinterOptions (void);
+            ~JobLoadPrinterOptions (void);
+
+            const gchar *getPrinterName (void);
+            gboolean run (void);
+            void setPrinterName (const gchar *printerName);
+            void setSource (IPrinterSource *source);
+            PrinterOptions *takeOptions (void);
+
+        protected:
+            /// The printer's options, until the cache takes them.
+            PrinterOptions *m_Options;
+            /// The name of the printer to read its options.
+            gchar *m_PrinterName;
+            /// Where to read the options from.
+            IPrinterSource *m_Source;
+    };
+}
+
+#endif // !__JOB_LOAD_PRINTER_OPTIONS_H__
@@ -0,0 +1,123 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static gboolean job_load_printers_done (gpointer data);
+
+///
+/// @brief Constructs a new JobLoadPrinters object.
+///
+JobLoadPrinters::JobLoadPrinters ():
+    IJob ()
+{
+    m_DefaultPrinter = -1;
+    m_Printers = NULL;
+    m_Source = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobLoadPrinters.
+///
+JobLoadPrinters::~JobLoadPrinters ()
+{
+    g_strfreev (m_Printers);
+}
+
+///
+/// @brief Gets the index of the default printer.
+///
+/// @return The default printer's index, or -1 if there is none.
+///
+gint
+JobLoadPrinters::getDefaultPrinter ()
+{
+    return m_DefaultPrinter;
+}
+
+///
+/// @brief Lists the printers.
+///
+gboolean
+JobLoadPrinters::run ()
+{
+    g_assert (NULL != m_Source && "The printers' source is NULL.");
+
+    m_Printers = m_Source->getPrinters (&m_DefaultPrinter);
+    JOB_NOTIFIER (job_load_printers_done, this);
+
+    return JOB_DELETE;
+}
+
+///
+/// @brief Sets where to get the printers from.
+///
+/// @param source The printers' source.
+///
+void
+JobLoadPrinters::setSource (IPrinterSource *source)
+{
+    g_assert (NULL != source && "Tried to set a NULL source.");
+
+    m_Source = source;
+}
+
+///
+/// @brief Takes the listed printers.
+///
+/// @return The printers' names, that the caller must free with
+///         g_strfreev().
+///
+gchar **
+JobLoadPrinters::takePrinters ()
+{
+    gchar **printers = m_Printers;
+    m_Printers = NULL;
+    return printers;
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The printers have been listed.
+///
+/// @param data This parameter holds the JobLoadPrinters that finished.
+///
+gboolean
+job_load_printers_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobLoadPrinters *job = (JobLoadPrinters *)data;
+    gint defaultPrinter = job->getDefaultPrinter ();
+    PrinterCache::getCache ().setPrinters (job->takePrinters (),
+                                           defaultPrinter);
+    JOB_NOTIFIER_END();
+
+    return FALSE;
+}
@@ -0,0 +1,58 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_LOAD_PRINTERS_H__)
+#define __JOB_LOAD_PRINTERS_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IPrinterSource;
+
+    ///
+    /// @class JobLoadPrinters
+    /// @brief A background job that lists the printers.
+    ///
+    /// The list is handed to the PrinterCache when done.
+    ///
+    class JobLoadPrinters: public IJob
+    {
+        public:
+            JobLoadPrinters (void);
+            ~JobLoadPrinters (void);
+
+            gint getDefaultPrinter (void);
+            gboolean run (void);
+            void setSource (IPrinterSource *source);
+            gchar **takePrinters (void);
+
+        protected:
+            /// The index of the default printer, or -1.
+            gint m_DefaultPrinter;
+            /// The printers' names, until the cache takes them.
+            gchar **m_Printers;
+            /// Where to get the printers from.
+            IPrinterSource *m_Source;
+    };
+}
+
+#endif // !__JOB_LOAD_PRINTERS_H__
@@ -21,14 +21,42 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <config.h>
+#include <errno.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <cairo-ps.h>
 #include <cups/cups.h>
 #include "epdfview.h"
 
 using namespace ePDFView;
 
 // Forward declaration.
+static gint getPrintOptions (JobPrint *job, cups_option_t **options);
 static gboolean job_print_end (gpointer data);
+static gpointer job_print_produce (gpointer data);
+static gboolean job_print_progress (gpointer data);
+static gpointer job_print_stream (gpointer data);
+static cairo_status_t job_print_write (void *closure,
+                                       const unsigned char *data,
+                                       unsigned int length);
+
+// Constants.
+/// The bytes read from the pipe on each write to the printer's output.
+static const gsize PRINT_BUFFER_SIZE = 64 * 1024;
+
+///
+/// @brief The progress of a print, passed to the main thread.
+///
+typedef struct
+{
+    /// The job printing the document.
+    JobPrint *job;
+    /// The number of pages already converted.
+    guint numPagesPrinted;
+    /// The number of pages to print.
+    guint numPagesToPrint;
+} PrintProgress;
 
 ///
 /// @brief Constructs a new JobPrint object.
@@ -36,12 +64,17 @@ static gboolean job_print_end (gpointer data);
 JobPrint::JobPrint ():
     IJob ()
 {
+    m_Cancelled = FALSE;
     m_Collate = FALSE;
     m_ColorModel = NULL;
     m_CurrentPage = 1;
     m_Document = NULL;
     m_DocumentCopy = NULL;
+    m_Error = NULL;
     m_NumberOfCopies = 1;
+    m_NumPagesPrinted = 0;
+    m_NumPagesToPrint = 0;
+    m_Output = NULL;
     m_PageHeight = 0.1624f;
     m_PageLayout = PRINT_PAGE_LAYOUT_PLAIN;
     m_PageOrientation = PRINT_PAGE_ORIENTATION_PORTRAIT;
@@ -50,8 +83,10 @@ JobPrint::JobPrint ():
     m_PageSet = PRINT_ALL_PAGE_SET;
     m_PageWidth = 0.1147f;
     m_PrinterName = NULL;
+    m_Producer = NULL;
+    m_ProducerFd = -1;
     m_Resolution = NULL;
-    m_TempFileName = NULL;
+    m_StreamFd = -1;
 }
 
 ///
@@ -60,12 +95,33 @@ JobPrint::JobPrint ():
 JobPrint::~JobPrint ()
 {
     delete m_DocumentCopy;
+    delete m_Output;
     delete[] m_PageRange;
     g_free (m_ColorModel);
     g_free (m_PageRangeString);
     g_free (m_PrinterName);
     g_free (m_Resolution);
-    g_free (m_TempFileName);
+    setError (NULL);
+    if ( -1 != m_ProducerFd )
+    {
+        close (m_ProducerFd);
+    }
+    if ( -1 != m_StreamFd )
+    {
+        close (m_StreamFd);
+    }
+}
+
+///
+/// @brief Stops notifying the document.
+///
+/// This is called when the document is deleted before the print
+/// ends. The print goes on from the job's copy of the document.
+///
+void
+JobPrint::detachDocument ()
+{
+    m_Document = NULL;
 }
 
 gboolean
@@ -92,6 +148,17 @@ JobPrint::getNumberOfCopies ()
     return m_NumberOfCopies;
 }
 
+///
+/// @brief Gets the error that stopped the print.
+///
+/// @return The error or NULL if the print didn't fail.
+///
+GError *
+JobPrint::getError ()
+{
+    return m_Error;
+}
+
 IDocument &
 JobPrint::getDocument ()
 {
@@ -100,6 +167,31 @@ JobPrint::getDocument ()
     return *m_DocumentCopy;
 }
 
+///
+/// @brief Gets the number of pages already converted to PostScript.
+///
+/// This can be called from any thread.
+///
+/// @return The number of converted pages.
+///
+guint
+JobPrint::getNumPagesPrinted ()
+{
+    return g_atomic_int_get (&m_NumPagesPrinted);
+}
+
+///
+/// @brief Gets the number of pages to print.
+///
+/// @return The number of pages in the range and set to print, once
+///         the print is set up.
+///
+guint
+JobPrint::getNumPagesToPrint ()
+{
+    return m_NumPagesToPrint;
+}
+
 gfloat
 JobPrint::getPageHeight ()
 {
@@ -148,44 +240,188 @@ JobPrint::getResolution ()
     return m_Resolution;
 }
 
-const gchar *
-JobPrint::getTempFileName ()
+///
+/// @brief Gets the document to print.
+///
+/// @return The document set with setDocument(), that is notified about
+///         the print's progress, or NULL if it was already deleted.
+///
+IDocument *
+JobPrint::getSourceDocument ()
 {
-    return m_TempFileName;
+    return m_Document;
 }
 
 ///
-/// @brief Renders a single page into a PostScript document.
+/// @brief Imposes the pages to print on the printer's sheets.
 ///
-gboolean
-JobPrint::run ()
+/// Each sheet gets several pages scaled down to fit in a grid, or two
+/// pages in booklet order, and is drawn to a cairo PostScript surface
+/// that writes to the pipe. The printer receives the sheets ready to
+/// print, so it doesn't need to support the number-up option.
+///
+void
+JobPrint::imposePages ()
 {
-    // This only will only be executed the first time.
-    setUpPrint ();
+    GArray *pages = g_array_sized_new (FALSE, FALSE, sizeof (gint),
+                                       getNumPagesToPrint ());
+    IDocument &document = getDocument ();
+    for ( gint pageNum = 1 ; pageNum <= document.getNumPages () ; pageNum++ )
+    {
+        if ( m_PageRange[pageNum - 1] )
+        {
+            g_array_append_val (pages, pageNum);
+        }
+    }
 
-    guint currentPage = getCurrentPage ();
-    getDocument ().outputPostscriptPage (currentPage);
+    gdouble sheetWidth = getPageWidth ();
+    gdouble sheetHeight = getPageHeight ();
+    PrintImposition imposition (getPageLayout (), pages->len,
+                                sheetWidth, sheetHeight);
+    cairo_surface_t *surface =
+        cairo_ps_surface_create_for_stream (job_print_write, &m_ProducerFd,
+                                            sheetWidth, sheetHeight);
+    for ( guint sheet = 0 ;
+          sheet < imposition.getNumSheets () &&
+          !g_atomic_int_get (&m_Cancelled) ;
+          sheet++ )
+    {
+        cairo_t *context = cairo_create (surface);
+        for ( guint slot = 0 ; slot < imposition.getPagesPerSheet () ; slot++ )
+        {
+            gint page = imposition.getPage (sheet, slot);
+            if ( -1 == page )
+            {
+                continue;
+            }
+            gint pageNum = g_array_index (pages, gint, page);
+            gdouble pageWidth;
+            gdouble pageHeight;
+            document.getPageSizeForPage (pageNum, &pageWidth, &pageHeight);
+            cairo_matrix_t matrix;
+            imposition.getPageTransform (slot, pageWidth, pageHeight,
+                                         &matrix);
+
+            cairo_save (context);
+            cairo_transform (context, &matrix);
+            cairo_rectangle (context, 0, 0, pageWidth, pageHeight);
+            cairo_clip (context);
+            document.renderPageForPrinting (pageNum, context);
+            cairo_restore (context);
+
+            g_atomic_int_inc (&m_NumPagesPrinted);
+            notifyProgress ();
+        }
+        cairo_show_page (context);
+        cairo_destroy (context);
+    }
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+    g_array_free (pages, TRUE);
 
-    guint numPages = getDocument ().getNumPages ();
-    for (guint pageNum = currentPage ; pageNum < numPages ; ++pageNum )
+    close (m_ProducerFd);
+    m_ProducerFd = -1;
+}
+
+///
+/// @brief Tells the main thread how many pages are already converted.
+///
+void
+JobPrint::notifyProgress ()
+{
+    PrintProgress *progress = g_new (PrintProgress, 1);
+    progress->job = this;
+    progress->numPagesPrinted = getNumPagesPrinted ();
+    progress->numPagesToPrint = getNumPagesToPrint ();
+    JOB_NOTIFIER (job_print_progress, progress);
+}
+
+///
+/// @brief Converts the pages to print to PostScript.
+///
+/// This is run by the producer thread. The pages are written to the
+/// pipe that streamPostscript() reads from, and the pipe is closed
+/// when all pages are converted or the output failed. Plain layouts
+/// are converted by the document, the rest are imposed by imposePages().
+///
+void
+JobPrint::producePostscript ()
+{
+    if ( 0 == getNumPagesToPrint () )
+    {
+        close (m_ProducerFd);
+        m_ProducerFd = -1;
+        return;
+    }
+    if ( PRINT_PAGE_LAYOUT_PLAIN != getPageLayout () )
+    {
+        imposePages ();
+        return;
+    }
+
+    // The document closes the pipe at outputPostscriptEnd().
+    IDocument &document = getDocument ();
+    document.outputPostscriptBegin (m_ProducerFd, getNumPagesToPrint (),
+                                    getPageWidth (), getPageHeight ());
+    m_ProducerFd = -1;
+    guint numPages = document.getNumPages ();
+    for ( guint pageNum = 1 ;
+          pageNum <= numPages && !g_atomic_int_get (&m_Cancelled) ;
+          pageNum++ )
     {
-        if (m_PageRange[pageNum])
+        if ( m_PageRange[pageNum - 1] )
         {
-            setCurrentPage (pageNum + 1);
-            break;
+            document.outputPostscriptPage (pageNum);
+            g_atomic_int_inc (&m_NumPagesPrinted);
+            notifyProgress ();
         }
     }
+    document.outputPostscriptEnd ();
+}
 
-    if ( getCurrentPage () == currentPage )
+///
+/// @brief Starts to print the document.
+///
+/// The print is set up from the jobs' thread, but the pages are
+/// converted and sent to the printer from the job's own threads, so
+/// the pages to show can still be rendered meanwhile.
+///
+/// @return FALSE, because the job is deleted when the print ends.
+///
+gboolean
+JobPrint::run ()
+{
+    setUpPrint ();
+    if ( NULL == m_DocumentCopy )
     {
+        GError *error = NULL;
+        g_set_error (&error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorOpenFile,
+                     _("Couldn't read the document '%s' again to print it."),
+                     m_Document->getFileName ());
+        setError (error);
         JOB_NOTIFIER (job_print_end, this);
+        return FALSE;
     }
-    else
+    if ( NULL == m_Output )
     {
-        IJob::enqueue (this);
+        m_Output = new CupsPrintOutput ();
     }
 
-    return JOB_DELETE;
+    gint pipeFds[2];
+    GError *error = NULL;
+    if ( !g_unix_open_pipe (pipeFds, FD_CLOEXEC, &error) )
+    {
+        setError (error);
+        JOB_NOTIFIER (job_print_end, this);
+        return FALSE;
+    }
+    m_StreamFd = pipeFds[0];
+    m_ProducerFd = pipeFds[1];
+
+    m_Producer = g_thread_new ("print-producer", job_print_produce, this);
+    g_thread_unref (g_thread_new ("print-stream", job_print_stream, this));
+
+    return FALSE;
 }
 
 void
@@ -211,6 +447,22 @@ void
 JobPrint::setDocument (IDocument *document)
 {
     m_Document = document;
+    setOwner (document);
+}
+
+///
+/// @brief Sets the error that stopped the print.
+///
+/// @param error The error. The job takes its ownership.
+///
+void
+JobPrint::setError (GError *error)
+{
+    if ( NULL != m_Error )
+    {
+        g_error_free (m_Error);
+    }
+    m_Error = error;
 }
 
 void
@@ -219,6 +471,20 @@ JobPrint::setNumberOfCopies (guint copies)
     m_NumberOfCopies = copies;
 }
 
+///
+/// @brief Sets where to stream the print to.
+///
+/// When no output is set, the print is sent to CUPS.
+///
+/// @param output The print's output. The job takes its ownership.
+///
+void
+JobPrint::setOutput (IPrintOutput *output)
+{
+    delete m_Output;
+    m_Output = output;
+}
+
 void
 JobPrint::setPrinterName (const gchar *name)
 {
@@ -395,22 +661,21 @@ JobPrint::setUpPageRange ()
     return totalNumberOfPages;
 }
 
-void
-JobPrint::setTempFileName (const gchar *fileName)
-{
-    g_free (m_TempFileName);
-    m_TempFileName = g_strdup (fileName);
-}
-
 void
 JobPrint::setUpPrint ()
 {
-    if ( NULL != m_Document )
+    if ( NULL == m_DocumentCopy )
     {
         // Get a *copy* of the document. We don't want to open
-        // a new document while printing, do we?
+        // a new document while printing, do we? The copy takes its
+        // own parsed document from the ones the document shares, as
+        // the producer thread reads it while the jobs' thread reads
+        // the original, so only the first print parses it again.
         m_DocumentCopy = m_Document->copy ();
-        m_Document = NULL;
+        if ( NULL == m_DocumentCopy )
+        {
+            return;
+        }
 
         // This array tells us which pages to export to postscript.
         int numPages = getDocument ().getNumPages ();
@@ -426,7 +691,7 @@ JobPrint::setUpPrint ()
             g_free (pageRange);
         }
         // Now get the real range to print.
-        gint numPagesToPrint = setUpPageRange ();
+        m_NumPagesToPrint = setUpPageRange ();
 
         // Set the current page to the first page that must be rendered.
         for (int currentPage = 0 ; currentPage < numPages ; ++currentPage )
@@ -437,44 +702,237 @@ JobPrint::setUpPrint ()
                 break;
             }
         }
+    }
+}
 
-        // Create a temporary file to store the postscript
-        gchar tempFileName[1024];
-        int cupsFile = cupsTempFd (tempFileName, 1024);
-        setTempFileName (tempFileName);
-        getDocument ().outputPostscriptBegin (tempFileName, numPagesToPrint,
-                                              getPageWidth (),
-                                              getPageHeight ());
-        close (cupsFile);
+///
+/// @brief Writes the converted pages to the print's output.
+///
+/// This is run by the streaming thread. It reads what the producer
+/// writes to the pipe until the pipe is closed. If the output fails,
+/// the producer is told to stop and the rest of the pipe is read
+/// without writing it, so the producer never waits for a full pipe.
+///
+void
+JobPrint::streamPostscript ()
+{
+    GError *error = NULL;
+    cups_option_t *options = NULL;
+    gint numOptions = getPrintOptions (this, &options);
+    gboolean started =
+        m_Output->begin (getPrinterName (), getDocument ().getFileName (),
+                         numOptions, options, &error);
+    cupsFreeOptions (numOptions, options);
+    if ( !started )
+    {
+        g_atomic_int_set (&m_Cancelled, TRUE);
     }
+
+    gchar *buffer = g_new (gchar, PRINT_BUFFER_SIZE);
+    gssize bytesRead;
+    while ( 0 != (bytesRead = read (m_StreamFd, buffer, PRINT_BUFFER_SIZE)) )
+    {
+        if ( 0 > bytesRead )
+        {
+            if ( EINTR == errno )
+            {
+                continue;
+            }
+            if ( NULL == error )
+            {
+                g_set_error (&error, EPDFVIEW_DOCUMENT_ERROR,
+                             DocumentErrorPrinting, "%s",
+                             g_strerror (errno));
+            }
+            g_atomic_int_set (&m_Cancelled, TRUE);
+            break;
+        }
+        if ( NULL == error && !m_Output->write (buffer, bytesRead, &error) )
+        {
+            g_atomic_int_set (&m_Cancelled, TRUE);
+        }
+    }
+    g_free (buffer);
+    close (m_StreamFd);
+    m_StreamFd = -1;
+    g_thread_join (m_Producer);
+    m_Producer = NULL;
+
+    if ( NULL == error )
+    {
+        m_Output->finish (&error);
+    }
+    else if ( started )
+    {
+        m_Output->cancel ();
+    }
+    setError (error);
+    // The job can be deleted as soon as it's notified.
+    JOB_NOTIFIER (job_print_end, this);
 }
 
 ////////////////////////////////////////////////////////////////
 // Static threaded functions.
 ////////////////////////////////////////////////////////////////
 
+///
+/// @brief The print has ended.
+///
+/// The document is notified whether the print was sent or why it failed,
+/// and the job is deleted.
+///
+/// @param data The JobPrint that ended.
+///
+/// @return FALSE to remove the idle callback.
+///
 gboolean
 job_print_end (gpointer data)
 {
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobPrint *job = (JobPrint *)data;
-    job->getDocument().outputPostscriptEnd ();
+    IDocument *document = job->getSourceDocument ();
+    if ( NULL == document )
+    {
+        // The document was closed while printing.
+    }
+    else if ( NULL != job->getError () )
+    {
+        document->notifyPrintError (job->getError ());
+    }
+    else
+    {
+        document->notifyPrint ();
+    }
+    // run() returned FALSE, so the job is always deleted here.
+    delete job;
+
+    return FALSE;
+}
+
+///
+/// @brief The producer thread's function.
+///
+/// @param data The JobPrint whose pages to convert.
+///
+/// @return NULL.
+///
+gpointer
+job_print_produce (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobPrint *job = (JobPrint *)data;
+    job->producePostscript ();
+
+    return NULL;
+}
 
-    // Add Cups options.
-    cups_option_t *options;
+///
+/// @brief A page has been converted.
+///
+/// The job is still alive, because its end is notified after all its
+/// progress.
+///
+/// @param data The PrintProgress to notify. It's freed.
+///
+/// @return FALSE to remove the idle callback.
+///
+gboolean
+job_print_progress (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    PrintProgress *progress = (PrintProgress *)data;
+    IDocument *document = progress->job->getSourceDocument ();
+    if ( NULL != document )
+    {
+        document->notifyPrintProgress (progress->numPagesPrinted,
+                                       progress->numPagesToPrint);
+    }
+    g_free (progress);
+
+    return FALSE;
+}
+
+///
+/// @brief The streaming thread's function.
+///
+/// @param data The JobPrint whose pages to stream.
+///
+/// @return NULL.
+///
+gpointer
+job_print_stream (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobPrint *job = (JobPrint *)data;
+    job->streamPostscript ();
+
+    return NULL;
+}
+
+///
+/// @brief Writes the imposed sheets to the pipe.
+///
+/// @param closure The pipe's file descriptor.
+/// @param data The bytes to write.
+/// @param length The number of bytes in @a data.
+///
+/// @return CAIRO_STATUS_SUCCESS if all bytes were written, or
+///         CAIRO_STATUS_WRITE_ERROR otherwise.
+///
+cairo_status_t
+job_print_write (void *closure, const unsigned char *data,
+                 unsigned int length)
+{
+    gint fd = *(gint *)closure;
+    while ( 0 < length )
+    {
+        ssize_t written = write (fd, data, length);
+        if ( 0 > written )
+        {
+            if ( EINTR == errno )
+            {
+                continue;
+            }
+            return CAIRO_STATUS_WRITE_ERROR;
+        }
+        data += written;
+        length -= written;
+    }
+
+    return CAIRO_STATUS_SUCCESS;
+}
+
+///
+/// @brief Gets the CUPS options of a print job.
+///
+/// @param job The job to get its options.
+/// @param options The output location to save the options to. They
+///                must be freed with cupsFreeOptions().
+///
+/// @return The number of options saved in @a options.
+///
+gint
+getPrintOptions (JobPrint *job, cups_option_t **options)
+{
     gint numOptions = 0;
+    *options = NULL;
 
     gchar *numCopies = g_strdup_printf ("%d", job->getNumberOfCopies ());
-    numOptions = cupsAddOption ("copies", numCopies, numOptions, &options);
+    numOptions = cupsAddOption ("copies", numCopies, numOptions, options);
     g_free (numCopies);
 
     gchar *collate = g_strdup (job->getCollate() ? "True" : "False");
-    numOptions = cupsAddOption ("Collate", collate, numOptions, &options);
+    numOptions = cupsAddOption ("Collate", collate, numOptions, options);
     g_free (collate);
 
+    // Imposed sheets are already rotated as needed.
     gchar *orientation = NULL;
-    if ( PRINT_PAGE_ORIENTATION_LANDSCAPE == job->getPageOrientation () )
+    if ( PRINT_PAGE_ORIENTATION_LANDSCAPE == job->getPageOrientation () &&
+         PRINT_PAGE_LAYOUT_PLAIN == job->getPageLayout () )
     {
         orientation = g_strdup_printf ("4");
     }
@@ -483,40 +941,25 @@ job_print_end (gpointer data)
         orientation = g_strdup_printf ("3");
     }
     numOptions = cupsAddOption ("orientation-requested", orientation,
-                                 numOptions, &options);
+                                 numOptions, options);
     g_free (orientation);
 
-    gchar *layout = NULL;
-    switch (job->getPageLayout ())
+    // The other layouts are already imposed on the sheets by imposePages().
+    if ( PRINT_PAGE_LAYOUT_BOOKLET == job->getPageLayout () )
     {
-        case PRINT_PAGE_LAYOUT_2IN1:
-            layout = g_strdup_printf ("%d", 2);
-            break;
-
-        case PRINT_PAGE_LAYOUT_4IN1:
-            layout = g_strdup_printf ("%d", 4);
-            break;
-
-        case PRINT_PAGE_LAYOUT_6IN1:
-            layout = g_strdup_printf ("%d", 6);
-            break;
-
-        default:
-            layout = g_strdup_printf ("%d", 1);
+        numOptions = cupsAddOption ("sides", "two-sided-short-edge",
+                                    numOptions, options);
+    }
+    if ( NULL != job->getColorModel () )
+    {
+        numOptions = cupsAddOption ("ColorModel", job->getColorModel (),
+                                    numOptions, options);
+    }
+    if ( NULL != job->getResolution () )
+    {
+        numOptions = cupsAddOption ("resolution", job->getResolution (),
+                                    numOptions, options);
     }
-    numOptions = cupsAddOption ("number-up", layout, numOptions, &options);
-    g_free (layout);
-    numOptions = cupsAddOption ("ColorModel", job->getColorModel (),
-                                numOptions, &options);
-    numOptions = cupsAddOption ("resolution", job->getResolution (),
-                                numOptions, &options);
-
-    cupsPrintFile (job->getPrinterName (), job->getTempFileName (),
-                   job->getDocument ().getFileName (), numOptions, options);
-
-    cupsFreeOptions (numOptions, options);
-
-    JOB_NOTIFIER_END ();
 
-    return FALSE;
+    return numOptions;
 }
@@ -25,6 +25,9 @@
 
 namespace ePDFView
 {
+    // Forward declarations.
+    class IPrintOutput;
+
     ///
     /// @enum PrintPageLayout
     ///
@@ -33,7 +36,9 @@ namespace ePDFView
         PRINT_PAGE_LAYOUT_PLAIN,
         PRINT_PAGE_LAYOUT_2IN1,
         PRINT_PAGE_LAYOUT_4IN1,
-        PRINT_PAGE_LAYOUT_6IN1
+        PRINT_PAGE_LAYOUT_6IN1,
+        PRINT_PAGE_LAYOUT_8IN1,
+        PRINT_PAGE_LAYOUT_BOOKLET
     };
 
     ///
@@ -59,8 +64,15 @@ namespace ePDFView
     /// @class JobPrint
     /// @brief A background job that prints the document.
     ///
-    /// This class converts the document to postscript and then
-    /// uses CUPS to print the converted document.
+    /// This class converts the document to postscript and streams it
+    /// to CUPS while the pages are still converted.
+    ///
+    /// The job only prepares the print from the jobs' thread. Then a
+    /// producer thread converts the pages, from its own copy of the
+    /// document, into a pipe, and a second thread writes what it reads
+    /// from the pipe to the printer's output. The pipe bounds the memory
+    /// used: when it's full the producer waits for the printer. The
+    /// job deletes itself when the print ends.
     ///
     class JobPrint: public IJob
     {
@@ -68,20 +80,26 @@ namespace ePDFView
             JobPrint (void);
             ~JobPrint (void);
 
+            void detachDocument (void);
             gboolean getCollate (void);
             const gchar *getColorModel (void);
             IDocument &getDocument (void);
+            GError *getError (void);
             guint getNumberOfCopies (void);
+            guint getNumPagesPrinted (void);
+            guint getNumPagesToPrint (void);
             PrintPageLayout getPageLayout (void);
             PrintPageOrientation getPageOrientation (void);
             const gchar *getPrinterName (void);
             const gchar *getResolution (void);
-            const gchar *getTempFileName (void);
+            IDocument *getSourceDocument (void);
+            void producePostscript (void);
             virtual gboolean run (void);
             void setCollate (gboolean collate);
             void setColorModel (const gchar *colorModel);
             void setDocument (IDocument *document);
             void setNumberOfCopies (guint copies);
+            void setOutput (IPrintOutput *output);
             void setPageLayout (PrintPageLayout layout);
             void setPageOrientation (PrintPageOrientation orientation);
             void setPageRange (const gchar *range);
@@ -90,14 +108,26 @@ namespace ePDFView
             void setPrinterName (const gchar *name);
             void setResolution (const gchar *resolution);
             void setUpPrint (void);
+            void streamPostscript (void);
 
         protected:
+            /// @brief Tells the producer to stop, because the output
+            /// failed.
+            volatile gint m_Cancelled;
             gboolean m_Collate;
             gchar *m_ColorModel;
             guint m_CurrentPage;
             IDocument *m_Document;
             IDocument *m_DocumentCopy;
+            /// The error that stopped the print, or NULL.
+            GError *m_Error;
             guint m_NumberOfCopies;
+            /// The pages already converted, read with g_atomic_int_get().
+            volatile gint m_NumPagesPrinted;
+            /// The number of pages in the page range and set.
+            guint m_NumPagesToPrint;
+            /// The output to stream the converted pages to.
+            IPrintOutput *m_Output;
             gfloat m_PageHeight;
             PrintPageLayout m_PageLayout;
             PrintPageOrientation m_PageOrientation;
@@ -107,15 +137,22 @@ namespace ePDFView
             gchar *m_Resolution;
             gfloat m_PageWidth;
             gchar *m_PrinterName;
-            gchar *m_TempFileName;
+            /// The thread that converts the pages.
+            GThread *m_Producer;
+            /// The pipe's end the converted pages are written to.
+            gint m_ProducerFd;
+            /// The pipe's end the converted pages are read from.
+            gint m_StreamFd;
 
             guint getCurrentPage (void);
             gfloat getPageHeight (void);
             const gchar *getPageRangeString (void);
             PrintPageSet getPageSet (void);
             gfloat getPageWidth (void);
+            void imposePages (void);
+            void notifyProgress (void);
             void setCurrentPage (guint pageNumber);
-            void setTempFileName (const gchar *fileName);
+            void setError (GError *error);
             guint setUpPageRange (void);
     };
 }
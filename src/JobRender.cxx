@@ -28,8 +28,6 @@ G_LOCK_DEFINE (JobRender);
 
 /// Tells if we can render more pages or not. Used in test suites only.
 gboolean JobRender::m_CanProcessJobs = TRUE;
-/// This tells the minimum age the jobs must have in order to process them.
-guint32 JobRender::m_MinAge = 0;
 
 // Forwards declarations.
 static gboolean job_render_done (gpointer data);
@@ -61,10 +59,13 @@ JobRender::run (void)
 {
     G_LOCK (JobRender);
     IDocument *doc = getDocument ();
-    if ( NULL != doc && m_MinAge <= getAge ())
+    if ( NULL != doc && doc->getMinRenderAge () <= getAge ())
     {
         m_PageImage = doc->renderPage (getPageNumber ()); 
         G_UNLOCK (JobRender);
+        // The links don't depend on the zoom, so each page's links are
+        // only extracted the first time it's rendered.
+        doc->loadPageLinks (getPageNumber ());
         JOB_NOTIFIER (job_render_done, this);
         return JOB_DELETE;
     }
@@ -83,6 +84,18 @@ JobRender::getAge ()
     return m_Age;
 }
 
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobRender::detachDocument ()
+{
+    m_Document = NULL;
+}
+
 ///
 /// @brief Gets the document to get the page to render.
 ///
@@ -146,21 +159,7 @@ JobRender::setDocument (IDocument *document)
     g_assert (NULL != document && "Setting a NULL document.");
 
     m_Document = document;
-}
-
-///
-/// @brief Sets the minimum job's age.
-///
-/// In order to prevent rendering previously queued jobs that are no
-/// longer needed, a presenter can set the minimum age that a job
-/// needs to have in order to be rendered.
-///
-/// @param age The minimum job's age.
-///
-void
-JobRender::setMinAge (guint32 age)
-{
-    m_MinAge = age;
+    setOwner (document);
 }
 
 ///
@@ -200,6 +199,10 @@ job_render_done (gpointer data)
         doc->notifyPageRendered (job->getPageNumber(), 
                                  job->getAge (), job->getPageImage ());
     }
+    else
+    {
+        delete job->getPageImage ();
+    }
     JOB_NOTIFIER_END();
 
     G_UNLOCK (JobRender);
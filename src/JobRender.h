@@ -40,6 +40,7 @@ namespace ePDFView
 
             gboolean run (void);
 
+            void detachDocument (void);
             guint32 getAge (void);
             IDocument *getDocument (void);
             DocumentPage *getPageImage (void);
@@ -49,14 +50,12 @@ namespace ePDFView
             void setPageNumber (gint pageNumber);
 
             static gboolean m_CanProcessJobs;
-            static void setMinAge (guint32 age);
 
         protected:
             /// The job's age.
             guint32 m_Age;
             /// The class to use to render the page.
             IDocument *m_Document;
-            static guint32 m_MinAge;
             /// The page's rendered image.
             DocumentPage *m_PageImage;
             /// The page's number to render.
@@ -0,0 +1,200 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_EXTERN (JobRender);
+
+// Forwards declarations.
+static gboolean job_render_thumbnail_done (gpointer data);
+
+///
+/// @brief Constructs a new JobRenderThumbnail object.
+///
+JobRenderThumbnail::JobRenderThumbnail ():
+    IJob ()
+{
+    m_Document = NULL;
+    m_PageNumber = 0;
+    m_Size = 0;
+    m_Thumbnail = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobRenderThumbnail.
+///
+JobRenderThumbnail::~JobRenderThumbnail ()
+{
+}
+
+///
+/// @brief Renders the thumbnail.
+///
+gboolean
+JobRenderThumbnail::run ()
+{
+    G_LOCK (JobRender);
+    IDocument *document = getDocument ();
+    if ( NULL == document || !document->beginThumbnail (getPageNumber ()) )
+    {
+        G_UNLOCK (JobRender);
+        return TRUE;
+    }
+    m_Thumbnail = document->loadThumbnail (getPageNumber (), getSize ());
+    G_UNLOCK (JobRender);
+    JOB_NOTIFIER (job_render_thumbnail_done, this);
+    return JOB_DELETE;
+}
+
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobRenderThumbnail::detachDocument ()
+{
+    m_Document = NULL;
+}
+
+///
+/// @brief Gets the document to render the thumbnail of.
+///
+/// @return The document or NULL if can't process more jobs (test only.)
+///
+IDocument *
+JobRenderThumbnail::getDocument ()
+{
+    if ( JobRender::m_CanProcessJobs )
+    {
+        return m_Document;
+    }
+    return NULL;
+}
+
+///
+/// @brief Gets the number of the page to render its thumbnail.
+///
+/// @return The thumbnail's page number.
+///
+gint
+JobRenderThumbnail::getPageNumber ()
+{
+    return m_PageNumber;
+}
+
+///
+/// @brief Gets the maximum size of the thumbnail.
+///
+/// @return The maximum width and height of the thumbnail.
+///
+gint
+JobRenderThumbnail::getSize ()
+{
+    return m_Size;
+}
+
+///
+/// @brief Gets the rendered thumbnail.
+///
+/// @return The thumbnail, as returned by the document.
+///
+DocumentPage *
+JobRenderThumbnail::getThumbnail ()
+{
+    return m_Thumbnail;
+}
+
+///
+/// @brief Sets the document to render the thumbnail of.
+///
+/// @param document The document to render the thumbnail of.
+///
+void
+JobRenderThumbnail::setDocument (IDocument *document)
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+
+    m_Document = document;
+    setOwner (document);
+}
+
+///
+/// @brief Sets the page to render its thumbnail.
+///
+/// @param pageNumber The number of the thumbnail's page.
+///
+void
+JobRenderThumbnail::setPageNumber (gint pageNumber)
+{
+    m_PageNumber = pageNumber;
+}
+
+///
+/// @brief Sets the maximum size of the thumbnail.
+///
+/// @param size The maximum width and height of the thumbnail.
+///
+void
+JobRenderThumbnail::setSize (gint size)
+{
+    m_Size = size;
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The thumbnail has been rendered.
+///
+/// Gives the thumbnail to the document, that notifies its observers,
+/// and destroys the job.
+///
+/// @param data The job that is done.
+///
+gboolean
+job_render_thumbnail_done (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    G_LOCK (JobRender);
+
+    JobRenderThumbnail *job = (JobRenderThumbnail *)data;
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifyThumbnailRendered (job->getPageNumber (),
+                                           job->getThumbnail ());
+    }
+    else
+    {
+        delete job->getThumbnail ();
+    }
+    JOB_NOTIFIER_END();
+
+    G_UNLOCK (JobRender);
+
+    return FALSE;
+}
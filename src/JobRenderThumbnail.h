@@ -0,0 +1,68 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__JOB_RENDER_THUMBNAIL_H__)
+#define __JOB_RENDER_THUMBNAIL_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentPage;
+    class IDocument;
+
+    ///
+    /// @class JobRenderThumbnail
+    /// @brief A background job that renders a page's thumbnail.
+    ///
+    /// The job is queued with low priority, so it only runs when no page
+    /// is waiting to render. If the thumbnail is no longer shown when the
+    /// job runs, it does nothing.
+    ///
+    class JobRenderThumbnail: public IJob
+    {
+        public:
+            JobRenderThumbnail (void);
+            ~JobRenderThumbnail (void);
+
+            gboolean run (void);
+
+            void detachDocument (void);
+            IDocument *getDocument (void);
+            gint getPageNumber (void);
+            gint getSize (void);
+            DocumentPage *getThumbnail (void);
+            void setDocument (IDocument *document);
+            void setPageNumber (gint pageNumber);
+            void setSize (gint size);
+
+        protected:
+            /// The document to render the thumbnail of.
+            IDocument *m_Document;
+            /// The number of the page to render its thumbnail.
+            gint m_PageNumber;
+            /// The maximum width and height of the thumbnail.
+            gint m_Size;
+            /// The rendered thumbnail.
+            DocumentPage *m_Thumbnail;
+    };
+}
+
+#endif // !__JOB_RENDER_THUMBNAIL_H__
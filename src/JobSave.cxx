@@ -52,17 +52,28 @@ JobSave::~JobSave ()
     }
 }
 
+///
+/// @brief Stops using the document.
+///
+/// This is called when the document is deleted before the job
+/// notified it.
+///
+void
+JobSave::detachDocument ()
+{
+    m_Document = NULL;
+}
+
 ///
 /// @brief The document that's saving a copy from.
 ///
-/// @return The document that is saving a copy from.
+/// @return The document that is saving a copy from, or NULL
+///         if it was deleted.
 ///
-IDocument &
+IDocument *
 JobSave::getDocument ()
 {
-    g_assert (NULL != m_Document && "The document is NULL.");
-
-    return *m_Document;
+    return m_Document;
 }
 
 ///
@@ -94,7 +105,7 @@ gboolean
 JobSave::run ()
 {
     GError *error = NULL;
-    if ( getDocument ().saveFile (getFileName (), &error) )
+    if ( getDocument ()->saveFile (getFileName (), &error) )
     {
         JOB_NOTIFIER (job_save_done, this);
     }
@@ -118,6 +129,7 @@ JobSave::setDocument (IDocument *document)
     g_assert ( NULL != document && "Tried to set a NULL document.");
 
     m_Document = document;
+    setOwner (document);
 }
 
 ///
@@ -162,7 +174,11 @@ job_save_done (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobSave *job = (JobSave *)data;
-    job->getDocument ().notifySave ();
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifySave ();
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
@@ -181,7 +197,11 @@ job_save_error (gpointer data)
     g_assert (NULL != data && "The data parameter is NULL.");
 
     JobSave *job = (JobSave *)data;
-    job->getDocument ().notifySaveError (job->getError ());
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifySaveError (job->getError ());
+    }
     JOB_NOTIFIER_END();
 
     return FALSE;
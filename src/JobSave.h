@@ -40,7 +40,8 @@ namespace ePDFView
             JobSave (void);
             ~JobSave (void);
 
-            IDocument &getDocument (void);
+            void detachDocument (void);
+            IDocument *getDocument (void);
             GError *getError (void);
             const gchar *getFileName (void);
             gboolean run (void);
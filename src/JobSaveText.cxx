@@ -0,0 +1,341 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static gboolean job_save_text_end (gpointer data);
+static gpointer job_save_text_extract (gpointer data);
+static void job_save_text_page_saved (guint numPagesSaved,
+                                      guint numPagesToSave, gpointer data);
+static gboolean job_save_text_progress (gpointer data);
+
+///
+/// @brief The progress of a text save, passed to the main thread.
+///
+typedef struct
+{
+    /// The job saving the text.
+    JobSaveText *job;
+    /// The number of pages already written.
+    guint numPagesSaved;
+    /// The number of pages to write.
+    guint numPagesToSave;
+} SaveTextProgress;
+
+///
+/// @brief Constructs a new JobSaveText object.
+///
+JobSaveText::JobSaveText ():
+    IJob ()
+{
+    m_Cancelled = FALSE;
+    m_Document = NULL;
+    m_DocumentCopy = NULL;
+    m_Error = NULL;
+    m_Exporter = NULL;
+    m_FileName = NULL;
+    g_mutex_init (&m_Lock);
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by JobSaveText.
+///
+JobSaveText::~JobSaveText ()
+{
+    delete m_Exporter;
+    delete m_DocumentCopy;
+    g_free (m_FileName);
+    if ( NULL != m_Error )
+    {
+        g_error_free (m_Error);
+    }
+    g_mutex_clear (&m_Lock);
+}
+
+///
+/// @brief Stops saving the text.
+///
+/// Can be called from any thread. The document is notified with a
+/// G_IO_ERROR_CANCELLED error, and the partial file is removed.
+///
+void
+JobSaveText::cancel ()
+{
+    g_mutex_lock (&m_Lock);
+    g_atomic_int_set (&m_Cancelled, TRUE);
+    if ( NULL != m_Exporter )
+    {
+        m_Exporter->cancel ();
+    }
+    g_mutex_unlock (&m_Lock);
+}
+
+///
+/// @brief Stops notifying the document.
+///
+/// This is called by the document when it's deleted before the job
+/// ends.
+///
+void
+JobSaveText::detachDocument ()
+{
+    m_Document = NULL;
+}
+
+///
+/// @brief The document whose text is saved.
+///
+/// @return The document to notify, or NULL if it was already deleted.
+///
+IDocument *
+JobSaveText::getDocument ()
+{
+    return m_Document;
+}
+
+///
+/// @brief Gets the last error.
+///
+/// @return The error that stopped the save, or NULL.
+///
+GError *
+JobSaveText::getError ()
+{
+    return m_Error;
+}
+
+///
+/// @brief Gets the file name to save to.
+///
+/// @return The file name to save to.
+///
+const gchar *
+JobSaveText::getFileName ()
+{
+    return m_FileName;
+}
+
+///
+/// @brief Starts to save the text.
+///
+/// The document is copied from the jobs' thread, which is the only one
+/// allowed to read it, and the text is extracted from the job's own
+/// thread.
+///
+/// @return FALSE, because the job is deleted when the save ends.
+///
+gboolean
+JobSaveText::run ()
+{
+    g_assert (NULL != m_Document && "The document is NULL.");
+
+    m_DocumentCopy = m_Document->copy ();
+    if ( NULL == m_DocumentCopy )
+    {
+        GError *error = NULL;
+        g_set_error (&error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorOpenFile,
+                     _("Couldn't read the document '%s' again to save its "
+                       "text."), m_Document->getFileName ());
+        setError (error);
+        JOB_NOTIFIER (job_save_text_end, this);
+        return FALSE;
+    }
+    DocumentExporter *exporter = new DocumentExporter (m_DocumentCopy);
+    exporter->setFormat (EXPORT_FORMAT_TEXT);
+    exporter->setOutputPattern (getFileName ());
+    exporter->setProgressCallback (job_save_text_page_saved, this);
+    g_mutex_lock (&m_Lock);
+    m_Exporter = exporter;
+    if ( g_atomic_int_get (&m_Cancelled) )
+    {
+        m_Exporter->cancel ();
+    }
+    g_mutex_unlock (&m_Lock);
+
+    g_thread_unref (g_thread_new ("save-text", job_save_text_extract, this));
+
+    return FALSE;
+}
+
+///
+/// @brief Extracts and writes the text.
+///
+/// This is run by the job's thread.
+///
+void
+JobSaveText::saveText ()
+{
+    GError *error = NULL;
+    m_Exporter->exportPages (&error);
+    setError (error);
+    // The job can be deleted as soon as it's notified.
+    JOB_NOTIFIER (job_save_text_end, this);
+}
+
+///
+/// @brief Sets the document to save the text from.
+///
+/// @param document The document whose text will be saved.
+///
+void
+JobSaveText::setDocument (IDocument *document)
+{
+    g_assert ( NULL != document && "Tried to set a NULL document.");
+    m_Document = document;
+    setOwner (document);
+}
+
+///
+/// @brief Sets the last error.
+///
+/// @param error The error that stopped the save, or NULL.
+///
+void
+JobSaveText::setError (GError *error)
+{
+    if ( NULL != m_Error )
+    {
+        g_error_free (m_Error);
+    }
+    m_Error = error;
+}
+
+///
+/// @brief Sets the file name to save to.
+///
+/// @param fileName The file name to save to.
+///
+void
+JobSaveText::setFileName (const gchar *fileName)
+{
+    g_free (m_FileName);
+    m_FileName = g_strdup (fileName);
+}
+
+////////////////////////////////////////////////////////////////
+// Static threaded functions.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The text save has ended.
+///
+/// Notifies the document, unless it was deleted meanwhile, about the
+/// save's result.
+///
+/// @param data This parameter holds the JobSaveText that ended.
+///
+/// @return FALSE, to remove the idle callback.
+///
+gboolean
+job_save_text_end (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobSaveText *job = (JobSaveText *)data;
+    IDocument *document = job->getDocument ();
+    if ( NULL != document )
+    {
+        document->removeSaveTextJob (job);
+        if ( NULL != job->getError () )
+        {
+            document->notifySaveTextError (job->getError ());
+        }
+        else
+        {
+            document->notifySaveText ();
+        }
+    }
+    // run() returned FALSE, so the job is always deleted here.
+    delete job;
+
+    return FALSE;
+}
+
+///
+/// @brief Runs the text extraction.
+///
+/// @param data This parameter holds the JobSaveText to run.
+///
+/// @return NULL.
+///
+gpointer
+job_save_text_extract (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    JobSaveText *job = (JobSaveText *)data;
+    job->saveText ();
+
+    return NULL;
+}
+
+///
+/// @brief A page's text was written.
+///
+/// This is called from the exporter's threads, so the progress is
+/// passed to the main thread.
+///
+/// @param numPagesSaved The number of pages already written.
+/// @param numPagesToSave The number of pages to write.
+/// @param data This parameter holds the JobSaveText.
+///
+void
+job_save_text_page_saved (guint numPagesSaved, guint numPagesToSave,
+                          gpointer data)
+{
+    SaveTextProgress *progress = g_new (SaveTextProgress, 1);
+    progress->job = (JobSaveText *)data;
+    progress->numPagesSaved = numPagesSaved;
+    progress->numPagesToSave = numPagesToSave;
+    JOB_NOTIFIER (job_save_text_progress, progress);
+}
+
+///
+/// @brief Notifies the document about the progress.
+///
+/// The job is still alive, because its end is notified after all its
+/// progress.
+///
+/// @param data This parameter holds the SaveTextProgress.
+///
+/// @return FALSE, to remove the idle callback.
+///
+gboolean
+job_save_text_progress (gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    SaveTextProgress *progress = (SaveTextProgress *)data;
+    IDocument *document = progress->job->getDocument ();
+    if ( NULL != document )
+    {
+        document->notifySaveTextProgress (progress->numPagesSaved,
+                                          progress->numPagesToSave);
+    }
+    g_free (progress);
+
+    return FALSE;
+}
@@ -0,0 +1,79 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_SAVE_TEXT_H__)
+#define __JOB_SAVE_TEXT_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentExporter;
+    class IDocument;
+
+    ///
+    /// @class JobSaveText
+    /// @brief A background job that saves the text of all pages to a file.
+    ///
+    /// The text is extracted by a DocumentExporter from the job's own
+    /// thread, so the jobs' thread can keep rendering pages meanwhile.
+    /// The exporter works on a copy of the document, made when
+    /// the job runs, so the document can be reloaded while its text is
+    /// being saved.
+    ///
+    class JobSaveText: public IJob
+    {
+        public:
+            JobSaveText (void);
+            ~JobSaveText (void);
+
+            void cancel (void);
+            void detachDocument (void);
+            IDocument *getDocument (void);
+            GError *getError (void);
+            const gchar *getFileName (void);
+            gboolean run (void);
+            void saveText (void);
+            void setDocument (IDocument *document);
+            void setError (GError *error);
+            void setFileName (const gchar *fileName);
+
+        protected:
+            /// Tells if the job was cancelled before it started.
+            volatile gint m_Cancelled;
+            /// @brief The document to notify, or NULL if it was deleted.
+            /// Only changed from the main thread.
+            IDocument *m_Document;
+            /// The copy of the document the text is extracted from.
+            IDocument *m_DocumentCopy;
+            /// The error produced when saving.
+            GError *m_Error;
+            /// @brief The exporter that extracts the text, or NULL until
+            /// the job runs. Protected by m_Lock.
+            DocumentExporter *m_Exporter;
+            /// The file name to save to.
+            gchar *m_FileName;
+            /// Protects m_Exporter.
+            GMutex m_Lock;
+    };
+}
+
+#endif // __JOB_SAVE_TEXT_H__
@@ -22,6 +22,7 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include "epdfview.h"
 #include <stdio.h>
@@ -34,6 +35,17 @@ G_LOCK_DEFINE_STATIC (fileSaved);
 static volatile gboolean fileSaved;
 #endif // DEBUG
 
+// Constants.
+/// The milliseconds the file must stay unchanged before reloading it.
+static const guint AUTO_RELOAD_DELAY = 500;
+/// The times to wait again for a file that is still being written.
+static const guint AUTO_RELOAD_CHECKS = 10;
+/// The bytes at the file's end where to look for the end of file marker.
+static const gsize END_OF_FILE_SEARCH_SIZE = 1024;
+
+// Forward declarations.
+static gboolean isFileComplete (const gchar *fileName, goffset *size);
+
 ///
 /// @brief Constructs a new main presenter with a default document.
 ///
@@ -53,8 +65,13 @@ MainPter::MainPter (IDocument *document)
 {
     g_assert (NULL != document && "Tried to set a NULL document");
 
+    m_AutoReloadChecks = 0;
+    m_AutoReloading = FALSE;
+    m_AutoReloadSize = -1;
+    m_AutoReloadSource = 0;
     m_Document = document;
     m_Document->attach (this);
+    m_FileMonitor = NULL;
     m_View = NULL;
     m_PagePter = NULL;
     m_FindPter = NULL;
@@ -68,6 +85,8 @@ MainPter::MainPter (IDocument *document)
     m_CachedCurrentPage = -1;
     m_CachedTotalPages = -1;
     m_CachedDocumentLoaded = FALSE;
+    m_CurrentSection = NULL;
+    m_ShowLoadedOutline = FALSE;
     // Initial zoom not yet applied
     m_InitialZoomApplied = FALSE;
 #if defined (DEBUG)
@@ -85,6 +104,7 @@ MainPter::MainPter (IDocument *document)
 ///
 MainPter::~MainPter ()
 {
+    stopWatchingFile ();
     // Need to delete the page presenter first before deleting
     // the document, because the page presenter will detach itself
     // from the document.
@@ -160,6 +180,7 @@ MainPter::setInitialState ()
         view.sensitiveRotateRight (TRUE);
         view.sensitiveRotateLeft (TRUE);
         view.sensitiveSave (TRUE);
+        view.sensitiveSaveText (TRUE);
         view.sensitiveZoom (TRUE);
         view.sensitiveZoomIn (TRUE);
         view.sensitiveZoomOut (TRUE);
@@ -174,10 +195,13 @@ MainPter::setInitialState ()
 
         // Check if we should see the outlines.
         showSidebar = (0 < m_Document->getOutline ()->getNumChildren () &&
-                       PageModeOutlines == m_Document->getPageMode ());
+                       PageModeOutlines == m_Document->getPageMode ()) ||
+                      PageModeThumbs == m_Document->getPageMode ();
         // IDocument::getOutline is set if and only if m_Document is
         // loaded.
         view.setOutline (m_Document->getOutline ());
+        m_CurrentSection = NULL;
+        view.setThumbnails (m_Document->getNumPages ());
     }
     else
     {
@@ -200,11 +224,13 @@ MainPter::setInitialState ()
         view.sensitiveRotateRight (FALSE);
         view.sensitiveRotateLeft (FALSE);
         view.sensitiveSave (FALSE);
+        view.sensitiveSaveText (FALSE);
         view.sensitiveZoom (FALSE);
         view.sensitiveZoomIn (FALSE);
         view.sensitiveZoomOut (FALSE);
         view.sensitiveZoomFit (FALSE);
         view.sensitiveZoomWidth (FALSE);
+        view.setThumbnails (0);
         showSidebar = FALSE;
 #if defined (HAVE_CUPS)
         view.sensitivePrint (FALSE);
@@ -235,6 +261,32 @@ MainPter::setInitialState ()
     view.show ();
 }
 
+///
+/// @brief Highlights the outline's section of a page.
+///
+/// The document's outline index finds the section in logarithmic time,
+/// so this can be done on every page change even for huge outlines.
+/// The view is only told when the section changes. When the selected
+/// item starts at the same page as the section, like a chapter and its
+/// first section, it's kept so the item the user clicked stays selected.
+///
+/// @param pageNum The page to highlight the section of.
+///
+void
+MainPter::selectCurrentSection (gint pageNum)
+{
+    DocumentOutline *section = m_Document->getOutlineSection (pageNum);
+    if ( section == m_CurrentSection ||
+         ( NULL != section && NULL != m_CurrentSection &&
+           section->getDestinationPage () ==
+               m_CurrentSection->getDestinationPage () ) )
+    {
+        return;
+    }
+    m_CurrentSection = section;
+    getView ().selectOutline (section);
+}
+
 ///
 /// @brief Sets the view's state while loading or reloading a document.
 ///
@@ -267,6 +319,7 @@ MainPter::setOpenState (const gchar *fileName, gboolean reload)
     view.sensitiveRotateRight (FALSE);
     view.sensitiveRotateLeft (FALSE);
     view.sensitiveSave (FALSE);
+    view.sensitiveSaveText (FALSE);
     view.sensitiveZoom (FALSE);
     view.sensitiveZoomIn (FALSE);
     view.sensitiveZoomOut (FALSE);
@@ -533,6 +586,8 @@ MainPter::outlineActivated (DocumentOutline *outline)
 {
     g_assert (NULL != outline && "The outline activated is NULL.");
 
+    // The view already selected it.
+    m_CurrentSection = outline;
     m_PagePter->setNextPageScroll (PAGE_SCROLL_START);
     m_Document->goToPage (outline->getDestinationPage ());
 }
@@ -708,6 +763,44 @@ MainPter::saveFileActivated ()
     }
 }
 
+///
+/// @brief The "Save Text" was activated.
+///
+/// The presenter asks the view for the name of the text file and then
+/// lets the document save the text of all its pages in the background.
+/// The progress is shown in the status bar.
+///
+void
+MainPter::saveTextActivated ()
+{
+    Config &config = Config::getConfig ();
+    gchar *lastFolder = config.getSaveFileFolder ();
+    IMainView &view = getView ();
+    gchar *baseName = g_path_get_basename (m_Document->getFileName ());
+    gchar *extension = g_strrstr (baseName, ".");
+    if ( NULL != extension && extension != baseName )
+    {
+        *extension = '\0';
+    }
+    gchar *textFileName = g_strconcat (baseName, ".txt", NULL);
+    gchar *fileName = view.saveTextFileDialog (lastFolder, textFileName);
+    g_free (textFileName);
+    g_free (baseName);
+    g_free (lastFolder);
+    if ( NULL != fileName )
+    {
+        gchar *statusText = g_strdup_printf (_("Saving text to %s..."),
+                                             fileName);
+        view.setStatusBarText (statusText);
+        g_free (statusText);
+        gchar *dirName = g_path_get_dirname (fileName);
+        config.setSaveFileFolder (dirName);
+        g_free (dirName);
+        m_Document->saveText (fileName);
+        g_free (fileName);
+    }
+}
+
 
 ///
 /// @brief The "Show Index" was activated.
@@ -770,6 +863,67 @@ MainPter::showToolbarActivated (gboolean show)
     getView ().showToolbar (show);
 }
 
+///
+/// @brief A page's thumbnail was activated.
+///
+/// When the user clicks on a thumbnail in the sidebar, the view tells
+/// the presenter which page to go to.
+///
+/// @param pageNum The number of the thumbnail's page.
+///
+void
+MainPter::thumbnailActivated (gint pageNum)
+{
+    m_PagePter->setNextPageScroll (PAGE_SCROLL_START);
+    m_Document->goToPage (pageNum);
+}
+
+///
+/// @brief A page's thumbnail is no longer visible.
+///
+/// Its render is skipped if it's still queued.
+///
+/// @param pageNum The number of the thumbnail's page.
+///
+void
+MainPter::thumbnailHidden (gint pageNum)
+{
+    m_Document->cancelThumbnail (pageNum);
+}
+
+///
+/// @brief A page's thumbnail became visible.
+///
+/// Shows the cached thumbnail, if any, or else queues its render.
+///
+/// @param pageNum The number of the thumbnail's page.
+///
+void
+MainPter::thumbnailShown (gint pageNum)
+{
+    DocumentPage *thumbnail = m_Document->getThumbnail (pageNum);
+    if ( NULL != thumbnail )
+    {
+        getView ().showThumbnail (pageNum, thumbnail);
+    }
+    else
+    {
+        m_Document->requestThumbnail (pageNum);
+    }
+}
+
+///
+/// @brief The view's window got the focus or its tab was selected.
+///
+/// Its document becomes the last to release its cached images when
+/// the documents open use too much memory.
+///
+void
+MainPter::windowActivated ()
+{
+    CacheBudget::getBudget ().activate (m_Document);
+}
+
 ///
 /// @brief The user entered a zoom value.
 ///
@@ -980,10 +1134,15 @@ MainPter::openDocument (const gchar *fileName, const gchar *oldPassword,
 void
 MainPter::notifyLoad ()
 {
+    StartupProfile::mark ("document loaded");
     setInitialState ();
+    watchFile ();
     
     // Reset flag so initial zoom will be applied when page is ready
     m_InitialZoomApplied = FALSE;
+    // The outline is read after the first page is shown.
+    m_ShowLoadedOutline = TRUE;
+    getView ().showThumbnails (PageModeThumbs == m_Document->getPageMode ());
     
     m_Document->goToFirstPage ();
     // This way will inform all observers even if the page doesn't
@@ -1000,6 +1159,20 @@ MainPter::notifyLoad ()
 void
 MainPter::notifyLoadError (const gchar *fileName, const GError *error)
 {
+    StartupProfile::finish ("load error");
+    // A file that changed on its own keeps showing the last document
+    // that could be read, until it changes again.
+    if ( m_AutoReloading )
+    {
+        m_AutoReloading = FALSE;
+        getView ().setStatusBarText (error->message);
+#if defined (DEBUG)
+        G_LOCK (fileLoaded);
+        fileLoaded = TRUE;
+        G_UNLOCK (fileLoaded);
+#endif // DEBUG
+        return;
+    }
     gchar *errorTitle = g_strdup_printf ("%s \"%s\"", _("Error Loading File"), fileName);
     getView ().showErrorMessage (errorTitle, error->message);
     g_free (errorTitle);
@@ -1014,6 +1187,7 @@ MainPter::notifyLoadError (const gchar *fileName, const GError *error)
 void
 MainPter::notifyLoadPassword (const gchar *fileName, gboolean reload, const GError *error)
 {
+    StartupProfile::finish ("password asked");
     if ( 0 < m_PasswordTries )
     {
         m_PasswordTries--;
@@ -1053,6 +1227,31 @@ MainPter::notifyLoadPassword (const gchar *fileName, gboolean reload, const GErr
     }
 }
 
+void
+MainPter::notifyOutlineIndexed ()
+{
+    m_CurrentSection = NULL;
+    selectCurrentSection (m_Document->getCurrentPageNum ());
+}
+
+void
+MainPter::notifyOutlineLoaded (DocumentOutline *outline)
+{
+    IMainView &view = getView ();
+    view.setOutline (outline);
+    m_CurrentSection = NULL;
+    selectCurrentSection (m_Document->getCurrentPageNum ());
+    // Only a new document may open the index by itself, a reloaded
+    // document keeps the index as the user left it.
+    if ( m_ShowLoadedOutline &&
+         0 < outline->getNumChildren () &&
+         PageModeOutlines == m_Document->getPageMode () )
+    {
+        view.showIndex (TRUE);
+    }
+    m_ShowLoadedOutline = FALSE;
+}
+
 void
 MainPter::notifyPageChanged (gint pageNum)
 {
@@ -1087,6 +1286,8 @@ MainPter::notifyPageChanged (gint pageNum)
         m_CachedTotalPages = numPages;
         m_CachedDocumentLoaded = documentLoaded;
     }
+    selectCurrentSection (pageNum);
+    view.selectThumbnail (pageNum);
 
     // Only check zoom settings if document is actually loaded
     if (documentLoaded)
@@ -1140,10 +1341,35 @@ MainPter::notifyPageZoomed (gdouble zoom)
     view.sensitiveZoomOut (m_Document->canZoomOut ());
 }
 
+void
+MainPter::notifyPrint ()
+{
+    // Remove the status text.
+    getView ().setStatusBarText (NULL);
+}
+
+void
+MainPter::notifyPrintError (const GError *error)
+{
+    getView ().setStatusBarText (NULL);
+    getView ().showErrorMessage (_("Error Printing"), error->message);
+}
+
+void
+MainPter::notifyPrintProgress (guint numPagesPrinted, guint numPagesToPrint)
+{
+    gchar *statusText = g_strdup_printf (_("Printing page %u of %u..."),
+                                         numPagesPrinted, numPagesToPrint);
+    getView ().setStatusBarText (statusText);
+    g_free (statusText);
+}
+
 void
 MainPter::notifyReload ()
 {
+    m_AutoReloading = FALSE;
     gboolean showIndex = getView ().isIndexVisible();
+    m_ShowLoadedOutline = FALSE;
     setInitialState ();
     getView ().showIndex(showIndex);
     m_Document->goToPage(m_ReloadPage);
@@ -1178,6 +1404,33 @@ MainPter::notifySaveError (const GError *error)
 #endif // DEBUG
 }
 
+void
+MainPter::notifySaveText ()
+{
+    // Remove the status text.
+    getView ().setStatusBarText (NULL);
+}
+
+void
+MainPter::notifySaveTextError (const GError *error)
+{
+    getView ().setStatusBarText (NULL);
+    // Cancelling isn't an error the user needs to be told about.
+    if ( !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED) )
+    {
+        getView ().showErrorMessage (_("Error Saving Text"), error->message);
+    }
+}
+
+void
+MainPter::notifySaveTextProgress (guint numPagesSaved, guint numPagesToSave)
+{
+    gchar *statusText = g_strdup_printf (_("Saving text of page %u of %u..."),
+                                         numPagesSaved, numPagesToSave);
+    getView ().setStatusBarText (statusText);
+    g_free (statusText);
+}
+
 #if defined (DEBUG)
 ///
 /// @brief Waits until a file is loaded.
@@ -1227,3 +1480,198 @@ MainPter::notifyTextSelected (const gchar* text)
 {
     getView ().copyTextToClibboard(text);
 }
+
+void
+MainPter::notifyThumbnailRendered (gint pageNum, DocumentPage *thumbnail)
+{
+    getView ().showThumbnail (pageNum, thumbnail);
+}
+
+///
+/// @brief Reloads the document once its file stopped changing.
+///
+/// This is the timeout scheduled by scheduleAutoReload().
+///
+/// @param user The MainPter whose document changed.
+///
+/// @return FALSE, to remove the timeout source.
+///
+gboolean
+MainPter::autoReload (gpointer user)
+{
+    g_assert (NULL != user && "The data parameter is NULL.");
+
+    MainPter *pter = (MainPter *)user;
+    pter->m_AutoReloadSource = 0;
+    pter->reloadChangedFile ();
+
+    return FALSE;
+}
+
+///
+/// @brief The document's file changed.
+///
+/// @param monitor The monitor of the document's file.
+/// @param file The file that changed.
+/// @param otherFile The file's new name, when it was moved.
+/// @param event What happened to the file.
+/// @param user The MainPter whose document changed.
+///
+void
+MainPter::fileChanged (GFileMonitor *monitor, GFile *file, GFile *otherFile,
+                       GFileMonitorEvent event, gpointer user)
+{
+    g_assert (NULL != user && "The data parameter is NULL.");
+
+    // A deleted file is usually created again by the program that saves it.
+    if ( G_FILE_MONITOR_EVENT_CHANGED == event ||
+         G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT == event ||
+         G_FILE_MONITOR_EVENT_CREATED == event )
+    {
+        ((MainPter *)user)->scheduleAutoReload ();
+    }
+}
+
+///
+/// @brief Reloads the document if its file is complete.
+///
+/// A file that doesn't end with the end of file marker or that changed
+/// its size since the last change is still being written, so the reload
+/// waits for a few more times.
+///
+void
+MainPter::reloadChangedFile ()
+{
+    goffset size = -1;
+    if ( !isFileComplete (m_Document->getFileName (), &size) ||
+         size != m_AutoReloadSize )
+    {
+        m_AutoReloadSize = size;
+        if ( 0 < m_AutoReloadChecks )
+        {
+            m_AutoReloadChecks--;
+            m_AutoReloadSource = g_timeout_add (AUTO_RELOAD_DELAY,
+                                                MainPter::autoReload, this);
+        }
+        return;
+    }
+
+    m_AutoReloading = TRUE;
+    m_ReloadPage = m_Document->getCurrentPageNum ();
+    m_Document->reload ();
+}
+
+///
+/// @brief Reloads the document once its file stops changing.
+///
+/// Each change delays the reload, so a file written in several steps
+/// is only reloaded once.
+///
+void
+MainPter::scheduleAutoReload ()
+{
+    if ( 0 != m_AutoReloadSource )
+    {
+        g_source_remove (m_AutoReloadSource);
+    }
+    isFileComplete (m_Document->getFileName (), &m_AutoReloadSize);
+    m_AutoReloadChecks = AUTO_RELOAD_CHECKS;
+    m_AutoReloadSource = g_timeout_add (AUTO_RELOAD_DELAY,
+                                        MainPter::autoReload, this);
+}
+
+///
+/// @brief Stops watching the document's file for changes.
+///
+void
+MainPter::stopWatchingFile ()
+{
+    if ( 0 != m_AutoReloadSource )
+    {
+        g_source_remove (m_AutoReloadSource);
+        m_AutoReloadSource = 0;
+    }
+    if ( NULL != m_FileMonitor )
+    {
+        g_signal_handlers_disconnect_by_data (m_FileMonitor, this);
+        g_file_monitor_cancel (m_FileMonitor);
+        g_object_unref (m_FileMonitor);
+        m_FileMonitor = NULL;
+    }
+}
+
+///
+/// @brief Starts watching the document's file for changes.
+///
+/// The document is reloaded when its file changes, unless the user
+/// disabled it or the document was read from the standard input.
+///
+void
+MainPter::watchFile ()
+{
+    stopWatchingFile ();
+    const gchar *fileName = m_Document->getFileName ();
+    if ( !Config::getConfig ().autoReload () ||
+         NULL == fileName || '\0' == fileName[0] ||
+         0 == g_ascii_strcasecmp ("-", fileName) )
+    {
+        m_Document->setWatched (FALSE);
+        return;
+    }
+    m_Document->setWatched (TRUE);
+
+    GFile *file = g_file_new_for_path (fileName);
+    m_FileMonitor = g_file_monitor_file (file, G_FILE_MONITOR_NONE,
+                                         NULL, NULL);
+    g_object_unref (file);
+    if ( NULL != m_FileMonitor )
+    {
+        g_signal_connect (m_FileMonitor, "changed",
+                          G_CALLBACK (MainPter::fileChanged), this);
+    }
+}
+
+///
+/// @brief Checks if a PDF file looks completely written.
+///
+/// @param fileName The name of the file to check.
+/// @param size The location to store the file's size, or -1 if the
+///             file can't be read.
+///
+/// @return TRUE if the file ends with the PDF end of file marker,
+///         FALSE otherwise.
+///
+gboolean
+isFileComplete (const gchar *fileName, goffset *size)
+{
+    static const gchar END_OF_FILE[] = "%%EOF";
+    static const gsize END_OF_FILE_LENGTH = sizeof (END_OF_FILE) - 1;
+
+    *size = -1;
+    FILE *file = fopen (fileName, "rb");
+    if ( NULL == file )
+    {
+        return FALSE;
+    }
+    gboolean complete = FALSE;
+    if ( 0 == fseeko (file, 0, SEEK_END) )
+    {
+        *size = ftello (file);
+        goffset start = MAX (0, *size - (goffset)END_OF_FILE_SEARCH_SIZE);
+        gchar buffer[END_OF_FILE_SEARCH_SIZE];
+        if ( 0 == fseeko (file, start, SEEK_SET) )
+        {
+            gsize length = fread (buffer, 1, sizeof (buffer), file);
+            for ( gsize position = 0 ;
+                  !complete && position + END_OF_FILE_LENGTH <= length ;
+                  position++ )
+            {
+                complete = ( 0 == memcmp (&buffer[position], END_OF_FILE,
+                                          END_OF_FILE_LENGTH) );
+            }
+        }
+    }
+    fclose (file);
+
+    return complete;
+}
@@ -72,11 +72,16 @@ namespace ePDFView
             void rotateLeftActivated (void);
             void rotateRightActivated (void);
             void saveFileActivated (void);
+            void saveTextActivated (void);
             void showIndexActivated (gboolean show);
             void showMenubarActivated (gboolean show); //krogan
             void invertToggleActivated (gboolean on); //krogan
             void showStatusbarActivated (gboolean show);
             void showToolbarActivated (gboolean show);
+            void thumbnailActivated (gint pageNum);
+            void thumbnailHidden (gint pageNum);
+            void thumbnailShown (gint pageNum);
+            void windowActivated (void);
             void zoomActivated (void);
             void zoomFitActivated (gboolean active);
             void zoomInActivated (void);
@@ -89,13 +94,25 @@ namespace ePDFView
             void notifyLoadError (const gchar *fileName, const GError *error);
             void notifyLoadPassword (const gchar *fileName, gboolean reload,
                                      const GError *error);
+            void notifyOutlineIndexed (void);
+            void notifyOutlineLoaded (DocumentOutline *outline);
             void notifyPageChanged (gint pageNum);
             void notifyPageRotated (gint rotation);
             void notifyPageZoomed (gdouble zoom);
+            void notifyPrint (void);
+            void notifyPrintError (const GError *error);
+            void notifyPrintProgress (guint numPagesPrinted,
+                                      guint numPagesToPrint);
             void notifyReload (void);
             void notifySave (void);
             void notifySaveError (const GError *error);
+            void notifySaveText (void);
+            void notifySaveTextError (const GError *error);
+            void notifySaveTextProgress (guint numPagesSaved,
+                                         guint numPagesToSave);
             void notifyTextSelected (const gchar* text);
+            void notifyThumbnailRendered (gint pageNum,
+                                          DocumentPage *thumbnail);
 
 			gboolean isDocumentLoaded(void);
 			
@@ -110,8 +127,18 @@ namespace ePDFView
             void checkZoomSettings (void);
 
         protected:
+            /// The number of size checks left before reloading a changed file.
+            guint m_AutoReloadChecks;
+            /// Tells if the document is being reloaded because its file changed.
+            gboolean m_AutoReloading;
+            /// The file's size when it last changed, or -1 if unknown.
+            goffset m_AutoReloadSize;
+            /// The timeout that reloads the changed file, or 0 if none.
+            guint m_AutoReloadSource;
             /// The document that it's showing.
             IDocument *m_Document;
+            /// The monitor of the document's file, or NULL if not watched.
+            GFileMonitor *m_FileMonitor;
             /// The presenter of the find bar.
             FindPter *m_FindPter;
             /// The number of times the password has been tried for a document.
@@ -137,11 +164,26 @@ namespace ePDFView
             gint m_CachedCurrentPage;
             gint m_CachedTotalPages;
             gboolean m_CachedDocumentLoaded;
+            /// The outline item of the section the current page is in.
+            DocumentOutline *m_CurrentSection;
+            /// Whether to show the index if the outline read after the
+            /// load isn't empty.
+            gboolean m_ShowLoadedOutline;
             
             /// Flag to track if initial zoom has been applied
             gboolean m_InitialZoomApplied;
 
+            static gboolean autoReload (gpointer user);
+            static void fileChanged (GFileMonitor *monitor, GFile *file,
+                                     GFile *otherFile,
+                                     GFileMonitorEvent event,
+                                     gpointer user);
+            void reloadChangedFile (void);
+            void scheduleAutoReload (void);
+            void selectCurrentSection (gint pageNum);
             void setZoomText (gdouble zoom);
+            void stopWatchingFile (void);
+            void watchFile (void);
             void zoomFit (void);
             void zoomWidth (void);
             void zoomHeight (void);
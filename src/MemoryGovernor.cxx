@@ -0,0 +1,181 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+#if defined (HAVE_MALLOC_TRIM)
+#include <malloc.h>
+#endif // HAVE_MALLOC_TRIM
+
+using namespace ePDFView;
+
+MemoryGovernor *MemoryGovernor::m_Governor = NULL;
+
+///
+/// @brief Constructs a new MemoryGovernor object.
+///
+/// The governor doesn't listen to the system's warnings until start()
+/// is called.
+///
+MemoryGovernor::MemoryGovernor ()
+{
+    m_LastLevel = (GMemoryMonitorWarningLevel)0;
+    m_Monitor = NULL;
+    m_NumWarnings = 0;
+}
+
+///
+/// @brief Stops listening to the system's warnings.
+///
+MemoryGovernor::~MemoryGovernor ()
+{
+    if ( NULL != m_Monitor )
+    {
+        g_signal_handlers_disconnect_by_data (m_Monitor, this);
+        g_object_unref (m_Monitor);
+    }
+}
+
+///
+/// @brief Destroys the governor.
+///
+void
+MemoryGovernor::destroy ()
+{
+    delete m_Governor;
+    m_Governor = NULL;
+}
+
+///
+/// @brief Gets the governor.
+///
+/// The first time this function is called creates the governor.
+///
+/// @return The reference to the governor.
+///
+MemoryGovernor &
+MemoryGovernor::getGovernor ()
+{
+    if ( NULL == m_Governor )
+    {
+        m_Governor = new MemoryGovernor ();
+    }
+
+    g_assert (NULL != m_Governor && "The memory governor is NULL.");
+    return *m_Governor;
+}
+
+///
+/// @brief Gets the level of the last warning.
+///
+/// @return The level of the last low memory warning, or 0 if none was
+///         received.
+///
+GMemoryMonitorWarningLevel
+MemoryGovernor::getLastLevel ()
+{
+    return m_LastLevel;
+}
+
+///
+/// @brief Gets the number of warnings received.
+///
+/// @return How many low memory warnings were received.
+///
+guint
+MemoryGovernor::getNumWarnings ()
+{
+    return m_NumWarnings;
+}
+
+///
+/// @brief Frees memory after a low memory warning.
+///
+/// This is called when the system's memory monitor warns, but it can
+/// be called directly to send a warning.
+///
+/// @param level How low the system is on memory.
+///
+/// @return The bytes freed from the documents' caches.
+///
+gsize
+MemoryGovernor::notifyLowMemory (GMemoryMonitorWarningLevel level)
+{
+    m_LastLevel = level;
+    m_NumWarnings++;
+
+    CacheBudget &budget = CacheBudget::getBudget ();
+    gsize released = budget.releasePrefetchedPages ();
+    if ( G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM <= level )
+    {
+        released += budget.release (G_MAXSIZE);
+    }
+    if ( G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL <= level )
+    {
+        budget.notifyLowMemory ();
+    }
+#if defined (HAVE_MALLOC_TRIM)
+    // The freed images are too large to be reused soon.
+    malloc_trim (0);
+#endif // HAVE_MALLOC_TRIM
+
+    g_debug ("Low memory warning (level %d): %" G_GSIZE_FORMAT
+             " bytes of cache freed", level, released);
+    return released;
+}
+
+///
+/// @brief Starts listening to the system's low memory warnings.
+///
+/// The warnings are received in the main loop of the thread that
+/// calls this function.
+///
+void
+MemoryGovernor::start ()
+{
+    if ( NULL != m_Monitor )
+    {
+        return;
+    }
+
+    m_Monitor = g_memory_monitor_dup_default ();
+    g_signal_connect (m_Monitor, "low-memory-warning",
+                      G_CALLBACK (MemoryGovernor::lowMemoryWarning), this);
+}
+
+///
+/// @brief The system's memory monitor warns of low memory.
+///
+/// @param monitor The system's memory monitor.
+/// @param level How low the system is on memory.
+/// @param data The MemoryGovernor that listens to the warnings.
+///
+void
+MemoryGovernor::lowMemoryWarning (GMemoryMonitor *monitor,
+                                  GMemoryMonitorWarningLevel level,
+                                  gpointer data)
+{
+    g_assert (NULL != data && "The data parameter is NULL.");
+
+    MemoryGovernor *governor = (MemoryGovernor *)data;
+    governor->notifyLowMemory (level);
+}
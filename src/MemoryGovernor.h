@@ -0,0 +1,78 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__MEMORY_GOVERNOR_H__)
+#define __MEMORY_GOVERNOR_H__
+
+namespace ePDFView
+{
+    ///
+    /// @class MemoryGovernor
+    /// @brief Frees the caches when the system is low on memory.
+    ///
+    /// The governor listens to the low memory warnings of the system's
+    /// GMemoryMonitor and frees the memory that can be rebuilt, the most
+    /// costly to rebuild last:
+    ///
+    /// - On any warning, the pages rendered in advance are deleted.
+    /// - From G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM, the compressed
+    ///   pages and the thumbnails of all documents are deleted too.
+    /// - From G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL, the views delete
+    ///   their scaled copies of the page as well.
+    ///
+    /// After that the freed memory is given back to the system. The
+    /// warnings can be sent with notifyLowMemory() for testing.
+    ///
+    /// Like Config, there is a single instance that can be destroyed
+    /// with MemoryGovernor::destroy(), mostly for testing.
+    ///
+    class MemoryGovernor
+    {
+        public:
+            static void destroy (void);
+            static MemoryGovernor &getGovernor (void);
+
+            GMemoryMonitorWarningLevel getLastLevel (void);
+            guint getNumWarnings (void);
+            gsize notifyLowMemory (GMemoryMonitorWarningLevel level);
+            void start (void);
+
+        protected:
+            /// The only instance.
+            static MemoryGovernor *m_Governor;
+            /// The level of the last warning, or 0 if none was received.
+            GMemoryMonitorWarningLevel m_LastLevel;
+            /// The system's memory monitor, or NULL until start().
+            GMemoryMonitor *m_Monitor;
+            /// The number of warnings received.
+            guint m_NumWarnings;
+
+            MemoryGovernor (void);
+            ~MemoryGovernor (void);
+
+            static void lowMemoryWarning (GMemoryMonitor *monitor,
+                                          GMemoryMonitorWarningLevel level,
+                                          gpointer data);
+    };
+}
+
+#endif // !__MEMORY_GOVERNOR_H__
@@ -21,23 +21,66 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <config.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <gdk/gdk.h>
+#include <glib/gstdio.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <poppler.h>
 #include <unistd.h>
 #include <algorithm>
+#if defined (HAVE_FICLONE)
+#include <linux/fs.h>
+#endif // HAVE_FICLONE
 #include "epdfview.h"
 
 using namespace ePDFView;
 
+G_LOCK_DEFINE_STATIC (namedDestinations);
+G_LOCK_DEFINE_STATIC (pageFingerprints);
+G_LOCK_DEFINE_STATIC (pageSizes);
+G_LOCK_DEFINE_STATIC (textLayouts);
+
 // Constants.
 static const gint PIXBUF_BITS_PER_SAMPLE = 8;
 static const gint DATE_LENGTH = 100;
+/// The minimum number of bytes to read from the standard input at once.
+static const gsize STDIN_READ_SIZE = 1024 * 1024;
+/// The scale of the render that tells if a page's drawing changed.
+static const gdouble FINGERPRINT_SCALE = 0.25;
+/// The size of the buffer to copy a file when the kernel can't.
+static const gsize SAVE_BUFFER_SIZE = 1024 * 1024;
+
+///
+/// @brief The unrotated size of a page.
+///
+typedef struct
+{
+    /// The page's width.
+    gdouble width;
+    /// The page's height.
+    gdouble height;
+} PageSize;
 
 // Forward declarations.
+static void addAreaToChecksum (GChecksum *checksum,
+                               const PopplerRectangle *area);
 static PageLayout convertPageLayout (gint pageLayout);
 static PageMode convertPageMode (gint pageMode);
+static gboolean copyFileContents (gint sourceFd, gint destinationFd,
+                                  goffset size);
 static gchar *getAbsoluteFileName (const gchar *fileName);
+static gchar *getPageFingerprint (PopplerDocument *document, gint pageNum);
+static gboolean isSameFile (const struct stat *info,
+                            const struct stat *other);
+static PageSize readPageSize (PopplerDocument *document, gint pageNum);
+static GBytes *readStandardInput (GError **error);
+#if defined (HAVE_POPPLER_0_78_0)
+static gboolean addNamedDestination (gpointer key, gpointer value,
+                                     gpointer data);
+#endif // HAVE_POPPLER_0_78_0
 
 namespace
 {
@@ -65,8 +108,19 @@ namespace
 PDFDocument::PDFDocument ():
     IDocument ()
 {
+    m_Core = NULL;
     m_Document = NULL;
+    m_IsCopy = FALSE;
+    m_NamedDestinations = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, NULL);
+    m_NamedDestinationsLoaded = FALSE;
     m_PostScript = NULL;
+    m_PostScriptFd = -1;
+    m_PageFingerprints = g_ptr_array_new_with_free_func (g_free);
+    m_PageSizes = g_array_new (FALSE, FALSE, sizeof (PageSize));
+    m_Contents = NULL;
+    m_SourceInfoValid = FALSE;
+    m_TextLayouts = g_ptr_array_new ();
 }
 
 ///
@@ -74,22 +128,83 @@ PDFDocument::PDFDocument ():
 ///
 PDFDocument::~PDFDocument ()
 {
+    stopJobs ();
     clearCache ();
     outputPostscriptEnd ();
-    if ( NULL != m_Document )
+    releaseCore ();
+    if ( NULL != m_Contents )
     {
-        g_object_unref (G_OBJECT (m_Document));
-        m_Document = NULL;
+        g_bytes_unref (m_Contents);
     }
+    g_hash_table_destroy (m_NamedDestinations);
+    g_ptr_array_free (m_PageFingerprints, TRUE);
+    clearTextLayouts (FALSE);
+    g_ptr_array_free (m_TextLayouts, TRUE);
+    g_array_unref (m_PageSizes);
 }
 
+///
+/// @brief Makes a copy of the document to read from another thread.
+///
+/// The copy takes a parsed document of its own from the core the
+/// document shares with its copies, which only parses the document
+/// again when no earlier copy gave one back. The bytes, the page sizes
+/// table and the metadata already read are shared or copied, so they
+/// aren't read again. Reloading or closing this document later doesn't
+/// change the copy.
+///
+/// @return A new document that must be deleted when no longer needed,
+///         or NULL if the document isn't loaded or couldn't be parsed
+///         again.
+///
 IDocument *
 PDFDocument::copy () const
 {
-    // Making a deep copy is just making a new document and loading the same
-    // file.
+    if ( NULL == m_Core )
+    {
+        return NULL;
+    }
+    PopplerDocument *document = m_Core->acquire ();
+    if ( NULL == document )
+    {
+        return NULL;
+    }
+
     PDFDocument *newDocument = new PDFDocument ();
-    newDocument->loadFile (getFileName (), getPassword (), NULL);
+    newDocument->m_Core = m_Core->ref ();
+    newDocument->m_Document = document;
+    newDocument->m_IsCopy = TRUE;
+    newDocument->setFileName (getFileName ());
+    newDocument->setPassword (getPassword ());
+    if ( NULL != m_Contents )
+    {
+        newDocument->m_Contents = g_bytes_ref (m_Contents);
+    }
+    newDocument->m_SourceInfo = m_SourceInfo;
+    newDocument->m_SourceInfoValid = m_SourceInfoValid;
+    G_LOCK (pageSizes);
+    g_array_unref (newDocument->m_PageSizes);
+    newDocument->m_PageSizes = g_array_ref (m_PageSizes);
+    G_UNLOCK (pageSizes);
+
+    newDocument->setAuthor (g_strdup (m_Author));
+    newDocument->setCreationDate (g_strdup (m_CreationDate));
+    newDocument->setCreator (g_strdup (m_Creator));
+    newDocument->setFormat (g_strdup (m_Format));
+    newDocument->setKeywords (g_strdup (m_Keywords));
+#if defined (HAVE_POPPLER_0_15_1)
+    newDocument->setLinearized (m_Linearized);
+#else // !HAVE_POPPLER_0_15_1
+    newDocument->setLinearized (g_strdup (m_Linearized));
+#endif // HAVE_POPPLER_0_15_1
+    newDocument->setModifiedDate (g_strdup (m_ModifiedDate));
+    newDocument->setProducer (g_strdup (m_Producer));
+    newDocument->setSubject (g_strdup (m_Subject));
+    newDocument->setTitle (g_strdup (m_Title));
+    newDocument->setPageLayout (m_PageLayout);
+    newDocument->setPageMode (m_PageMode);
+    newDocument->setNumPages (m_PageNumber);
+    newDocument->m_Outline = new DocumentOutline ();
 
     return newDocument;
 }
@@ -100,25 +215,26 @@ PDFDocument::copy () const
 /// Based on the passed @a link, this function creates a new document
 /// links of the best type for the link's action.
 ///
+/// The link's coordinates are unscaled, but with the origin moved to the
+/// page's top-left corner.
+///
 /// @param link The link to create the document link from.
 /// @param pageHeight The unscaled size of the page's height.
-/// @param scale The scale to calculate the link's coordinates.
 ///
 /// @return The link best suited for @a link or NULL if no link can be
 ///         created.
 IDocumentLink *
 PDFDocument::createDocumentLink (const PopplerLinkMapping *link,
-                                 const gdouble pageHeight,
-                                 const gdouble scale)
+                                 const gdouble pageHeight)
 {
     PopplerAction *action = link->action;
     IDocumentLink *documentLink = NULL;
 
     // Calculate the four link's corners.
-    gdouble topLeft = link->area.x1 * scale;
-    gdouble topRight = link->area.x2 * scale;
-    gdouble bottomLeft = (pageHeight - link->area.y2) * scale;
-    gdouble bottomRight = (pageHeight - link->area.y1) * scale;
+    gdouble topLeft = link->area.x1;
+    gdouble topRight = link->area.x2;
+    gdouble bottomLeft = pageHeight - link->area.y2;
+    gdouble bottomRight = pageHeight - link->area.y1;
 
     switch (action->type)
     {
@@ -126,21 +242,7 @@ PDFDocument::createDocumentLink (const PopplerLinkMapping *link,
         case POPPLER_ACTION_GOTO_DEST:
         {
             PopplerActionGotoDest *actionGoTo = (PopplerActionGotoDest *)action;
-            PopplerDest *destination = actionGoTo->dest;
-            int pageNum = destination->page_num;
-#if POPPLER_CHECK_VERSION(0, 5, 2)
-            if ( POPPLER_DEST_NAMED == destination->type )
-            {
-                destination =
-                    poppler_document_find_dest (m_Document,
-                                                destination->named_dest);
-                if ( NULL != destination )
-                {
-                    pageNum = destination->page_num;
-                    poppler_dest_free (destination);
-                }
-            }
-#endif // HAVE_POPPLER_0_5_2
+            gint pageNum = getDestinationPage (actionGoTo->dest);
 
             documentLink = new DocumentLinkGoto (
                     topLeft, bottomLeft, topRight, bottomRight,
@@ -165,10 +267,24 @@ PDFDocument::createDocumentLink (const PopplerLinkMapping *link,
     return documentLink;
 }
 
-GList *
+///
+/// @brief Finds text on a single page.
+///
+/// All matches of the page are stored by value in a single array sized
+/// for the number of matches that Poppler gives, so a page with thousands
+/// of matches costs one allocation instead of one per match.
+///
+/// @param pageNum The number of the page to find the text in.
+/// @param textToFind The text to find in the page.
+///
+/// @return An array of DocumentRectangle with the unscaled positions of
+///         the matches, or NULL if the text is not on the page. The array
+///         must be freed with g_array_free (results, TRUE).
+///
+GArray *
 PDFDocument::findTextInPage (gint pageNum, const gchar *textToFind)
 {
-    GList *results = NULL;
+    GArray *results = NULL;
 
     if ( NULL == m_Document )
     {
@@ -181,22 +297,65 @@ PDFDocument::findTextInPage (gint pageNum, const gchar *textToFind)
         gdouble height = 1.0;
         poppler_page_get_size (page, NULL, &height);
         GList *matches = poppler_page_find_text (page, textToFind);
-        for ( GList *match = g_list_first (matches) ;
-              NULL != match ;
-              match = g_list_next (match) )
-        {
-            PopplerRectangle *matchRect = (PopplerRectangle *)match->data;
-            DocumentRectangle *rect =
-                new DocumentRectangle (matchRect->x1,
-                                       (height - matchRect->y2),
-                                       matchRect->x2,
-                                       (height - matchRect->y1));
-            results = g_list_prepend (results, rect);
+        guint numMatches = g_list_length (matches);
+        if ( 0 < numMatches )
+        {
+            results = g_array_sized_new (FALSE, FALSE,
+                                         sizeof (DocumentRectangle),
+                                         numMatches);
+            for ( GList *match = g_list_first (matches) ;
+                  NULL != match ;
+                  match = g_list_next (match) )
+            {
+                PopplerRectangle *matchRect = (PopplerRectangle *)match->data;
+                DocumentRectangle rect (matchRect->x1,
+                                        (height - matchRect->y2),
+                                        matchRect->x2,
+                                        (height - matchRect->y1));
+                g_array_append_val (results, rect);
+            }
         }
+        g_list_free_full (matches, (GDestroyNotify)poppler_rectangle_free);
         g_object_unref (G_OBJECT (page));
     }
 
-    return g_list_reverse (results);
+    return results;
+}
+
+///
+/// @brief Gets the text of a single page.
+///
+/// @param pageNum The number of the page to get its text.
+///
+/// @return The page's text in reading order, as Poppler lays it out, or
+///         NULL if the page has no text. Must be freed with g_free().
+///
+gchar *
+PDFDocument::getPageText (gint pageNum)
+{
+    if ( NULL == m_Document )
+    {
+        return NULL;
+    }
+
+    PopplerPage *page = poppler_document_get_page (m_Document, pageNum - 1);
+    if ( NULL == page )
+    {
+        return NULL;
+    }
+#if defined (HAVE_POPPLER_0_17_0)
+    gchar *text = poppler_page_get_text (page);
+#else // !HAVE_POPPLER_0_17_0
+    gdouble pageWidth;
+    gdouble pageHeight;
+    poppler_page_get_size (page, &pageWidth, &pageHeight);
+    PopplerRectangle pageRect = { 0, 0, pageWidth, pageHeight };
+    gchar *text = poppler_page_get_text (page, POPPLER_SELECTION_GLYPH,
+                                         &pageRect);
+#endif // HAVE_POPPLER_0_17_0
+    g_object_unref (G_OBJECT (page));
+
+    return text;
 }
 
 ///
@@ -215,6 +374,10 @@ PDFDocument::isLoaded ()
 ///
 /// Tries to open the PDF file @a filename using the password in @a password.
 ///
+/// When @a filename is "-" the document is read from the standard input
+/// straight to memory. Reloading such a document reuses the bytes read the
+/// first time, because the standard input can only be read once.
+///
 /// @param filename The name of the file name to open. It must be an absolute
 ///                 path.
 /// @param password The password to use to open @a filename.
@@ -229,50 +392,74 @@ PDFDocument::loadFile (const gchar *filename, const gchar *password,
 {
     g_assert (NULL != filename && "Tried to load a NULL file name");
 
-    gchar *absoluteFileName = getAbsoluteFileName (filename);
-    gchar *filename_uri = g_filename_to_uri (absoluteFileName, NULL, error);
-    g_free (absoluteFileName);
-    if ( NULL == filename_uri )
-    {
-        return FALSE;
-    }
     // Try to open the PDF document.
     GError *loadError = NULL;
-    // In case the user specified to read the PDF file from the stdin
-    // (i.e., -), then we save the contents of the stdin to a temporary
-    // file and use the URI to this temporary file to load.
+    GBytes *contents = NULL;
+    gchar *filename_uri = NULL;
+    PopplerDocument *newDocument = NULL;
+    struct stat sourceInfo;
+    gboolean sourceInfoValid = FALSE;
     if ( g_ascii_strcasecmp ("-", filename) == 0 )
     {
-        gchar *tmpFileName;
-        gint fd = g_file_open_tmp ("epdfviewXXXXXX", &tmpFileName, error);
-        if ( -1 == fd )
+        // A reload or a copy of a document read from the standard
+        // input has its bytes, but no name or "-" as the name.
+        const gchar *loadedName = getFileName ();
+        if ( NULL != m_Contents && ( '\0' == loadedName[0] ||
+                                     0 == g_ascii_strcasecmp ("-", loadedName) ) )
         {
-            return FALSE;
+            contents = g_bytes_ref (m_Contents);
         }
-        while ( !feof (stdin) )
+        else if ( NULL == (contents = readStandardInput (&loadError)) )
         {
-            gchar inputLine[512];
-            size_t readBytes = fread (inputLine, sizeof (char),
-                                      sizeof (inputLine) / sizeof (char),
-                                      stdin);
-            write (fd, inputLine, readBytes);
-        }
-        close (fd);
+            g_set_error (error,
+                         EPDFVIEW_DOCUMENT_ERROR, DocumentErrorOpenFile,
+                         _("Failed to load document '%s'.\n%s\n"),
+                         filename, loadError->message);
+            g_error_free (loadError);
 
-        g_free (filename_uri);
-        filename_uri = g_filename_to_uri (tmpFileName, NULL, error);
-        g_free (tmpFileName);
+            return FALSE;
+        }
+    }
+    else
+    {
+        gchar *absoluteFileName = getAbsoluteFileName (filename);
+        // Taken before reading the file, so a change while reading it
+        // makes saveFile() not trust the file anymore.
+        sourceInfoValid = (0 == g_stat (absoluteFileName, &sourceInfo));
+        // The file isn't mapped: a file truncated or rewritten in place
+        // while mapped, as when it's generated again, would crash with
+        // SIGBUS. Poppler's file reader gets read errors instead.
+        filename_uri = g_filename_to_uri (absoluteFileName, NULL, error);
+        g_free (absoluteFileName);
         if ( NULL == filename_uri )
         {
             return FALSE;
         }
+        newDocument = poppler_document_new_from_file (filename_uri,
+                                                      password,
+                                                      &loadError);
+    }
+    if ( NULL != contents )
+    {
+#if defined (HAVE_POPPLER_0_82_0)
+        newDocument = poppler_document_new_from_bytes (contents, password,
+                                                       &loadError);
+#else // !HAVE_POPPLER_0_82_0
+        // The data must be kept alive while the document is in use,
+        // that's why they are saved in m_Contents below.
+        newDocument = poppler_document_new_from_data (
+                (char *)g_bytes_get_data (contents, NULL),
+                (int)g_bytes_get_size (contents), password, &loadError);
+#endif // HAVE_POPPLER_0_82_0
     }
-    PopplerDocument *newDocument =
-        poppler_document_new_from_file (filename_uri, password, &loadError);
-    g_free (filename_uri);
     // Check if the document couldn't be opened successfully and why.
     if ( NULL == newDocument )
     {
+        if ( NULL != contents )
+        {
+            g_bytes_unref (contents);
+        }
+        g_free (filename_uri);
         DocumentError errorCode = DocumentErrorNone;
         switch ( loadError->code )
         {
@@ -305,34 +492,116 @@ PDFDocument::loadFile (const gchar *filename, const gchar *password,
         return FALSE;
     }
 
+    // When reloading the same file, the pages with cached data that
+    // didn't change can keep it.
+    if ( NULL != m_Document && 0 == g_strcmp0 (filename, getFileName ()) )
+    {
+        setUnchangedPages (findUnchangedPages (newDocument));
+    }
+    else
+    {
+        setUnchangedPages (NULL);
+        G_LOCK (pageFingerprints);
+        g_ptr_array_set_size (m_PageFingerprints, 0);
+        G_UNLOCK (pageFingerprints);
+    }
+
     // Set the used filename and password to let the user reload the
     // document.
     setFileName (filename);
     setPassword (password);
-    if ( NULL != m_Document )
+    // The copies of this document may still use the old page sizes.
+    gint numPages = poppler_document_get_n_pages (newDocument);
+    GArray *pageSizes = g_array_sized_new (FALSE, TRUE, sizeof (PageSize),
+                                           numPages);
+    g_array_set_size (pageSizes, numPages);
+    G_LOCK (pageSizes);
+    GArray *oldPageSizes = m_PageSizes;
+    m_PageSizes = pageSizes;
+    G_UNLOCK (pageSizes);
+    g_array_unref (oldPageSizes);
+    // The copies of this document keep the old core until deleted.
+    releaseCore ();
+    m_Core = new PDFDocumentCore (contents, filename_uri, password);
+    m_IsCopy = FALSE;
+    g_free (filename_uri);
+    m_Document = newDocument;
+    if ( NULL != m_Contents )
     {
-        g_object_unref (G_OBJECT (m_Document));
-        m_Document = NULL;
+        g_bytes_unref (m_Contents);
     }
-    m_Document = newDocument;
-    // Load the document's information and outline.
-    loadMetadata ();
-    PopplerIndexIter *outline = poppler_index_iter_new (m_Document);
-    m_Outline = new DocumentOutline ();
-    setOutline (m_Outline, outline);
-    // XXX: I still don't know why, but it seems that if I don't request
-    // a page here, when rendering a page Glib tells me
-    // that cannot register existing type `PopplerPage'... Yes, this
-    // is a kludge, but I don't know enough to check it why it does that.
-    PopplerPage *page = poppler_document_get_page (m_Document, 0);
-    if ( NULL != page )
+    m_Contents = contents;
+    if ( sourceInfoValid )
     {
-        g_object_unref (G_OBJECT (page));
+        m_SourceInfo = sourceInfo;
     }
+    m_SourceInfoValid = sourceInfoValid;
+    G_LOCK (namedDestinations);
+    g_hash_table_remove_all (m_NamedDestinations);
+    m_NamedDestinationsLoaded = FALSE;
+    G_UNLOCK (namedDestinations);
+    clearTextLayouts (TRUE);
+    // Load the document's information. The outline is read by
+    // loadOutline() once the first page is queued to render; meanwhile
+    // the document has an empty outline.
+    loadMetadata ();
+    m_Outline = new DocumentOutline ();
 
     return TRUE;
 }
 
+///
+/// @brief Reads the document's outline.
+///
+/// Only the outline's first level is read, as it is always shown in
+/// the index. Deeper levels are read when expanded.
+///
+/// @return A new outline with the document's outline items.
+///
+DocumentOutline *
+PDFDocument::loadOutline ()
+{
+    g_assert (NULL != m_Document && "The document has not been loaded.");
+
+    DocumentOutline *outline =
+        new PDFDocumentOutline (this, poppler_index_iter_new (m_Document));
+    outline->getNumChildren ();
+
+    return outline;
+}
+
+///
+/// @brief Reads the unrotated size of all pages.
+///
+/// The pages already read by getPageSizeForPage() are skipped. Once
+/// read, getPageSizeForPage() doesn't need to ask Poppler for any page
+/// anymore.
+///
+void
+PDFDocument::loadPageSizes ()
+{
+    g_assert (NULL != m_Document && "The document has not been loaded.");
+
+    G_LOCK (pageSizes);
+    GArray *pageSizes = g_array_ref (m_PageSizes);
+    G_UNLOCK (pageSizes);
+    for ( guint page = 0 ; page < pageSizes->len ; page++ )
+    {
+        G_LOCK (pageSizes);
+        gboolean knownSize =
+            0.0 < g_array_index (pageSizes, PageSize, page).width;
+        G_UNLOCK (pageSizes);
+        if ( !knownSize )
+        {
+            PageSize size = readPageSize (m_Document, page + 1);
+            G_LOCK (pageSizes);
+            g_array_index (pageSizes, PageSize, page) = size;
+            G_UNLOCK (pageSizes);
+        }
+    }
+    g_array_unref (pageSizes);
+}
+
 ///
 /// @brief Reads the document's meta data.
 ///
@@ -428,101 +697,251 @@ PDFDocument::loadMetadata (void)
 }
 
 ///
-/// @brief Sets the pages links.
+/// @brief Gets the links of a page.
 ///
-/// This function adds all links from a page to the rendered page
-/// image of it.
+/// Adds all links from a page to @a links, unscaled.
 ///
-/// @param renderedPage The rendered page to add the links to.
-/// @param popplerPage The page to get the links from.
+/// @param pageNum The number of the page to get the links of.
+/// @param links The index to add the links to.
 ///
 void
-PDFDocument::setLinks (DocumentPage *renderedPage, PopplerPage *popplerPage)
+PDFDocument::getPageLinks (gint pageNum, DocumentLinkIndex *links)
 {
+    g_assert (NULL != m_Document && "Tried to get links of a NULL document.");
+
+    PopplerPage *popplerPage =
+        poppler_document_get_page (m_Document, pageNum - 1);
+    if ( NULL == popplerPage )
+    {
+        return;
+    }
+
     gdouble pageHeight = 1.0;
     // Get the height, to calculate the Y position as the document's origin
     // is at the bottom-left corner, not the top-left as the screen does.
     poppler_page_get_size (popplerPage, NULL, &pageHeight);
-    // We'll already calculate the positions scaled.
-    gdouble scale = getZoom ();
     GList *pageLinks = poppler_page_get_link_mapping (popplerPage);
     for (GList *pageLink = g_list_first (pageLinks) ;
          NULL != pageLink ;
          pageLink = g_list_next (pageLink) )
     {
         PopplerLinkMapping *link = (PopplerLinkMapping *)pageLink->data;
-        IDocumentLink *documentLink = createDocumentLink (link, pageHeight, scale);
+        IDocumentLink *documentLink = createDocumentLink (link, pageHeight);
         if ( NULL != documentLink )
         {
-            renderedPage->addLink (documentLink);
+            links->addLink (documentLink);
         }
     }
     poppler_page_free_link_mapping (pageLinks);
+    g_object_unref (G_OBJECT (popplerPage));
 }
 
 ///
-/// @brief Sets the document's outline.
+/// @brief Remembers a page's fingerprint for findUnchangedPages().
+///
+/// @param pageNum The number of the page to get the fingerprint of.
+///
+void
+PDFDocument::loadPageFingerprint (gint pageNum)
+{
+    G_LOCK (pageFingerprints);
+    gboolean known = ( (guint)pageNum <= m_PageFingerprints->len &&
+                       NULL != g_ptr_array_index (m_PageFingerprints,
+                                                  pageNum - 1) );
+    G_UNLOCK (pageFingerprints);
+    if ( known || NULL == m_Document )
+    {
+        return;
+    }
+
+    // Only the jobs read m_Document, so the page can't be computed twice.
+    gchar *fingerprint = getPageFingerprint (m_Document, pageNum);
+    G_LOCK (pageFingerprints);
+    if ( (guint)pageNum > m_PageFingerprints->len )
+    {
+        g_ptr_array_set_size (m_PageFingerprints, pageNum);
+    }
+    g_ptr_array_index (m_PageFingerprints, pageNum - 1) = fingerprint;
+    G_UNLOCK (pageFingerprints);
+}
+
 ///
-/// This is a recursive function that adds child outlines
-/// from the PDF's outline to the passed @a outline.
+/// @brief Deletes the text layouts of all pages.
 ///
-/// @param outline The outline to set the nodes to. The first
-///                call must be set to the root DocumentOutline.
-/// @param childrenList The list of children for to set to @a outline.
-///                     The first line must be the returned valued of
-///                     poppler_index_iter_new().
+/// @param onlyChanged TRUE to keep the layouts of the pages that
+///                    isPageUnchanged() tells, FALSE to delete them all.
 ///
 void
-PDFDocument::setOutline (DocumentOutline *outline,
-                         PopplerIndexIter *childrenList)
+PDFDocument::clearTextLayouts (gboolean onlyChanged)
 {
-    if ( NULL != childrenList )
+    G_LOCK (textLayouts);
+    for ( guint page = 0 ; page < m_TextLayouts->len ; page++ )
     {
-        do
+        if ( onlyChanged && isPageUnchanged (page + 1) )
         {
-            PopplerAction *action =
-                poppler_index_iter_get_action (childrenList);
-            if ( POPPLER_ACTION_GOTO_DEST == action->type )
-            {
-                PopplerActionGotoDest *actionGoTo =
-                    (PopplerActionGotoDest *)action;
-                DocumentOutline *child = new DocumentOutline ();
-                child->setParent (outline);
-                child->setTitle (actionGoTo->title);
-                PopplerDest *destination = actionGoTo->dest;
-                child->setDestination (destination->page_num);
+            continue;
+        }
+        delete (DocumentTextLayout *)g_ptr_array_index (m_TextLayouts, page);
+        g_ptr_array_index (m_TextLayouts, page) = NULL;
+    }
+    if ( !onlyChanged )
+    {
+        g_ptr_array_set_size (m_TextLayouts, 0);
+    }
+    G_UNLOCK (textLayouts);
+}
+
+///
+/// @brief Finds the pages with cached data that a reload didn't change.
+///
+/// Poppler doesn't give the pages' content streams, so each page is
+/// compared by a fingerprint of its size, text, glyphs, images, links,
+/// annotations and a small render. Only the pages that have a fingerprint,
+/// because the document is watched, and still have a rendered image
+/// cached are compared, so a reload computes at most one fingerprint per
+/// cached image. The old fingerprints are used because, if the file was
+/// written over, the old document could be reading the new file already.
+///
+/// The fingerprints of the pages that changed or weren't compared are
+/// forgotten.
+///
+/// @param newDocument The document that replaces m_Document.
+///
+/// @return A new array of gint page numbers that didn't change. It must
+///         be freed with g_array_free().
+///
+GArray *
+PDFDocument::findUnchangedPages (PopplerDocument *newDocument)
+{
+    GArray *unchangedPages = g_array_new (FALSE, FALSE, sizeof (gint));
+    gint numPages = poppler_document_get_n_pages (newDocument);
+    G_LOCK (pageFingerprints);
+    if ( m_PageFingerprints->len > (guint)numPages )
+    {
+        g_ptr_array_set_size (m_PageFingerprints, numPages);
+    }
+    for ( guint page = 0 ; page < m_PageFingerprints->len ; page++ )
+    {
+        gchar *oldFingerprint =
+            (gchar *)g_ptr_array_index (m_PageFingerprints, page);
+        if ( NULL == oldFingerprint )
+        {
+            continue;
+        }
+        gint pageNum = page + 1;
+        gchar *newFingerprint = NULL;
+        if ( hasPageImage (pageNum) )
+        {
+            newFingerprint = getPageFingerprint (newDocument, pageNum);
+        }
+        if ( NULL != newFingerprint &&
+             0 == g_strcmp0 (oldFingerprint, newFingerprint) )
+        {
+            g_array_append_val (unchangedPages, pageNum);
+        }
+        else
+        {
+            g_free (oldFingerprint);
+            g_ptr_array_index (m_PageFingerprints, page) = NULL;
+        }
+        g_free (newFingerprint);
+    }
+    G_UNLOCK (pageFingerprints);
+
+    return unchangedPages;
+}
+
+///
+/// @brief Gets the page a destination points to.
+///
+/// The first named destination makes the document to read the page of
+/// all of its named destinations at once into
+/// PDFDocument::m_NamedDestinations, so the outline and the links of
+/// every page don't search the document's name tree for each name.
+///
+/// The outline is read as it's expanded by the main thread while the
+/// links are read by the jobs, so the table is used while holding a lock.
+///
+/// @param destination The destination to get the page of.
+///
+/// @return The number of the page @a destination points to.
+///
+gint
+PDFDocument::getDestinationPage (PopplerDest *destination)
+{
+    gint pageNum = destination->page_num;
 #if POPPLER_CHECK_VERSION(0, 5, 2)
-                if ( POPPLER_DEST_NAMED == destination->type )
-                {
-                    destination =
-                        poppler_document_find_dest (m_Document,
-                                                    destination->named_dest);
-                    if ( NULL != destination )
-                    {
-                        child->setDestination (destination->page_num);
-                        poppler_dest_free (destination);
-                        destination = NULL;
-                    }
-                }
-#endif // HAVE_POPPLER_0_5_2
+    if ( POPPLER_DEST_NAMED == destination->type )
+    {
+        G_LOCK (namedDestinations);
+        if ( !m_NamedDestinationsLoaded )
+        {
+            loadNamedDestinations ();
+        }
 
-                    outline->addChild (child);
-                PopplerIndexIter *childIter =
-                    poppler_index_iter_get_child (childrenList);
-                setOutline (child, childIter);
-            }
+        gpointer cachedPage = NULL;
+        if ( g_hash_table_lookup_extended (m_NamedDestinations,
+                                           destination->named_dest,
+                                           NULL, &cachedPage) )
+        {
+            G_UNLOCK (namedDestinations);
+            return GPOINTER_TO_INT (cachedPage);
+        }
+
+        // Not in the table, either because this Poppler can't list them
+        // or because the name is broken. Look it up just this time.
+        PopplerDest *namedDestination =
+            poppler_document_find_dest (m_Document, destination->named_dest);
+        if ( NULL != namedDestination )
+        {
+            pageNum = namedDestination->page_num;
+            poppler_dest_free (namedDestination);
         }
-        while ( poppler_index_iter_next (childrenList) );
+        g_hash_table_insert (m_NamedDestinations,
+                             g_strdup (destination->named_dest),
+                             GINT_TO_POINTER (pageNum));
+        G_UNLOCK (namedDestinations);
+    }
+#endif // HAVE_POPPLER_0_5_2
+
+    return pageNum;
+}
+
+///
+/// @brief Loads the page of all named destinations.
+///
+/// The whole name tree is read in a single pass, which is much faster
+/// than looking for each name on documents with lots of named
+/// destinations, like the ones made by LaTeX's hyperref.
+///
+/// With Poppler older than 0.78 the names can't be listed and they are
+/// still looked up one by one the first time each is used.
+///
+/// It must be called while holding the named destinations' lock.
+///
+void
+PDFDocument::loadNamedDestinations ()
+{
+    g_assert (NULL != m_Document && "The document has not been loaded.");
 
-        poppler_index_iter_free (childrenList);
+    m_NamedDestinationsLoaded = TRUE;
+#if defined (HAVE_POPPLER_0_78_0)
+    GTree *destinations = poppler_document_create_dests_tree (m_Document);
+    if ( NULL != destinations )
+    {
+        g_tree_foreach (destinations, addNamedDestination,
+                        m_NamedDestinations);
+        g_tree_destroy (destinations);
     }
+#endif // HAVE_POPPLER_0_78_0
 }
 
 ///
 /// @brief Gets a document's page's unscaled size.
 ///
 /// Retrieves the width and height of a document's page before to scale, but
-/// after rotation.
+/// after rotation. Each page's size is only read once from Poppler, the
+/// rotation is applied to the remembered size.
 ///
 /// @param pageNum The page to get its size.
 /// @param width The output pointer to save the page's width.
@@ -531,57 +950,97 @@ PDFDocument::setOutline (DocumentOutline *outline,
 void
 PDFDocument::getPageSizeForPage (gint pageNum, gdouble *width, gdouble *height)
 {
-    g_assert (NULL != m_Document && "Tried to get size of a NULL document.");
     g_assert (NULL != width && "Tried to save the page's width to NULL.");
     g_assert (NULL != height && "Tried to save the page's height to NULL.");
 
-    PopplerPage *page = poppler_document_get_page (m_Document, pageNum - 1);
-    if ( NULL != page )
+    gdouble unrotatedWidth;
+    gdouble unrotatedHeight;
+    getUnrotatedPageSize (pageNum, &unrotatedWidth, &unrotatedHeight);
+    // Check which rotation has the document's page to know what is width
+    // and what is height.
+    gint rotate = getRotation ();
+    if ( 90 == rotate || 270 == rotate )
     {
-        gdouble pageWidth;
-        gdouble pageHeight;
-        // Check which rotation has the document's page to know what is width
-        // and what is height.
-        gint rotate = getRotation ();
-        if ( 90 == rotate || 270 == rotate )
-        {
-            poppler_page_get_size (page, &pageHeight, &pageWidth);
-        }
-        else
-        {
-            poppler_page_get_size (page, &pageWidth, &pageHeight);
-        }
-
-        *width = pageWidth;
-        *height = pageHeight;
-
-        g_object_unref (G_OBJECT (page));
+        *width = unrotatedHeight;
+        *height = unrotatedWidth;
     }
     else
     {
-        // Just give any valor, except 0.
-        *width = 1.0;
-        *height = 1.0;
+        *width = unrotatedWidth;
+        *height = unrotatedHeight;
     }
 }
 
+///
+/// @brief Gets a document's page's size before scaling and rotation.
+///
+/// Each page's size is only read once from Poppler.
+///
+/// @param pageNum The page to get its size.
+/// @param width The output pointer to save the page's width.
+/// @param height The output pointer to save the page's height.
+///
 void
-PDFDocument::outputPostscriptBegin (const gchar *fileName, guint numOfPages,
-                                    gfloat pageWidth, gfloat pageHeight)
+PDFDocument::getUnrotatedPageSize (gint pageNum, gdouble *width,
+                                   gdouble *height)
 {
-    if ( NULL != m_Document )
+    g_assert (NULL != m_Document && "Tried to get size of a NULL document.");
+
+    PageSize size = { 0.0, 0.0 };
+    G_LOCK (pageSizes);
+    gboolean validPage = 0 < pageNum && (guint)pageNum <= m_PageSizes->len;
+    if ( validPage )
     {
-        if ( NULL != m_PostScript )
+        size = g_array_index (m_PageSizes, PageSize, pageNum - 1);
+    }
+    G_UNLOCK (pageSizes);
+    if ( 0.0 == size.width )
+    {
+        size = readPageSize (m_Document, pageNum);
+        // Remember it, so the page is asked only once.
+        if ( validPage )
         {
-            outputPostscriptEnd ();
+            G_LOCK (pageSizes);
+            if ( (guint)pageNum <= m_PageSizes->len )
+            {
+                g_array_index (m_PageSizes, PageSize, pageNum - 1) = size;
+            }
+            G_UNLOCK (pageSizes);
         }
+    }
+    *width = size.width;
+    *height = size.height;
+}
+
+void
+PDFDocument::outputPostscriptBegin (gint fd, guint numOfPages,
+                                    gfloat pageWidth, gfloat pageHeight)
+{
+    if ( NULL != m_PostScript )
+    {
+        outputPostscriptEnd ();
+    }
+    if ( NULL != m_Document && 0 < numOfPages )
+    {
+#if defined (HAVE_POPPLER_21_12_0)
+        // Poppler closes the file descriptor when the file is freed.
+        m_PostScript = poppler_ps_file_new_fd (m_Document, fd, 0, numOfPages);
+#else // !HAVE_POPPLER_21_12_0
+        gchar *fileName = g_strdup_printf ("/dev/fd/%d", fd);
         m_PostScript =
             poppler_ps_file_new (m_Document, fileName, 0, numOfPages);
-        if ( NULL != m_PostScript )
-        {
-            poppler_ps_file_set_paper_size (m_PostScript,
-                                            pageWidth, pageHeight);
-        }
+        g_free (fileName);
+        m_PostScriptFd = fd;
+#endif // HAVE_POPPLER_21_12_0
+    }
+    if ( NULL != m_PostScript )
+    {
+        poppler_ps_file_set_paper_size (m_PostScript, pageWidth, pageHeight);
+    }
+    else
+    {
+        m_PostScriptFd = -1;
+        close (fd);
     }
 }
 
@@ -593,6 +1052,11 @@ PDFDocument::outputPostscriptEnd ()
         poppler_ps_file_free (m_PostScript);
         m_PostScript = NULL;
     }
+    if ( -1 != m_PostScriptFd )
+    {
+        close (m_PostScriptFd);
+        m_PostScriptFd = -1;
+    }
 }
 
 void
@@ -604,7 +1068,36 @@ PDFDocument::outputPostscriptPage (guint pageNum)
         if ( NULL != page )
         {
             poppler_page_render_to_ps (page, m_PostScript);
+            g_object_unref (G_OBJECT (page));
+        }
+    }
+}
+
+///
+/// @brief Drops the parsed document and the shared core.
+///
+/// A copy gives its parsed document back to the core, for the next
+/// copies. The document that loaded the file deletes its own instead,
+/// as its outline may still read it from the main thread.
+///
+/// The document isn't loaded anymore afterwards.
+///
+void
+PDFDocument::releaseCore ()
+{
+    if ( NULL != m_Core )
+    {
+        if ( m_IsCopy )
+        {
+            m_Core->release (m_Document);
+        }
+        else
+        {
+            g_object_unref (G_OBJECT (m_Document));
         }
+        m_Document = NULL;
+        m_Core->unref ();
+        m_Core = NULL;
     }
 }
 
@@ -728,8 +1221,7 @@ PDFDocument::renderPage (gint pageNum)
         
         g_message("PDFDocument::renderPage: Converted BGRA to RGBA");
         
-        // Set up links and clean up
-        setLinks(renderedPage, page);
+        // Clean up
         g_object_unref(G_OBJECT(page));
         
         g_message("PDFDocument::renderPage: Page rendered successfully!");
@@ -741,11 +1233,123 @@ PDFDocument::renderPage (gint pageNum)
 
     return (renderedPage);
 }
+
 ///
-/// @brief Saves a document's copy to a file.
+/// @brief Renders a document's page for printing.
+///
+/// @param pageNum The page to render.
+/// @param context The cairo context to draw the page to, with the page's
+///                top left corner at its origin.
+///
+void
+PDFDocument::renderPageForPrinting (gint pageNum, cairo_t *context)
+{
+    if ( NULL == m_Document )
+    {
+        return;
+    }
+
+    PopplerPage *page = poppler_document_get_page (m_Document, pageNum - 1);
+    if ( NULL != page )
+    {
+        poppler_page_render_for_printing (page, context);
+        g_object_unref (G_OBJECT (page));
+    }
+}
+
+///
+/// @brief Renders a page's thumbnail.
+///
+/// The thumbnail keeps the page's aspect ratio and doesn't depend on the
+/// current zoom or rotation. When the document has an embedded thumbnail
+/// for the page, it's scaled instead of rendering the page.
+///
+/// @param pageNum The page to render its thumbnail.
+/// @param size The maximum width and height of the thumbnail.
+///
+/// @return A DocumentPage with the thumbnail, or NULL if the page can't
+///         be read. The returned page must be freed by calling delete.
+///
+DocumentPage *
+PDFDocument::renderThumbnail (gint pageNum, gint size)
+{
+    if ( NULL == m_Document )
+    {
+        return NULL;
+    }
+    PopplerPage *page = poppler_document_get_page (m_Document, pageNum - 1);
+    if ( NULL == page )
+    {
+        return NULL;
+    }
+
+    // The page is drawn unrotated, so its size is too, whatever the
+    // document's rotation.
+    gdouble pageWidth;
+    gdouble pageHeight;
+    getUnrotatedPageSize (pageNum, &pageWidth, &pageHeight);
+    gdouble scale = (gdouble)size / MAX (MAX (pageWidth, pageHeight), 1.0);
+    gint width = MAX ((gint)(pageWidth * scale + 0.5), 1);
+    gint height = MAX ((gint)(pageHeight * scale + 0.5), 1);
+
+    cairo_surface_t *surface =
+        cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t *context = cairo_create (surface);
+    cairo_set_source_rgb (context, 1.0, 1.0, 1.0);
+    cairo_paint (context);
+
+    cairo_surface_t *embedded = poppler_page_get_thumbnail (page);
+    if ( NULL != embedded )
+    {
+        gint embeddedWidth = cairo_image_surface_get_width (embedded);
+        gint embeddedHeight = cairo_image_surface_get_height (embedded);
+        cairo_scale (context, (gdouble)width / MAX (embeddedWidth, 1),
+                     (gdouble)height / MAX (embeddedHeight, 1));
+        cairo_set_source_surface (context, embedded, 0, 0);
+        cairo_pattern_set_filter (cairo_get_source (context),
+                                  CAIRO_FILTER_GOOD);
+        cairo_paint (context);
+        cairo_surface_destroy (embedded);
+    }
+    else
+    {
+        cairo_scale (context, (gdouble)width / pageWidth,
+                     (gdouble)height / pageHeight);
+        poppler_page_render (page, context);
+    }
+    cairo_destroy (context);
+    cairo_surface_flush (surface);
+    g_object_unref (G_OBJECT (page));
+
+    DocumentPage *thumbnail = new DocumentPage ();
+    thumbnail->newPage (width, height);
+    const guchar *source = cairo_image_surface_get_data (surface);
+    gint sourceStride = cairo_image_surface_get_stride (surface);
+    guchar *destination = thumbnail->getData ();
+    gint destinationStride = thumbnail->getRowStride ();
+    for ( gint row = 0 ; row < height ; row++ )
+    {
+        memcpy (destination, source, width * 4);
+        source += sourceStride;
+        destination += destinationStride;
+    }
+    cairo_surface_destroy (surface);
+    convert_bgra_to_rgba (thumbnail->getData (), width, height,
+                          destinationStride);
+
+    return thumbnail;
+}
+
+///
+/// @brief Saves a document's copy to a file.
 ///
 /// Tries to save the document to file @a filename.
 ///
+/// The viewer never changes a document, so when the file it was opened
+/// from didn't change since, or when it was read from the standard
+/// input, its bytes are copied as they are instead of letting Poppler
+/// write the whole document again.
+///
 /// @param filename The path, absolute or relative, to the file name
 ///                 to save the copy to.
 /// @param error Location to store any error that could happen or
@@ -760,6 +1364,12 @@ PDFDocument::saveFile (const gchar *filename, GError **error)
     g_assert (NULL != filename && "Tried to save to a NULL file name.");
 
     gchar *absoluteFileName = getAbsoluteFileName (filename);
+    gboolean saved = FALSE;
+    if ( copyUnchangedSource (absoluteFileName, &saved, error) )
+    {
+        g_free (absoluteFileName);
+        return saved;
+    }
     gchar *filename_uri = g_filename_to_uri (absoluteFileName, NULL, error);
     g_free (absoluteFileName);
     if ( NULL == filename_uri )
@@ -777,6 +1387,96 @@ PDFDocument::saveFile (const gchar *filename, GError **error)
     return result;
 }
 
+///
+/// @brief Copies the bytes the document was read from to a file.
+///
+/// The bytes read from the standard input are written from memory, and
+/// the file the document was opened from is copied if it's still the
+/// same file, with the same size and modification time, that was read.
+/// The copy is left to the kernel, that can share the blocks on file
+/// systems like Btrfs or XFS and otherwise copies without passing the
+/// data through the process.
+///
+/// @param fileName The absolute path to the file to save to.
+/// @param saved The location to tell if the file was saved.
+/// @param error Location to store any error that could happen or
+///              set to NULL to ignore errors.
+///
+/// @return TRUE if the bytes were copied or tried to, with the result
+///         in @a saved, or FALSE if the document must be saved by
+///         Poppler.
+///
+gboolean
+PDFDocument::copyUnchangedSource (const gchar *fileName, gboolean *saved,
+                                  GError **error)
+{
+    if ( !m_SourceInfoValid )
+    {
+        if ( NULL == m_Contents )
+        {
+            return FALSE;
+        }
+        gsize length = 0;
+        const gchar *data =
+            (const gchar *)g_bytes_get_data (m_Contents, &length);
+        *saved = g_file_set_contents (fileName, data, length, error);
+        return TRUE;
+    }
+
+    gchar *sourceName = getAbsoluteFileName (getFileName ());
+    gint sourceFd = g_open (sourceName, O_RDONLY, 0);
+    g_free (sourceName);
+    if ( -1 == sourceFd )
+    {
+        return FALSE;
+    }
+    struct stat sourceInfo;
+    if ( 0 != fstat (sourceFd, &sourceInfo) ||
+         !isSameFile (&sourceInfo, &m_SourceInfo) )
+    {
+        close (sourceFd);
+        return FALSE;
+    }
+
+    // Saving over the file itself would truncate it before the copy.
+    struct stat destinationInfo;
+    if ( 0 == g_stat (fileName, &destinationInfo) &&
+         destinationInfo.st_dev == sourceInfo.st_dev &&
+         destinationInfo.st_ino == sourceInfo.st_ino )
+    {
+        close (sourceFd);
+        *saved = TRUE;
+        return TRUE;
+    }
+
+    gint destinationFd = g_open (fileName, O_WRONLY | O_CREAT | O_TRUNC,
+                                 0666);
+    gboolean copied = ( -1 != destinationFd &&
+                        copyFileContents (sourceFd, destinationFd,
+                                          sourceInfo.st_size) );
+    gint copyError = errno;
+    close (sourceFd);
+    if ( -1 != destinationFd && 0 != close (destinationFd) && copied )
+    {
+        copied = FALSE;
+        copyError = errno;
+    }
+    if ( !copied )
+    {
+        if ( -1 != destinationFd )
+        {
+            g_unlink (fileName);
+        }
+        g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (copyError),
+                     _("Couldn't write '%s': %s"), fileName,
+                     g_strerror (copyError));
+    }
+    *saved = copied;
+
+    return TRUE;
+}
+
+#if !defined (HAVE_POPPLER_0_17_0)
 static void
 repairEmpty(PopplerRectangle& rect)
 {
@@ -786,12 +1486,107 @@ repairEmpty(PopplerRectangle& rect)
     if(rect.x1 == rect.x2)
         rect.x2++;
 }
+#endif // !HAVE_POPPLER_0_17_0
 
+///
+/// @brief Gets the text layout of a page.
+///
+/// The first time a page's layout is requested it is read from Poppler
+/// and then kept until the document is loaded again. The caller must
+/// hold the textLayouts lock while using the returned layout.
+///
+/// @param pageNum The number of the page to get the layout of.
+///
+/// @return The page's layout or NULL if the page can't be read.
+///
+DocumentTextLayout *
+PDFDocument::getTextLayout (gint pageNum)
+{
+    if ( 0 >= pageNum || NULL == m_Document )
+    {
+        return NULL;
+    }
+    if ( (guint)pageNum <= m_TextLayouts->len &&
+         NULL != g_ptr_array_index (m_TextLayouts, pageNum - 1) )
+    {
+        return (DocumentTextLayout *)
+            g_ptr_array_index (m_TextLayouts, pageNum - 1);
+    }
+
+    DocumentTextLayout *layout = NULL;
+#if defined (HAVE_POPPLER_0_17_0)
+    PopplerPage *page = poppler_document_get_page (m_Document, pageNum - 1);
+    if ( NULL == page )
+    {
+        return NULL;
+    }
+    gchar *text = poppler_page_get_text (page);
+    layout = new DocumentTextLayout (text);
+    g_free (text);
+    PopplerRectangle *glyphs = NULL;
+    guint numGlyphs = 0;
+    if ( poppler_page_get_text_layout (page, &glyphs, &numGlyphs) )
+    {
+        for ( guint glyph = 0 ; glyph < numGlyphs ; glyph++ )
+        {
+            layout->addGlyph (glyphs[glyph].x1, glyphs[glyph].y1,
+                              glyphs[glyph].x2, glyphs[glyph].y2);
+        }
+        g_free (glyphs);
+    }
+    g_object_unref (G_OBJECT (page));
+
+    if ( (guint)pageNum > m_TextLayouts->len )
+    {
+        g_ptr_array_set_size (m_TextLayouts, pageNum);
+    }
+    g_ptr_array_index (m_TextLayouts, pageNum - 1) = layout;
+#endif // HAVE_POPPLER_0_17_0
+
+    return layout;
+}
+
+///
+/// @brief Notifies the text of a selection.
+///
+/// The text is taken from the page's cached layout, so the same glyphs
+/// that getTextRegion() highlighted are the ones copied.
+///
+/// @param rect The selection, from where the drag started to where it
+///             ended, in scaled coordinates.
+///
 void
 PDFDocument::setTextSelection (DocumentRectangle *rect)
 {
     g_assert(rect);
 
+#if defined (HAVE_POPPLER_0_17_0)
+    gdouble scale = getZoom ();
+    gchar *text = NULL;
+    G_LOCK (textLayouts);
+    DocumentTextLayout *layout = getTextLayout (getCurrentPageNum ());
+    if ( NULL != layout )
+    {
+        text = layout->getSelectionText (rect->getX1 () / scale,
+                                         rect->getY1 () / scale,
+                                         rect->getX2 () / scale,
+                                         rect->getY2 () / scale);
+    }
+    G_UNLOCK (textLayouts);
+    if ( NULL == text )
+    {
+        return;
+    }
+
+    for ( GList *obs = g_list_first (m_Observers) ;
+          NULL != obs ;
+          obs = g_list_next (obs) )
+    {
+        IDocumentObserver *observer = (IDocumentObserver*)obs->data;
+        observer->notifyTextSelected(text);
+    }
+    g_free (text);
+#else // !HAVE_POPPLER_0_17_0
     PopplerPage *page = poppler_document_get_page (m_Document, getCurrentPageNum()-1);
     if(!page)
         return;
@@ -838,11 +1633,41 @@ PDFDocument::setTextSelection (DocumentRectangle *rect)
         g_object_unref(page);
     if(text)
         g_free(text);
+#endif // HAVE_POPPLER_0_17_0
 }
 
+///
+/// @brief Gets the area to highlight for a text selection.
+///
+/// The page's glyph layout is read once and kept, so dragging a
+/// selection doesn't ask Poppler for the page on each mouse motion.
+///
+/// @param r The selection, from where the drag started to where it is
+///          now, in scaled coordinates.
+///
+/// @return The scaled region to highlight or NULL if the current page
+///         is not available. Must be freed with cairo_region_destroy().
+///
 cairo_region_t*
 PDFDocument::getTextRegion (DocumentRectangle *r)
 {
+#if defined (HAVE_POPPLER_0_17_0)
+    gdouble scale = getZoom ();
+    cairo_region_t *region = NULL;
+    G_LOCK (textLayouts);
+    DocumentTextLayout *layout = getTextLayout (getCurrentPageNum ());
+    if ( NULL != layout )
+    {
+        region = layout->getSelectionRegion (r->getX1 () / scale,
+                                             r->getY1 () / scale,
+                                             r->getX2 () / scale,
+                                             r->getY2 () / scale,
+                                             scale);
+    }
+    G_UNLOCK (textLayouts);
+
+    return region;
+#else // !HAVE_POPPLER_0_17_0
     cairo_region_t *res = NULL;
     PopplerPage *page = poppler_document_get_page (m_Document, getCurrentPageNum()-1);
     if(!page)
@@ -885,6 +1710,7 @@ PDFDocument::getTextRegion (DocumentRectangle *r)
     g_object_unref(page);
 
     return res;
+#endif // HAVE_POPPLER_0_17_0
 }
 
 
@@ -993,3 +1819,373 @@ getAbsoluteFileName (const gchar *fileName)
 
     return absoluteFileName;
 }
+
+///
+/// @brief Copies a whole file to another.
+///
+/// The destination first tries to share the source's blocks, which is
+/// instant on file systems that support it. Otherwise the kernel copies
+/// the data, and only when it can't either, as between some file
+/// systems, the data is copied through a large buffer.
+///
+/// @param sourceFd The file descriptor to copy from, at its start.
+/// @param destinationFd The file descriptor to copy to, empty.
+/// @param size The number of bytes to copy.
+///
+/// @return TRUE if the file was copied, FALSE otherwise, with errno set.
+///
+gboolean
+copyFileContents (gint sourceFd, gint destinationFd, goffset size)
+{
+#if defined (HAVE_FICLONE)
+    if ( 0 == ioctl (destinationFd, FICLONE, sourceFd) )
+    {
+        return TRUE;
+    }
+#endif // HAVE_FICLONE
+
+#if defined (HAVE_COPY_FILE_RANGE)
+    goffset copied = 0;
+    // Both file offsets move with the copy, so the buffer below can
+    // continue where the kernel stopped.
+    while ( copied < size )
+    {
+        ssize_t copiedBytes = copy_file_range (sourceFd, NULL,
+                                               destinationFd, NULL,
+                                               size - copied, 0);
+        if ( 0 < copiedBytes )
+        {
+            copied += copiedBytes;
+        }
+        else if ( 0 == copiedBytes )
+        {
+            break;
+        }
+        else if ( EINTR != errno )
+        {
+            if ( ENOSYS != errno && EXDEV != errno && EINVAL != errno &&
+                 EOPNOTSUPP != errno )
+            {
+                return FALSE;
+            }
+            break;
+        }
+    }
+#endif // HAVE_COPY_FILE_RANGE
+
+    gchar *buffer = (gchar *)g_malloc (SAVE_BUFFER_SIZE);
+    gboolean result = TRUE;
+    while ( result )
+    {
+        ssize_t readBytes = read (sourceFd, buffer, SAVE_BUFFER_SIZE);
+        if ( 0 == readBytes )
+        {
+            break;
+        }
+        else if ( 0 > readBytes )
+        {
+            result = (EINTR == errno);
+            continue;
+        }
+        for ( ssize_t written = 0 ; result && written < readBytes ; )
+        {
+            ssize_t writtenBytes = write (destinationFd, buffer + written,
+                                          readBytes - written);
+            if ( 0 <= writtenBytes )
+            {
+                written += writtenBytes;
+            }
+            else
+            {
+                result = (EINTR == errno);
+            }
+        }
+    }
+    gint copyError = errno;
+    g_free (buffer);
+    errno = copyError;
+
+    return result;
+}
+
+///
+/// @brief Tells if the information of a file is the same that was read.
+///
+/// @param info The file's current information.
+/// @param other The information read before.
+///
+/// @return TRUE if both are the same file, unchanged since @a other was
+///         read, FALSE otherwise.
+///
+gboolean
+isSameFile (const struct stat *info, const struct stat *other)
+{
+    gboolean same = info->st_dev == other->st_dev &&
+                    info->st_ino == other->st_ino &&
+                    info->st_size == other->st_size &&
+                    info->st_mtime == other->st_mtime &&
+                    info->st_ctime == other->st_ctime;
+#if defined (HAVE_STAT_ST_MTIM)
+    // A file rewritten with the same size within a second only differs
+    // in the nanoseconds.
+    same = same &&
+           info->st_mtim.tv_nsec == other->st_mtim.tv_nsec &&
+           info->st_ctim.tv_nsec == other->st_ctim.tv_nsec;
+#endif // HAVE_STAT_ST_MTIM
+
+    return same;
+}
+
+///
+/// @brief Reads the whole standard input to memory.
+///
+/// The buffer doubles its size each time it gets full, so a large piped
+/// document is read with a few large reads and copied only a few times.
+/// When the standard input is a redirected file, its size is known and
+/// the buffer is allocated only once.
+///
+/// @param error Location to store the error occurring or NULL to ignore
+///              errors.
+///
+/// @return The bytes read or NULL on error. They must be freed with
+///         g_bytes_unref().
+///
+GBytes *
+readStandardInput (GError **error)
+{
+    gsize bufferSize = STDIN_READ_SIZE;
+    struct stat inputInfo;
+    if ( 0 == fstat (STDIN_FILENO, &inputInfo) &&
+         S_ISREG (inputInfo.st_mode) && 0 < inputInfo.st_size )
+    {
+        // One more byte to see the end of the file without growing.
+        bufferSize = (gsize)inputInfo.st_size + 1;
+    }
+
+    GByteArray *buffer = g_byte_array_sized_new (bufferSize);
+    g_byte_array_set_size (buffer, bufferSize);
+    gsize length = 0;
+    for ( ; ; )
+    {
+        if ( buffer->len == length )
+        {
+            g_byte_array_set_size (buffer, MAX (buffer->len * 2,
+                                                length + STDIN_READ_SIZE));
+        }
+        ssize_t readBytes = read (STDIN_FILENO, buffer->data + length,
+                                  buffer->len - length);
+        if ( 0 == readBytes )
+        {
+            break;
+        }
+        else if ( 0 > readBytes )
+        {
+            gint readError = errno;
+            if ( EINTR == readError )
+            {
+                continue;
+            }
+            g_set_error (error, G_FILE_ERROR,
+                         g_file_error_from_errno (readError),
+                         "%s", g_strerror (readError));
+            g_byte_array_free (buffer, TRUE);
+            return NULL;
+        }
+        length += readBytes;
+    }
+    g_byte_array_set_size (buffer, length);
+
+    return g_byte_array_free_to_bytes (buffer);
+}
+
+#if defined (HAVE_POPPLER_0_78_0)
+///
+/// @brief Adds a single named destination to the table.
+///
+/// This is the g_tree_foreach() callback of loadNamedDestinations().
+///
+/// @param key The named destination's name, in the same form that
+///            PopplerDest's named_dest has.
+/// @param value The PopplerDest the name points to.
+/// @param data The GHashTable to add the name to.
+///
+/// @return FALSE to keep traversing the tree.
+///
+gboolean
+addNamedDestination (gpointer key, gpointer value, gpointer data)
+{
+    PopplerDest *destination = (PopplerDest *)value;
+    g_hash_table_insert ((GHashTable *)data, g_strdup ((const gchar *)key),
+                         GINT_TO_POINTER (destination->page_num));
+    return FALSE;
+}
+#endif // HAVE_POPPLER_0_78_0
+
+///
+/// @brief Adds an area to a checksum.
+///
+/// @param checksum The checksum to add the area to.
+/// @param area The area to add.
+///
+void
+addAreaToChecksum (GChecksum *checksum, const PopplerRectangle *area)
+{
+    gdouble coordinates[] = { area->x1, area->y1, area->x2, area->y2 };
+    g_checksum_update (checksum, (const guchar *)coordinates,
+                       sizeof (coordinates));
+}
+
+///
+/// @brief Computes a fingerprint of a page's contents.
+///
+/// Two pages with the same fingerprint have the same size, text, glyph
+/// positions, images, links and annotations, and look the same when
+/// rendered at FINGERPRINT_SCALE.
+///
+/// @param document The document to get the page from.
+/// @param pageNum The number of the page to compute the fingerprint of.
+///
+/// @return The page's fingerprint, that must be freed with g_free(), or
+///         NULL if the page can't be read.
+///
+gchar *
+getPageFingerprint (PopplerDocument *document, gint pageNum)
+{
+    PopplerPage *page = poppler_document_get_page (document, pageNum - 1);
+    if ( NULL == page )
+    {
+        return NULL;
+    }
+
+    GChecksum *checksum = g_checksum_new (G_CHECKSUM_SHA256);
+    gdouble size[2];
+    poppler_page_get_size (page, &size[0], &size[1]);
+    g_checksum_update (checksum, (const guchar *)size, sizeof (size));
+
+    gchar *text = poppler_page_get_text (page);
+    if ( NULL != text )
+    {
+        g_checksum_update (checksum, (const guchar *)text, -1);
+        g_free (text);
+    }
+#if defined (HAVE_POPPLER_0_17_0)
+    PopplerRectangle *glyphs = NULL;
+    guint numGlyphs = 0;
+    if ( poppler_page_get_text_layout (page, &glyphs, &numGlyphs) )
+    {
+        for ( guint glyph = 0 ; glyph < numGlyphs ; glyph++ )
+        {
+            addAreaToChecksum (checksum, &glyphs[glyph]);
+        }
+        g_free (glyphs);
+    }
+#endif // HAVE_POPPLER_0_17_0
+
+    GList *images = poppler_page_get_image_mapping (page);
+    for ( GList *item = g_list_first (images) ;
+          NULL != item ;
+          item = g_list_next (item) )
+    {
+        PopplerImageMapping *image = (PopplerImageMapping *)item->data;
+        addAreaToChecksum (checksum, &image->area);
+    }
+    poppler_page_free_image_mapping (images);
+
+    GList *links = poppler_page_get_link_mapping (page);
+    for ( GList *item = g_list_first (links) ;
+          NULL != item ;
+          item = g_list_next (item) )
+    {
+        PopplerLinkMapping *link = (PopplerLinkMapping *)item->data;
+        addAreaToChecksum (checksum, &link->area);
+        gint type = link->action->type;
+        g_checksum_update (checksum, (const guchar *)&type, sizeof (type));
+        if ( POPPLER_ACTION_URI == link->action->type &&
+             NULL != link->action->uri.uri )
+        {
+            g_checksum_update (checksum,
+                               (const guchar *)link->action->uri.uri, -1);
+        }
+        else if ( POPPLER_ACTION_GOTO_DEST == link->action->type &&
+                  NULL != link->action->goto_dest.dest )
+        {
+            PopplerDest *destination = link->action->goto_dest.dest;
+            g_checksum_update (checksum,
+                               (const guchar *)&destination->page_num,
+                               sizeof (destination->page_num));
+            if ( NULL != destination->named_dest )
+            {
+                g_checksum_update (checksum,
+                                   (const guchar *)destination->named_dest,
+                                   -1);
+            }
+        }
+    }
+    poppler_page_free_link_mapping (links);
+
+#if defined (HAVE_POPPLER_0_8_0)
+    GList *annotations = poppler_page_get_annot_mapping (page);
+    for ( GList *item = g_list_first (annotations) ;
+          NULL != item ;
+          item = g_list_next (item) )
+    {
+        PopplerAnnotMapping *annotation = (PopplerAnnotMapping *)item->data;
+        addAreaToChecksum (checksum, &annotation->area);
+        gint type = poppler_annot_get_annot_type (annotation->annot);
+        g_checksum_update (checksum, (const guchar *)&type, sizeof (type));
+        gchar *contents = poppler_annot_get_contents (annotation->annot);
+        if ( NULL != contents )
+        {
+            g_checksum_update (checksum, (const guchar *)contents, -1);
+            g_free (contents);
+        }
+    }
+    poppler_page_free_annot_mapping (annotations);
+#endif // HAVE_POPPLER_0_8_0
+
+    // Vector graphics and the images' pixels have no other way to tell
+    // if they changed.
+    gint width = MAX ((gint)(size[0] * FINGERPRINT_SCALE + 0.5), 1);
+    gint height = MAX ((gint)(size[1] * FINGERPRINT_SCALE + 0.5), 1);
+    cairo_surface_t *surface =
+        cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t *context = cairo_create (surface);
+    cairo_set_source_rgb (context, 1.0, 1.0, 1.0);
+    cairo_paint (context);
+    cairo_scale (context, FINGERPRINT_SCALE, FINGERPRINT_SCALE);
+    poppler_page_render (page, context);
+    cairo_destroy (context);
+    cairo_surface_flush (surface);
+    g_checksum_update (checksum, cairo_image_surface_get_data (surface),
+                       cairo_image_surface_get_stride (surface) * height);
+    cairo_surface_destroy (surface);
+    g_object_unref (G_OBJECT (page));
+
+    gchar *fingerprint = g_strdup (g_checksum_get_string (checksum));
+    g_checksum_free (checksum);
+
+    return fingerprint;
+}
+
+///
+/// @brief Reads the unrotated size of a page.
+///
+/// @param document The document to read the page from.
+/// @param pageNum The number of the page to read the size of.
+///
+/// @return The page's size, or 1x1 if the page can't be read, as the
+///         size must never be 0.
+///
+PageSize
+readPageSize (PopplerDocument *document, gint pageNum)
+{
+    PageSize size = { 1.0, 1.0 };
+    PopplerPage *page = poppler_document_get_page (document, pageNum - 1);
+    if ( NULL != page )
+    {
+        poppler_page_get_size (page, &size.width, &size.height);
+        g_object_unref (G_OBJECT (page));
+    }
+
+    return size;
+}
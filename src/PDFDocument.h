@@ -25,6 +25,7 @@
 
 
 /// Forward declarations.
+typedef struct _PopplerDest PopplerDest;
 typedef struct _PopplerDocument PopplerDocument;
 typedef struct _PopplerIndexIter PopplerIndexIter;
 typedef struct _PopplerLinkMapping PopplerLinkMapping;
@@ -33,6 +34,9 @@ typedef struct _PopplerPSFile PopplerPSFile;
 
 namespace ePDFView 
 {
+    // Forward declarations.
+    class PDFDocumentCore;
+
     ///
     /// @class PDFDocument
     /// @brief A PDF document.
@@ -46,36 +50,80 @@ namespace ePDFView
             ~PDFDocument (void);
 
             IDocument *copy (void) const;
-            GList *findTextInPage (gint pageNum, const gchar *textToFind);
+            GArray *findTextInPage (gint pageNum, const gchar *textToFind);
+            gint getDestinationPage (PopplerDest *destination);
+            gchar *getPageText (gint pageNum);
             gboolean isLoaded (void);
             gboolean loadFile (const gchar *filename, const gchar *password, 
                            GError **error);
+            DocumentOutline *loadOutline (void);
+            void loadPageFingerprint (gint pageNum);
+            void loadPageSizes (void);
+            void getPageLinks (gint pageNum, DocumentLinkIndex *links);
             void getPageSizeForPage (gint pageNum, gdouble *width,
                                      gdouble *height);
-            void outputPostscriptBegin (const gchar *fileName, guint numOfPages,
+            void outputPostscriptBegin (gint fd, guint numOfPages,
                                         gfloat pageWidth, gfloat pageHeight);
             void outputPostscriptEnd (void);
             void outputPostscriptPage (guint pageNum);
 
             DocumentPage *renderPage (gint pageNum);
+            void renderPageForPrinting (gint pageNum, cairo_t *context);
+            DocumentPage *renderThumbnail (gint pageNum, gint size);
             gboolean saveFile (const gchar *fileName, GError **error);
             cairo_region_t* getTextRegion (DocumentRectangle* rect);
             void setTextSelection (DocumentRectangle *rect);
 
         protected:
-            /// The PDF document.
+            /// @brief The bytes the document was read from, when it
+            /// wasn't opened by file name.
+            GBytes *m_Contents;
+            /// @brief The parsed documents shared with the copies, or NULL
+            /// if not loaded. m_Document was taken from it.
+            PDFDocumentCore *m_Core;
+            /// The PDF document, only read from a single thread at once.
             PopplerDocument *m_Document;
+            /// @brief Tells if m_Document was taken from m_Core by copy(),
+            /// rather than parsed by loadFile().
+            gboolean m_IsCopy;
+            /// @brief The fingerprint of each page, to tell if a reload
+            /// changed it. A page's entry is NULL until its links are read.
+            GPtrArray *m_PageFingerprints;
+            /// @brief The page number of each named destination, shared
+            /// by the outline and the links.
+            GHashTable *m_NamedDestinations;
+            /// Tells if all named destinations are in m_NamedDestinations.
+            gboolean m_NamedDestinationsLoaded;
+            /// @brief The unrotated size of each page, as PageSize. A
+            /// page's width is 0 until getPageSizeForPage() or
+            /// loadPageSizes() reads it.
+            GArray *m_PageSizes;
             /// The output to PostScript.
             PopplerPSFile *m_PostScript;
+            /// @brief The information of the file the document was opened
+            /// from, taken before reading it. Valid if m_SourceInfoValid.
+            struct stat m_SourceInfo;
+            /// Tells if the document was opened from a file by name.
+            gboolean m_SourceInfoValid;
+            /// @brief The file descriptor m_PostScript writes to, when
+            /// Poppler doesn't close it, or -1.
+            gint m_PostScriptFd;
+            /// @brief The text layout of each page, as DocumentTextLayout.
+            /// A page's entry is NULL until some text is selected on it.
+            GPtrArray *m_TextLayouts;
 
             IDocumentLink *createDocumentLink (const PopplerLinkMapping *link,
-                                               const gdouble pageHeight,
-                                               const gdouble scale);
+                                               const gdouble pageHeight);
+            void clearTextLayouts (gboolean onlyChanged);
+            gboolean copyUnchangedSource (const gchar *fileName,
+                                          gboolean *saved, GError **error);
+            GArray *findUnchangedPages (PopplerDocument *newDocument);
+            DocumentTextLayout *getTextLayout (gint pageNum);
+            void getUnrotatedPageSize (gint pageNum, gdouble *width,
+                                       gdouble *height);
             void loadMetadata (void);
-            void setOutline (DocumentOutline *outline,
-                             PopplerIndexIter *childrenList);
-            void setLinks (DocumentPage *renderedPage,
-                           PopplerPage *popplerPage);
+            void loadNamedDestinations (void);
+            void releaseCore (void);
     };
 }
 
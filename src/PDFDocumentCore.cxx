@@ -0,0 +1,188 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <poppler.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Constants.
+/// The most parsed documents kept for the next copies.
+static const guint MAX_IDLE_DOCUMENTS = 4;
+
+///
+/// @brief Constructs a new PDFDocumentCore object.
+///
+/// The core starts with a single reference.
+///
+/// @param contents The bytes the document was read from, or NULL if it
+///                 was opened by file name. The core takes a reference.
+/// @param uri The URI of the file the document was opened from, used
+///            when @a contents is NULL.
+/// @param password The password to parse the document with, or NULL.
+///
+PDFDocumentCore::PDFDocumentCore (GBytes *contents, const gchar *uri,
+                                  const gchar *password)
+{
+    g_assert ( ( NULL != contents || NULL != uri ) &&
+               "The core has nothing to parse the document from.");
+
+    m_Contents = ( NULL != contents ) ? g_bytes_ref (contents) : NULL;
+    m_IdleDocuments = g_queue_new ();
+    g_mutex_init (&m_Lock);
+    m_Password = g_strdup (password);
+    m_RefCount = 1;
+    m_Uri = g_strdup (uri);
+}
+
+///
+/// @brief Deletes the parsed documents no copy uses.
+///
+PDFDocumentCore::~PDFDocumentCore ()
+{
+    PopplerDocument *document;
+    while ( NULL != (document =
+                (PopplerDocument *)g_queue_pop_head (m_IdleDocuments)) )
+    {
+        g_object_unref (G_OBJECT (document));
+    }
+    g_queue_free (m_IdleDocuments);
+    g_mutex_clear (&m_Lock);
+    if ( NULL != m_Contents )
+    {
+        g_bytes_unref (m_Contents);
+    }
+    g_free (m_Password);
+    g_free (m_Uri);
+}
+
+///
+/// @brief Takes a parsed document for a single thread.
+///
+/// Reuses a document that was given back with release(), or parses a
+/// new one if there is none. The parse is done without the lock, so it
+/// doesn't block the other threads.
+///
+/// @return A parsed document that must be given back with release(),
+///         or NULL if the document couldn't be parsed again.
+///
+PopplerDocument *
+PDFDocumentCore::acquire ()
+{
+    g_mutex_lock (&m_Lock);
+    PopplerDocument *document =
+        (PopplerDocument *)g_queue_pop_head (m_IdleDocuments);
+    g_mutex_unlock (&m_Lock);
+    if ( NULL != document )
+    {
+        return document;
+    }
+
+    if ( NULL != m_Contents )
+    {
+#if defined (HAVE_POPPLER_0_82_0)
+        document = poppler_document_new_from_bytes (m_Contents, m_Password,
+                                                    NULL);
+#else // !HAVE_POPPLER_0_82_0
+        document = poppler_document_new_from_data (
+                (char *)g_bytes_get_data (m_Contents, NULL),
+                (int)g_bytes_get_size (m_Contents), m_Password, NULL);
+#endif // HAVE_POPPLER_0_82_0
+    }
+    else
+    {
+        // NULL if the file was removed or changed since it was loaded.
+        document = poppler_document_new_from_file (m_Uri, m_Password, NULL);
+    }
+
+    return document;
+}
+
+///
+/// @brief Gets the number of parsed documents that no copy uses.
+///
+/// @return How many documents the next copies can take without parsing.
+///
+guint
+PDFDocumentCore::getNumIdle ()
+{
+    g_mutex_lock (&m_Lock);
+    guint numIdle = g_queue_get_length (m_IdleDocuments);
+    g_mutex_unlock (&m_Lock);
+
+    return numIdle;
+}
+
+///
+/// @brief Adds a reference to the core.
+///
+/// @return The core.
+///
+PDFDocumentCore *
+PDFDocumentCore::ref ()
+{
+    g_atomic_int_inc (&m_RefCount);
+
+    return this;
+}
+
+///
+/// @brief Gives back a document taken with acquire().
+///
+/// The document is kept for the next copies, unless there are already
+/// MAX_IDLE_DOCUMENTS kept.
+///
+/// @param document The document to give back. The thread that took it
+///                 must not use it anymore.
+///
+void
+PDFDocumentCore::release (PopplerDocument *document)
+{
+    g_assert (NULL != document && "Tried to release a NULL document.");
+
+    g_mutex_lock (&m_Lock);
+    if ( MAX_IDLE_DOCUMENTS > g_queue_get_length (m_IdleDocuments) )
+    {
+        g_queue_push_head (m_IdleDocuments, document);
+        document = NULL;
+    }
+    g_mutex_unlock (&m_Lock);
+    if ( NULL != document )
+    {
+        g_object_unref (G_OBJECT (document));
+    }
+}
+
+///
+/// @brief Removes a reference to the core.
+///
+/// The core is deleted when the last reference is removed.
+///
+void
+PDFDocumentCore::unref ()
+{
+    if ( g_atomic_int_dec_and_test (&m_RefCount) )
+    {
+        delete this;
+    }
+}
@@ -0,0 +1,78 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__PDF_DOCUMENT_CORE_H__)
+#define __PDF_DOCUMENT_CORE_H__
+
+/// Forward declarations.
+typedef struct _PopplerDocument PopplerDocument;
+
+namespace ePDFView
+{
+    ///
+    /// @class PDFDocumentCore
+    /// @brief The parsed documents a PDFDocument shares with its copies.
+    ///
+    /// Poppler's documents can't be read from two threads at once, so
+    /// each copy of a PDFDocument takes a parsed document of its own from
+    /// the core, and gives it back when deleted. The documents given back
+    /// are kept for the next copies, so only the first copies of a file
+    /// parse it; later ones, like the next print, take a document already
+    /// parsed. The new documents are parsed from the same bytes, or file,
+    /// that the document was read from.
+    ///
+    /// The core is refcounted: the document and each of its copies hold
+    /// a reference, and reloading the document only drops its own.
+    ///
+    class PDFDocumentCore
+    {
+        public:
+            PDFDocumentCore (GBytes *contents, const gchar *uri,
+                             const gchar *password);
+
+            PopplerDocument *acquire (void);
+            guint getNumIdle (void);
+            PDFDocumentCore *ref (void);
+            void release (PopplerDocument *document);
+            void unref (void);
+
+        protected:
+            /// @brief The bytes the document was read from, or NULL if it
+            /// was opened by file name.
+            GBytes *m_Contents;
+            /// The parsed documents that no copy uses.
+            GQueue *m_IdleDocuments;
+            /// Protects m_IdleDocuments.
+            GMutex m_Lock;
+            /// The password to parse the document with, or NULL.
+            gchar *m_Password;
+            /// The references to the core, read with g_atomic_int_get().
+            volatile gint m_RefCount;
+            /// @brief The URI of the file to parse the document from, when
+            /// m_Contents is NULL.
+            gchar *m_Uri;
+
+            ~PDFDocumentCore (void);
+    };
+}
+
+#endif // !__PDF_DOCUMENT_CORE_H__
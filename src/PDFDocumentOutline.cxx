@@ -0,0 +1,108 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <config.h>
+#include <poppler.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief Constructs a new PDFDocumentOutline.
+///
+/// @param document The document the outline belongs to.
+/// @param children Poppler's iterator to the outline's first child, as
+///                 returned by poppler_index_iter_new() or
+///                 poppler_index_iter_get_child(). The outline takes it.
+///                 It can be NULL if the outline has no children.
+///
+PDFDocumentOutline::PDFDocumentOutline (PDFDocument *document,
+                                        PopplerIndexIter *children):
+    DocumentOutline ()
+{
+    g_assert (NULL != document && "Tried to set a NULL document.");
+
+    m_ChildrenIter = children;
+    m_Document = document;
+}
+
+///
+/// @brief Destroys all dynamically allocated memory for PDFDocumentOutline.
+///
+PDFDocumentOutline::~PDFDocumentOutline ()
+{
+    if ( NULL != m_ChildrenIter )
+    {
+        poppler_index_iter_free (m_ChildrenIter);
+    }
+}
+
+///
+/// @brief Tells if the outline has children without reading them.
+///
+/// @return TRUE if the outline has children, FALSE otherwise.
+///
+gboolean
+PDFDocumentOutline::hasChildren ()
+{
+    if ( !m_ChildrenLoaded )
+    {
+        return NULL != m_ChildrenIter;
+    }
+    return DocumentOutline::hasChildren ();
+}
+
+///
+/// @brief Reads the outline's children from the document.
+///
+/// Only this level is read. Each child keeps the iterator to its own
+/// children for when they are needed. As before, only the children that
+/// go to a page of the document are added.
+///
+void
+PDFDocumentOutline::loadChildren ()
+{
+    if ( NULL == m_ChildrenIter )
+    {
+        return;
+    }
+
+    do
+    {
+        PopplerAction *action = poppler_index_iter_get_action (m_ChildrenIter);
+        if ( POPPLER_ACTION_GOTO_DEST == action->type )
+        {
+            PopplerActionGotoDest *actionGoTo = (PopplerActionGotoDest *)action;
+            DocumentOutline *child = new PDFDocumentOutline (m_Document,
+                    poppler_index_iter_get_child (m_ChildrenIter));
+            child->setParent (this);
+            child->setTitle (actionGoTo->title);
+            child->setDestination (
+                    m_Document->getDestinationPage (actionGoTo->dest));
+            addChild (child);
+        }
+        poppler_action_free (action);
+    }
+    while ( poppler_index_iter_next (m_ChildrenIter) );
+
+    poppler_index_iter_free (m_ChildrenIter);
+    m_ChildrenIter = NULL;
+}
@@ -0,0 +1,61 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__PDF_DOCUMENT_OUTLINE_H__)
+#define __PDF_DOCUMENT_OUTLINE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class PDFDocument;
+
+    ///
+    /// @class PDFDocumentOutline
+    /// @brief An outline item of a PDF document that reads its children
+    ///        on demand.
+    ///
+    /// Generated documents can have tens of thousands of outline items,
+    /// and reading them all makes opening the document and filling the
+    /// index view slow. Each item only keeps Poppler's iterator to its
+    /// children and reads them the first time they are asked for, that
+    /// is when the item is expanded in the index.
+    ///
+    class PDFDocumentOutline: public DocumentOutline
+    {
+        public:
+            PDFDocumentOutline (PDFDocument *document,
+                                PopplerIndexIter *children);
+            ~PDFDocumentOutline (void);
+
+            gboolean hasChildren (void);
+
+        protected:
+            /// @brief Poppler's iterator to the first child, or NULL if
+            /// the outline has no children or they have been read.
+            PopplerIndexIter *m_ChildrenIter;
+            /// The document to resolve the children's destinations with.
+            PDFDocument *m_Document;
+
+            void loadChildren (void);
+    };
+}
+
+#endif // !__PDF_DOCUMENT_OUTLINE_H__
@@ -68,6 +68,7 @@ static gboolean g_InsideRefreshPage = FALSE;  // Prevent recursive refreshPage c
 PagePter::PagePter (IDocument *document)
 {
     m_LastSelection = NULL;
+    m_SelectionIdle = 0;
     m_Document = document;
     m_Document->attach (this);
     m_DragInfo = NULL;
@@ -81,6 +82,10 @@ PagePter::PagePter (IDocument *document)
 ///
 PagePter::~PagePter ()
 {
+    if ( 0 != m_SelectionIdle )
+    {
+        g_source_remove (m_SelectionIdle);
+    }
     if (m_LastSelection) {
         cairo_region_destroy(m_LastSelection);
         m_LastSelection = NULL;
@@ -251,6 +256,11 @@ PagePter::mouseButtonReleased (gint button)
 {
     if ( 1 == button )
     {
+        if ( 0 != m_SelectionIdle )
+        {
+            g_source_remove (m_SelectionIdle);
+            m_SelectionIdle = 0;
+        }
         if(m_LastSelection)
             cairo_region_destroy(m_LastSelection);
         m_LastSelection = NULL;
@@ -307,32 +317,77 @@ PagePter::mouseMoved (gint x, gint y)
             view.scrollPage (view.getHorizontalScroll (), view.getVerticalScroll (),
                              x - m_DragInfo->startX, y - m_DragInfo->startY);
         }
-        else{
-            if(!m_Document->isLoaded())
-                return ;
-            
-            DocumentRectangle rect(m_DragInfo->startX, m_DragInfo->startY,
-                                          m_DragInfo->x, m_DragInfo->y);
+        else if ( 0 == m_SelectionIdle )
+        {
+            // The selection is computed once all the pending motion
+            // events are handled, not once per event.
+            m_SelectionIdle = g_idle_add_full (G_PRIORITY_HIGH_IDLE,
+                                               PagePter::selectionChanged,
+                                               this, NULL);
+        }
+    }
+}
+
+///
+/// @brief Updates the text selection after the mouse moved.
+///
+/// @param user The PagePter whose selection changed.
+///
+/// @return FALSE, to remove the idle source.
+///
+gboolean
+PagePter::selectionChanged (gpointer user)
+{
+    g_assert (NULL != user && "The data parameter is NULL.");
 
-            cairo_region_t *region = m_Document->getTextRegion (&rect);
-            if (NULL == region)
-                return;
+    PagePter *pter = (PagePter *)user;
+    pter->m_SelectionIdle = 0;
+    pter->updateSelection ();
 
-            if( !m_LastSelection || 
-                !cairo_region_equal(m_LastSelection, region)
-            ){
-                if(m_LastSelection) {
-                    cairo_region_destroy(m_LastSelection);
-                }
-                m_LastSelection = cairo_region_copy(region);
-                DocumentPage *page = m_Document->getCurrentPage();
-                if ( NULL != page )
-                    refreshPage (PAGE_SCROLL_NONE, FALSE);
-            }
-            
-            // Free the temporary region returned by getTextRegion
-            cairo_region_destroy(region);
+    return FALSE;
+}
+
+///
+/// @brief Highlights the text between where the drag started and the mouse.
+///
+/// Only the part of the page whose selection state changed since the
+/// last update is inverted and sent to the view.
+///
+void
+PagePter::updateSelection ()
+{
+    if ( NULL == m_DragInfo || !m_Document->isLoaded () )
+    {
+        return;
+    }
+
+    DocumentRectangle rect (m_DragInfo->startX, m_DragInfo->startY,
+                            m_DragInfo->x, m_DragInfo->y);
+    cairo_region_t *region = m_Document->getTextRegion (&rect);
+    if ( NULL == region )
+    {
+        return;
+    }
+
+    if ( NULL == m_LastSelection ||
+         !cairo_region_equal (m_LastSelection, region) )
+    {
+        DocumentPage *page = m_Document->getCurrentPage ();
+        if ( NULL != page )
+        {
+            cairo_region_t *changed = page->updateSelection (region);
+            getView ().updatePageArea (page, changed);
+            cairo_region_destroy (changed);
         }
+        if ( NULL != m_LastSelection )
+        {
+            cairo_region_destroy (m_LastSelection);
+        }
+        m_LastSelection = region;
+    }
+    else
+    {
+        cairo_region_destroy (region);
     }
 }
 
@@ -353,6 +408,12 @@ PagePter::notifyLoad ()
     refreshPage (PAGE_SCROLL_START, FALSE);
 }
 
+void
+PagePter::notifyLowMemory ()
+{
+    getView ().releaseMemory ();
+}
+
 void
 PagePter::notifyPageChanged (gint pageNum)
 {
@@ -402,6 +463,7 @@ PagePter::pageNotAvailable (gpointer user)
             if ( NULL != data->pter->m_LastSelection )
                 documentPage->setSelection(data->pter->m_LastSelection);
             view.showPage (documentPage, data->scroll);
+            StartupProfile::finish ("first page shown");
             delete data;
             return FALSE;  // Stop the idle callback
         }
@@ -482,6 +544,7 @@ PagePter::refreshPage(PageScroll pageScroll, gboolean wasZoomed)
             if ( NULL != m_LastSelection )
                 documentPage->setSelection(m_LastSelection);
             view.showPage (documentPage, pageScroll);
+            StartupProfile::finish ("first page shown");
         }
         else
         {
@@ -54,12 +54,14 @@ namespace ePDFView
             void mouseMoved (gint x, gint y);
             void notifyFindChanged (DocumentRectangle *matchRect);
             void notifyLoad (void);
+            void notifyLowMemory (void);
             void notifyPageChanged (gint pageNum);
             void notifyPageRotated (gint rotation);
             void notifyPageZoomed (gdouble zoom);
             void notifyReload (void);
 			void tryReShowPage (void);
             static gboolean pageNotAvailable (gpointer user);
+            static gboolean selectionChanged (gpointer user);
             void scrollToNextPage (void);
             void scrollToPreviousPage (void);
             void setNextPageScroll (PageScroll next);
@@ -68,6 +70,7 @@ namespace ePDFView
             void setMode(PagePterMode mode);
 			void setInvertColorToggle(char on);//krogan
             void refreshPage (PageScroll pageScroll, gboolean wasZoomed);
+            void updateSelection (void);
 
         protected:
             /// The document whose page is shown.
@@ -80,6 +83,9 @@ namespace ePDFView
             IPageView *m_PageView;
             /// Last text selection
             cairo_region_t *m_LastSelection;
+            /// @brief The idle source that updates the text selection.
+            /// The mouse motions between two updates are merged into one.
+            guint m_SelectionIdle;
             /// What page presenter must do when user move mouse with button pressed.
             PagePterMode m_ScrollMode;
     };
@@ -0,0 +1,277 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+// Forward declarations.
+static guint getLayoutPagesPerSheet (PrintPageLayout layout);
+
+///
+/// @brief Constructs a new PrintImposition object.
+///
+/// The grid is chosen for pages of the same proportions as the sheet,
+/// which are most documents printed on their own paper size.
+///
+/// @param layout The layout of the pages on the sheets.
+/// @param numPages The number of pages to print.
+/// @param sheetWidth The sheet's width, in 1/72 inches.
+/// @param sheetHeight The sheet's height, in 1/72 inches.
+///
+PrintImposition::PrintImposition (PrintPageLayout layout, guint numPages,
+                                  gdouble sheetWidth, gdouble sheetHeight)
+{
+    g_assert (0 < sheetWidth && 0 < sheetHeight && "Invalid sheet size.");
+
+    m_Booklet = PRINT_PAGE_LAYOUT_BOOKLET == layout;
+    m_Landscape = FALSE;
+    m_NumColumns = 1;
+    m_NumPages = numPages;
+    m_NumRows = 1;
+    m_SheetHeight = sheetHeight;
+    m_SheetWidth = sheetWidth;
+
+    guint pagesPerSheet = getLayoutPagesPerSheet (layout);
+    if ( m_Booklet )
+    {
+        m_Landscape = TRUE;
+        m_NumColumns = 2;
+    }
+    else if ( 1 < pagesPerSheet )
+    {
+        gdouble bestScale = 0.0;
+        for ( gint landscape = FALSE ; landscape <= TRUE ; landscape++ )
+        {
+            gdouble frameWidth = landscape ? sheetHeight : sheetWidth;
+            gdouble frameHeight = landscape ? sheetWidth : sheetHeight;
+            for ( guint columns = 1 ; columns <= pagesPerSheet ; columns++ )
+            {
+                if ( 0 != pagesPerSheet % columns )
+                {
+                    continue;
+                }
+                guint rows = pagesPerSheet / columns;
+                gdouble scale =
+                    MIN (frameWidth / columns / sheetWidth,
+                         frameHeight / rows / sheetHeight);
+                // Only a clearly larger scale changes the grid, so
+                // rounding doesn't turn the sheet.
+                if ( scale > bestScale * 1.0001 )
+                {
+                    bestScale = scale;
+                    m_Landscape = landscape;
+                    m_NumColumns = columns;
+                    m_NumRows = rows;
+                }
+            }
+        }
+    }
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by PrintImposition.
+///
+PrintImposition::~PrintImposition ()
+{
+}
+
+///
+/// @brief Gets the number of columns of the grid.
+///
+/// @return The columns, as seen on the sheet turned to landscape when
+///         isLandscape() is TRUE.
+///
+guint
+PrintImposition::getNumColumns ()
+{
+    return m_NumColumns;
+}
+
+///
+/// @brief Gets the number of rows of the grid.
+///
+/// @return The rows, as seen on the sheet turned to landscape when
+///         isLandscape() is TRUE.
+///
+guint
+PrintImposition::getNumRows ()
+{
+    return m_NumRows;
+}
+
+///
+/// @brief Gets the number of sheets to print.
+///
+/// For booklets, each side of a sheet counts as a sheet.
+///
+/// @return The number of sheet sides with pages.
+///
+guint
+PrintImposition::getNumSheets ()
+{
+    guint pagesPerSheet = getPagesPerSheet ();
+    if ( m_Booklet )
+    {
+        // The pages are padded to fill whole folded sheets.
+        return (m_NumPages + 3) / 4 * 2;
+    }
+    return (m_NumPages + pagesPerSheet - 1) / pagesPerSheet;
+}
+
+///
+/// @brief Gets the page placed on a sheet's cell.
+///
+/// @param sheet The index of the sheet, from 0.
+/// @param slot The index of the cell on the sheet, in reading order.
+///
+/// @return The index, from 0, of the page among the pages to print, or
+///         -1 if the cell is blank.
+///
+gint
+PrintImposition::getPage (guint sheet, guint slot)
+{
+    g_assert (slot < getPagesPerSheet () && "Invalid slot.");
+
+    guint page;
+    if ( m_Booklet )
+    {
+        guint numPadded = (m_NumPages + 3) / 4 * 4;
+        guint folded = sheet / 2;
+        if ( 0 == sheet % 2 )
+        {
+            // The front has the last and the first pages not yet placed.
+            page = 0 == slot ? numPadded - 1 - 2 * folded : 2 * folded;
+        }
+        else
+        {
+            page = 0 == slot ? 2 * folded + 1 : numPadded - 2 - 2 * folded;
+        }
+    }
+    else
+    {
+        page = sheet * getPagesPerSheet () + slot;
+    }
+
+    return page < m_NumPages ? (gint)page : -1;
+}
+
+///
+/// @brief Gets where a page is drawn on the sheet.
+///
+/// The transformation maps the page's unscaled coordinates, with the
+/// origin at its top-left corner, to the sheet's, in 1/72 inches and
+/// with the origin at the sheet's top-left corner. When the sheet is
+/// turned to landscape, the top of the grid is the sheet's left side.
+///
+/// @param slot The index of the cell on the sheet, in reading order.
+/// @param pageWidth The page's width.
+/// @param pageHeight The page's height.
+/// @param matrix The output location to save the transformation to.
+///
+void
+PrintImposition::getPageTransform (guint slot, gdouble pageWidth,
+                                   gdouble pageHeight, cairo_matrix_t *matrix)
+{
+    g_assert (slot < getPagesPerSheet () && "Invalid slot.");
+    g_assert (NULL != matrix && "Tried to save the transformation to NULL.");
+
+    gdouble frameWidth = m_Landscape ? m_SheetHeight : m_SheetWidth;
+    gdouble frameHeight = m_Landscape ? m_SheetWidth : m_SheetHeight;
+    gdouble cellWidth = frameWidth / m_NumColumns;
+    gdouble cellHeight = frameHeight / m_NumRows;
+    gdouble scale = 1.0;
+    if ( 0 < pageWidth && 0 < pageHeight )
+    {
+        scale = MIN (cellWidth / pageWidth, cellHeight / pageHeight);
+    }
+    guint column = slot % m_NumColumns;
+    guint row = slot / m_NumColumns;
+
+    cairo_matrix_t pageToFrame;
+    cairo_matrix_init (&pageToFrame, scale, 0.0, 0.0, scale,
+                       column * cellWidth +
+                           (cellWidth - pageWidth * scale) / 2.0,
+                       row * cellHeight +
+                           (cellHeight - pageHeight * scale) / 2.0);
+    cairo_matrix_t frameToSheet;
+    if ( m_Landscape )
+    {
+        // x' = y and y' = sheetHeight - x.
+        cairo_matrix_init (&frameToSheet, 0.0, -1.0, 1.0, 0.0,
+                           0.0, m_SheetHeight);
+    }
+    else
+    {
+        cairo_matrix_init_identity (&frameToSheet);
+    }
+    cairo_matrix_multiply (matrix, &pageToFrame, &frameToSheet);
+}
+
+///
+/// @brief Gets the number of pages on each sheet.
+///
+/// @return The number of cells of the grid.
+///
+guint
+PrintImposition::getPagesPerSheet ()
+{
+    return m_NumColumns * m_NumRows;
+}
+
+///
+/// @brief Tells if the grid is laid on the sheet turned to landscape.
+///
+/// @return TRUE if the sheet is turned, FALSE otherwise.
+///
+gboolean
+PrintImposition::isLandscape ()
+{
+    return m_Landscape;
+}
+
+///
+/// @brief Gets the number of pages on each sheet of a layout.
+///
+/// @param layout The layout to get its number of pages.
+///
+/// @return The number of pages of @a layout.
+///
+guint
+getLayoutPagesPerSheet (PrintPageLayout layout)
+{
+    switch ( layout )
+    {
+        case PRINT_PAGE_LAYOUT_2IN1:
+        case PRINT_PAGE_LAYOUT_BOOKLET:
+            return 2;
+        case PRINT_PAGE_LAYOUT_4IN1:
+            return 4;
+        case PRINT_PAGE_LAYOUT_6IN1:
+            return 6;
+        case PRINT_PAGE_LAYOUT_8IN1:
+            return 8;
+        default:
+            return 1;
+    }
+}
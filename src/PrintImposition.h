@@ -0,0 +1,77 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__PRINT_IMPOSITION_H__)
+#define __PRINT_IMPOSITION_H__
+
+namespace ePDFView
+{
+    ///
+    /// @class PrintImposition
+    /// @brief Places the pages to print on the printed sheets.
+    ///
+    /// With a N pages per sheet layout, the sheet is divided in a grid
+    /// of N cells, and the pages are placed in reading order, each
+    /// scaled to fit its cell and centered. The grid, and whether the
+    /// sheet is turned to landscape, are chosen to make the pages as
+    /// large as possible.
+    ///
+    /// The booklet layout places two pages on each side of the sheets,
+    /// in the order that, printed on both sides and folded in half,
+    /// reads as a booklet.
+    ///
+    class PrintImposition
+    {
+        public:
+            PrintImposition (PrintPageLayout layout, guint numPages,
+                             gdouble sheetWidth, gdouble sheetHeight);
+            ~PrintImposition (void);
+
+            guint getNumColumns (void);
+            guint getNumRows (void);
+            guint getNumSheets (void);
+            gint getPage (guint sheet, guint slot);
+            void getPageTransform (guint slot, gdouble pageWidth,
+                                   gdouble pageHeight,
+                                   cairo_matrix_t *matrix);
+            guint getPagesPerSheet (void);
+            gboolean isLandscape (void);
+
+        protected:
+            /// Tells if the pages are ordered for a booklet.
+            gboolean m_Booklet;
+            /// Tells if the grid is laid on the sheet turned to landscape.
+            gboolean m_Landscape;
+            /// The number of columns of the grid.
+            guint m_NumColumns;
+            /// The number of pages to print.
+            guint m_NumPages;
+            /// The number of rows of the grid.
+            guint m_NumRows;
+            /// The sheet's height, in 1/72 inches.
+            gdouble m_SheetHeight;
+            /// The sheet's width, in 1/72 inches.
+            gdouble m_SheetWidth;
+    };
+}
+
+#endif // !__PRINT_IMPOSITION_H__
@@ -21,55 +21,10 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <config.h>
-#include <cups/cups.h>
-#include <cups/ipp.h>
-#include <cups/ppd.h>
-#include <locale.h>
 #include "epdfview.h"
 
-#if (CUPS_VERSION_MAJOR > 1) || (CUPS_VERSION_MINOR > 5)
-#define HAVE_CUPS_1_6 1
-#endif
-
-#ifndef HAVE_CUPS_1_6
-inline int ippGetInteger (ipp_attribute_t *attr, int element)
-{
-    return (attr->values[element].integer);
-}
-
-inline const char * ippGetString (ipp_attribute_t *attr,
-                                  int             element,
-                                  const char      **language /*UNUSED*/)
-{
-    return (attr->values[element].string.text);
-}
-
-inline int ippSetOperation (ipp_t *ipp, ipp_op_t op)
-{
-  if (!ipp)
-    return (0);
-  ipp->request.op.operation_id = op;
-  return (1);
-}
-
-inline int ippSetRequestId (ipp_t *ipp, int request_id)
-{
-    if (!ipp)
-        return (0);
-    ipp->request.any.request_id = request_id;
-    return (1);
-}
-#endif
-
 using namespace ePDFView;
 
-// Structures
-struct _printerAttributes
-{
-    gchar *location;
-    gchar *state;
-};
-
 PrintPter::PrintPter (IDocument *document)
 {
     m_View = NULL;
@@ -78,6 +33,11 @@ PrintPter::PrintPter (IDocument *document)
 
 PrintPter::~PrintPter ()
 {
+    PrinterCache &cache = PrinterCache::getCache ();
+    if ( this == cache.getPresenter () )
+    {
+        cache.setPresenter (NULL);
+    }
     delete m_View;
 }
 
@@ -98,8 +58,12 @@ PrintPter::setView (IPrintView *view)
     view->sensitiveCollate (FALSE);
     view->sensitivePageRange (FALSE);
 
-    // Retrieve and set the list of printer.
-    listPrinters ();
+    // The printers are added when listed. Until then, nothing can be
+    // printed.
+    view->sensitivePrintButton (FALSE);
+    PrinterCache &cache = PrinterCache::getCache ();
+    cache.setPresenter (this);
+    cache.requestPrinters ();
 
     getView ().setPresenter (this);
 }
@@ -158,14 +122,14 @@ PrintPter::printActivated ()
         {
             printerName = g_strdup (printerAndInstanceNames);
         }
-        g_free (printerAndInstanceNames);
 
         float pageWidth;
         float pageHeight;
         char *pageSizeName = view.getPageSize ();
-        getPageSizeForPrinter (printerName, pageSizeName,
+        getPageSizeForPrinter (printerAndInstanceNames, pageSizeName,
                                &pageWidth, &pageHeight);
         g_free (pageSizeName);
+        g_free (printerAndInstanceNames);
         // Create the new print job.
         JobPrint *job = new JobPrint ();
         job->setDocument (m_Document);
@@ -219,144 +183,45 @@ void
 PrintPter::printerSelectionChanged ()
 {
     IPrintView &view = getView ();
+    // Until the printer's options are loaded, the lists are empty.
+    view.clearPageSizeList ();
+    view.clearResolutionList ();
+    view.clearColorModelList ();
 
     gchar *printerAndInstanceNames = view.getSelectedPrinterName ();
-
     if ( NULL != printerAndInstanceNames )
     {
-        cups_dest_t *destinations;
-        guint numDestinations = cupsGetDests (&destinations);
-        if ( NULL == destinations )
-        {
-            g_free (printerAndInstanceNames);
-            return;
-        }
-        gchar *slashPosition = g_strrstr (printerAndInstanceNames, "/");
-        gchar *printerName = NULL;
-        gchar *instanceName = NULL;
-        if ( slashPosition != NULL )
-        {
-            *slashPosition = '\0';
-            printerName = g_strdup (printerAndInstanceNames);
-            instanceName = g_strdup (slashPosition + 1);
-            *slashPosition = '/';
-        }
-        else
-        {
-            printerName = g_strdup (printerAndInstanceNames);
-        }
-        cups_dest_t *destination = cupsGetDest (printerName, instanceName,
-                                                numDestinations, destinations);
-        if ( NULL == destinations )
-        {
-            g_free (printerName);
-            cupsFreeDests (numDestinations, destinations);
-            return;
-        }
+        PrinterCache::getCache ().requestOptions (printerAndInstanceNames);
+        g_free (printerAndInstanceNames);
+    }
+}
 
-        const gchar *printerPPDName = cupsGetPPD (printerName);
-        if ( NULL != printerPPDName )
+///
+/// @brief Gets the index of a printer in the list.
+///
+/// @param printerName The printer's name.
+///
+/// @return The printer's index or -1 if it's not listed.
+///
+gint
+PrintPter::findPrinter (const gchar *printerName)
+{
+    gint defaultPrinter;
+    gchar **printers = PrinterCache::getCache ().getPrinters (&defaultPrinter);
+    gint printerIndex = -1;
+    for ( gint currentPrinter = 0 ;
+          NULL != printers && NULL != printers[currentPrinter] ;
+          ++currentPrinter )
+    {
+        if ( 0 == g_strcmp0 (printerName, printers[currentPrinter]) )
         {
-            ppd_file_t *printerPPD = ppdOpenFile (printerPPDName);
-            if ( NULL != printerPPD )
-            {
-                ppdMarkDefaults (printerPPD);
-                cupsMarkOptions (printerPPD, destination->num_options,
-                                 destination->options);
-
-                // Get the page sizes.
-                ppd_option_t *pageSizeOption =
-                    ppdFindOption (printerPPD, "PageSize");
-                view.clearPageSizeList ();
-                int pageSizeToSelect = 0;
-                if ( 0 != pageSizeOption )
-                {
-                    ppd_choice_t *pageSizeChoice = pageSizeOption->choices;
-                    for ( int currentSize = 0 ;
-                         currentSize < pageSizeOption->num_choices ;
-                         ++currentSize, ++pageSizeChoice )
-                    {
-                        const gchar *sizeName = pageSizeChoice->text;
-                        const gchar *sizeValue = pageSizeChoice->choice;
-
-                        view.addPageSize (_(sizeName), sizeValue);
-                        if ( pageSizeChoice->marked )
-                        {
-                            pageSizeToSelect = currentSize;
-                        }
-                    }
-                }
-                else
-                {
-                    view.addPageSize (_("A4"), "A4");
-                }
-                view.selectPageSize (pageSizeToSelect);
-
-                // Get the resolutions.
-                ppd_option_t *resolutionOption =
-                    ppdFindOption (printerPPD, "Resolution");
-                view.clearResolutionList ();
-                int resolutionToSelect = 0;
-                if ( 0 != resolutionOption )
-                {
-                    ppd_choice_t *resolutionChoice = resolutionOption->choices;
-                    for ( int currentRes = 0 ;
-                            currentRes < resolutionOption->num_choices ;
-                            ++currentRes, ++resolutionChoice )
-                    {
-                        const gchar *resName = resolutionChoice->text;
-                        const gchar *resValue = resolutionChoice->choice;
-
-                        view.addResolution (_(resName), resValue);
-                        if ( resolutionChoice->marked )
-                        {
-                            resolutionToSelect = currentRes;
-                        }
-                    }
-                }
-                else
-                {
-                    view.addResolution (_("300 DPI"), "300x300dpi");
-                }
-                view.selectResolution (resolutionToSelect);
-
-                // Get the color models.
-                ppd_option_t *colorModelOption =
-                    ppdFindOption (printerPPD, "ColorModel");
-                view.clearColorModelList ();
-                int colorModelToSelect = 0;
-                if ( NULL != colorModelOption )
-                {
-                    ppd_choice_t *colorModelChoice = colorModelOption->choices;
-                    for ( int currentColor = 0 ;
-                          currentColor < colorModelOption->num_choices ;
-                          ++currentColor, ++colorModelChoice )
-                    {
-                        const gchar *colorName = colorModelChoice->text;
-                        const gchar *colorValue = colorModelChoice->choice;
-
-                        view.addColorModel (_(colorName), colorValue);
-                        if ( colorModelChoice->marked )
-                        {
-                            colorModelToSelect = currentColor;
-                        }
-                    }
-                }
-                else
-                {
-                    view.addColorModel (_("Grayscale"), "Gray");
-                }
-                view.selectColorModel (colorModelToSelect);
-                ppdClose (printerPPD);
-                if (printerPPDName != NULL)
-                    unlink(printerPPDName);
-            }
+            printerIndex = currentPrinter;
+            break;
         }
-        cupsFreeDests (numDestinations, destinations);
-        g_free (printerName);
-        g_free (instanceName);
-        g_free (printerAndInstanceNames);
     }
+    g_strfreev (printers);
+
+    return printerIndex;
 }
 
 void
@@ -373,189 +238,159 @@ PrintPter::getPageSizeForPrinter (const gchar *printerName,
 
     if ( NULL != printerName )
     {
-        const gchar *printerPPDName = cupsGetPPD (printerName);
-        if ( NULL != printerPPDName )
+        PrinterOptions *options =
+            PrinterCache::getCache ().getOptions (printerName);
+        if ( NULL != options )
         {
-            ppd_file_t *printerPPD = ppdOpenFile (printerPPDName);
-            if ( NULL != printerPPD )
-            {
-                for ( int currentSize = 0 ;
-                      currentSize < printerPPD->num_sizes ;
-                      ++currentSize )
-                {
-                    ppd_size_t *size = &printerPPD->sizes[currentSize];
-                    if ( 0 == g_ascii_strcasecmp (pageSizeName, size->name) )
-                    {
-                        *pageWidth = size->width;
-                        *pageHeight = size->length;
-                        break;
-                    }
-                }
-                ppdClose (printerPPD);
-            }
+            options->getPageSize (pageSizeName, pageWidth, pageHeight);
         }
     }
 }
 
-printerAttributes *
-PrintPter::getPrinterAttributes (const gchar *printerName)
+///
+/// @brief A printer's state has been loaded.
+///
+/// @param printerName The printer's name.
+///
+void
+PrintPter::notifyPrinterAttributesLoaded (const gchar *printerName)
 {
-    // Create and empty attributes structure.
-    printerAttributes *attributes = new printerAttributes ();
-    attributes->state = NULL;
-    attributes->location = NULL;
-
-    // The attributes to request from the server.
-    const gchar *attributesToRequest[] =
-    {
-        "printer-state",
-        "printer-location"
-    };
-
-#if (CUPS_VERSION_MAJOR > 1) || (CUPS_VERSION_MINOR >= 7)
-    http_t *http = httpConnect2(cupsServer(), ippPort(), NULL, AF_UNSPEC, HTTP_ENCRYPTION_IF_REQUESTED, 1, 30000, NULL);
-#else
-    http_t *http = httpConnect (cupsServer (), ippPort ());
-#endif
-    if ( NULL == http )
+    gint printerIndex = findPrinter (printerName);
+    gint numJobs;
+    const gchar *state;
+    const gchar *location;
+    if ( -1 != printerIndex &&
+         PrinterCache::getCache ().getAttributes (printerName, &numJobs,
+                                                  &state, &location) )
     {
-        printf ("No http!\n");
-        return attributes;
+        getView ().setPrinterAttributes (printerIndex, numJobs, state,
+                                         location);
     }
+}
 
-    ipp_t *request = ippNew ();
-
-    ippSetOperation(request, IPP_GET_PRINTER_ATTRIBUTES);
-    ippSetRequestId(request, 1);
-
-    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_CHARSET,
-                  "attributes-charset", NULL, "utf-8");
-    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_LANGUAGE,
-                  "attributes-natural-language", NULL,
-                  setlocale (LC_MESSAGES, NULL));
-    ippAddStrings (request, IPP_TAG_OPERATION, IPP_TAG_KEYWORD,
-                   "requested-attributes", G_N_ELEMENTS (attributesToRequest),
-                   NULL, attributesToRequest);
-    gchar *uri = g_strdup_printf ("ipp://localhost/printers/%s", printerName);
-    ippAddString (request, IPP_TAG_OPERATION, IPP_TAG_URI,
-                  "printer-uri", NULL, uri);
-
-    ipp_t *answer = cupsDoRequest (http, request, "/");
-    if ( NULL != answer )
-    {
-        // Get the state.
-        ipp_attribute_t *state =
-            ippFindAttribute (answer, "printer-state", IPP_TAG_ZERO);
-        if ( NULL != state )
-        {
-            switch (ippGetInteger (state, 0))
-            {
-                case IPP_PRINTER_IDLE:
-                    attributes->state = g_strdup (_("Idle"));
-                    break;
-                case IPP_PRINTER_STOPPED:
-                    attributes->state = g_strdup (_("Stopped"));
-                    break;
-                case IPP_PRINTER_PROCESSING:
-                    attributes->state = g_strdup (_("Processing"));
-                    break;
-                default:
-                    attributes->state = g_strdup (_("Unknown"));
-                    break;
-            }
-        }
-
-        // Get the location.
-        ipp_attribute_t *location =
-            ippFindAttribute (answer, "printer-location", IPP_TAG_ZERO);
-        if ( NULL != location )
-        {
-            attributes->location = g_strdup (ippGetString (location, 0, NULL));
-        }
-
-        ippDelete (answer);
-    }
-    else
+///
+/// @brief A printer's options have been loaded.
+///
+/// The options are only shown if the printer is still the selected.
+///
+/// @param printerName The printer's name.
+///
+void
+PrintPter::notifyPrinterOptionsLoaded (const gchar *printerName)
+{
+    gchar *selectedPrinter = getView ().getSelectedPrinterName ();
+    if ( 0 == g_strcmp0 (printerName, selectedPrinter) )
     {
-        printf ("No answer!\n");
+        showPrinterOptions (PrinterCache::getCache ().getOptions (printerName));
     }
-
-    httpClose (http);
-    g_free (uri);
-    return attributes;
+    g_free (selectedPrinter);
 }
 
+///
+/// @brief The printers have been listed.
+///
+/// The printers are added without their state, that is requested
+/// for each printer and shown as it arrives.
+///
 void
-PrintPter::listPrinters (void)
+PrintPter::notifyPrintersLoaded ()
 {
     IPrintView &view = getView ();
+    PrinterCache &cache = PrinterCache::getCache ();
 
-    cups_dest_t *destinations;
-    int numDestinations = cupsGetDests (&destinations);
-    // For now we don't have any printer selected.
-    int printerToSelect = -1;
-
-    for ( int currentDestination = 0 ; currentDestination < numDestinations ;
-          ++currentDestination )
+    gint defaultPrinter;
+    gchar **printers = cache.getPrinters (&defaultPrinter);
+    guint numPrinters = NULL != printers ? g_strv_length (printers) : 0;
+    for ( guint currentPrinter = 0 ; currentPrinter < numPrinters ;
+          ++currentPrinter )
     {
-        // Get the printer name and the local instance, if it has any.
-        gchar *printerName = destinations[currentDestination].name;
-        gchar *printerAndInstanceNames = NULL;
-        if ( NULL != destinations[currentDestination].instance )
-        {
-            printerAndInstanceNames = g_strdup_printf ("%s/%s",
-                    destinations[currentDestination].name,
-                    destinations[currentDestination].instance );
-        }
-        else
-        {
-            printerAndInstanceNames =
-                g_strdup (destinations[currentDestination].name);
-        }
-        // Get the number of jobs the printer currently has.
-        cups_job_t *destinationJobs;
-        int numJobs = cupsGetJobs (&destinationJobs, printerName, 1, 0);
-        cupsFreeJobs (numJobs, destinationJobs);
-        // Get the state and location.
-        printerAttributes *attributes = getPrinterAttributes (printerName);
-        // Set all this data to the view.
-        view.addPrinter (printerAndInstanceNames, numJobs,
-                               attributes->state, attributes->location);
-        g_free (printerAndInstanceNames);
-        g_free (attributes->location);
-        g_free (attributes->state);
-        delete attributes;
-
-        // If the printer is the default and we don't have any printer
-        // selected, then we should select it.
-        if ( -1 == printerToSelect &&
-             destinations[currentDestination].is_default )
-        {
-            printerToSelect = currentDestination;
-        }
+        view.addPrinter (printers[currentPrinter], 0, NULL, NULL);
+    }
+    for ( guint currentPrinter = 0 ; currentPrinter < numPrinters ;
+          ++currentPrinter )
+    {
+        cache.requestAttributes (printers[currentPrinter]);
     }
-    cupsFreeDests (numDestinations, destinations);
+    g_strfreev (printers);
 
     // If not printer is available, insensitive the print button.
-    if ( 0 == numDestinations )
+    if ( 0 == numPrinters )
     {
         view.sensitivePrintButton (FALSE);
     }
-    // Otherwise select a printer: the previously used, the default or 
-    // the first.
+    // Otherwise select a printer: the default or the first.
     else
     {
-        if ( -1 == printerToSelect )
+        view.sensitivePrintButton (TRUE);
+        if ( -1 == defaultPrinter )
         {
             view.selectPrinter (0);
         }
         else
         {
-            view.selectPrinter (printerToSelect);
+            view.selectPrinter (defaultPrinter);
         }
-        // The selection has been changed before the
+        // The selection may have been changed before the
         // view could connect the signals, so here we'll set the selected
-        // printer's page sizes "by hand".
+        // printer's options "by hand".
         printerSelectionChanged ();
     }
 }
+
+///
+/// @brief Shows the choices of the selected printer's options.
+///
+/// @param options The printer's options or NULL to show the defaults.
+///
+void
+PrintPter::showPrinterOptions (PrinterOptions *options)
+{
+    IPrintView &view = getView ();
+
+    view.clearPageSizeList ();
+    view.clearResolutionList ();
+    view.clearColorModelList ();
+    if ( NULL == options )
+    {
+        view.addPageSize (_("A4"), "A4");
+        view.selectPageSize (0);
+        view.addResolution (_("300 DPI"), "300x300dpi");
+        view.selectResolution (0);
+        view.addColorModel (_("Grayscale"), "Gray");
+        view.selectColorModel (0);
+        return;
+    }
+
+    for ( guint choice = 0 ;
+          choice < options->getNumChoices (PRINTER_OPTION_PAGE_SIZE) ;
+          ++choice )
+    {
+        view.addPageSize (
+                options->getChoiceText (PRINTER_OPTION_PAGE_SIZE, choice),
+                options->getChoiceValue (PRINTER_OPTION_PAGE_SIZE, choice));
+    }
+    view.selectPageSize (
+            options->getSelectedChoice (PRINTER_OPTION_PAGE_SIZE));
+
+    for ( guint choice = 0 ;
+          choice < options->getNumChoices (PRINTER_OPTION_RESOLUTION) ;
+          ++choice )
+    {
+        view.addResolution (
+                options->getChoiceText (PRINTER_OPTION_RESOLUTION, choice),
+                options->getChoiceValue (PRINTER_OPTION_RESOLUTION, choice));
+    }
+    view.selectResolution (
+            options->getSelectedChoice (PRINTER_OPTION_RESOLUTION));
+
+    for ( guint choice = 0 ;
+          choice < options->getNumChoices (PRINTER_OPTION_COLOR_MODEL) ;
+          ++choice )
+    {
+        view.addColorModel (
+                options->getChoiceText (PRINTER_OPTION_COLOR_MODEL, choice),
+                options->getChoiceValue (PRINTER_OPTION_COLOR_MODEL, choice));
+    }
+    view.selectColorModel (
+            options->getSelectedChoice (PRINTER_OPTION_COLOR_MODEL));
+}
@@ -23,15 +23,19 @@
 #if !defined (__PRINT_PTER_H__)
 #define __PRINT_PTER_H__
 
-// Forward declarations.
-typedef struct _printerAttributes printerAttributes;
-
 namespace ePDFView
 {
+    // Forward declarations.
+    class PrinterOptions;
+
     ///
     /// @class PrintPter
     /// @brief Print Presenter.
     ///
+    /// The printers and their options are loaded by PrinterCache in the
+    /// background, and shown as soon as they arrive, so the dialog
+    /// doesn't wait for the printing system.
+    ///
     class PrintPter
     {
         public:
@@ -42,6 +46,9 @@ namespace ePDFView
             void setView (IPrintView *view);
 
             void cancelActivated (void);
+            void notifyPrinterAttributesLoaded (const gchar *printerName);
+            void notifyPrinterOptionsLoaded (const gchar *printerName);
+            void notifyPrintersLoaded (void);
             void numberOfCopiesChanged (void);
             void pageRangeOptionChanged (void);
             void printActivated (void);
@@ -51,11 +58,11 @@ namespace ePDFView
             IDocument *m_Document;
             IPrintView *m_View;
 
+            gint findPrinter (const gchar *printerName);
             void getPageSizeForPrinter (const gchar *printerName,
                                         const gchar *sizeName,
                                         float *pageWidth, float *pageHeight);
-            printerAttributes *getPrinterAttributes (const gchar *printerName);
-            void listPrinters (void);
+            void showPrinterOptions (PrinterOptions *options);
     };
 }
 
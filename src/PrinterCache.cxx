@@ -0,0 +1,466 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+G_LOCK_DEFINE_STATIC (printerCache);
+
+// Forward declarations.
+static void freePrinterAttributes (gpointer data);
+static void freePrinterOptions (gpointer data);
+
+///
+/// @brief The state of a printer.
+///
+typedef struct
+{
+    /// The number of jobs the printer had.
+    gint numJobs;
+    /// The printer's translated state, or NULL.
+    gchar *state;
+    /// The printer's location, or NULL.
+    gchar *location;
+} PrinterAttributes;
+
+PrinterCache *PrinterCache::m_Cache = NULL;
+
+///
+/// @brief Constructs a new PrinterCache object.
+///
+/// The printers are got from CUPS unless another source is set.
+///
+PrinterCache::PrinterCache ()
+{
+    m_Attributes = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                          freePrinterAttributes);
+    m_AttributesPending = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                 g_free, NULL);
+    m_DefaultPrinter = -1;
+    m_NumLoading = 0;
+    m_Options = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                       freePrinterOptions);
+    m_OptionsPending = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                              g_free, NULL);
+    m_Presenter = NULL;
+    m_Printers = NULL;
+    m_PrintersPending = FALSE;
+    m_Source = NULL;
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by PrinterCache.
+///
+PrinterCache::~PrinterCache ()
+{
+    g_hash_table_unref (m_Attributes);
+    g_hash_table_unref (m_AttributesPending);
+    g_hash_table_unref (m_Options);
+    g_hash_table_unref (m_OptionsPending);
+    g_strfreev (m_Printers);
+    delete m_Source;
+}
+
+///
+/// @brief Destroys the cache.
+///
+/// No job loading printers must be running.
+///
+void
+PrinterCache::destroy ()
+{
+    delete m_Cache;
+    m_Cache = NULL;
+}
+
+///
+/// @brief Gets the cache.
+///
+/// The first time this function is called creates the cache.
+///
+/// @return The reference to the cache.
+///
+PrinterCache &
+PrinterCache::getCache ()
+{
+    if ( NULL == m_Cache )
+    {
+        m_Cache = new PrinterCache ();
+    }
+
+    g_assert (NULL != m_Cache && "The printer cache is NULL.");
+    return *m_Cache;
+}
+
+///
+/// @brief Gets a printer's state.
+///
+/// @param printerName The printer's name.
+/// @param numJobs The output location to save the number of jobs to.
+/// @param state The output location to save the state to. It belongs
+///              to the cache.
+/// @param location The output location to save the location to. It
+///                 belongs to the cache.
+///
+/// @return TRUE if the printer's state is loaded, FALSE otherwise.
+///
+gboolean
+PrinterCache::getAttributes (const gchar *printerName, gint *numJobs,
+                             const gchar **state, const gchar **location)
+{
+    G_LOCK (printerCache);
+    PrinterAttributes *attributes =
+        (PrinterAttributes *)g_hash_table_lookup (m_Attributes, printerName);
+    if ( NULL != attributes )
+    {
+        *numJobs = attributes->numJobs;
+        *state = attributes->state;
+        *location = attributes->location;
+    }
+    G_UNLOCK (printerCache);
+
+    return NULL != attributes;
+}
+
+///
+/// @brief Gets a printer's options.
+///
+/// @param printerName The printer's name.
+///
+/// @return The printer's options, that belong to the cache, or NULL if
+///         they aren't loaded or the printer doesn't tell.
+///
+PrinterOptions *
+PrinterCache::getOptions (const gchar *printerName)
+{
+    G_LOCK (printerCache);
+    PrinterOptions *options =
+        (PrinterOptions *)g_hash_table_lookup (m_Options, printerName);
+    G_UNLOCK (printerCache);
+
+    return options;
+}
+
+///
+/// @brief Gets the presenter notified about the loaded printers.
+///
+/// @return The presenter or NULL.
+///
+PrintPter *
+PrinterCache::getPresenter ()
+{
+    return m_Presenter;
+}
+
+///
+/// @brief Gets the printers' names.
+///
+/// @param defaultPrinter The output location to save the index of the
+///                       default printer to, or -1.
+///
+/// @return A copy of the printers' names, that must be freed with
+///         g_strfreev(), or NULL if they aren't listed yet.
+///
+gchar **
+PrinterCache::getPrinters (gint *defaultPrinter)
+{
+    G_LOCK (printerCache);
+    gchar **printers = g_strdupv (m_Printers);
+    *defaultPrinter = m_DefaultPrinter;
+    G_UNLOCK (printerCache);
+
+    return printers;
+}
+
+///
+/// @brief Gets where the printers are got from.
+///
+/// @return The printers' source.
+///
+IPrinterSource &
+PrinterCache::getSource ()
+{
+    if ( NULL == m_Source )
+    {
+        m_Source = new CupsPrinterSource ();
+    }
+    return *m_Source;
+}
+
+///
+/// @brief Tells if any job is still loading printers.
+///
+/// @return TRUE if a requested result didn't arrive yet.
+///
+gboolean
+PrinterCache::isLoading ()
+{
+    G_LOCK (printerCache);
+    gboolean loading = 0 < m_NumLoading;
+    G_UNLOCK (printerCache);
+
+    return loading;
+}
+
+///
+/// @brief A job finished loading printers.
+///
+/// This is called after the presenter is notified, so if the
+/// presenter requests anything else, the cache never looks idle
+/// in between.
+///
+void
+PrinterCache::loadFinished ()
+{
+    G_LOCK (printerCache);
+    g_assert (0 < m_NumLoading && "No job was loading printers.");
+    m_NumLoading--;
+    G_UNLOCK (printerCache);
+}
+
+///
+/// @brief Requests a printer's state.
+///
+/// The state is loaded by a low priority job, so the pages to show are
+/// rendered before. The presenter is notified right away if the state
+/// is already known.
+///
+/// @param printerName The printer's name.
+///
+void
+PrinterCache::requestAttributes (const gchar *printerName)
+{
+    G_LOCK (printerCache);
+    gboolean loaded = g_hash_table_contains (m_Attributes, printerName);
+    gboolean load = !loaded &&
+                    !g_hash_table_contains (m_AttributesPending, printerName);
+    if ( load )
+    {
+        g_hash_table_add (m_AttributesPending, g_strdup (printerName));
+        m_NumLoading++;
+    }
+    G_UNLOCK (printerCache);
+
+    if ( load )
+    {
+        JobLoadPrinterAttributes *job = new JobLoadPrinterAttributes ();
+        job->setSource (&getSource ());
+        job->setPrinterName (printerName);
+        IJob::enqueueLowPriority (job);
+    }
+    else if ( loaded && NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrinterAttributesLoaded (printerName);
+    }
+}
+
+///
+/// @brief Requests a printer's options.
+///
+/// The presenter is notified right away if the options are already
+/// known.
+///
+/// @param printerName The printer's name.
+///
+void
+PrinterCache::requestOptions (const gchar *printerName)
+{
+    G_LOCK (printerCache);
+    gboolean loaded = g_hash_table_contains (m_Options, printerName);
+    gboolean load = !loaded &&
+                    !g_hash_table_contains (m_OptionsPending, printerName);
+    if ( load )
+    {
+        g_hash_table_add (m_OptionsPending, g_strdup (printerName));
+        m_NumLoading++;
+    }
+    G_UNLOCK (printerCache);
+
+    if ( load )
+    {
+        JobLoadPrinterOptions *job = new JobLoadPrinterOptions ();
+        job->setSource (&getSource ());
+        job->setPrinterName (printerName);
+        IJob::enqueue (job);
+    }
+    else if ( loaded && NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrinterOptionsLoaded (printerName);
+    }
+}
+
+///
+/// @brief Requests the list of printers.
+///
+/// The presenter is notified right away if the printers are already
+/// listed.
+///
+void
+PrinterCache::requestPrinters ()
+{
+    G_LOCK (printerCache);
+    gboolean loaded = NULL != m_Printers;
+    gboolean load = !loaded && !m_PrintersPending;
+    if ( load )
+    {
+        m_PrintersPending = TRUE;
+        m_NumLoading++;
+    }
+    G_UNLOCK (printerCache);
+
+    if ( load )
+    {
+        JobLoadPrinters *job = new JobLoadPrinters ();
+        job->setSource (&getSource ());
+        IJob::enqueue (job);
+    }
+    else if ( loaded && NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrintersLoaded ();
+    }
+}
+
+///
+/// @brief Saves a printer's loaded state.
+///
+/// @param printerName The printer's name.
+/// @param numJobs The number of jobs the printer has.
+/// @param state The printer's state. The cache takes its ownership.
+/// @param location The printer's location. The cache takes its ownership.
+///
+void
+PrinterCache::setAttributes (const gchar *printerName, gint numJobs,
+                             gchar *state, gchar *location)
+{
+    PrinterAttributes *attributes = g_new (PrinterAttributes, 1);
+    attributes->numJobs = numJobs;
+    attributes->state = state;
+    attributes->location = location;
+
+    G_LOCK (printerCache);
+    g_hash_table_insert (m_Attributes, g_strdup (printerName), attributes);
+    g_hash_table_remove (m_AttributesPending, printerName);
+    G_UNLOCK (printerCache);
+
+    if ( NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrinterAttributesLoaded (printerName);
+    }
+    loadFinished ();
+}
+
+///
+/// @brief Saves a printer's loaded options.
+///
+/// @param printerName The printer's name.
+/// @param options The printer's options or NULL. The cache takes its
+///                ownership.
+///
+void
+PrinterCache::setOptions (const gchar *printerName, PrinterOptions *options)
+{
+    G_LOCK (printerCache);
+    g_hash_table_insert (m_Options, g_strdup (printerName), options);
+    g_hash_table_remove (m_OptionsPending, printerName);
+    G_UNLOCK (printerCache);
+
+    if ( NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrinterOptionsLoaded (printerName);
+    }
+    loadFinished ();
+}
+
+///
+/// @brief Sets the presenter to notify about the loaded printers.
+///
+/// @param presenter The presenter or NULL to stop notifying.
+///
+void
+PrinterCache::setPresenter (PrintPter *presenter)
+{
+    m_Presenter = presenter;
+}
+
+///
+/// @brief Saves the listed printers.
+///
+/// @param printers The printers' names. The cache takes its ownership.
+/// @param defaultPrinter The index of the default printer, or -1.
+///
+void
+PrinterCache::setPrinters (gchar **printers, gint defaultPrinter)
+{
+    G_LOCK (printerCache);
+    g_strfreev (m_Printers);
+    m_Printers = printers;
+    m_DefaultPrinter = defaultPrinter;
+    m_PrintersPending = FALSE;
+    G_UNLOCK (printerCache);
+
+    if ( NULL != m_Presenter )
+    {
+        m_Presenter->notifyPrintersLoaded ();
+    }
+    loadFinished ();
+}
+
+///
+/// @brief Sets where to get the printers from.
+///
+/// This is mostly used for testing.
+///
+/// @param source The printers' source. The cache takes its ownership.
+///
+void
+PrinterCache::setSource (IPrinterSource *source)
+{
+    delete m_Source;
+    m_Source = source;
+}
+
+///
+/// @brief Frees a printer's state.
+///
+/// @param data The PrinterAttributes to free.
+///
+void
+freePrinterAttributes (gpointer data)
+{
+    PrinterAttributes *attributes = (PrinterAttributes *)data;
+    g_free (attributes->state);
+    g_free (attributes->location);
+    g_free (attributes);
+}
+
+///
+/// @brief Frees a printer's options.
+///
+/// @param data The PrinterOptions to free, or NULL.
+///
+void
+freePrinterOptions (gpointer data)
+{
+    delete (PrinterOptions *)data;
+}
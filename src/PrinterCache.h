@@ -0,0 +1,103 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__PRINTER_CACHE_H__)
+#define __PRINTER_CACHE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class IPrinterSource;
+    class PrintPter;
+    class PrinterOptions;
+
+    ///
+    /// @class PrinterCache
+    /// @brief The printers known for the session.
+    ///
+    /// Listing the printers and asking for each printer's state and
+    /// options can take long, so they are loaded by jobs and kept until
+    /// the application ends. The print dialog's presenter requests what
+    /// it needs to show and is notified as soon as each result arrives,
+    /// or right away if it's already known.
+    ///
+    /// Like Config, there is a single instance that can be destroyed
+    /// with PrinterCache::destroy(), mostly for testing.
+    ///
+    class PrinterCache
+    {
+        public:
+            static void destroy (void);
+            static PrinterCache &getCache (void);
+
+            gboolean getAttributes (const gchar *printerName, gint *numJobs,
+                                    const gchar **state,
+                                    const gchar **location);
+            PrinterOptions *getOptions (const gchar *printerName);
+            PrintPter *getPresenter (void);
+            gchar **getPrinters (gint *defaultPrinter);
+            IPrinterSource &getSource (void);
+            gboolean isLoading (void);
+            void requestAttributes (const gchar *printerName);
+            void requestOptions (const gchar *printerName);
+            void requestPrinters (void);
+            void setAttributes (const gchar *printerName, gint numJobs,
+                                gchar *state, gchar *location);
+            void setOptions (const gchar *printerName,
+                             PrinterOptions *options);
+            void setPresenter (PrintPter *presenter);
+            void setPrinters (gchar **printers, gint defaultPrinter);
+            void setSource (IPrinterSource *source);
+
+        protected:
+            /// The only instance.
+            static PrinterCache *m_Cache;
+            /// The state of each printer, as PrinterAttributes.
+            GHashTable *m_Attributes;
+            /// The printers whose state is being loaded.
+            GHashTable *m_AttributesPending;
+            /// The index of the default printer, or -1.
+            gint m_DefaultPrinter;
+            /// The number of queued jobs that haven't finished.
+            guint m_NumLoading;
+            /// @brief The options of each printer, NULL for printers that
+            /// don't tell their options.
+            GHashTable *m_Options;
+            /// The printers whose options are being loaded.
+            GHashTable *m_OptionsPending;
+            /// The presenter to notify, or NULL.
+            PrintPter *m_Presenter;
+            /// The printers' names, or NULL if not listed yet.
+            gchar **m_Printers;
+            /// Tells if the printers are being listed.
+            gboolean m_PrintersPending;
+            /// Where to get the printers from.
+            IPrinterSource *m_Source;
+
+            PrinterCache (void);
+            ~PrinterCache (void);
+
+            void loadFinished (void);
+    };
+}
+
+#endif // !__PRINTER_CACHE_H__
@@ -0,0 +1,187 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief Constructs a new PrinterOptions object without choices.
+///
+PrinterOptions::PrinterOptions ()
+{
+    for ( gint option = 0 ; option < PRINTER_OPTION_NUM ; option++ )
+    {
+        m_ChoiceTexts[option] = g_ptr_array_new_with_free_func (g_free);
+        m_ChoiceValues[option] = g_ptr_array_new_with_free_func (g_free);
+        m_SelectedChoice[option] = 0;
+    }
+    m_PageSizes = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                         g_free, g_free);
+}
+
+///
+/// @brief Deletes all dynamically allocated memory by PrinterOptions.
+///
+PrinterOptions::~PrinterOptions ()
+{
+    for ( gint option = 0 ; option < PRINTER_OPTION_NUM ; option++ )
+    {
+        g_ptr_array_unref (m_ChoiceTexts[option]);
+        g_ptr_array_unref (m_ChoiceValues[option]);
+    }
+    g_hash_table_unref (m_PageSizes);
+}
+
+///
+/// @brief Adds a choice to an option.
+///
+/// @param option The option to add the choice to.
+/// @param text The possibly translated text to show.
+/// @param value The value ePDFView internally uses for the choice.
+/// @param selected TRUE if the choice is the option's default.
+///
+void
+PrinterOptions::addChoice (PrinterOptionType option, const gchar *text,
+                           const gchar *value, gboolean selected)
+{
+    g_assert (option < PRINTER_OPTION_NUM && "Invalid printer option.");
+
+    if ( selected )
+    {
+        m_SelectedChoice[option] = m_ChoiceTexts[option]->len;
+    }
+    g_ptr_array_add (m_ChoiceTexts[option], g_strdup (text));
+    g_ptr_array_add (m_ChoiceValues[option], g_strdup (value));
+}
+
+///
+/// @brief Adds the dimensions of a page size.
+///
+/// @param name The page size's name, as the value of its choice.
+/// @param width The page's width, in 1/72 inches.
+/// @param height The page's height, in 1/72 inches.
+///
+void
+PrinterOptions::addPageSize (const gchar *name, gfloat width, gfloat height)
+{
+    gfloat *size = g_new (gfloat, 2);
+    size[0] = width;
+    size[1] = height;
+    g_hash_table_insert (m_PageSizes, g_ascii_strdown (name, -1), size);
+}
+
+///
+/// @brief Gets the text to show of a choice.
+///
+/// @param option The option the choice belongs to.
+/// @param index The choice's index.
+///
+/// @return The choice's text.
+///
+const gchar *
+PrinterOptions::getChoiceText (PrinterOptionType option, guint index)
+{
+    g_assert (index < getNumChoices (option) && "Invalid choice index.");
+
+    return (const gchar *)g_ptr_array_index (m_ChoiceTexts[option], index);
+}
+
+///
+/// @brief Gets the value of a choice.
+///
+/// @param option The option the choice belongs to.
+/// @param index The choice's index.
+///
+/// @return The choice's value.
+///
+const gchar *
+PrinterOptions::getChoiceValue (PrinterOptionType option, guint index)
+{
+    g_assert (index < getNumChoices (option) && "Invalid choice index.");
+
+    return (const gchar *)g_ptr_array_index (m_ChoiceValues[option], index);
+}
+
+///
+/// @brief Gets the number of choices of an option.
+///
+/// @param option The option to get its number of choices.
+///
+/// @return The number of choices added to @a option.
+///
+guint
+PrinterOptions::getNumChoices (PrinterOptionType option)
+{
+    g_assert (option < PRINTER_OPTION_NUM && "Invalid printer option.");
+
+    return m_ChoiceTexts[option]->len;
+}
+
+///
+/// @brief Gets the dimensions of a page size.
+///
+/// @param name The page size's name. The case is ignored.
+/// @param width The output location to save the page's width to.
+/// @param height The output location to save the page's height to.
+///
+/// @return TRUE if the page size is known, FALSE otherwise, in which case
+///         @a width and @a height are left untouched.
+///
+gboolean
+PrinterOptions::getPageSize (const gchar *name, gfloat *width, gfloat *height)
+{
+    g_assert (NULL != width && "Tried to save the page width to NULL.");
+    g_assert (NULL != height && "Tried to save the page height to NULL.");
+
+    if ( NULL == name )
+    {
+        return FALSE;
+    }
+    gchar *key = g_ascii_strdown (name, -1);
+    gfloat *size = (gfloat *)g_hash_table_lookup (m_PageSizes, key);
+    g_free (key);
+    if ( NULL == size )
+    {
+        return FALSE;
+    }
+    *width = size[0];
+    *height = size[1];
+
+    return TRUE;
+}
+
+///
+/// @brief Gets the choice selected by default of an option.
+///
+/// @param option The option to get its default choice.
+///
+/// @return The index of the default choice.
+///
+guint
+PrinterOptions::getSelectedChoice (PrinterOptionType option)
+{
+    g_assert (option < PRINTER_OPTION_NUM && "Invalid printer option.");
+
+    return m_SelectedChoice[option];
+}
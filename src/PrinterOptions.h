@@ -0,0 +1,84 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__PRINTER_OPTIONS_H__)
+#define __PRINTER_OPTIONS_H__
+
+namespace ePDFView
+{
+    ///
+    /// @enum PrinterOptionType
+    /// @brief The printer's options listed in the print dialog.
+    ///
+    enum PrinterOptionType
+    {
+        /// The color models the printer supports.
+        PRINTER_OPTION_COLOR_MODEL = 0,
+        /// The page sizes the printer supports.
+        PRINTER_OPTION_PAGE_SIZE,
+        /// The resolutions the printer supports.
+        PRINTER_OPTION_RESOLUTION,
+        /// The number of option types.
+        PRINTER_OPTION_NUM
+    };
+
+    ///
+    /// @class PrinterOptions
+    /// @brief The choices of a printer's options.
+    ///
+    /// The choices are read from the printer's PPD in the background,
+    /// so the print dialog can list them without reading the PPD every
+    /// time the printer is selected. Besides the choices, it keeps the
+    /// dimensions of each page size, to print without reading the PPD
+    /// again.
+    ///
+    class PrinterOptions
+    {
+        public:
+            PrinterOptions (void);
+            ~PrinterOptions (void);
+
+            void addChoice (PrinterOptionType option, const gchar *text,
+                            const gchar *value, gboolean selected);
+            void addPageSize (const gchar *name, gfloat width, gfloat height);
+            const gchar *getChoiceText (PrinterOptionType option,
+                                        guint index);
+            const gchar *getChoiceValue (PrinterOptionType option,
+                                         guint index);
+            guint getNumChoices (PrinterOptionType option);
+            gboolean getPageSize (const gchar *name, gfloat *width,
+                                  gfloat *height);
+            guint getSelectedChoice (PrinterOptionType option);
+
+        protected:
+            /// The text to show of each option's choices.
+            GPtrArray *m_ChoiceTexts[PRINTER_OPTION_NUM];
+            /// The value to use of each option's choices.
+            GPtrArray *m_ChoiceValues[PRINTER_OPTION_NUM];
+            /// The width and height, in 1/72 inches, of each page size name.
+            GHashTable *m_PageSizes;
+            /// The index of the choice selected by default of each option.
+            guint m_SelectedChoice[PRINTER_OPTION_NUM];
+    };
+}
+
+#endif // !__PRINTER_OPTIONS_H__
@@ -0,0 +1,205 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief A phase of the startup.
+///
+typedef struct
+{
+    /// The phase's name.
+    const gchar *name;
+    /// The time the phase ended.
+    gint64 endTime;
+} StartupPhase;
+
+gboolean StartupProfile::m_Enabled = FALSE;
+GArray *StartupProfile::m_Phases = NULL;
+gint64 StartupProfile::m_StartTime = 0;
+GtkWidget *StartupProfile::m_Window = NULL;
+
+///
+/// @brief Prints the phases once the startup ends.
+///
+void
+StartupProfile::enable ()
+{
+    m_Enabled = TRUE;
+}
+
+///
+/// @brief Marks the end of the last startup phase.
+///
+/// The phases are printed after the window's frame clock paints the next
+/// frame, and no more phases are marked. Without a window they are
+/// printed right away.
+///
+/// @param phase The name of the phase that ended. It must be a static
+///              string.
+///
+void
+StartupProfile::finish (const gchar *phase)
+{
+    if ( NULL == m_Phases )
+    {
+        return;
+    }
+
+    mark (phase);
+    GArray *phases = m_Phases;
+    m_Phases = NULL;
+    if ( !m_Enabled )
+    {
+        g_array_free (phases, TRUE);
+    }
+    else if ( NULL == m_Window )
+    {
+        report (phases);
+    }
+    else if ( gtk_widget_get_realized (m_Window) )
+    {
+        waitForPaint (m_Window, phases);
+    }
+    else
+    {
+        // The window has no frame clock until it is realized.
+        g_signal_connect (G_OBJECT (m_Window), "realize",
+                          G_CALLBACK (StartupProfile::waitForPaint), phases);
+    }
+}
+
+///
+/// @brief Marks the end of a startup phase.
+///
+/// @param phase The name of the phase that ended. It must be a static
+///              string.
+///
+void
+StartupProfile::mark (const gchar *phase)
+{
+    if ( NULL != m_Phases )
+    {
+        StartupPhase startupPhase = { phase, g_get_monotonic_time () };
+        g_array_append_val (m_Phases, startupPhase);
+    }
+}
+
+///
+/// @brief Sets the window whose first frame ends the startup.
+///
+/// Only the first window shown while the startup is measured is used.
+///
+/// @param window The main window.
+///
+void
+StartupProfile::setWindow (GtkWidget *window)
+{
+    if ( NULL != m_Phases && NULL == m_Window )
+    {
+        m_Window = window;
+        g_object_add_weak_pointer (G_OBJECT (m_Window),
+                                   (gpointer *)&m_Window);
+    }
+}
+
+///
+/// @brief Starts measuring the startup.
+///
+/// It must be called first thing in main().
+///
+void
+StartupProfile::start ()
+{
+    m_StartTime = g_get_monotonic_time ();
+    m_Phases = g_array_new (FALSE, FALSE, sizeof (StartupPhase));
+}
+
+///
+/// @brief Prints the time of each phase.
+///
+/// @param phases The GArray with the marked phases. It is freed.
+///
+void
+StartupProfile::report (GArray *phases)
+{
+    g_printerr ("%-28s %10s %10s\n", "Startup phase", "ms", "total ms");
+    gint64 phaseStart = m_StartTime;
+    for ( guint phase = 0 ; phase < phases->len ; phase++ )
+    {
+        StartupPhase *startupPhase =
+            &g_array_index (phases, StartupPhase, phase);
+        g_printerr ("%-28s %10.3f %10.3f\n", startupPhase->name,
+                    (startupPhase->endTime - phaseStart) / 1000.0,
+                    (startupPhase->endTime - m_StartTime) / 1000.0);
+        phaseStart = startupPhase->endTime;
+    }
+    g_array_free (phases, TRUE);
+}
+
+///
+/// @brief The window's frame clock painted a frame.
+///
+/// Marks when the first frame after the startup ended was painted and
+/// prints the phases.
+///
+/// @param frameClock The window's frame clock.
+/// @param data The GArray with the marked phases.
+///
+void
+StartupProfile::reportAfterPaint (GdkFrameClock *frameClock, gpointer data)
+{
+    g_signal_handlers_disconnect_by_func (G_OBJECT (frameClock),
+            (gpointer)StartupProfile::reportAfterPaint, data);
+
+    GArray *phases = (GArray *)data;
+    StartupPhase frame = { "first frame painted", g_get_monotonic_time () };
+    g_array_append_val (phases, frame);
+    report (phases);
+}
+
+///
+/// @brief Waits for the window's frame clock to paint the next frame.
+///
+/// @param window The realized main window.
+/// @param data The GArray with the marked phases.
+///
+void
+StartupProfile::waitForPaint (GtkWidget *window, gpointer data)
+{
+    g_signal_handlers_disconnect_by_func (G_OBJECT (window),
+            (gpointer)StartupProfile::waitForPaint, data);
+
+    GdkFrameClock *frameClock = gtk_widget_get_frame_clock (window);
+    if ( NULL == frameClock )
+    {
+        report ((GArray *)data);
+        return;
+    }
+    g_signal_connect (G_OBJECT (frameClock), "after-paint",
+                      G_CALLBACK (StartupProfile::reportAfterPaint), data);
+    // Makes sure there is a frame to paint even if nothing changed.
+    gtk_widget_queue_draw (window);
+}
@@ -0,0 +1,68 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__STARTUP_PROFILE_H__)
+#define __STARTUP_PROFILE_H__
+
+namespace ePDFView
+{
+    ///
+    /// @class StartupProfile
+    /// @brief Measures where the startup time goes.
+    ///
+    /// Each phase of the startup marks when it ends. Once the first page
+    /// is shown, or the empty window when there's no document, and the
+    /// window's frame clock paints the next frame, the time of each phase
+    /// is printed to the standard error if the profile was enabled with
+    /// --startup-profile.
+    ///
+    /// The marks are only a time stamp each and stop after the first
+    /// page, so they are always taken. They must be taken from the main
+    /// thread.
+    ///
+    class StartupProfile
+    {
+        public:
+            static void enable (void);
+            static void finish (const gchar *phase);
+            static void mark (const gchar *phase);
+            static void setWindow (GtkWidget *window);
+            static void start (void);
+
+        protected:
+            /// Tells if the phases are printed when the startup ends.
+            static gboolean m_Enabled;
+            /// The phases marked, as StartupPhase, or NULL once finished.
+            static GArray *m_Phases;
+            /// The time the process started its main function.
+            static gint64 m_StartTime;
+            /// The window whose first frame ends the startup, or NULL.
+            static GtkWidget *m_Window;
+
+            static void report (GArray *phases);
+            static void reportAfterPaint (GdkFrameClock *frameClock,
+                                          gpointer data);
+            static void waitForPaint (GtkWidget *window, gpointer data);
+    };
+}
+
+#endif // !__STARTUP_PROFILE_H__
@@ -0,0 +1,218 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <config.h>
+#include "epdfview.h"
+
+using namespace ePDFView;
+
+///
+/// @brief A thumbnail in the cache.
+///
+typedef struct
+{
+    /// The number of the thumbnail's page.
+    gint pageNum;
+    /// The thumbnail's image.
+    DocumentPage *thumbnail;
+    /// The bytes the thumbnail's image uses.
+    gsize size;
+} ThumbnailCacheEntry;
+
+///
+/// @brief Constructs a new empty cache.
+///
+/// @param budget The maximum bytes that the thumbnails can use.
+///
+ThumbnailCache::ThumbnailCache (gsize budget)
+{
+    m_Budget = budget;
+    m_Order = g_queue_new ();
+    m_Size = 0;
+    m_Thumbnails = g_hash_table_new (g_direct_hash, g_direct_equal);
+}
+
+///
+/// @brief Deletes all cached thumbnails.
+///
+ThumbnailCache::~ThumbnailCache ()
+{
+    clear ();
+    g_queue_free (m_Order);
+    g_hash_table_destroy (m_Thumbnails);
+}
+
+///
+/// @brief Adds a thumbnail to the cache.
+///
+/// The thumbnail that @a pageNum had already is replaced. Then the least
+/// recently used thumbnails are deleted until the cache fits in its
+/// budget, but the new thumbnail is always kept.
+///
+/// @param pageNum The number of the thumbnail's page.
+/// @param thumbnail The thumbnail to add. The cache takes its ownership.
+///
+void
+ThumbnailCache::add (gint pageNum, DocumentPage *thumbnail)
+{
+    g_assert (NULL != thumbnail && "Tried to add a NULL thumbnail.");
+
+    remove (pageNum);
+
+    ThumbnailCacheEntry *entry = g_new (ThumbnailCacheEntry, 1);
+    entry->pageNum = pageNum;
+    entry->thumbnail = thumbnail;
+    entry->size = thumbnail->getRowStride () * thumbnail->getHeight ();
+    g_queue_push_head (m_Order, entry);
+    g_hash_table_insert (m_Thumbnails, GINT_TO_POINTER (pageNum),
+                         g_queue_peek_head_link (m_Order));
+    m_Size += entry->size;
+
+    while ( m_Size > m_Budget && 1 < g_queue_get_length (m_Order) )
+    {
+        removeLink (g_queue_peek_tail_link (m_Order));
+    }
+}
+
+///
+/// @brief Deletes all cached thumbnails.
+///
+void
+ThumbnailCache::clear ()
+{
+    while ( !g_queue_is_empty (m_Order) )
+    {
+        removeLink (g_queue_peek_head_link (m_Order));
+    }
+}
+
+///
+/// @brief Gets a cached thumbnail.
+///
+/// The thumbnail becomes the most recently used.
+///
+/// @param pageNum The number of the page to get its thumbnail.
+///
+/// @return The page's thumbnail, owned by the cache, or NULL if it isn't
+///         cached. It's valid until the next call to add(), clear()
+///         or remove().
+///
+DocumentPage *
+ThumbnailCache::get (gint pageNum)
+{
+    GList *link = (GList *)g_hash_table_lookup (m_Thumbnails,
+                                                GINT_TO_POINTER (pageNum));
+    if ( NULL == link )
+    {
+        return NULL;
+    }
+    g_queue_unlink (m_Order, link);
+    g_queue_push_head_link (m_Order, link);
+
+    return ((ThumbnailCacheEntry *)link->data)->thumbnail;
+}
+
+///
+/// @brief Gets the maximum bytes the thumbnails can use.
+///
+/// @return The cache's budget in bytes.
+///
+gsize
+ThumbnailCache::getBudget ()
+{
+    return m_Budget;
+}
+
+///
+/// @brief Gets the number of cached thumbnails.
+///
+/// @return How many thumbnails are in the cache.
+///
+guint
+ThumbnailCache::getNumThumbnails ()
+{
+    return g_queue_get_length (m_Order);
+}
+
+///
+/// @brief Gets the bytes that the cached thumbnails use.
+///
+/// @return The size of all cached thumbnails' images.
+///
+gsize
+ThumbnailCache::getSize ()
+{
+    return m_Size;
+}
+
+///
+/// @brief Deletes thumbnails to free memory.
+///
+/// The least recently used thumbnails are deleted until at least
+/// @a size bytes are freed or the cache is empty.
+///
+/// @param size The bytes to free.
+///
+/// @return The bytes freed.
+///
+gsize
+ThumbnailCache::release (gsize size)
+{
+    gsize oldSize = m_Size;
+    while ( oldSize - m_Size < size && !g_queue_is_empty (m_Order) )
+    {
+        removeLink (g_queue_peek_tail_link (m_Order));
+    }
+
+    return oldSize - m_Size;
+}
+
+///
+/// @brief Deletes a page's thumbnail from the cache.
+///
+/// @param pageNum The number of the page to delete its thumbnail.
+///
+void
+ThumbnailCache::remove (gint pageNum)
+{
+    GList *link = (GList *)g_hash_table_lookup (m_Thumbnails,
+                                                GINT_TO_POINTER (pageNum));
+    if ( NULL != link )
+    {
+        removeLink (link);
+    }
+}
+
+///
+/// @brief Deletes a cached thumbnail.
+///
+/// @param link The thumbnail's link in m_Order.
+///
+void
+ThumbnailCache::removeLink (GList *link)
+{
+    ThumbnailCacheEntry *entry = (ThumbnailCacheEntry *)link->data;
+    g_hash_table_remove (m_Thumbnails, GINT_TO_POINTER (entry->pageNum));
+    g_queue_delete_link (m_Order, link);
+    m_Size -= entry->size;
+    delete entry->thumbnail;
+    g_free (entry);
+}
@@ -0,0 +1,68 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__THUMBNAIL_CACHE_H__)
+#define __THUMBNAIL_CACHE_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DocumentPage;
+
+    ///
+    /// @class ThumbnailCache
+    /// @brief The rendered thumbnails of a document's pages.
+    ///
+    /// The cache holds thumbnails up to a size in bytes, separate from
+    /// the rendered pages' cache. When a new thumbnail doesn't fit, the
+    /// thumbnails that were least recently used are deleted.
+    ///
+    class ThumbnailCache
+    {
+        public:
+            ThumbnailCache (gsize budget);
+            ~ThumbnailCache (void);
+
+            void add (gint pageNum, DocumentPage *thumbnail);
+            void clear (void);
+            DocumentPage *get (gint pageNum);
+            gsize getBudget (void);
+            guint getNumThumbnails (void);
+            gsize getSize (void);
+            gsize release (gsize size);
+            void remove (gint pageNum);
+
+        protected:
+            /// The maximum bytes that the thumbnails can use.
+            gsize m_Budget;
+            /// @brief The cached thumbnails, as ThumbnailCacheEntry, from
+            /// the most to the least recently used.
+            GQueue *m_Order;
+            /// The bytes that the cached thumbnails use.
+            gsize m_Size;
+            /// The link in m_Order of each cached page number.
+            GHashTable *m_Thumbnails;
+
+            void removeLink (GList *link);
+    };
+}
+
+#endif // !__THUMBNAIL_CACHE_H__
@@ -26,28 +26,58 @@
 #include <config.h>
 #include <gettext.h>
 #include <glib.h>
+#include <sys/stat.h>
 #include <gtk/gtk.h>
 #include <cairo.h>
 
 #include <Config.h>
+#include <DiskCache.h>
 
 #include <DocumentRectangle.h>
 #include <IDocumentLink.h>
 #include <DocumentLinkGoto.h>
 #include <DocumentLinkUri.h>
+#include <DocumentLinkIndex.h>
 #include <DocumentOutline.h>
+#include <DocumentOutlineIndex.h>
 #include <DocumentPage.h>
+#include <DocumentTextLayout.h>
+#include <CompressedPageCache.h>
+#include <ThumbnailCache.h>
+#include <CacheBudget.h>
+#include <MemoryGovernor.h>
+#include <StartupProfile.h>
 #include <IDocumentObserver.h>
 #include <IDocument.h>
+#include <DocumentExporter.h>
+#include <PDFDocumentCore.h>
 #include <PDFDocument.h>
+#include <PDFDocumentOutline.h>
 
 #include <IJob.h>
+#include <JobCacheImage.h>
 #include <JobFind.h>
+#include <JobFingerprintPage.h>
+#include <JobIndexOutline.h>
 #include <JobLoad.h>
+#include <JobLoadOutline.h>
+#include <JobLoadPageSizes.h>
 #include <JobPrint.h>
+#include <PrintImposition.h>
 #include <JobRender.h>
+#include <JobRenderThumbnail.h>
 #include <JobSave.h>
+#include <JobSaveText.h>
 #if defined (HAVE_CUPS)
+#include <IPrintOutput.h>
+#include <CupsPrintOutput.h>
+#include <IPrinterSource.h>
+#include <CupsPrinterSource.h>
+#include <PrinterOptions.h>
+#include <PrinterCache.h>
+#include <JobLoadPrinterAttributes.h>
+#include <JobLoadPrinterOptions.h>
+#include <JobLoadPrinters.h>
 #endif // HAVE_CUPS
 
 #include <IFindView.h>
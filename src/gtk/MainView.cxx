@@ -29,11 +29,13 @@
 #include <epdfview.h>
 #include "StockIcons.h"
 #include "FindView.h"
+#include "OutlineModel.h"
 #include "PageView.h"
 #include "PreferencesView.h"
 #if defined (HAVE_CUPS)
 #include "PrintView.h"
 #endif // HAVE_CUPS
+#include "MainWindow.h"
 #include "MainView.h"
 
 using namespace ePDFView;
@@ -44,15 +46,7 @@ using namespace ePDFView;
 // GTK4: Position constants removed (not using GtkToolbar positioning)
 static gint CURRENT_PAGE_WIDTH = 5;
 static gint CURRENT_ZOOM_WIDTH = 6;
-
-// Enumerations.
-enum indexColumns
-{
-    outlineTitleColumn,
-    outlinePageColumn,
-    outlineDataColumn,
-    outlineNumColumns
-};
+static gint TAB_TITLE_WIDTH = 24;
 
 // Forward declarations.
 static void main_window_about_box_cb (GtkWidget *, gpointer);
@@ -81,15 +75,30 @@ static void main_window_reload_cb (GtkWidget *, gpointer);
 static void main_window_rotate_left_cb (GtkWidget *, gpointer);
 static void main_window_rotate_right_cb (GtkWidget *, gpointer);
 static void main_window_open_file_cb (GtkWidget *, gpointer);
-static void main_window_outline_cb (GtkTreeSelection *, gpointer);
+static void main_window_open_tab_cb (GtkWidget *, gpointer);
+static void main_window_outline_cb (GtkSingleSelection *, GParamSpec *,
+                                    gpointer);
+static void main_window_outline_bind_cb (GtkSignalListItemFactory *,
+                                         GtkListItem *, gpointer);
+static void main_window_outline_setup_cb (GtkSignalListItemFactory *,
+                                          GtkListItem *, gpointer);
 static void main_window_preferences_cb (GtkWidget *, gpointer);
 static void main_window_quit_cb (GtkWidget *, gpointer);
 static void main_window_save_file_cb (GtkWidget *, gpointer);
+static void main_window_save_text_cb (GtkWidget *, gpointer);
 static void main_window_show_index_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_show_menubar_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_invert_color_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_show_statusbar_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_show_toolbar_cb (GSimpleAction *, GVariant *, gpointer);
+static void main_window_thumbnail_cb (GtkSingleSelection *, GParamSpec *,
+                                      gpointer);
+static void main_window_thumbnail_bind_cb (GtkSignalListItemFactory *,
+                                           GtkListItem *, gpointer);
+static void main_window_thumbnail_setup_cb (GtkSignalListItemFactory *,
+                                            GtkListItem *, gpointer);
+static void main_window_thumbnail_unbind_cb (GtkSignalListItemFactory *,
+                                             GtkListItem *, gpointer);
 static void main_window_zoom_fit_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_zoom_in_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_zoom_out_cb (GSimpleAction *, GVariant *, gpointer);
@@ -98,6 +107,8 @@ static void main_window_fit_width_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_fit_height_cb (GSimpleAction *, GVariant *, gpointer);
 static void main_window_set_page_mode (GSimpleAction *, GVariant *, gpointer);
 static void on_zoom_entry_activate (GtkEntry *, gpointer);
+static GtkTreeListRow *main_window_find_outline_row (GtkTreeListModel *,
+                                                     DocumentOutline *);
 // GTK4: Scroll events handled by PageView event controllers, not needed here
 
 #if defined (HAVE_CUPS)
@@ -107,8 +118,10 @@ static void main_window_print_cb (GtkWidget *, gpointer);
 // GTK4 action entries for GSimpleAction
 // GTK4: Create GAction wrappers for all widget callbacks
 ACTION_CALLBACK(main_window_open_file_action_cb, main_window_open_file_cb)
+ACTION_CALLBACK(main_window_open_tab_action_cb, main_window_open_tab_cb)
 ACTION_CALLBACK(main_window_reload_action_cb, main_window_reload_cb)
 ACTION_CALLBACK(main_window_save_file_action_cb, main_window_save_file_cb)
+ACTION_CALLBACK(main_window_save_text_action_cb, main_window_save_text_cb)
 #if defined (HAVE_CUPS)
 ACTION_CALLBACK(main_window_print_action_cb, main_window_print_cb)
 #endif
@@ -135,6 +148,10 @@ static const struct {
       N_("Open a PDF document"),
       G_CALLBACK (main_window_open_file_action_cb) },
 
+    { "open-tab", "tab-new", N_("Open in New _Tab..."), "<control>T",
+      N_("Open a PDF document in a new tab"),
+      G_CALLBACK (main_window_open_tab_action_cb) },
+
     { "reload-file", "view-refresh", N_("_Reload"), "<control>R",
       N_("Reload the current document"),
       G_CALLBACK (main_window_reload_action_cb) },
@@ -144,6 +161,10 @@ static const struct {
     //   N_("Save a copy of the current document"),
     //   G_CALLBACK (main_window_save_file_action_cb) },
 
+    { "save-text", "document-save", N_("Save _Text..."), NULL,
+      N_("Save the text of all pages to a file"),
+      G_CALLBACK (main_window_save_text_action_cb) },
+
 #if defined (HAVE_CUPS)
     { "print", "document-print", N_("_Print..."), "<control>P",
       N_("Print the current document"),
@@ -151,7 +172,7 @@ static const struct {
 #endif // HAVE_CUPS
 
     { "quit", "window-close", N_("_Close"), "<control>W",
-      N_("Close this window"),
+      N_("Close this tab"),
       G_CALLBACK (main_window_quit_action_cb) },
 
     { "find", "edit-find", N_("_Find"), "<control>F",
@@ -285,41 +306,39 @@ static const struct {
 // Interface Methods.
 ////////////////////////////////////////////////////////////////
 
-MainView::MainView (MainPter *pter):
+///
+/// @brief Constructs a new main view as a tab of a window.
+///
+/// The view isn't in the window until MainWindow::addTab() is called
+/// with its presenter.
+///
+/// @param pter The main presenter that will drive the view.
+/// @param window The window to show the view in.
+///
+MainView::MainView (MainPter *pter, MainWindow *window):
     IMainView (pter)
 {
+    g_assert (NULL != window && "Tried to set a NULL window.");
+
     // Initialise the stock items.
     epdfview_stock_icons_init ();
-    // Create the main window
-    m_MainWindow = gtk_window_new ();
-    setMainWindowIcon ();
-    
-    // Set window properties
-    gtk_window_set_title (GTK_WINDOW (m_MainWindow), "ePDFView");
-    gtk_window_set_default_size (GTK_WINDOW (m_MainWindow), 800, 600);
-    gtk_window_set_resizable (GTK_WINDOW (m_MainWindow), TRUE);
-    gtk_window_set_decorated (GTK_WINDOW (m_MainWindow), TRUE);
-    
-    // Enable mnemonics (Alt+key shortcuts for menu navigation)
-    gtk_widget_set_can_focus (m_MainWindow, TRUE);
-    
-    // The application will be set by gtk_application_add_window in main.cxx
-    // No need to set it here as it's already handled by the application
-    
-    // Connect signals
-    g_signal_connect (G_OBJECT (m_MainWindow), "destroy",
-                     G_CALLBACK (main_window_quit_cb), NULL);
-    // Create the main vertical box.
+    m_Window = window;
+    m_MainWindow = window->getWindow ();
+
+    // Create the main vertical box, which is the tab's contents.
     m_MainBox = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
-    gtk_window_set_child (GTK_WINDOW (m_MainWindow), m_MainBox);
     gtk_widget_set_visible (m_MainBox, TRUE);
+    createTabLabel ();
     
     // Create actions and modern headerbar
     createActions ();
+    StartupProfile::mark ("actions");
     createHeaderBar ();
+    StartupProfile::mark ("header bar");
     
     // Create page view
     GtkWidget *pageViewPaned = createPageView ();
+    StartupProfile::mark ("page view");
     gtk_box_append (GTK_BOX (m_MainBox), pageViewPaned);
     gtk_widget_set_vexpand (pageViewPaned, TRUE);
     
@@ -329,16 +348,15 @@ MainView::MainView (MainPter *pter):
     // Set initial focus to page view for keyboard navigation
     gtk_widget_grab_focus (m_PageViewWidget);
     
-    // Connect to the map signal to handle focus when the window is shown
-    g_signal_connect_swapped(m_MainWindow, "map", 
+    // Connect to the map signal to handle focus when the tab is shown
+    g_signal_connect_swapped(m_MainBox, "map", 
                            G_CALLBACK(+[](GtkWidget* widget, gpointer user_data) {
                                gtk_widget_grab_focus(GTK_WIDGET(user_data));
                            }), 
                            m_PageViewWidget);
     
-    // Add the find bar.
-    m_FindView = new FindView ();
-    gtk_box_append (GTK_BOX (m_MainBox), m_FindView->getTopWidget ());
+    // The find bar is created when it's first needed.
+    m_FindView = NULL;
 
     // GTK4: Use a simple label instead of deprecated GtkStatusbar
     m_StatusBar = gtk_label_new ("");
@@ -357,6 +375,7 @@ MainView::~MainView ()
     delete m_FindView;
     delete m_PageView;
     g_object_unref (G_OBJECT (m_ActionGroup));
+    g_hash_table_destroy (m_ThumbnailPictures);
 }
 
 void
@@ -738,6 +757,79 @@ MainView::saveFileDialog (const gchar *lastFolder, const gchar *fileName)
     return result;
 }
 
+gchar *
+MainView::saveTextFileDialog (const gchar *lastFolder, const gchar *fileName)
+{
+    gchar *result = NULL;
+
+    GtkFileChooserNative *native = gtk_file_chooser_native_new (
+            _("Save Text"),
+            GTK_WINDOW (m_MainWindow),
+            GTK_FILE_CHOOSER_ACTION_SAVE,
+            _("_Save"),
+            _("_Cancel"));
+
+    GtkFileChooser *chooser = GTK_FILE_CHOOSER (native);
+
+    if ( NULL != lastFolder )
+    {
+        GFile *folder = g_file_new_for_path (lastFolder);
+        gtk_file_chooser_set_current_folder (chooser, folder, NULL);
+        g_object_unref (folder);
+    }
+
+    if ( NULL != fileName )
+    {
+        gtk_file_chooser_set_current_name (chooser, fileName);
+    }
+
+    GtkFileFilter *textFilter = gtk_file_filter_new ();
+    gtk_file_filter_set_name (textFilter, _("Text Files"));
+    gtk_file_filter_add_mime_type (textFilter, "text/plain");
+    gtk_file_filter_add_pattern (textFilter, "*.txt");
+    gtk_file_chooser_add_filter (chooser, textFilter);
+
+    GtkFileFilter *anyFilter = gtk_file_filter_new ();
+    gtk_file_filter_set_name (anyFilter, _("All Files"));
+    gtk_file_filter_add_pattern (anyFilter, "*");
+    gtk_file_chooser_add_filter (chooser, anyFilter);
+
+    gtk_file_chooser_set_filter (chooser, textFilter);
+
+    GMainLoop *loop = g_main_loop_new (NULL, FALSE);
+    gint response = GTK_RESPONSE_CANCEL;
+
+    auto response_cb = +[](GtkNativeDialog *dialog, gint resp, gpointer user_data) {
+        gpointer *data = (gpointer*)user_data;
+        gint *response_ptr = (gint*)data[0];
+        GMainLoop *loop = (GMainLoop*)data[1];
+        *response_ptr = resp;
+        g_main_loop_quit (loop);
+    };
+
+    gpointer cb_data[] = {&response, loop};
+    g_signal_connect (native, "response", G_CALLBACK (response_cb), cb_data);
+
+    gtk_native_dialog_show (GTK_NATIVE_DIALOG (native));
+
+    while (g_main_loop_is_running(loop)) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    g_main_loop_unref (loop);
+
+    if (response == GTK_RESPONSE_ACCEPT)
+    {
+        GFile *file = gtk_file_chooser_get_file (chooser);
+        if (file) {
+            result = g_file_get_path (file);
+            g_object_unref (file);
+        }
+    }
+
+    g_object_unref (native);
+    return result;
+}
+
 void
 MainView::sensitiveFind (gboolean sensitive)
 {
@@ -805,6 +897,10 @@ MainView::sensitiveOpen (gboolean sensitive)
     if (action) {
         g_simple_action_set_enabled (G_SIMPLE_ACTION (action), sensitive);
     }
+    action = g_action_map_lookup_action (G_ACTION_MAP (m_ActionGroup), "open-tab");
+    if (action) {
+        g_simple_action_set_enabled (G_SIMPLE_ACTION (action), sensitive);
+    }
 }
 
 #if defined (HAVE_CUPS)
@@ -854,6 +950,15 @@ MainView::sensitiveSave (gboolean sensitive)
     }
 }
 
+void
+MainView::sensitiveSaveText (gboolean sensitive)
+{
+    GAction *action = g_action_map_lookup_action (G_ACTION_MAP (m_ActionGroup), "save-text");
+    if (action) {
+        g_simple_action_set_enabled (G_SIMPLE_ACTION (action), sensitive);
+    }
+}
+
 void
 MainView::sensitiveZoom (gboolean sensitive)
 {
@@ -922,7 +1027,11 @@ MainView::show (void)
     if (width <= 0 || width > 10000) width = 800;
     if (height <= 0 || height > 10000) height = 600;
     
-    gtk_window_set_default_size (GTK_WINDOW (m_MainWindow), width, height);
+    // The tabs opened later don't resize the window.
+    if ( !gtk_widget_get_visible (m_MainWindow) )
+    {
+        gtk_window_set_default_size (GTK_WINDOW (m_MainWindow), width, height);
+    }
     
     // CRITICAL: Present the window FIRST, then sync visibility
     // This ensures the window has a valid allocation before we modify child widgets
@@ -1010,7 +1119,7 @@ MainView::setCursor (ViewCursor cursorType)
     // In GTK4, use gtk_widget_set_cursor_from_name
     if (cursor_name)
     {
-        gtk_widget_set_cursor_from_name (m_MainWindow, cursor_name);
+        gtk_widget_set_cursor_from_name (m_MainBox, cursor_name);
     }
 }
 
@@ -1107,6 +1216,14 @@ MainView::setZoomText (const gchar *text)
 IFindView *
 MainView::getFindView ()
 {
+    if ( NULL == m_FindView )
+    {
+        // Above the status bar, below the page view.
+        m_FindView = new FindView ();
+        gtk_box_insert_child_after (GTK_BOX (m_MainBox),
+                                    m_FindView->getTopWidget (),
+                                    gtk_widget_get_prev_sibling (m_StatusBar));
+    }
     return m_FindView;
 }
 
@@ -1133,19 +1250,149 @@ MainView::getPrintView ()
 void
 MainView::setTitle (const gchar *title)
 {
-    gtk_window_set_title (GTK_WINDOW (m_MainWindow), title);
+    gtk_label_set_text (GTK_LABEL (m_TabTitle), title);
+    gtk_widget_set_tooltip_text (m_TabTitle, title);
+    if ( this == m_Window->getSelectedTab () )
+    {
+        gtk_window_set_title (GTK_WINDOW (m_MainWindow), title);
+    }
 }
 
 void
 MainView::setOutline (DocumentOutline *outline)
 {
-    gtk_tree_store_clear (m_Outline);
-    setOutlineChildren (outline, NULL);
+    // The rows are created when shown and the outline's children are
+    // only read when their parent is expanded, so this doesn't depend
+    // on the outline's size.
+    GtkTreeListModel *treeModel = NULL;
+    if ( NULL != outline )
+    {
+        treeModel = gtk_tree_list_model_new (
+                G_LIST_MODEL (outline_model_new (outline)), FALSE, FALSE,
+                outline_model_create_children, NULL, NULL);
+    }
+    // Nothing gets selected, because selecting an item goes to its page
+    // and the outline can be set after the user moved to another page.
+    gtk_single_selection_set_model (m_Outline, G_LIST_MODEL (treeModel));
+    if ( NULL != treeModel )
+    {
+        g_object_unref (treeModel);
+    }
+}
+
+void
+MainView::selectOutline (DocumentOutline *outline)
+{
+    guint position = GTK_INVALID_LIST_POSITION;
+    GListModel *treeModel = gtk_single_selection_get_model (m_Outline);
+    if ( NULL != outline && NULL != treeModel )
+    {
+        GtkTreeListRow *row =
+            main_window_find_outline_row (GTK_TREE_LIST_MODEL (treeModel),
+                                          outline);
+        if ( NULL != row )
+        {
+            position = gtk_tree_list_row_get_position (row);
+            g_object_unref (row);
+        }
+    }
+
+    // Highlighting the current section must not go to its page.
+    g_signal_handlers_block_by_func (G_OBJECT (m_Outline),
+                                     (gpointer)main_window_outline_cb, m_Pter);
+    gtk_single_selection_set_selected (m_Outline, position);
+    g_signal_handlers_unblock_by_func (G_OBJECT (m_Outline),
+                                       (gpointer)main_window_outline_cb,
+                                       m_Pter);
+#if GTK_CHECK_VERSION (4, 12, 0)
+    if ( GTK_INVALID_LIST_POSITION != position )
+    {
+        gtk_list_view_scroll_to (GTK_LIST_VIEW (m_TreeIndex), position,
+                                 GTK_LIST_SCROLL_NONE, NULL);
+    }
+#endif // GTK_CHECK_VERSION (4, 12, 0)
+}
+
+void
+MainView::setThumbnails (gint numPages)
+{
+    // Each item is only the page's number. The grid only creates the
+    // cells of the visible pages, and these request their thumbnail.
+    GPtrArray *pages = g_ptr_array_new_with_free_func (g_free);
+    for ( gint pageNum = 1 ; pageNum <= numPages ; pageNum++ )
+    {
+        g_ptr_array_add (pages, g_strdup_printf ("%d", pageNum));
+    }
+    g_ptr_array_add (pages, NULL);
+    GtkStringList *pageList =
+        gtk_string_list_new ((const gchar * const *)pages->pdata);
+    g_ptr_array_free (pages, TRUE);
+
+    g_signal_handlers_block_by_func (G_OBJECT (m_Thumbnails),
+                                     (gpointer)main_window_thumbnail_cb,
+                                     m_Pter);
+    gtk_single_selection_set_model (m_Thumbnails, G_LIST_MODEL (pageList));
+    g_signal_handlers_unblock_by_func (G_OBJECT (m_Thumbnails),
+                                       (gpointer)main_window_thumbnail_cb,
+                                       m_Pter);
+    g_object_unref (pageList);
+}
+
+void
+MainView::showThumbnail (gint pageNum, DocumentPage *thumbnail)
+{
+    GtkPicture *picture = (GtkPicture *)g_hash_table_lookup (
+            m_ThumbnailPictures, GINT_TO_POINTER (pageNum));
+    if ( NULL == picture )
+    {
+        // Scrolled out while it was rendered.
+        return;
+    }
 
-    // Already select the first outline.
-    GtkTreePath *path = gtk_tree_path_new_from_string ("0");
-    gtk_tree_view_set_cursor (GTK_TREE_VIEW (m_TreeIndex), path, NULL, FALSE);
-    gtk_tree_path_free (path);
+    gsize size = thumbnail->getRowStride () * thumbnail->getHeight ();
+    GBytes *pixels = g_bytes_new (thumbnail->getData (), size);
+    GdkTexture *texture =
+        gdk_memory_texture_new (thumbnail->getWidth (),
+                                thumbnail->getHeight (),
+                                GDK_MEMORY_R8G8B8A8, pixels,
+                                thumbnail->getRowStride ());
+    g_bytes_unref (pixels);
+    gtk_picture_set_paintable (picture, GDK_PAINTABLE (texture));
+    g_object_unref (texture);
+}
+
+void
+MainView::selectThumbnail (gint pageNum)
+{
+    guint position = (guint)(pageNum - 1);
+    if ( NULL == gtk_single_selection_get_model (m_Thumbnails) ||
+         g_list_model_get_n_items (G_LIST_MODEL (m_Thumbnails)) <= position )
+    {
+        position = GTK_INVALID_LIST_POSITION;
+    }
+
+    // Highlighting the current page must not go to it again.
+    g_signal_handlers_block_by_func (G_OBJECT (m_Thumbnails),
+                                     (gpointer)main_window_thumbnail_cb,
+                                     m_Pter);
+    gtk_single_selection_set_selected (m_Thumbnails, position);
+    g_signal_handlers_unblock_by_func (G_OBJECT (m_Thumbnails),
+                                       (gpointer)main_window_thumbnail_cb,
+                                       m_Pter);
+#if GTK_CHECK_VERSION (4, 12, 0)
+    if ( GTK_INVALID_LIST_POSITION != position )
+    {
+        gtk_grid_view_scroll_to (GTK_GRID_VIEW (m_ThumbnailsGrid), position,
+                                 GTK_LIST_SCROLL_NONE, NULL);
+    }
+#endif // GTK_CHECK_VERSION (4, 12, 0)
+}
+
+void
+MainView::showThumbnails (gboolean show)
+{
+    gtk_stack_set_visible_child_name (GTK_STACK (m_SidebarStack),
+                                      show ? "thumbnails" : "outline");
 }
 
 void
@@ -1276,47 +1523,78 @@ MainView::createPageView ()
     // Create the page view.
     m_PageView = new PageView ();
 
-    // Create the side bar, with the index tree.
-    m_Outline = gtk_tree_store_new (outlineNumColumns, 
-                                    G_TYPE_STRING, G_TYPE_INT, G_TYPE_POINTER);
-    m_TreeIndex = gtk_tree_view_new_with_model (GTK_TREE_MODEL (m_Outline));
-    gtk_widget_set_size_request (m_TreeIndex, 200, -1);
-
-    GtkTreeViewColumn *column = gtk_tree_view_column_new ();
-    gtk_tree_view_column_set_expand (column, TRUE);
-    gtk_tree_view_column_set_title (column, _("Index"));
-    gtk_tree_view_append_column (GTK_TREE_VIEW (m_TreeIndex), column);
-
-    {
-        GtkCellRenderer *renderer = gtk_cell_renderer_text_new ();
-        GValue ellipsizeMode = { 0, };
-        g_value_init (&ellipsizeMode, PANGO_TYPE_ELLIPSIZE_MODE);
-        g_value_set_enum (&ellipsizeMode, PANGO_ELLIPSIZE_END);
-        g_object_set_property (G_OBJECT (renderer),
-                               "ellipsize", &ellipsizeMode);
-        gtk_tree_view_column_pack_start (column, renderer, TRUE);
-        gtk_tree_view_column_set_attributes (column, renderer, "text", 0, NULL);
-    }
+    // Create the side bar, with the index list. The list's model is
+    // set by setOutline().
+    m_Outline = gtk_single_selection_new (NULL);
+    gtk_single_selection_set_autoselect (m_Outline, FALSE);
+    gtk_single_selection_set_can_unselect (m_Outline, TRUE);
+    g_signal_connect (G_OBJECT (m_Outline), "notify::selected",
+                      G_CALLBACK (main_window_outline_cb), m_Pter);
 
-    {
-        GtkCellRenderer *renderer = gtk_cell_renderer_text_new ();
-        gtk_tree_view_column_pack_end (column, renderer, FALSE);
-        gtk_tree_view_column_set_attributes (column, renderer, "text", 1, NULL);
-    }
+    GtkListItemFactory *factory = gtk_signal_list_item_factory_new ();
+    g_signal_connect (G_OBJECT (factory), "setup",
+                      G_CALLBACK (main_window_outline_setup_cb), NULL);
+    g_signal_connect (G_OBJECT (factory), "bind",
+                      G_CALLBACK (main_window_outline_bind_cb), NULL);
 
-    // Set the change signal of the selection.
-    GtkTreeSelection *selection = 
-        gtk_tree_view_get_selection (GTK_TREE_VIEW (m_TreeIndex));
-    gtk_tree_selection_set_mode (selection, GTK_SELECTION_SINGLE);
-    g_signal_connect (G_OBJECT (selection), "changed",
-                      G_CALLBACK (main_window_outline_cb), m_Pter);
+    m_TreeIndex = gtk_list_view_new (GTK_SELECTION_MODEL (m_Outline),
+                                     factory);
+    gtk_widget_set_size_request (m_TreeIndex, 200, -1);
 
-    m_Sidebar = gtk_scrolled_window_new ();
-    gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (m_Sidebar),
+    GtkWidget *outlineWindow = gtk_scrolled_window_new ();
+    gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (outlineWindow),
                                     GTK_POLICY_AUTOMATIC,
                                     GTK_POLICY_AUTOMATIC);
     // GTK4: gtk_scrolled_window_set_shadow_type removed, use CSS instead if needed
-    gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (m_Sidebar), m_TreeIndex);
+    gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (outlineWindow),
+                                   m_TreeIndex);
+
+    // The thumbnails' grid. The list's model is set by setThumbnails()
+    // and each cell asks for its thumbnail while it's shown.
+    m_ThumbnailPictures = g_hash_table_new (g_direct_hash, g_direct_equal);
+    m_Thumbnails = gtk_single_selection_new (NULL);
+    gtk_single_selection_set_autoselect (m_Thumbnails, FALSE);
+    gtk_single_selection_set_can_unselect (m_Thumbnails, TRUE);
+    g_signal_connect (G_OBJECT (m_Thumbnails), "notify::selected",
+                      G_CALLBACK (main_window_thumbnail_cb), m_Pter);
+
+    GtkListItemFactory *thumbnailFactory =
+        gtk_signal_list_item_factory_new ();
+    g_object_set_data (G_OBJECT (thumbnailFactory), "pictures",
+                       m_ThumbnailPictures);
+    g_signal_connect (G_OBJECT (thumbnailFactory), "setup",
+                      G_CALLBACK (main_window_thumbnail_setup_cb), NULL);
+    g_signal_connect (G_OBJECT (thumbnailFactory), "bind",
+                      G_CALLBACK (main_window_thumbnail_bind_cb), m_Pter);
+    g_signal_connect (G_OBJECT (thumbnailFactory), "unbind",
+                      G_CALLBACK (main_window_thumbnail_unbind_cb), m_Pter);
+
+    m_ThumbnailsGrid =
+        gtk_grid_view_new (GTK_SELECTION_MODEL (m_Thumbnails),
+                           thumbnailFactory);
+    gtk_grid_view_set_max_columns (GTK_GRID_VIEW (m_ThumbnailsGrid), 2);
+
+    GtkWidget *thumbnailsWindow = gtk_scrolled_window_new ();
+    gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (thumbnailsWindow),
+                                    GTK_POLICY_NEVER,
+                                    GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (thumbnailsWindow),
+                                   m_ThumbnailsGrid);
+
+    m_SidebarStack = gtk_stack_new ();
+    gtk_widget_set_vexpand (m_SidebarStack, TRUE);
+    gtk_stack_add_titled (GTK_STACK (m_SidebarStack), outlineWindow,
+                          "outline", _("Index"));
+    gtk_stack_add_titled (GTK_STACK (m_SidebarStack), thumbnailsWindow,
+                          "thumbnails", _("Pages"));
+    GtkWidget *switcher = gtk_stack_switcher_new ();
+    gtk_stack_switcher_set_stack (GTK_STACK_SWITCHER (switcher),
+                                  GTK_STACK (m_SidebarStack));
+    gtk_widget_set_halign (switcher, GTK_ALIGN_CENTER);
+
+    m_Sidebar = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+    gtk_box_append (GTK_BOX (m_Sidebar), switcher);
+    gtk_box_append (GTK_BOX (m_Sidebar), m_SidebarStack);
 
 
     GtkWidget *hPaned = gtk_paned_new (GTK_ORIENTATION_HORIZONTAL);
@@ -1361,9 +1639,6 @@ MainView::createActions ()
                      G_CALLBACK(main_window_set_page_mode), m_Pter);
     g_action_map_add_action (G_ACTION_MAP (m_ActionGroup), G_ACTION (page_mode_action));
     g_object_unref (page_mode_action);
-    
-    // Insert action group into the main window
-    gtk_widget_insert_action_group (m_MainWindow, "win", G_ACTION_GROUP (m_ActionGroup));
 }
 
 ///
@@ -1437,8 +1712,8 @@ MainView::createHeaderBar ()
     
     gtk_header_bar_set_title_widget (GTK_HEADER_BAR (m_HeaderBar), m_NavigationBox);
     
-    // Set as window titlebar
-    gtk_window_set_titlebar (GTK_WINDOW (m_MainWindow), m_HeaderBar);
+    // The window shows it while this tab is selected.
+    m_Window->addHeaderBar (m_HeaderBar);
 }
 
 ///
@@ -1458,9 +1733,11 @@ MainView::createMainMenu ()
     // File section
     GMenu *file_section = g_menu_new ();
     g_menu_append (file_section, _("Open…"), "win.open-file");
+    g_menu_append (file_section, _("Open in New Tab…"), "win.open-tab");
     g_menu_append (file_section, _("Reload"), "win.reload-file");
     // Removed "Save a Copy" - this is a PDF reader, not an editor
     // g_menu_append (file_section, _("Save a Copy…"), "win.save-file");
+    g_menu_append (file_section, _("Save Text…"), "win.save-text");
 #if defined (HAVE_CUPS)
     g_menu_append (file_section, _("Print…"), "win.print");
 #endif
@@ -1488,99 +1765,56 @@ MainView::createMainMenu ()
 }
 
 ///
-/// @brief Loads and sets the application's icon.
+/// @brief Creates the label of the view's tab.
+///
+/// It shows the document's title and a button to close the tab.
 ///
 void
-MainView::setMainWindowIcon ()
+MainView::createTabLabel ()
 {
-    const gchar *iconFiles[] =
-    {
-        "icon_epdfview-48.png",
-        "icon_epdfview-32.png",
-        "icon_epdfview-24.png",
-    };
+    m_TabLabel = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    m_TabTitle = gtk_label_new (_("PDF Viewer"));
+    gtk_label_set_ellipsize (GTK_LABEL (m_TabTitle), PANGO_ELLIPSIZE_END);
+    gtk_label_set_max_width_chars (GTK_LABEL (m_TabTitle), TAB_TITLE_WIDTH);
+    gtk_box_append (GTK_BOX (m_TabLabel), m_TabTitle);
 
-    GList *iconList = NULL;
-    int iconFilesNum = G_N_ELEMENTS (iconFiles);
-    
-    // Search paths for icons (system and local)
-    const gchar *icon_dirs[] = {
-        DATADIR "/pixmaps",           // Configured installation
-        "/usr/local/share/pixmaps",   // Local installation
-        "/usr/share/pixmaps",         // System location
-        NULL
-    };
-    
-    for ( int iconIndex = 0 ; iconIndex < iconFilesNum ; iconIndex++ )
-    {
-        GdkPixbuf *iconPixbuf = NULL;
-        
-        // Try each search path
-        for (int dirIndex = 0; icon_dirs[dirIndex] != NULL && iconPixbuf == NULL; dirIndex++) {
-            gchar *filename = g_build_filename (icon_dirs[dirIndex], 
-                                               iconFiles[iconIndex], NULL);
-            if (g_file_test(filename, G_FILE_TEST_EXISTS)) {
-                GError *error = NULL;
-                iconPixbuf = gdk_pixbuf_new_from_file (filename, &error);
-                if ( NULL == iconPixbuf )
-                {
-                    g_warning ("Error loading icon %s: %s\n", filename, error->message);
-                    g_error_free (error);
-                }
-            }
-            g_free (filename);
-        }
-        
-        if ( NULL != iconPixbuf )
-        {
-            iconList = g_list_prepend (iconList, iconPixbuf);
-        }
-    }
-    // GTK4: gtk_window_set_default_icon_list removed
-    // Use gtk_window_set_default_icon_name or individual window icons
-    if (iconList) {
-        // Set first icon as default
-        GdkPixbuf *first_icon = (GdkPixbuf *)iconList->data;
-        if (first_icon) {
-            GdkTexture *texture = gdk_texture_new_for_pixbuf (first_icon);
-            gtk_window_set_icon_name (GTK_WINDOW (m_MainWindow), "epdfview");
-            g_object_unref (texture);
-        }
-    }
-    g_list_foreach (iconList, (GFunc)g_object_unref, NULL);
-    g_list_free (iconList);
+    GtkWidget *closeButton =
+        gtk_button_new_from_icon_name ("window-close-symbolic");
+    gtk_button_set_has_frame (GTK_BUTTON (closeButton), FALSE);
+    gtk_widget_set_tooltip_text (closeButton, _("Close Tab"));
+    g_signal_connect (G_OBJECT (closeButton), "clicked",
+                      G_CALLBACK (main_window_quit_cb), m_Pter);
+    gtk_box_append (GTK_BOX (m_TabLabel), closeButton);
 }
 
 ///
-/// @brief Recusively sets the outline data.
+/// @brief Closes the view's tab.
+///
+/// The presenter, and the view with it, are deleted once the tab is
+/// removed from the window.
+///
+void
+MainView::close ()
+{
+    m_Window->closeTab (this);
+}
+
 ///
-/// This function adds the outline's data to the tree model.
+/// @brief Shows the view in its window, when its tab is selected.
 ///
-/// @param outline The outline element to add in @a rootIter
-///                all its children. The first time it must be the root
-///                outline element.
-/// @param rootIter The iter to add the @a outline's children to. The first
-///                 time it must be the tree's root iter.
+/// The window shows the view's header bar and title, and sends the
+/// "win" actions to it. The document becomes the last to release its
+/// cached images.
 ///
 void
-MainView::setOutlineChildren (DocumentOutline *outline, GtkTreeIter *rootIter)
+MainView::select ()
 {
-    if ( NULL != outline )
-    {
-        DocumentOutline *child = outline->getFirstChild ();
-        while (NULL != child)
-        {
-            GtkTreeIter childIter;
-            gtk_tree_store_append (m_Outline, &childIter, rootIter);
-            gtk_tree_store_set (m_Outline, &childIter,
-                                outlineTitleColumn, child->getTitle (),
-                                outlinePageColumn, child->getDestinationPage (),
-                                outlineDataColumn, child,
-                                -1);
-            setOutlineChildren (child, &childIter);
-            child = outline->getNextChild ();
-        }
-    }
+    m_Window->selectHeaderBar (m_HeaderBar);
+    gtk_widget_insert_action_group (m_MainWindow, "win",
+                                    G_ACTION_GROUP (m_ActionGroup));
+    gtk_window_set_title (GTK_WINDOW (m_MainWindow),
+                          gtk_label_get_text (GTK_LABEL (m_TabTitle)));
+    m_Pter->windowActivated ();
 }
 
 void
@@ -1886,29 +2120,271 @@ main_window_open_file_cb (GtkWidget *widget, gpointer data)
     pter->openFileActivated ();
 }
 
+///
+/// @brief The user tries to open a file in a new tab.
+///
+/// The file is opened like the files given to the application, which
+/// opens them in new tabs of the active window.
+///
+void
+main_window_open_tab_cb (GtkWidget *widget, gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    MainPter *pter = (MainPter *)data;
+    MainView *view = (MainView *)&(pter->getView ());
+    gchar *lastFolder = Config::getConfig ().getOpenFileFolder ();
+    view->openFileDialogAsync (lastFolder,
+        +[](gchar *fileName, gpointer userData) {
+            if ( NULL != fileName )
+            {
+                gchar *dirName = g_path_get_dirname (fileName);
+                Config::getConfig ().setOpenFileFolder (dirName);
+                g_free (dirName);
+
+                GFile *file = g_file_new_for_path (fileName);
+                g_application_open (g_application_get_default (), &file, 1,
+                                    "");
+                g_object_unref (file);
+                g_free (fileName);
+            }
+        }, NULL);
+    g_free (lastFolder);
+}
+
 ///
 /// @brief The user selected an outline index item.
 ///
 void
-main_window_outline_cb (GtkTreeSelection *treeSelection, gpointer data)
+main_window_outline_cb (GtkSingleSelection *selection, GParamSpec *pspec,
+                        gpointer data)
 {
     g_assert ( NULL != data && "The data parameter is NULL.");
 
-    // Since the selection is in single mode, get the currently
-    // selected item.
-    GtkTreeModel *indexModel = NULL;
-    GtkTreeIter iter;
-    if ( gtk_tree_selection_get_selected (treeSelection, &indexModel, &iter) )
+    // The selected item is NULL when the selection is cleared, for
+    // instance when a new outline is set.
+    GtkTreeListRow *row =
+        GTK_TREE_LIST_ROW (gtk_single_selection_get_selected_item (selection));
+    if ( NULL != row )
     {
-        gpointer outlineData;
-        gtk_tree_model_get (indexModel, &iter,
-                            outlineDataColumn, &outlineData, -1);
-        DocumentOutline *outline = (DocumentOutline *)outlineData;
+        OutlineModel *item =
+            EPDFVIEW_OUTLINE_MODEL (gtk_tree_list_row_get_item (row));
+        DocumentOutline *outline = outline_model_get_outline (item);
+        g_object_unref (item);
         MainPter *pter = (MainPter *)data;
         pter->outlineActivated (outline);
     }
 }
 
+///
+/// @brief Finds the index row of an outline item.
+///
+/// The item's parents are expanded, so their children are read if they
+/// weren't yet.
+///
+/// @param treeModel The index's model.
+/// @param outline The outline item to find.
+///
+/// @return A new reference to the row of @a outline, or NULL if the
+///         item is not in @a treeModel.
+///
+GtkTreeListRow *
+main_window_find_outline_row (GtkTreeListModel *treeModel,
+                              DocumentOutline *outline)
+{
+    DocumentOutline *parent = outline->getParent ();
+    if ( NULL == parent )
+    {
+        // The root item has no row.
+        return NULL;
+    }
+
+    GtkTreeListRow *row = NULL;
+    if ( NULL == parent->getParent () )
+    {
+        row = gtk_tree_list_model_get_child_row (treeModel,
+                                                 outline->getPosition ());
+    }
+    else
+    {
+        GtkTreeListRow *parentRow =
+            main_window_find_outline_row (treeModel, parent);
+        if ( NULL == parentRow )
+        {
+            return NULL;
+        }
+        gtk_tree_list_row_set_expanded (parentRow, TRUE);
+        row = gtk_tree_list_row_get_child_row (parentRow,
+                                               outline->getPosition ());
+        g_object_unref (parentRow);
+    }
+
+    // Make sure the row is the item's, in case it belongs to another
+    // outline.
+    if ( NULL != row )
+    {
+        OutlineModel *item =
+            EPDFVIEW_OUTLINE_MODEL (gtk_tree_list_row_get_item (row));
+        if ( outline_model_get_outline (item) != outline )
+        {
+            g_object_unref (row);
+            row = NULL;
+        }
+        g_object_unref (item);
+    }
+    return row;
+}
+
+///
+/// @brief Shows an outline item in an index row.
+///
+void
+main_window_outline_bind_cb (GtkSignalListItemFactory *factory,
+                             GtkListItem *listItem, gpointer data)
+{
+    GtkTreeListRow *row = GTK_TREE_LIST_ROW (gtk_list_item_get_item (listItem));
+    GtkTreeExpander *expander =
+        GTK_TREE_EXPANDER (gtk_list_item_get_child (listItem));
+    gtk_tree_expander_set_list_row (expander, row);
+
+    OutlineModel *item =
+        EPDFVIEW_OUTLINE_MODEL (gtk_tree_list_row_get_item (row));
+    DocumentOutline *outline = outline_model_get_outline (item);
+    g_object_unref (item);
+
+    GtkWidget *box = gtk_tree_expander_get_child (expander);
+    GtkWidget *title = gtk_widget_get_first_child (box);
+    GtkWidget *page = gtk_widget_get_next_sibling (title);
+    gtk_label_set_text (GTK_LABEL (title), outline->getTitle ());
+    gchar *pageText = g_strdup_printf ("%d", outline->getDestinationPage ());
+    gtk_label_set_text (GTK_LABEL (page), pageText);
+    g_free (pageText);
+}
+
+///
+/// @brief Creates the widgets of an index row.
+///
+/// Each row has an expander with the outline item's title and its
+/// destination page.
+///
+void
+main_window_outline_setup_cb (GtkSignalListItemFactory *factory,
+                              GtkListItem *listItem, gpointer data)
+{
+    GtkWidget *title = gtk_label_new (NULL);
+    gtk_label_set_xalign (GTK_LABEL (title), 0.0);
+    gtk_label_set_ellipsize (GTK_LABEL (title), PANGO_ELLIPSIZE_END);
+    gtk_widget_set_hexpand (title, TRUE);
+
+    GtkWidget *page = gtk_label_new (NULL);
+    gtk_label_set_xalign (GTK_LABEL (page), 1.0);
+
+    GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 6);
+    gtk_box_append (GTK_BOX (box), title);
+    gtk_box_append (GTK_BOX (box), page);
+
+    GtkWidget *expander = gtk_tree_expander_new ();
+    gtk_tree_expander_set_child (GTK_TREE_EXPANDER (expander), box);
+    gtk_list_item_set_child (listItem, expander);
+}
+
+///
+/// @brief The user selected a page's thumbnail.
+///
+void
+main_window_thumbnail_cb (GtkSingleSelection *selection, GParamSpec *pspec,
+                          gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    guint position = gtk_single_selection_get_selected (selection);
+    if ( GTK_INVALID_LIST_POSITION != position )
+    {
+        MainPter *pter = (MainPter *)data;
+        pter->thumbnailActivated ((gint)position + 1);
+    }
+}
+
+///
+/// @brief Shows a page's thumbnail cell.
+///
+/// The cell's picture is remembered, so the thumbnail can be shown when
+/// the presenter has it.
+///
+void
+main_window_thumbnail_bind_cb (GtkSignalListItemFactory *factory,
+                               GtkListItem *listItem, gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    GtkStringObject *item =
+        GTK_STRING_OBJECT (gtk_list_item_get_item (listItem));
+    const gchar *pageText = gtk_string_object_get_string (item);
+    gint pageNum = atoi (pageText);
+
+    GtkWidget *picture = gtk_widget_get_first_child (
+            gtk_list_item_get_child (listItem));
+    GtkWidget *label = gtk_widget_get_next_sibling (picture);
+    gtk_label_set_text (GTK_LABEL (label), pageText);
+    gtk_picture_set_paintable (GTK_PICTURE (picture), NULL);
+
+    GHashTable *pictures =
+        (GHashTable *)g_object_get_data (G_OBJECT (factory), "pictures");
+    g_hash_table_insert (pictures, GINT_TO_POINTER (pageNum), picture);
+    MainPter *pter = (MainPter *)data;
+    pter->thumbnailShown (pageNum);
+}
+
+///
+/// @brief Creates the widgets of a thumbnail cell.
+///
+/// Each cell has the page's thumbnail and its number below.
+///
+void
+main_window_thumbnail_setup_cb (GtkSignalListItemFactory *factory,
+                                GtkListItem *listItem, gpointer data)
+{
+    GtkWidget *picture = gtk_picture_new ();
+    gtk_picture_set_content_fit (GTK_PICTURE (picture),
+                                 GTK_CONTENT_FIT_CONTAIN);
+    gtk_widget_set_size_request (picture, IDocument::getThumbnailSize (),
+                                 IDocument::getThumbnailSize ());
+
+    GtkWidget *label = gtk_label_new (NULL);
+
+    GtkWidget *box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 3);
+    gtk_box_append (GTK_BOX (box), picture);
+    gtk_box_append (GTK_BOX (box), label);
+    gtk_list_item_set_child (listItem, box);
+}
+
+///
+/// @brief A page's thumbnail cell scrolled out.
+///
+void
+main_window_thumbnail_unbind_cb (GtkSignalListItemFactory *factory,
+                                 GtkListItem *listItem, gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    GtkStringObject *item =
+        GTK_STRING_OBJECT (gtk_list_item_get_item (listItem));
+    gint pageNum = atoi (gtk_string_object_get_string (item));
+    GtkWidget *picture = gtk_widget_get_first_child (
+            gtk_list_item_get_child (listItem));
+
+    // The cell could have been bound to the same page again already.
+    GHashTable *pictures =
+        (GHashTable *)g_object_get_data (G_OBJECT (factory), "pictures");
+    if ( g_hash_table_lookup (pictures, GINT_TO_POINTER (pageNum)) ==
+         picture )
+    {
+        g_hash_table_remove (pictures, GINT_TO_POINTER (pageNum));
+        MainPter *pter = (MainPter *)data;
+        pter->thumbnailHidden (pageNum);
+    }
+}
+
 ///
 /// @brief The user wants to change the preferences.
 ///
@@ -1937,15 +2413,18 @@ main_window_print_cb (GtkWidget *widget, gpointer data)
 #endif // HAVE_CUPS
 
 ///
-/// @brief Called when the window is closed or Quit is activated.
+/// @brief Called when the tab's close button or Close is activated.
+///
+/// Closing the last tab closes the window.
 ///
 void
 main_window_quit_cb (GtkWidget *widget, gpointer data)
 {
-    // GTK4: gtk_main_quit removed - use g_application_quit or exit
-    // Since we're using GtkApplication, we should get the app instance
-    // For now, just exit the main loop
-    exit(0);
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    MainPter *pter = (MainPter *)data;
+    MainView *view = (MainView *)&(pter->getView ());
+    view->close ();
 }
 
 ///
@@ -1980,6 +2459,18 @@ main_window_save_file_cb (GtkWidget *widget, gpointer data)
     pter->saveFileActivated ();
 }
 
+///
+/// @brief The user tries to save the text of the document.
+///
+void
+main_window_save_text_cb (GtkWidget *widget, gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    MainPter *pter = (MainPter *)data;
+    pter->saveTextActivated ();
+}
+
 /// KROGAN EDIT
 /// @brief Called when the user clicks on the "Show Menubar" action.
 ///
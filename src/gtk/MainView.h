@@ -29,13 +29,14 @@ namespace ePDFView
     // Forward declarations
     class FindView;
     class MainPter;
+    class MainWindow;
     class DocumentPage;
     class PageView;
 
     class MainView: public IMainView
     {
         public:
-            MainView (MainPter *pter);
+            MainView (MainPter *pter, MainWindow *window);
             ~MainView ();
 
             void activeZoomFit (gboolean active);
@@ -50,6 +51,8 @@ namespace ePDFView
             gchar *promptPasswordDialog (void);
             gchar *saveFileDialog (const gchar *lastFolder,
                                    const gchar *fileName);
+            gchar *saveTextFileDialog (const gchar *lastFolder,
+                                       const gchar *fileName);
             void sensitiveFind (gboolean sensitive);
             void sensitiveGoToFirstPage (gboolean sensitive);
             void sensitiveGoToLastPage (gboolean sensitive);
@@ -64,6 +67,7 @@ namespace ePDFView
             void sensitiveRotateLeft (gboolean sensitive);
             void sensitiveRotateRight (gboolean sensitive);
             void sensitiveSave (gboolean sensitive);
+            void sensitiveSaveText (gboolean sensitive);
             void sensitiveZoom (gboolean sensitive);
             void sensitiveZoomIn (gboolean sensitive);
             void sensitiveZoomOut (gboolean sensitive);
@@ -73,6 +77,11 @@ namespace ePDFView
             void setCurrentPageGoto (gint number);
             void setNumberOfPages (gint number);
             void setOutline (DocumentOutline *outline);
+            void selectOutline (DocumentOutline *outline);
+            void setThumbnails (gint numPages);
+            void showThumbnail (gint pageNum, DocumentPage *thumbnail);
+            void selectThumbnail (gint pageNum);
+            void showThumbnails (gboolean show);
             void setWindow (GtkWindow *window);
             void setZoomFactor (gfloat zoomFactor);
             void show (void);
@@ -85,6 +94,13 @@ namespace ePDFView
             
             // GTK4: Get the main window for application registration
             GtkWidget *getMainWindow () { return m_MainWindow; }
+
+            // Tabs.
+            void close (void);
+            GtkWidget *getHeaderBar (void) { return m_HeaderBar; }
+            GtkWidget *getTabLabel (void) { return m_TabLabel; }
+            GtkWidget *getTopWidget (void) { return m_MainBox; }
+            void select (void);
             
             void setCursor (ViewCursor cursorType);
             void setFullScreen (gboolean fullScreen);
@@ -113,12 +129,23 @@ namespace ePDFView
             GtkWidget *m_MainWindow;
             GtkWidget *m_MainBox;
             GtkWidget *m_NumberOfPages;
-            GtkTreeStore *m_Outline;
+            GtkSingleSelection *m_Outline;
             PageView *m_PageView;
             GtkWidget *m_Sidebar;
+            GtkWidget *m_SidebarStack;
             GtkWidget *m_StatusBar;
+            /// The label of the view's tab, with its close button.
+            GtkWidget *m_TabLabel;
+            /// The document's title in the tab's label.
+            GtkWidget *m_TabTitle;
             GtkWidget *m_TreeIndex;
+            /// The pictures of the thumbnails shown, by page number.
+            GHashTable *m_ThumbnailPictures;
+            GtkSingleSelection *m_Thumbnails;
+            GtkWidget *m_ThumbnailsGrid;
             GSimpleActionGroup *m_ActionGroup;
+            /// The window that shows the view as one of its tabs.
+            MainWindow *m_Window;
             
             // Modern headerbar UI
             GtkWidget *m_HeaderBar;
@@ -132,9 +159,7 @@ namespace ePDFView
             void createActions (void);
             void createHeaderBar (void);
             void createMainMenu (void);
-            void setMainWindowIcon (void);
-            void setOutlineChildren (DocumentOutline *outline, 
-                                     GtkTreeIter *rootIter);
+            void createTabLabel (void);
     };
 }
 
@@ -0,0 +1,317 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <config.h>
+#include <stdlib.h>
+#include <gtk/gtk.h>
+#include <epdfview.h>
+#include "MainView.h"
+#include "MainWindow.h"
+
+using namespace ePDFView;
+
+// Constants.
+/// The key of the presenter in its tab's contents data.
+static const gchar *TAB_PRESENTER_KEY = "epdfview-tab-presenter";
+
+// Forward declarations.
+static void main_window_active_cb (GObject *, GParamSpec *, gpointer);
+static gboolean main_window_delete_tab_cb (gpointer);
+static void main_window_destroy_cb (GtkWidget *, gpointer);
+static MainPter *main_window_get_presenter (GtkWidget *);
+static void main_window_switch_page_cb (GtkNotebook *, GtkWidget *, guint,
+                                        gpointer);
+
+///
+/// @brief Constructs a new main window without tabs.
+///
+MainWindow::MainWindow ()
+{
+    m_Tabs = NULL;
+    m_Window = gtk_window_new ();
+    gtk_window_set_title (GTK_WINDOW (m_Window), "ePDFView");
+    gtk_window_set_default_size (GTK_WINDOW (m_Window), 800, 600);
+    gtk_window_set_resizable (GTK_WINDOW (m_Window), TRUE);
+    gtk_window_set_decorated (GTK_WINDOW (m_Window), TRUE);
+    // The icon is installed in the icon theme as "epdfview", so it's only
+    // looked up, and loaded, when the window manager asks for it.
+    gtk_window_set_icon_name (GTK_WINDOW (m_Window), "epdfview");
+    // Enable mnemonics (Alt+key shortcuts for menu navigation)
+    gtk_widget_set_can_focus (m_Window, TRUE);
+
+    // The title bar can't be changed once the window is shown, so it's a
+    // stack with the header bar of each tab.
+    m_HeaderBars = gtk_stack_new ();
+    gtk_stack_set_hhomogeneous (GTK_STACK (m_HeaderBars), FALSE);
+    gtk_window_set_titlebar (GTK_WINDOW (m_Window), m_HeaderBars);
+
+    // The tabs are only shown when there are more than one.
+    m_Notebook = gtk_notebook_new ();
+    gtk_notebook_set_scrollable (GTK_NOTEBOOK (m_Notebook), TRUE);
+    gtk_notebook_set_show_border (GTK_NOTEBOOK (m_Notebook), FALSE);
+    gtk_notebook_set_show_tabs (GTK_NOTEBOOK (m_Notebook), FALSE);
+    gtk_window_set_child (GTK_WINDOW (m_Window), m_Notebook);
+
+    g_signal_connect (G_OBJECT (m_Window), "destroy",
+                      G_CALLBACK (main_window_destroy_cb), NULL);
+    g_signal_connect (G_OBJECT (m_Window), "notify::is-active",
+                      G_CALLBACK (main_window_active_cb), this);
+    g_signal_connect (G_OBJECT (m_Notebook), "switch-page",
+                      G_CALLBACK (main_window_switch_page_cb), this);
+}
+
+///
+/// @brief Deletes the presenters of the tabs.
+///
+/// This is called once the window is destroyed, so the views don't
+/// have any widget left.
+///
+MainWindow::~MainWindow ()
+{
+    g_list_free_full (m_Tabs, [](gpointer pter) {
+        delete static_cast<MainPter *> (pter);
+    });
+}
+
+///
+/// @brief Adds a header bar to show when its tab is selected.
+///
+/// MainView calls this when it creates its header bar.
+///
+/// @param headerBar The header bar of a tab.
+///
+void
+MainWindow::addHeaderBar (GtkWidget *headerBar)
+{
+    gtk_stack_add_child (GTK_STACK (m_HeaderBars), headerBar);
+}
+
+///
+/// @brief Adds a tab and selects it.
+///
+/// The window takes the ownership of the presenter, which must already
+/// have its MainView set.
+///
+/// @param pter The presenter of the tab's view.
+///
+void
+MainWindow::addTab (MainPter *pter)
+{
+    g_assert (NULL != pter && "Tried to add a NULL presenter.");
+
+    MainView *view = (MainView *)&(pter->getView ());
+    GtkWidget *contents = view->getTopWidget ();
+    g_object_set_data (G_OBJECT (contents), TAB_PRESENTER_KEY, pter);
+    m_Tabs = g_list_prepend (m_Tabs, pter);
+
+    gint pageNum = gtk_notebook_append_page (GTK_NOTEBOOK (m_Notebook),
+                                             contents, view->getTabLabel ());
+    gtk_notebook_set_tab_reorderable (GTK_NOTEBOOK (m_Notebook), contents,
+                                      TRUE);
+    gtk_notebook_set_show_tabs (GTK_NOTEBOOK (m_Notebook),
+                                1 < getNumTabs ());
+    gtk_notebook_set_current_page (GTK_NOTEBOOK (m_Notebook), pageNum);
+}
+
+///
+/// @brief Closes a tab.
+///
+/// Its presenter is deleted when idle, as this is usually called from
+/// the tab's own callbacks. Closing the last tab destroys the window.
+///
+/// @param view The view of the tab to close.
+///
+void
+MainWindow::closeTab (MainView *view)
+{
+    if ( 1 >= getNumTabs () )
+    {
+        gtk_window_destroy (GTK_WINDOW (m_Window));
+        return;
+    }
+
+    GtkWidget *contents = view->getTopWidget ();
+    MainPter *pter = main_window_get_presenter (contents);
+    m_Tabs = g_list_remove (m_Tabs, pter);
+    gtk_notebook_remove_page (
+            GTK_NOTEBOOK (m_Notebook),
+            gtk_notebook_page_num (GTK_NOTEBOOK (m_Notebook), contents));
+    // Another tab is selected by now, with its own header bar.
+    gtk_stack_remove (GTK_STACK (m_HeaderBars), view->getHeaderBar ());
+    gtk_notebook_set_show_tabs (GTK_NOTEBOOK (m_Notebook),
+                                1 < getNumTabs ());
+    g_idle_add (main_window_delete_tab_cb, pter);
+}
+
+///
+/// @brief Gets the number of tabs.
+///
+/// @return How many documents the window has open.
+///
+guint
+MainWindow::getNumTabs ()
+{
+    return g_list_length (m_Tabs);
+}
+
+///
+/// @brief Gets the view of the selected tab.
+///
+/// @return The view shown, or NULL if the window has no tab.
+///
+MainView *
+MainWindow::getSelectedTab ()
+{
+    gint pageNum = gtk_notebook_get_current_page (GTK_NOTEBOOK (m_Notebook));
+    if ( 0 > pageNum )
+    {
+        return NULL;
+    }
+    GtkWidget *contents =
+        gtk_notebook_get_nth_page (GTK_NOTEBOOK (m_Notebook), pageNum);
+    MainPter *pter = main_window_get_presenter (contents);
+    return (MainView *)&(pter->getView ());
+}
+
+///
+/// @brief Gets the presenters of the tabs.
+///
+/// @return The list of MainPter, in no particular order. It belongs
+///         to the window.
+///
+GList *
+MainWindow::getTabs ()
+{
+    return m_Tabs;
+}
+
+///
+/// @brief Gets the top level window.
+///
+/// @return The GtkWindow.
+///
+GtkWidget *
+MainWindow::getWindow ()
+{
+    return m_Window;
+}
+
+///
+/// @brief Shows a tab's header bar.
+///
+/// @param headerBar The header bar of the selected tab.
+///
+void
+MainWindow::selectHeaderBar (GtkWidget *headerBar)
+{
+    gtk_stack_set_visible_child (GTK_STACK (m_HeaderBars), headerBar);
+}
+
+////////////////////////////////////////////////////////////////
+// GTK+ Callbacks.
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief The window got or lost the focus.
+///
+/// The selected tab's document becomes the active.
+///
+void
+main_window_active_cb (GObject *window, GParamSpec *pspec, gpointer data)
+{
+    g_assert ( NULL != data && "The data parameter is NULL.");
+
+    MainWindow *mainWindow = (MainWindow *)data;
+    MainView *view = mainWindow->getSelectedTab ();
+    if ( gtk_window_is_active (GTK_WINDOW (window)) && NULL != view )
+    {
+        view->select ();
+    }
+}
+
+///
+/// @brief Deletes the presenter of a closed tab.
+///
+gboolean
+main_window_delete_tab_cb (gpointer data)
+{
+    delete static_cast<MainPter *> (data);
+
+    return FALSE;
+}
+
+///
+/// @brief Called when the window is closed.
+///
+/// When other windows are still open, as in the single instance mode,
+/// only this window is closed.
+///
+void
+main_window_destroy_cb (GtkWidget *widget, gpointer data)
+{
+    // A destroyed window is already removed from the application.
+    GtkApplication *app = GTK_APPLICATION (g_application_get_default ());
+    if ( NULL != app && NULL != gtk_application_get_windows (app) )
+    {
+        return;
+    }
+    // GTK4: gtk_main_quit removed - use g_application_quit or exit
+    // Since we're using GtkApplication, we should get the app instance
+    // For now, just exit the main loop
+    exit(0);
+}
+
+///
+/// @brief Gets the presenter of a tab.
+///
+/// @param contents The tab's contents.
+///
+/// @return The presenter of the tab's view.
+///
+MainPter *
+main_window_get_presenter (GtkWidget *contents)
+{
+    MainPter *pter = static_cast<MainPter *> (
+            g_object_get_data (G_OBJECT (contents), TAB_PRESENTER_KEY));
+    g_assert (NULL != pter && "The tab has no presenter.");
+
+    return pter;
+}
+
+///
+/// @brief The user selected another tab.
+///
+void
+main_window_switch_page_cb (GtkNotebook *notebook, GtkWidget *contents,
+                            guint pageNum, gpointer data)
+{
+    // The tabs are also removed when the window is destroyed, after its
+    // header bars, and then there is nothing to show.
+    if ( NULL == gtk_widget_get_root (GTK_WIDGET (notebook)) )
+    {
+        return;
+    }
+
+    MainPter *pter = main_window_get_presenter (contents);
+    MainView *view = (MainView *)&(pter->getView ());
+    view->select ();
+}
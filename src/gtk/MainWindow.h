@@ -0,0 +1,71 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__MAIN_WINDOW_H__)
+#define __MAIN_WINDOW_H__
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class MainPter;
+    class MainView;
+
+    ///
+    /// @class MainWindow
+    /// @brief The top level window, with a tab for each open document.
+    ///
+    /// Each tab is a MainView with its own header bar and actions. The
+    /// window shows the header bar of the selected tab and sends the
+    /// "win" actions, and thus the accelerators, to it. All the tabs'
+    /// documents share the job thread and the cache budget, where the
+    /// selected tab's document is the active one.
+    ///
+    /// The window owns the presenters of its tabs, which own the views.
+    ///
+    class MainWindow
+    {
+        public:
+            MainWindow (void);
+            ~MainWindow (void);
+
+            void addTab (MainPter *pter);
+            void addHeaderBar (GtkWidget *headerBar);
+            void closeTab (MainView *view);
+            guint getNumTabs (void);
+            MainView *getSelectedTab (void);
+            GList *getTabs (void);
+            GtkWidget *getWindow (void);
+            void selectHeaderBar (GtkWidget *headerBar);
+
+        protected:
+            /// The header bars of the tabs, one shown at a time.
+            GtkWidget *m_HeaderBars;
+            /// The notebook with the tabs' contents.
+            GtkWidget *m_Notebook;
+            /// The presenters of the tabs, in no particular order.
+            GList *m_Tabs;
+            /// The top level window.
+            GtkWidget *m_Window;
+    };
+}
+
+#endif // !__MAIN_WINDOW_H__
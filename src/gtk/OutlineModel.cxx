@@ -0,0 +1,156 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <config.h>
+#include <gtk/gtk.h>
+#include <epdfview.h>
+#include "OutlineModel.h"
+
+using namespace ePDFView;
+
+///
+/// @brief The outline model's instance data.
+///
+struct _OutlineModel
+{
+    GObject parent;
+    /// The outline item whose children are listed. Owned by the document.
+    DocumentOutline *outline;
+};
+
+// Forward declarations.
+static void outline_model_list_model_init (GListModelInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (OutlineModel, outline_model, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL,
+                                                outline_model_list_model_init))
+
+///
+/// @brief Gets the type of the list's items.
+///
+static GType
+outline_model_get_item_type (GListModel *list)
+{
+    return EPDFVIEW_TYPE_OUTLINE_MODEL;
+}
+
+///
+/// @brief Gets the number of children of the outline item.
+///
+/// This is what makes the outline read its children, when the item is
+/// expanded.
+///
+static guint
+outline_model_get_n_items (GListModel *list)
+{
+    OutlineModel *model = EPDFVIEW_OUTLINE_MODEL (list);
+    return model->outline->getNumChildren ();
+}
+
+///
+/// @brief Creates the item for an outline's child.
+///
+static gpointer
+outline_model_get_item (GListModel *list, guint position)
+{
+    OutlineModel *model = EPDFVIEW_OUTLINE_MODEL (list);
+    DocumentOutline *child = model->outline->getChild (position);
+    if ( NULL == child )
+    {
+        return NULL;
+    }
+    return outline_model_new (child);
+}
+
+static void
+outline_model_list_model_init (GListModelInterface *iface)
+{
+    iface->get_item_type = outline_model_get_item_type;
+    iface->get_n_items = outline_model_get_n_items;
+    iface->get_item = outline_model_get_item;
+}
+
+static void
+outline_model_class_init (OutlineModelClass *klass)
+{
+}
+
+static void
+outline_model_init (OutlineModel *model)
+{
+    model->outline = NULL;
+}
+
+///
+/// @brief Creates a new outline model.
+///
+/// @param outline The outline item to list the children of. It must
+///                outlive the model.
+///
+/// @return A new outline model. Free it with g_object_unref().
+///
+OutlineModel *
+outline_model_new (DocumentOutline *outline)
+{
+    g_assert (NULL != outline && "Tried to list a NULL outline.");
+
+    OutlineModel *model =
+        EPDFVIEW_OUTLINE_MODEL (g_object_new (EPDFVIEW_TYPE_OUTLINE_MODEL,
+                                              NULL));
+    model->outline = outline;
+    return model;
+}
+
+///
+/// @brief Gets the model of an index row's children.
+///
+/// This is the GtkTreeListModelCreateModelFunc for the index. It only
+/// checks if the outline item has children, without reading them, so
+/// the index can show the expanders of the visible rows cheaply.
+///
+/// @param item The OutlineModel of the row.
+/// @param data Unused.
+///
+/// @return A new reference to @a item if it has children, or NULL.
+///
+GListModel *
+outline_model_create_children (gpointer item, gpointer data)
+{
+    OutlineModel *model = EPDFVIEW_OUTLINE_MODEL (item);
+    if ( model->outline->hasChildren () )
+    {
+        return G_LIST_MODEL (g_object_ref (model));
+    }
+    return NULL;
+}
+
+///
+/// @brief Gets the outline item of a model.
+///
+/// @param model The model to get its outline item.
+///
+/// @return The outline item @a model lists the children of.
+///
+DocumentOutline *
+outline_model_get_outline (OutlineModel *model)
+{
+    return model->outline;
+}
@@ -0,0 +1,44 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - A lightweight PDF Viewer.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__OUTLINE_MODEL_H__)
+#define __OUTLINE_MODEL_H__
+
+#include <gio/gio.h>
+
+///
+/// @brief A GListModel with the children of a document's outline item.
+///
+/// Each item of the list is another OutlineModel with a child of the
+/// outline, so the same object is both a row of the index and the model
+/// of its children once it's expanded by a GtkTreeListModel. The items
+/// are created only when the list view asks for them, and the outline
+/// only reads the children of the items that are expanded.
+///
+#define EPDFVIEW_TYPE_OUTLINE_MODEL (outline_model_get_type ())
+G_DECLARE_FINAL_TYPE (OutlineModel, outline_model, EPDFVIEW, OUTLINE_MODEL,
+                      GObject)
+
+OutlineModel *outline_model_new (ePDFView::DocumentOutline *outline);
+GListModel *outline_model_create_children (gpointer item, gpointer data);
+ePDFView::DocumentOutline *outline_model_get_outline (OutlineModel *model);
+
+#endif // !__OUTLINE_MODEL_H__
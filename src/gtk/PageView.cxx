@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <gettext.h>
+#include <string.h>
 #include <gtk/gtk.h>
 #include <gdk/gdkkeysyms.h>
 #include <epdfview.h>
@@ -633,6 +634,22 @@ PageView::scrollPage (gdouble scrollX, gdouble scrollY, gint dx, gint dy)
     }
 }
 
+///
+/// @brief Deletes the scaled copies of the shown page.
+///
+/// The page itself is kept, and the next resizePage() scales it again.
+///
+void
+PageView::releaseMemory ()
+{
+    clearZoomCache ();
+    if ( NULL != m_CurrentScaledPixbuf )
+    {
+        g_object_unref (m_CurrentScaledPixbuf);
+        m_CurrentScaledPixbuf = NULL;
+    }
+}
+
 void 
 PageView::showPage (DocumentPage *page, PageScroll scroll)
 {
@@ -741,6 +758,59 @@ PageView::tryReShowPage()
 	}
 }
 
+void
+PageView::updatePageArea (DocumentPage *page, cairo_region_t *area)
+{
+    if ( NULL == m_CurrentPixbuf ||
+         gdk_pixbuf_get_width (m_CurrentPixbuf) != page->getWidth () ||
+         gdk_pixbuf_get_height (m_CurrentPixbuf) != page->getHeight () ||
+         (gboolean)gdk_pixbuf_get_has_alpha (m_CurrentPixbuf) != page->hasAlpha () )
+    {
+        showPage (page, PAGE_SCROLL_NONE);
+        return;
+    }
+    lastPageShown = page;
+
+    // GTK4 redraws the whole drawing area anyway, so the saving is in
+    // not copying and inverting the rest of the page's image.
+    gint bytesPerPixel = gdk_pixbuf_get_n_channels (m_CurrentPixbuf);
+    gint destStride = gdk_pixbuf_get_rowstride (m_CurrentPixbuf);
+    guchar *dest = gdk_pixbuf_get_pixels (m_CurrentPixbuf);
+    gint srcStride = page->getRowStride ();
+    guchar *src = page->getData ();
+    gint numRects = cairo_region_num_rectangles (area);
+    for ( gint rectIndex = 0 ; rectIndex < numRects ; rectIndex++ )
+    {
+        cairo_rectangle_int_t rect;
+        cairo_region_get_rectangle (area, rectIndex, &rect);
+        gint x1 = MAX (rect.x, 0);
+        gint y1 = MAX (rect.y, 0);
+        gint x2 = MIN (rect.x + rect.width, page->getWidth ());
+        gint y2 = MIN (rect.y + rect.height, page->getHeight ());
+        if ( x1 >= x2 )
+        {
+            continue;
+        }
+        for ( gint y = y1 ; y < y2 ; y++ )
+        {
+            guchar *destRow = dest + y * destStride + x1 * bytesPerPixel;
+            memcpy (destRow, src + y * srcStride + x1 * bytesPerPixel,
+                    (x2 - x1) * bytesPerPixel);
+            if ( invertColorToggle )
+            {
+                for ( gint x = 0 ; x < x2 - x1 ; x++ )
+                {
+                    guchar *pixel = destRow + x * bytesPerPixel;
+                    pixel[0] = 255 - pixel[0];
+                    pixel[1] = 255 - pixel[1];
+                    pixel[2] = 255 - pixel[2];
+                }
+            }
+        }
+    }
+    gtk_widget_queue_draw (m_PageImage);
+}
+
 void
 PageView::showText (const gchar *text)
 {
@@ -148,8 +148,10 @@ namespace ePDFView {
             void setCursor (PageCursor cursorType);
             void setPresenter (PagePter *pter);
             
+            void releaseMemory (void);
             void showPage (DocumentPage *page, PageScroll scroll);
             void tryReShowPage (void);
+            void updatePageArea (DocumentPage *page, cairo_region_t *area);
             
             void showText (const gchar *text);
             
@@ -416,6 +416,28 @@ PrintView::sensitivePrintButton (gboolean sensitive)
     }
 }
 
+void
+PrintView::setPrinterAttributes (guint printerIndex, gint jobs,
+                                 const gchar *state, const gchar *location)
+{
+    PrinterData *data = (PrinterData *)g_list_model_get_item(
+        G_LIST_MODEL(m_PrinterList), printerIndex);
+    if (data == NULL)
+    {
+        return;
+    }
+
+    // Update the printer's data in place and tell the list view.
+    data->jobs = jobs;
+    g_free(data->state);
+    data->state = g_strdup(state);
+    g_free(data->location);
+    data->location = g_strdup(location);
+    g_list_model_items_changed(G_LIST_MODEL(m_PrinterList), printerIndex,
+                               1, 1);
+    g_object_unref(data);
+}
+
 void
 PrintView::addOptionToList (GListStore *optionList, const gchar *name,
                          const gchar *value)
@@ -788,6 +810,20 @@ PrintView::createLayoutListModel ()
     g_list_store_append(m_Layout, &data);
     g_free(data.name);
     g_free(data.value);
+    
+    // 8 pages in 1
+    data.name = g_strdup(_("8 pages in 1"));
+    data.value = g_strdup_printf("%d", PRINT_PAGE_LAYOUT_8IN1);
+    g_list_store_append(m_Layout, &data);
+    g_free(data.name);
+    g_free(data.value);
+    
+    // Booklet
+    data.name = g_strdup(_("Booklet"));
+    data.value = g_strdup_printf("%d", PRINT_PAGE_LAYOUT_BOOKLET);
+    g_list_store_append(m_Layout, &data);
+    g_free(data.name);
+    g_free(data.value);
 }
 
 void
@@ -61,7 +61,9 @@ typedef enum {
     PRINT_PAGE_LAYOUT_1IN1 = 0,
     PRINT_PAGE_LAYOUT_2IN1,
     PRINT_PAGE_LAYOUT_4IN1,
-    PRINT_PAGE_LAYOUT_6IN1
+    PRINT_PAGE_LAYOUT_6IN1,
+    PRINT_PAGE_LAYOUT_8IN1,
+    PRINT_PAGE_LAYOUT_BOOKLET
 } PrintPageLayout;
 
 // Print page orientation options
@@ -133,6 +135,9 @@ namespace ePDFView
             virtual void sensitiveCollate (gboolean sensitive);
             virtual void sensitivePageRange (gboolean sensitive);
             virtual void sensitivePrintButton (gboolean sensitive);
+            virtual void setPrinterAttributes (guint printerIndex, gint jobs,
+                                               const gchar *state,
+                                               const gchar *location);
 
         protected:
             GtkWidget *m_AllPagesRangeOption;
@@ -45,6 +45,14 @@ static const struct
 void
 epdfview_stock_icons_init (void)
 {
+    // Every window calls this, but the search path is only added once.
+    static gboolean initialised = FALSE;
+    if ( initialised )
+    {
+        return;
+    }
+    initialised = TRUE;
+
     // In GTK4, we add the data directory to the icon theme search path
     // This allows the icon theme to find our custom icons
     GtkIconTheme *icon_theme = gtk_icon_theme_get_for_display (gdk_display_get_default ());
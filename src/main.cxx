@@ -30,6 +30,7 @@
 #endif
 #include "epdfview.h"
 #include "gtk/MainView.h"
+#include "gtk/MainWindow.h"
 
 // GTK4 initialization - no compatibility layer needed
 
@@ -46,19 +47,153 @@ using namespace ePDFView;
 struct AppData
 {
     GtkApplication *app;
+    /// The file to open in the first window, read from the standard
+    /// input, or NULL. Other files come through the "open" signal.
     gchar *fileToOpen;
+    /// The open windows, as MainWindow.
+    GList *windows;
+};
+
+// A file to load once its tab is shown.
+struct FileToLoad
+{
+    /// The presenter of the tab that loads the file.
     MainPter *mainPter;
+    /// The document to load the file to.
     PDFDocument *document;
-    MainView *mainView;
+    /// The file name to load.
+    gchar *fileName;
 };
 
+// The key of the MainWindow in its window's data.
+static const gchar *MAIN_WINDOW_KEY = "epdfview-main-window";
+
+// The command line options of the headless export.
+struct ExportOptions
+{
+    /// The format to export to, or NULL to start the viewer.
+    gchar *format;
+    /// The file name pattern to export to.
+    gchar *output;
+    /// The pages to export, or NULL for all.
+    gchar *pages;
+    /// The resolution of the exported images.
+    gdouble resolution;
+    /// The number of rendering threads, or 0 for one per processor.
+    gint numThreads;
+};
+
+///
+/// @brief Exports a document's pages without creating any window.
+///
+/// Prints how long the export took, so it can be used to measure the
+/// rendering speed.
+///
+/// @param fileName The document to export.
+/// @param options The export options read from the command line.
+///
+/// @return The process's exit status.
+///
+static int
+exportFromCommandLine (const gchar *fileName, ExportOptions *options)
+{
+    ExportFormat format;
+    if ( !DocumentExporter::parseFormat (options->format, &format) )
+    {
+        g_printerr (_("Unknown export format '%s'. Use png, pdf, ps or txt.\n"),
+                    options->format);
+        return EXIT_FAILURE;
+    }
+    if ( NULL == fileName || NULL == options->output )
+    {
+        g_printerr (_("Exporting needs a document and an --output name.\n"));
+        return EXIT_FAILURE;
+    }
+    if ( 0 > options->numThreads )
+    {
+        g_printerr (_("The number of jobs must be positive.\n"));
+        return EXIT_FAILURE;
+    }
+
+    PDFDocument document;
+    GError *error = NULL;
+    if ( !document.loadFile (fileName, NULL, &error) )
+    {
+        g_printerr ("%s: %s\n", fileName, error->message);
+        g_error_free (error);
+        return EXIT_FAILURE;
+    }
+
+    DocumentExporter exporter (&document);
+    exporter.setFormat (format);
+    exporter.setOutputPattern (options->output);
+    exporter.setNumThreads (options->numThreads);
+    if ( !exporter.setResolution (options->resolution, &error) ||
+         ( NULL != options->pages &&
+           !exporter.setPageRange (options->pages, &error) ) )
+    {
+        g_printerr ("%s\n", error->message);
+        g_error_free (error);
+        return EXIT_FAILURE;
+    }
+
+    gint64 startTime = g_get_monotonic_time ();
+    gboolean exported = exporter.exportPages (&error);
+    gdouble seconds = (g_get_monotonic_time () - startTime) /
+                      (gdouble)G_USEC_PER_SEC;
+    if ( !exported )
+    {
+        g_printerr ("%s\n", error->message);
+        g_error_free (error);
+        return EXIT_FAILURE;
+    }
+    guint numPages = exporter.getNumPagesExported ();
+    g_printerr (_("Exported %u pages in %.3f s (%.1f pages/s).\n"),
+                numPages, seconds,
+                0.0 < seconds ? numPages / seconds : 0.0);
+
+    return EXIT_SUCCESS;
+}
+
+///
+/// @brief Checks whether the help is asked for in the command line.
+///
+/// @param argc The number of arguments.
+/// @param argv The arguments.
+///
+/// @return TRUE if any of the help options is in @a argv, FALSE
+///         otherwise.
+///
+static gboolean
+hasHelpOption (int argc, char **argv)
+{
+    for ( int arg = 1 ; arg < argc ; arg++ )
+    {
+        if ( 0 == g_strcmp0 ("--", argv[arg]) )
+        {
+            break;
+        }
+        if ( 0 == g_strcmp0 ("-h", argv[arg]) ||
+             0 == g_strcmp0 ("-?", argv[arg]) ||
+             g_str_has_prefix (argv[arg], "--help") )
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 static int
 loadFileFromCommandLine (gpointer data)
 {
-    AppData *appData = static_cast<AppData *> (data);
+    FileToLoad *fileToLoad = static_cast<FileToLoad *> (data);
+    StartupProfile::mark ("main loop");
 
-    appData->mainPter->setOpenState (appData->fileToOpen, FALSE);
-    appData->document->load (appData->fileToOpen, NULL);
+    fileToLoad->mainPter->setOpenState (fileToLoad->fileName, FALSE);
+    fileToLoad->document->load (fileToLoad->fileName, NULL);
+    g_free (fileToLoad->fileName);
+    g_free (fileToLoad);
 
     return FALSE;
 }
@@ -67,40 +202,131 @@ loadFileFromCommandLine (gpointer data)
 static gboolean
 handleReloadSignal(gpointer data)
 {
-    MainPter *mainPter = static_cast<MainPter *> (data);
+    AppData *appData = static_cast<AppData *> (data);
 
-	mainPter->reloadActivated ();
+    for ( GList *window = appData->windows ; NULL != window ;
+          window = g_list_next (window) )
+    {
+        MainWindow *mainWindow = static_cast<MainWindow *> (window->data);
+        for ( GList *tab = mainWindow->getTabs () ; NULL != tab ;
+              tab = g_list_next (tab) )
+        {
+            static_cast<MainPter *> (tab->data)->reloadActivated ();
+        }
+    }
 	return TRUE;
 }
 #endif
 
+///
+/// @brief Opens a document in a new tab.
+///
+/// All tabs, of this window or others, share the process' job thread,
+/// cache budget, disk cache and configuration.
+///
+/// @param mainWindow The window to add the tab to.
+/// @param fileName The file to load in the tab, or NULL.
+///
+static void
+openTab (MainWindow *mainWindow, const gchar *fileName)
+{
+    PDFDocument *document = new PDFDocument;
+    MainPter *mainPter = new MainPter (document);
+    MainView *mainView = new MainView (mainPter, mainWindow);
+    mainPter->setView (mainView);
+    mainWindow->addTab (mainPter);
+    StartupProfile::mark ("main window");
+
+    // Show the main window (GTK4: windows are hidden by default)
+    mainView->show ();
+    StartupProfile::mark ("window shown");
+
+    // If we have a file to open, schedule it
+    if ( NULL != fileName )
+    {
+        FileToLoad *fileToLoad = g_new (FileToLoad, 1);
+        fileToLoad->mainPter = mainPter;
+        fileToLoad->document = document;
+        fileToLoad->fileName = g_strdup (fileName);
+        g_idle_add (loadFileFromCommandLine, fileToLoad);
+    }
+}
+
+///
+/// @brief Opens a new main window.
+///
+/// @param appData The application's data.
+///
+/// @return The new window, without tabs.
+///
+static MainWindow *
+openWindow (AppData *appData)
+{
+    MainWindow *mainWindow = new MainWindow ();
+
+    // GTK4: Register the window with the application (prevents immediate exit)
+    GtkWindow *window = GTK_WINDOW (mainWindow->getWindow ());
+    g_object_set_data (G_OBJECT (window), MAIN_WINDOW_KEY, mainWindow);
+    gtk_application_add_window (appData->app, window);
+    appData->windows = g_list_append (appData->windows, mainWindow);
+    StartupProfile::setWindow (GTK_WIDGET (window));
+
+    return mainWindow;
+}
+
+///
+/// @brief Deletes a closed window's tabs.
+///
+/// It's called from an idle, because the window is removed from the
+/// application while it's being destroyed.
+///
+static gboolean
+deleteMainWindow (gpointer data)
+{
+    delete static_cast<MainWindow *> (data);
+
+    return FALSE;
+}
+
 // GTK4 Application callbacks
 static void
-on_activate (GtkApplication *app, gpointer user_data)
+on_startup (GtkApplication *app, gpointer user_data)
 {
     AppData *appData = static_cast<AppData *> (user_data);
-    
-    // Create the main presenter and document
-    appData->document = new PDFDocument;
-    // Initialize background job dispatcher (queue + thread)
+    // GTK is initialised before this handler runs.
+    StartupProfile::mark ("gtk init");
+
+    // Keep the thumbnails and the first pages between sessions, unless
+    // the user disabled it.
+    gint diskCacheSize = Config::getConfig ().getDiskCacheSize ();
+    if ( 0 < diskCacheSize && NULL == IDocument::getDiskCache () )
+    {
+        gchar *cacheDirectory =
+            g_build_filename (g_get_user_cache_dir (), PACKAGE, NULL);
+        IDocument::setDiskCache (
+                new DiskCache (cacheDirectory,
+                               (gsize)diskCacheSize * 1024 * 1024));
+        g_free (cacheDirectory);
+    }
+    StartupProfile::mark ("configuration and cache");
+
+    // Initialize background job dispatcher (queue + thread). Only the
+    // primary instance gets here, so a forwarding one never starts it.
     IJob::init();
-    appData->mainPter = new MainPter (appData->document);
-    
-    // Create the main view
-    appData->mainView = new MainView (appData->mainPter);
-    
-    // Let the presenter know which is its view
-    appData->mainPter->setView (appData->mainView);
-    
-    // GTK4: Register the window with the application (prevents immediate exit)
-    gtk_application_add_window (app, GTK_WINDOW (appData->mainView->getMainWindow()));
-    
+    StartupProfile::mark ("job thread");
+
+    // Free the caches when the system is low on memory.
+    MemoryGovernor::getGovernor ().start ();
+
     // Setup keyboard shortcuts
     const char *quit_accels[] = { "<Control>Q", NULL };
     gtk_application_set_accels_for_action (app, "win.quit", quit_accels);
     
     const char *open_accels[] = { "<Control>O", NULL };
     gtk_application_set_accels_for_action (app, "win.open-file", open_accels);
+
+    const char *open_tab_accels[] = { "<Control>T", NULL };
+    gtk_application_set_accels_for_action (app, "win.open-tab", open_tab_accels);
     
     const char *find_accels[] = { "<Control>F", NULL };
     gtk_application_set_accels_for_action (app, "win.find", find_accels);
@@ -133,30 +359,91 @@ on_activate (GtkApplication *app, gpointer user_data)
     
     const char *zoom_out_accels[] = { "<Control>minus", "<Control>KP_Subtract", NULL };
     gtk_application_set_accels_for_action (app, "win.zoom-out", zoom_out_accels);
-    
-    // Show the main window (GTK4: windows are hidden by default)
-    appData->mainView->show ();
-    
-    // If we have a file to open, schedule it
-    if (appData->fileToOpen != NULL)
-    {
-        g_idle_add (loadFileFromCommandLine, appData);
-    }
 
 #ifndef _WIN32
-    g_unix_signal_add(SIGHUP, handleReloadSignal, appData->mainPter);
+    g_unix_signal_add(SIGHUP, handleReloadSignal, appData);
 #endif
-}static void
-on_shutdown (GtkApplication *app, gpointer user_data)
+    StartupProfile::mark ("accelerators");
+}
+
+static void
+on_activate (GtkApplication *app, gpointer user_data)
 {
     AppData *appData = static_cast<AppData *> (user_data);
-    
-    // Delete the main presenter (which also deletes the view)
-    if (appData->mainPter != NULL)
+
+    // Starting again without files shows the window already open.
+    GtkWindow *activeWindow = gtk_application_get_active_window (app);
+    if ( NULL != activeWindow && NULL == appData->fileToOpen )
+    {
+        gtk_window_present (activeWindow);
+        return;
+    }
+    openTab (openWindow (appData), appData->fileToOpen);
+    if ( NULL == appData->fileToOpen )
+    {
+        StartupProfile::finish ("empty window");
+    }
+    g_free (appData->fileToOpen);
+    appData->fileToOpen = NULL;
+}
+
+static void
+on_open (GtkApplication *app, GFile **files, gint numFiles,
+         const gchar *hint, gpointer user_data)
+{
+    AppData *appData = static_cast<AppData *> (user_data);
+
+    // The files open in new tabs of the active window. In the single
+    // instance mode, these can be the files of a later invocation,
+    // forwarded by it.
+    MainWindow *mainWindow = NULL;
+    GtkWindow *activeWindow = gtk_application_get_active_window (app);
+    if ( NULL != activeWindow )
+    {
+        mainWindow = static_cast<MainWindow *> (
+                g_object_get_data (G_OBJECT (activeWindow), MAIN_WINDOW_KEY));
+    }
+    if ( NULL == mainWindow )
+    {
+        mainWindow = openWindow (appData);
+    }
+    for ( gint file = 0 ; file < numFiles ; file++ )
+    {
+        gchar *fileName = g_file_get_path (files[file]);
+        if ( NULL == fileName )
+        {
+            fileName = g_file_get_uri (files[file]);
+        }
+        openTab (mainWindow, fileName);
+        g_free (fileName);
+    }
+}
+
+static void
+on_window_removed (GtkApplication *app, GtkWindow *window,
+                   gpointer user_data)
+{
+    AppData *appData = static_cast<AppData *> (user_data);
+
+    MainWindow *mainWindow = static_cast<MainWindow *> (
+            g_object_get_data (G_OBJECT (window), MAIN_WINDOW_KEY));
+    if ( NULL != mainWindow )
     {
-        delete appData->mainPter;
-        appData->mainPter = NULL;
+        appData->windows = g_list_remove (appData->windows, mainWindow);
+        g_idle_add (deleteMainWindow, mainWindow);
     }
+}
+
+static void
+on_shutdown (GtkApplication *app, gpointer user_data)
+{
+    AppData *appData = static_cast<AppData *> (user_data);
+    
+    // Delete the windows' main presenters (which also delete the views)
+    g_list_free_full (appData->windows, [](gpointer mainWindow) {
+        delete static_cast<MainWindow *> (mainWindow);
+    });
+    appData->windows = NULL;
     
     // Save the configuration
     Config::getConfig().save ();
@@ -165,6 +452,7 @@ on_shutdown (GtkApplication *app, gpointer user_data)
 int
 main (int argc, char **argv)
 {
+    StartupProfile::start ();
 #ifdef _WIN32
 
     if (fileno (stdout) != -1 &&
@@ -195,39 +483,113 @@ main (int argc, char **argv)
     (void)bindtextdomain (PACKAGE, LOCALEDIR);
     (void)bind_textdomain_codeset (PACKAGE, "UTF-8");
     (void)textdomain (PACKAGE);
-    
-    // Initialise the working thread.
-    IJob::init ();
-    
-    // Create the GTK4 application
-    // Note: G_APPLICATION_NON_UNIQUE allows multiple instances
-    // G_APPLICATION_HANDLES_COMMAND_LINE allows us to handle command line args
-    GtkApplication *app = gtk_application_new ("io.github.jotarandom.epdfview",
-                                               G_APPLICATION_NON_UNIQUE);
-    
-    // Set application name
-    g_set_application_name (_("PDF Viewer"));
+    StartupProfile::mark ("locale");
+
+    // The export options are read before GTK's, so exporting never
+    // needs a display. Anything else, the help included, is left for
+    // the application, which also lists these options in its help.
+    ExportOptions exportOptions = { NULL, NULL, NULL, 150.0, 0 };
+    gboolean singleInstance = FALSE;
+    gboolean startupProfile = FALSE;
+    GOptionEntry exportEntries[] =
+    {
+        { "startup-profile", 0, 0, G_OPTION_ARG_NONE, &startupProfile,
+          N_("Print how long each phase of the startup takes"), NULL },
+        { "single-instance", 0, 0, G_OPTION_ARG_NONE, &singleInstance,
+          N_("Open the files in the already running viewer, if any"),
+          NULL },
+        { "export", 'e', 0, G_OPTION_ARG_STRING, &exportOptions.format,
+          N_("Export the document without a window, as png, pdf, ps "
+             "or txt"),
+          N_("FORMAT") },
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &exportOptions.output,
+          N_("The file to export to, where %d is the page number, or - "
+             "to write the text to the standard output"),
+          N_("PATTERN") },
+        { "pages", 0, 0, G_OPTION_ARG_STRING, &exportOptions.pages,
+          N_("The pages to export, as in 1-3,5"), N_("RANGE") },
+        { "dpi", 0, 0, G_OPTION_ARG_DOUBLE, &exportOptions.resolution,
+          N_("The resolution of the exported images, 150 by default"),
+          N_("DPI") },
+        { "jobs", 'j', 0, G_OPTION_ARG_INT, &exportOptions.numThreads,
+          N_("The number of rendering threads, one per processor by "
+             "default"), N_("N") },
+        { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
+    };
+    GOptionContext *optionContext = g_option_context_new (_("[FILE]"));
+    g_option_context_add_main_entries (optionContext, exportEntries,
+                                       PACKAGE);
+    g_option_context_set_help_enabled (optionContext, FALSE);
+    g_option_context_set_ignore_unknown_options (optionContext, TRUE);
+    GError *optionError = NULL;
+    gboolean parsed = g_option_context_parse (optionContext, &argc, &argv,
+                                              &optionError);
+    g_option_context_free (optionContext);
+    if ( !parsed )
+    {
+        g_printerr ("%s\n", optionError->message);
+        g_error_free (optionError);
+        return EXIT_FAILURE;
+    }
+    if ( startupProfile )
+    {
+        StartupProfile::enable ();
+    }
+    StartupProfile::mark ("command line");
+    if ( NULL != exportOptions.format && !hasHelpOption (argc, argv) )
+    {
+        int status = exportFromCommandLine (1 < argc ? argv[1] : NULL,
+                                            &exportOptions);
+        g_free (exportOptions.format);
+        g_free (exportOptions.output);
+        g_free (exportOptions.pages);
+        return status;
+    }
     
     // Initialize application data
     AppData appData = { 0 };
-    appData.app = app;
     appData.fileToOpen = NULL;
-    appData.mainPter = NULL;
-    appData.document = NULL;
-    appData.mainView = NULL;
-    
-    // Check if we have a file to open from command line
-    if (argc > 1)
+    appData.windows = NULL;
+
+    // The standard input can't be forwarded to another instance, so
+    // it's read by this one, and GApplication doesn't see it as a file.
+    int appArgc = argc;
+    if ( 1 < argc && 0 == g_strcmp0 ("-", argv[1]) )
     {
         appData.fileToOpen = g_strdup (argv[1]);
+        singleInstance = FALSE;
+        appArgc = 1;
     }
+
+    // Create the GTK4 application
+    // By default every invocation is its own instance. In the single
+    // instance mode, GApplication sends the files of later invocations
+    // to the first one, over the session bus, and they exit without
+    // initialising GTK.
+    GApplicationFlags flags = G_APPLICATION_HANDLES_OPEN;
+    if ( !singleInstance )
+    {
+        flags = (GApplicationFlags)(flags | G_APPLICATION_NON_UNIQUE);
+    }
+    GtkApplication *app = gtk_application_new ("io.github.jotarandom.epdfview",
+                                               flags);
+    appData.app = app;
+    g_application_add_main_option_entries (G_APPLICATION (app),
+                                           exportEntries);
+    
+    // Set application name
+    g_set_application_name (_("PDF Viewer"));
     
     // Connect application signals
+    g_signal_connect (app, "startup", G_CALLBACK (on_startup), &appData);
     g_signal_connect (app, "activate", G_CALLBACK (on_activate), &appData);
+    g_signal_connect (app, "open", G_CALLBACK (on_open), &appData);
+    g_signal_connect (app, "window-removed",
+                      G_CALLBACK (on_window_removed), &appData);
     g_signal_connect (app, "shutdown", G_CALLBACK (on_shutdown), &appData);
     
     // Run the application
-    int status = g_application_run (G_APPLICATION (app), argc, argv);
+    int status = g_application_run (G_APPLICATION (app), appArgc, argv);
     
     // Cleanup
     if (appData.fileToOpen != NULL)
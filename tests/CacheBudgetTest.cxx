@@ -0,0 +1,294 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Cache Budget Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "DumbDocument.h"
+#include "CacheBudgetTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (CacheBudgetTest);
+
+///
+/// @brief An observer that uses the budget when memory runs low.
+///
+class BudgetObserver: public IDocumentObserver
+{
+    public:
+        BudgetObserver (void) { m_Size = 0; }
+
+        void notifyLowMemory (void)
+        {
+            CacheBudget &budget = CacheBudget::getBudget ();
+            budget.trim ();
+            m_Size = budget.getSize ();
+        }
+
+        /// The budget's size when memory ran low.
+        gsize m_Size;
+};
+
+// Forward declarations.
+static void addThumbnails (DumbDocument *document, gint numThumbnails);
+static DocumentPage *newThumbnail (void);
+
+// Constants.
+/// The width and height of the test thumbnails.
+static const gint TEST_THUMBNAIL_SIZE = 16;
+/// How many thumbnails each test document has.
+static const gint TEST_NUM_THUMBNAILS = 4;
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// Both documents get TEST_NUM_THUMBNAILS thumbnails and the second is
+/// the active.
+///
+void
+CacheBudgetTest::setUp ()
+{
+    DocumentPage *thumbnail = newThumbnail ();
+    m_ThumbnailSize = thumbnail->getRowStride () * thumbnail->getHeight ();
+    delete thumbnail;
+
+    m_Background = new DumbDocument ();
+    m_Active = new DumbDocument ();
+    addThumbnails (m_Background, TEST_NUM_THUMBNAILS);
+    addThumbnails (m_Active, TEST_NUM_THUMBNAILS);
+    CacheBudget::getBudget ().activate (m_Active);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+CacheBudgetTest::tearDown ()
+{
+    delete m_Background;
+    delete m_Active;
+    CacheBudget::destroy ();
+}
+
+///
+/// @brief Checks that the documents are added and removed.
+///
+void
+CacheBudgetTest::addDocuments ()
+{
+    CacheBudget &budget = CacheBudget::getBudget ();
+    CPPUNIT_ASSERT_EQUAL (2 * TEST_NUM_THUMBNAILS * m_ThumbnailSize,
+                          budget.getSize ());
+
+    guint numDocuments = budget.getNumDocuments ();
+    DumbDocument *document = new DumbDocument ();
+    CPPUNIT_ASSERT_EQUAL (numDocuments + 1, budget.getNumDocuments ());
+    delete document;
+    CPPUNIT_ASSERT_EQUAL (numDocuments, budget.getNumDocuments ());
+}
+
+///
+/// @brief Checks that the background document releases memory first.
+///
+void
+CacheBudgetTest::releaseBackgroundFirst ()
+{
+    CacheBudget &budget = CacheBudget::getBudget ();
+    gsize released = budget.release (m_ThumbnailSize);
+
+    CPPUNIT_ASSERT_EQUAL (m_ThumbnailSize, released);
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS - 1) * m_ThumbnailSize,
+                          m_Background->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL (TEST_NUM_THUMBNAILS * m_ThumbnailSize,
+                          m_Active->getCacheSize ());
+
+    // Activating the other document changes which releases first.
+    budget.activate (m_Background);
+    budget.release (m_ThumbnailSize);
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS - 1) * m_ThumbnailSize,
+                          m_Background->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS - 1) * m_ThumbnailSize,
+                          m_Active->getCacheSize ());
+}
+
+///
+/// @brief Checks that the active document releases memory when needed.
+///
+void
+CacheBudgetTest::releaseActiveLast ()
+{
+    CacheBudget &budget = CacheBudget::getBudget ();
+    gsize released = budget.release ((TEST_NUM_THUMBNAILS + 1) *
+                                     m_ThumbnailSize);
+
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS + 1) * m_ThumbnailSize,
+                          released);
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Background->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS - 1) * m_ThumbnailSize,
+                          m_Active->getCacheSize ());
+
+    // Nothing more than what is cached can be released.
+    released = budget.release (2 * TEST_NUM_THUMBNAILS * m_ThumbnailSize);
+    CPPUNIT_ASSERT_EQUAL ((TEST_NUM_THUMBNAILS - 1) * m_ThumbnailSize,
+                          released);
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, budget.getSize ());
+}
+
+///
+/// @brief Checks that the caches are trimmed to the limit.
+///
+void
+CacheBudgetTest::keepWithinLimit ()
+{
+    CacheBudget &budget = CacheBudget::getBudget ();
+    budget.setLimit (TEST_NUM_THUMBNAILS * m_ThumbnailSize);
+
+    CPPUNIT_ASSERT_EQUAL (budget.getLimit (), budget.getSize ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Background->getCacheSize ());
+
+    // A new thumbnail of the active document drops its oldest one.
+    m_Active->addThumbnail (TEST_NUM_THUMBNAILS + 1, newThumbnail ());
+    budget.trim ();
+    CPPUNIT_ASSERT_EQUAL (budget.getLimit (), budget.getSize ());
+    CPPUNIT_ASSERT (NULL == m_Active->getThumbnail (1));
+    CPPUNIT_ASSERT (NULL != m_Active->getThumbnail (TEST_NUM_THUMBNAILS + 1));
+}
+
+///
+/// @brief Checks that the rendered pages count in the budget.
+///
+/// The background document releases its rendered pages other than the
+/// current, but the active document keeps all of its.
+///
+void
+CacheBudgetTest::releaseRenderedPages ()
+{
+    // The queued renders do nothing, so the test gives the images.
+    G_LOCK (JobRender);
+    JobRender::m_CanProcessJobs = FALSE;
+    G_UNLOCK (JobRender);
+    // Loading caches the first two pages and removes the thumbnails.
+    m_Background->notifyLoad ();
+    m_Active->notifyLoad ();
+    // The second page cached has age 1.
+    m_Background->notifyPageRendered (2, 1, newThumbnail ());
+    m_Active->notifyPageRendered (2, 1, newThumbnail ());
+    CacheBudget &budget = CacheBudget::getBudget ();
+    CPPUNIT_ASSERT_EQUAL (m_ThumbnailSize, m_Background->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL (2 * m_ThumbnailSize, budget.getSize ());
+
+    gsize released = budget.release (2 * m_ThumbnailSize);
+    CPPUNIT_ASSERT_EQUAL (m_ThumbnailSize, released);
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Background->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL (m_ThumbnailSize, m_Active->getCacheSize ());
+
+    G_LOCK (JobRender);
+    JobRender::m_CanProcessJobs = TRUE;
+    G_UNLOCK (JobRender);
+}
+
+///
+/// @brief Checks that the active document's rendered pages don't count.
+///
+/// The active document never releases its rendered pages for the
+/// budget, so when they alone are over the limit the budget must not
+/// release its thumbnails each time a page is rendered.
+///
+void
+CacheBudgetTest::keepActivePagesOutOfLimit ()
+{
+    G_LOCK (JobRender);
+    JobRender::m_CanProcessJobs = FALSE;
+    G_UNLOCK (JobRender);
+    // Loading removes the thumbnails of both documents.
+    m_Background->notifyLoad ();
+    m_Active->notifyLoad ();
+    CacheBudget &budget = CacheBudget::getBudget ();
+    budget.setLimit (m_ThumbnailSize);
+    m_Active->addThumbnail (1, newThumbnail ());
+
+    DocumentPage *pageImage = new DocumentPage ();
+    pageImage->newPage (2 * TEST_THUMBNAIL_SIZE, 2 * TEST_THUMBNAIL_SIZE);
+    gsize pageSize = pageImage->getRowStride () * pageImage->getHeight ();
+    m_Active->notifyPageRendered (2, 1, pageImage);
+    CPPUNIT_ASSERT (pageSize > budget.getLimit ());
+    CPPUNIT_ASSERT_EQUAL (pageSize + m_ThumbnailSize, budget.getSize ());
+    CPPUNIT_ASSERT (NULL != m_Active->getThumbnail (1));
+
+    // Only the thumbnails over the limit are released.
+    m_Active->addThumbnail (2, newThumbnail ());
+    budget.trim ();
+    CPPUNIT_ASSERT_EQUAL (pageSize + m_ThumbnailSize, budget.getSize ());
+    CPPUNIT_ASSERT (NULL == m_Active->getThumbnail (1));
+    CPPUNIT_ASSERT (NULL != m_Active->getThumbnail (2));
+
+    G_LOCK (JobRender);
+    JobRender::m_CanProcessJobs = TRUE;
+    G_UNLOCK (JobRender);
+}
+
+///
+/// @brief Checks that the documents' observers can use the budget.
+///
+/// The budget doesn't hold its lock while it calls the documents, so
+/// an observer that trims the caches doesn't block.
+///
+void
+CacheBudgetTest::callBackFromDocuments ()
+{
+    BudgetObserver observer;
+    m_Active->attach (&observer);
+    CacheBudget &budget = CacheBudget::getBudget ();
+    budget.notifyLowMemory ();
+    CPPUNIT_ASSERT_EQUAL (budget.getSize (), observer.m_Size);
+    CPPUNIT_ASSERT_EQUAL (2 * TEST_NUM_THUMBNAILS * m_ThumbnailSize,
+                          observer.m_Size);
+    m_Active->detach (&observer);
+}
+
+///
+/// @brief Adds test thumbnails to a document.
+///
+/// @param document The document to add the thumbnails to.
+/// @param numThumbnails How many thumbnails to add, from the first page.
+///
+void
+addThumbnails (DumbDocument *document, gint numThumbnails)
+{
+    for ( gint pageNum = 1 ; pageNum <= numThumbnails ; pageNum++ )
+    {
+        document->addThumbnail (pageNum, newThumbnail ());
+    }
+}
+
+///
+/// @brief Creates a test thumbnail.
+///
+/// @return A new TEST_THUMBNAIL_SIZE square page.
+///
+DocumentPage *
+newThumbnail ()
+{
+    DocumentPage *thumbnail = new DocumentPage ();
+    thumbnail->newPage (TEST_THUMBNAIL_SIZE, TEST_THUMBNAIL_SIZE);
+    return thumbnail;
+}
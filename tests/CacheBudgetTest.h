@@ -0,0 +1,67 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Cache Budget Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__CACHE_BUDGET_TEST_H__)
+#define __CACHE_BUDGET_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DumbDocument;
+
+    class CacheBudgetTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (CacheBudgetTest);
+        CPPUNIT_TEST (addDocuments);
+        CPPUNIT_TEST (releaseBackgroundFirst);
+        CPPUNIT_TEST (releaseActiveLast);
+        CPPUNIT_TEST (keepWithinLimit);
+        CPPUNIT_TEST (releaseRenderedPages);
+        CPPUNIT_TEST (keepActivePagesOutOfLimit);
+        CPPUNIT_TEST (callBackFromDocuments);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void addDocuments (void);
+            void releaseBackgroundFirst (void);
+            void releaseActiveLast (void);
+            void keepWithinLimit (void);
+            void releaseRenderedPages (void);
+            void keepActivePagesOutOfLimit (void);
+            void callBackFromDocuments (void);
+
+        protected:
+            /// The document that isn't being read.
+            DumbDocument *m_Background;
+            /// The document being read.
+            DumbDocument *m_Active;
+            /// The bytes of a test thumbnail.
+            gsize m_ThumbnailSize;
+    };
+}
+
+#endif // !__CACHE_BUDGET_TEST_H__
@@ -0,0 +1,277 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Compressed Page Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <string.h>
+#include <epdfview.h>
+#include "CompressedPageCacheTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (CompressedPageCacheTest);
+
+// Forward declarations.
+static gboolean equalPages (DocumentPage *page, DocumentPage *other);
+static DocumentPage *newTestPage (void);
+
+// Constants.
+/// The width of the test pages.
+static const gint TEST_PAGE_WIDTH = 200;
+/// The height of the test pages.
+static const gint TEST_PAGE_HEIGHT = 260;
+/// The rows between the start of two lines of text in the test pages.
+static const gint TEST_LINE_HEIGHT = 24;
+/// The rows of each line of text in the test pages.
+static const gint TEST_TEXT_HEIGHT = 8;
+/// The white pixels at the left and right of the lines of text.
+static const gint TEST_MARGIN = 20;
+/// How much a test page must be compressed at least.
+static const gdouble TEST_MIN_RATIO = 5.0;
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// The cache's budget holds two compressed test pages.
+///
+void
+CompressedPageCacheTest::setUp ()
+{
+    CompressedPageCache *cache = new CompressedPageCache (G_MAXSIZE);
+    DocumentPage *page = newTestPage ();
+    cache->add (1, page);
+    gsize size = cache->getSize ();
+    delete page;
+    delete cache;
+    m_Cache = new CompressedPageCache (2 * size);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+CompressedPageCacheTest::tearDown ()
+{
+    delete m_Cache;
+}
+
+///
+/// @brief Checks a cache without pages.
+///
+void
+CompressedPageCacheTest::emptyCache ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+    CPPUNIT_ASSERT_EQUAL (0.0, m_Cache->getCompressionRatio ());
+    CPPUNIT_ASSERT_EQUAL (0.0, m_Cache->getDecodeTime ());
+    CPPUNIT_ASSERT (NULL == m_Cache->take (1));
+    // Removing a missing page does nothing.
+    m_Cache->remove (1);
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumPages ());
+}
+
+///
+/// @brief Checks that a taken page is equal to the added and removed.
+///
+void
+CompressedPageCacheTest::takePage ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Cache->getNumPages ());
+
+    DocumentPage *taken = m_Cache->take (1);
+    CPPUNIT_ASSERT (NULL != taken);
+    CPPUNIT_ASSERT (equalPages (page, taken));
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+    CPPUNIT_ASSERT (NULL == m_Cache->take (1));
+    CPPUNIT_ASSERT (0.0 <= m_Cache->getDecodeTime ());
+
+    delete taken;
+    delete page;
+}
+
+///
+/// @brief Checks that a largely white page is compressed.
+///
+void
+CompressedPageCacheTest::compressWhitePage ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    CPPUNIT_ASSERT (TEST_MIN_RATIO <= m_Cache->getCompressionRatio ());
+    CPPUNIT_ASSERT ((gsize)(page->getRowStride () * page->getHeight ()) >=
+                    (gsize)(TEST_MIN_RATIO * m_Cache->getSize ()));
+
+    // A blank page is just a row and its repetitions.
+    DocumentPage *blank = new DocumentPage ();
+    blank->newPage (TEST_PAGE_WIDTH, TEST_PAGE_HEIGHT);
+    m_Cache->add (2, blank);
+    DocumentPage *taken = m_Cache->take (2);
+    CPPUNIT_ASSERT (equalPages (blank, taken));
+    CPPUNIT_ASSERT (TEST_MIN_RATIO <= m_Cache->getCompressionRatio ());
+
+    delete taken;
+    delete blank;
+    delete page;
+}
+
+///
+/// @brief Checks that the oldest page is deleted when full.
+///
+void
+CompressedPageCacheTest::evictOldestPage ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    m_Cache->add (2, page);
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT_EQUAL (m_Cache->getBudget (), m_Cache->getSize ());
+
+    m_Cache->add (3, page);
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT (NULL == m_Cache->take (1));
+    for ( gint pageNum = 2 ; pageNum <= 3 ; pageNum++ )
+    {
+        DocumentPage *taken = m_Cache->take (pageNum);
+        CPPUNIT_ASSERT (NULL != taken);
+        delete taken;
+    }
+
+    delete page;
+}
+
+///
+/// @brief Checks that releasing memory deletes the oldest images.
+///
+void
+CompressedPageCacheTest::releasePages ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    gsize size = m_Cache->getSize ();
+    m_Cache->add (2, page);
+
+    CPPUNIT_ASSERT_EQUAL (size, m_Cache->release (1));
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT (NULL == m_Cache->take (1));
+    // Nothing more than what is cached can be released.
+    CPPUNIT_ASSERT_EQUAL (size, m_Cache->release (3 * size));
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+
+    delete page;
+}
+
+///
+/// @brief Checks that adding a page's image again replaces it.
+///
+void
+CompressedPageCacheTest::replacePage ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    DocumentPage *blank = new DocumentPage ();
+    blank->newPage (TEST_PAGE_WIDTH, TEST_PAGE_HEIGHT);
+    m_Cache->add (1, blank);
+
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Cache->getNumPages ());
+    DocumentPage *taken = m_Cache->take (1);
+    CPPUNIT_ASSERT (equalPages (blank, taken));
+
+    delete taken;
+    delete blank;
+    delete page;
+}
+
+///
+/// @brief Checks that clearing the cache deletes all pages.
+///
+void
+CompressedPageCacheTest::clearCache ()
+{
+    DocumentPage *page = newTestPage ();
+    m_Cache->add (1, page);
+    m_Cache->add (2, page);
+    GList *pageNumbers = m_Cache->getPageNumbers ();
+    CPPUNIT_ASSERT_EQUAL ((guint)2, g_list_length (pageNumbers));
+    g_list_free (pageNumbers);
+    m_Cache->clear ();
+
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumPages ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+    CPPUNIT_ASSERT (NULL == m_Cache->getPageNumbers ());
+    CPPUNIT_ASSERT (NULL == m_Cache->take (1));
+
+    delete page;
+}
+
+///
+/// @brief Checks if two pages have the same image.
+///
+/// @param page The first page to compare.
+/// @param other The second page to compare.
+///
+/// @return TRUE if both pages have the same size and pixels.
+///
+gboolean
+equalPages (DocumentPage *page, DocumentPage *other)
+{
+    return NULL != page && NULL != other &&
+           page->getWidth () == other->getWidth () &&
+           page->getHeight () == other->getHeight () &&
+           0 == memcmp (page->getData (), other->getData (),
+                        page->getRowStride () * page->getHeight ());
+}
+
+///
+/// @brief Creates a test page.
+///
+/// The page is white with lines of dark strokes, like a page of text.
+///
+/// @return A new TEST_PAGE_WIDTH x TEST_PAGE_HEIGHT page.
+///
+DocumentPage *
+newTestPage ()
+{
+    DocumentPage *page = new DocumentPage ();
+    page->newPage (TEST_PAGE_WIDTH, TEST_PAGE_HEIGHT);
+    for ( gint y = 0 ; y < TEST_PAGE_HEIGHT ; y++ )
+    {
+        if ( TEST_TEXT_HEIGHT <= y % TEST_LINE_HEIGHT )
+        {
+            continue;
+        }
+        guint32 *row = (guint32 *)(page->getData () +
+                                   y * page->getRowStride ());
+        for ( gint x = TEST_MARGIN ; x < TEST_PAGE_WIDTH - TEST_MARGIN ;
+              x++ )
+        {
+            gint stroke = (x + y * 7) % 11;
+            if ( 3 > stroke )
+            {
+                row[x] = 0xff000000 | (stroke * 0x404040);
+            }
+        }
+    }
+    return page;
+}
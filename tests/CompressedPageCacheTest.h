@@ -0,0 +1,58 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Compressed Page Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__COMPRESSED_PAGE_CACHE_TEST_H__)
+#define __COMPRESSED_PAGE_CACHE_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class CompressedPageCacheTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (CompressedPageCacheTest);
+        CPPUNIT_TEST (emptyCache);
+        CPPUNIT_TEST (takePage);
+        CPPUNIT_TEST (compressWhitePage);
+        CPPUNIT_TEST (evictOldestPage);
+        CPPUNIT_TEST (releasePages);
+        CPPUNIT_TEST (replacePage);
+        CPPUNIT_TEST (clearCache);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void emptyCache (void);
+            void takePage (void);
+            void compressWhitePage (void);
+            void evictOldestPage (void);
+            void releasePages (void);
+            void replacePage (void);
+            void clearCache (void);
+
+        protected:
+            CompressedPageCache *m_Cache;
+    };
+}
+
+#endif // !__COMPRESSED_PAGE_CACHE_TEST_H__
@@ -67,6 +67,8 @@ ConfigTest::defaultValues ()
     CPPUNIT_ASSERT_EQUAL ((gchar *)NULL, config.getSaveFileFolder ());
     CPPUNIT_ASSERT (!config.zoomToWidth ());
     CPPUNIT_ASSERT (!config.zoomToFit ());
+    CPPUNIT_ASSERT (config.autoReload ());
+    CPPUNIT_ASSERT_EQUAL (64, config.getDiskCacheSize ());
 
     gchar *commandLine = config.getExternalBrowserCommandLine ();
     CPPUNIT_ASSERT (0 == g_ascii_strcasecmp ("firefox %s", commandLine));
@@ -201,3 +203,34 @@ ConfigTest::externalBrowser ()
     CPPUNIT_ASSERT ( 0 == g_ascii_strcasecmp ("xterm -e lynx %s", commandLine));
     g_free (commandLine);
 }
+
+///
+/// @brief Checks setting the value for reloading changed documents.
+///
+void
+ConfigTest::autoReload ()
+{
+    Config &config = Config::getConfig ();
+
+    config.setAutoReload (FALSE);
+    CPPUNIT_ASSERT ( !config.autoReload () );
+    config.setAutoReload (TRUE);
+    CPPUNIT_ASSERT ( config.autoReload () );
+}
+
+///
+/// @brief Checks setting the size of the disk cache.
+///
+void
+ConfigTest::diskCacheSize ()
+{
+    Config &config = Config::getConfig ();
+
+    config.setDiskCacheSize (0);
+    CPPUNIT_ASSERT_EQUAL (0, config.getDiskCacheSize ());
+    config.setDiskCacheSize (16);
+    CPPUNIT_ASSERT_EQUAL (16, config.getDiskCacheSize ());
+    // A negative size disables the cache as well.
+    config.setDiskCacheSize (-5);
+    CPPUNIT_ASSERT_EQUAL (0, config.getDiskCacheSize ());
+}
@@ -38,6 +38,8 @@ namespace ePDFView
         CPPUNIT_TEST (saveCurrentFolder);
         CPPUNIT_TEST (zoomValues);
         CPPUNIT_TEST (externalBrowser);
+        CPPUNIT_TEST (autoReload);
+        CPPUNIT_TEST (diskCacheSize);
         CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -52,6 +54,8 @@ namespace ePDFView
             void saveCurrentFolder (void);
             void zoomValues (void);
             void externalBrowser (void);
+            void autoReload (void);
+            void diskCacheSize (void);
     };
 }
 
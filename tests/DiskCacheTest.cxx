@@ -0,0 +1,297 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Disk Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <string.h>
+#include <utime.h>
+#include <glib/gstdio.h>
+#include <epdfview.h>
+#include "DiskCacheTest.h"
+#include "Utils.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (DiskCacheTest);
+
+// Forward declarations.
+static DocumentPage *newTestImage (gint width, gint height, guchar seed);
+
+// Constants.
+/// The document key used by the tests.
+static const gchar *TEST_KEY = "0123456789abcdef";
+
+///
+/// @brief Sets up the environment for each test.
+///
+void
+DiskCacheTest::setUp ()
+{
+    m_Directory = g_dir_make_tmp ("epdfview-cache-XXXXXX", NULL);
+    CPPUNIT_ASSERT (NULL != m_Directory);
+    m_Cache = new DiskCache (m_Directory, 1024 * 1024);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+DiskCacheTest::tearDown ()
+{
+    delete m_Cache;
+    removeDirectory (m_Directory);
+    g_free (m_Directory);
+}
+
+///
+/// @brief Checks that a stored image is read back as it was.
+///
+void
+DiskCacheTest::storeAndLookup ()
+{
+    DocumentPage *image = newTestImage (40, 30, 7);
+    CPPUNIT_ASSERT (m_Cache->store (TEST_KEY, "page-1", image, 1.5, 90));
+    CPPUNIT_ASSERT (0 < m_Cache->getSize ());
+
+    gdouble zoom = 0.0;
+    gint rotation = 0;
+    DocumentPage *cached = m_Cache->lookup (TEST_KEY, "page-1", &zoom,
+                                            &rotation);
+    CPPUNIT_ASSERT (NULL != cached);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (1.5, zoom, 0.0001);
+    CPPUNIT_ASSERT_EQUAL (90, rotation);
+    CPPUNIT_ASSERT_EQUAL (image->getWidth (), cached->getWidth ());
+    CPPUNIT_ASSERT_EQUAL (image->getHeight (), cached->getHeight ());
+    CPPUNIT_ASSERT (0 == memcmp (image->getData (), cached->getData (),
+                                 image->getRowStride () *
+                                 image->getHeight ()));
+    delete cached;
+    delete image;
+}
+
+///
+/// @brief Checks looking up entries that were never stored.
+///
+void
+DiskCacheTest::missingEntry ()
+{
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL));
+
+    DocumentPage *image = newTestImage (10, 10, 1);
+    m_Cache->store (TEST_KEY, "page-1", image, 1.0, 0);
+    delete image;
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-2", NULL, NULL));
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup ("fedcba9876543210", "page-1",
+                                             NULL, NULL));
+}
+
+///
+/// @brief Checks that storing an entry again replaces it.
+///
+void
+DiskCacheTest::replaceEntry ()
+{
+    DocumentPage *image = newTestImage (20, 20, 1);
+    m_Cache->store (TEST_KEY, "page-1", image, 1.0, 0);
+    gsize size = m_Cache->getSize ();
+    delete image;
+    image = newTestImage (20, 20, 2);
+    m_Cache->store (TEST_KEY, "page-1", image, 2.0, 0);
+    CPPUNIT_ASSERT_EQUAL (size, m_Cache->getSize ());
+
+    gdouble zoom = 0.0;
+    DocumentPage *cached = m_Cache->lookup (TEST_KEY, "page-1", &zoom, NULL);
+    CPPUNIT_ASSERT (NULL != cached);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (2.0, zoom, 0.0001);
+    CPPUNIT_ASSERT (0 == memcmp (image->getData (), cached->getData (),
+                                 image->getRowStride () *
+                                 image->getHeight ()));
+    delete cached;
+    delete image;
+}
+
+///
+/// @brief Checks that entries that can't be read back are deleted.
+///
+void
+DiskCacheTest::corruptedEntry ()
+{
+    DocumentPage *image = newTestImage (64, 64, 3);
+    gchar *path = getEntryPath ("page-1");
+    gchar *contents = NULL;
+    gsize length = 0;
+
+    // A truncated entry, as if the disk filled up.
+    m_Cache->store (TEST_KEY, "page-1", image, 1.0, 0);
+    CPPUNIT_ASSERT (g_file_get_contents (path, &contents, &length, NULL));
+    CPPUNIT_ASSERT (g_file_set_contents (path, contents, length / 2, NULL));
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL));
+    CPPUNIT_ASSERT (!g_file_test (path, G_FILE_TEST_EXISTS));
+
+    // A changed byte in the compressed image.
+    m_Cache->store (TEST_KEY, "page-1", image, 1.0, 0);
+    contents[length - 8] ^= 0x5a;
+    CPPUNIT_ASSERT (g_file_set_contents (path, contents, length, NULL));
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL));
+    CPPUNIT_ASSERT (!g_file_test (path, G_FILE_TEST_EXISTS));
+    contents[length - 8] ^= 0x5a;
+
+    // A header with the largest size, but the small image's data.
+    guint32 size[3] = { 16384, 16384, 16384 * 4 };
+    memcpy (contents + 8, size, sizeof (size));
+    CPPUNIT_ASSERT (g_file_set_contents (path, contents, length, NULL));
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL));
+    CPPUNIT_ASSERT (!g_file_test (path, G_FILE_TEST_EXISTS));
+    g_free (contents);
+
+    // Something that is not an entry at all.
+    CPPUNIT_ASSERT (g_file_set_contents (path, "%PDF-1.4", -1, NULL));
+    CPPUNIT_ASSERT (NULL == m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL));
+    CPPUNIT_ASSERT (!g_file_test (path, G_FILE_TEST_EXISTS));
+
+    // The cache still works afterwards.
+    m_Cache->store (TEST_KEY, "page-1", image, 1.0, 0);
+    DocumentPage *cached = m_Cache->lookup (TEST_KEY, "page-1", NULL, NULL);
+    CPPUNIT_ASSERT (NULL != cached);
+    delete cached;
+    g_free (path);
+    delete image;
+}
+
+///
+/// @brief Checks that the least recently used entries are deleted.
+///
+void
+DiskCacheTest::pruneLeastRecentlyUsed ()
+{
+    DocumentPage *image = newTestImage (32, 32, 5);
+    m_Cache->store (TEST_KEY, "a", image, 1.0, 0);
+    gsize entrySize = m_Cache->getSize ();
+    // A cache with room for two entries, that finds the one stored.
+    delete m_Cache;
+    m_Cache = new DiskCache (m_Directory, entrySize * 2 + entrySize / 2);
+    CPPUNIT_ASSERT_EQUAL (entrySize, m_Cache->getSize ());
+
+    m_Cache->store (TEST_KEY, "b", image, 1.0, 0);
+    setUsedTime ("a", 1000);
+    setUsedTime ("b", 2000);
+    // Reading "a" makes "b" the least recently used.
+    DocumentPage *cached = m_Cache->lookup (TEST_KEY, "a", NULL, NULL);
+    CPPUNIT_ASSERT (NULL != cached);
+    delete cached;
+    m_Cache->store (TEST_KEY, "c", image, 1.0, 0);
+
+    CPPUNIT_ASSERT (m_Cache->getSize () <= m_Cache->getBudget ());
+    gchar *path = getEntryPath ("b");
+    CPPUNIT_ASSERT (!g_file_test (path, G_FILE_TEST_EXISTS));
+    g_free (path);
+    cached = m_Cache->lookup (TEST_KEY, "a", NULL, NULL);
+    CPPUNIT_ASSERT (NULL != cached);
+    delete cached;
+    cached = m_Cache->lookup (TEST_KEY, "c", NULL, NULL);
+    CPPUNIT_ASSERT (NULL != cached);
+    delete cached;
+    delete image;
+}
+
+///
+/// @brief Checks the key that tells documents apart.
+///
+void
+DiskCacheTest::documentKey ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "test.pdf", NULL);
+    CPPUNIT_ASSERT (NULL == DiskCache::getDocumentKey (fileName));
+
+    CPPUNIT_ASSERT (g_file_set_contents (fileName, "%PDF-1.4 first", -1,
+                                         NULL));
+    gchar *key = DiskCache::getDocumentKey (fileName);
+    CPPUNIT_ASSERT (NULL != key);
+    gchar *sameKey = DiskCache::getDocumentKey (fileName);
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 (key, sameKey));
+    g_free (sameKey);
+
+    CPPUNIT_ASSERT (g_file_set_contents (fileName, "%PDF-1.4 changed", -1,
+                                         NULL));
+    gchar *changedKey = DiskCache::getDocumentKey (fileName);
+    CPPUNIT_ASSERT (NULL != changedKey);
+    CPPUNIT_ASSERT (0 != g_strcmp0 (key, changedKey));
+    g_free (changedKey);
+    g_free (key);
+    g_free (fileName);
+}
+
+///
+/// @brief Gets the file of an entry with the test key.
+///
+/// @param name The entry's name.
+///
+/// @return The entry's path, that must be freed with g_free().
+///
+gchar *
+DiskCacheTest::getEntryPath (const gchar *name)
+{
+    gchar *fileName = g_strconcat (TEST_KEY, "-", name, ".cache", NULL);
+    gchar *path = g_build_filename (m_Directory, fileName, NULL);
+    g_free (fileName);
+
+    return path;
+}
+
+///
+/// @brief Sets when an entry with the test key was last used.
+///
+/// @param name The entry's name.
+/// @param usedTime The time to set.
+///
+void
+DiskCacheTest::setUsedTime (const gchar *name, time_t usedTime)
+{
+    gchar *path = getEntryPath (name);
+    struct utimbuf times;
+    times.actime = usedTime;
+    times.modtime = usedTime;
+    CPPUNIT_ASSERT_EQUAL (0, g_utime (path, &times));
+    g_free (path);
+}
+
+///
+/// @brief Creates an image with a pattern.
+///
+/// @param width The image's width.
+/// @param height The image's height.
+/// @param seed Changes the pattern.
+///
+/// @return A new image.
+///
+DocumentPage *
+newTestImage (gint width, gint height, guchar seed)
+{
+    DocumentPage *image = new DocumentPage ();
+    image->newPage (width, height);
+    guchar *data = image->getData ();
+    gint size = image->getRowStride () * height;
+    for ( gint byte = 0 ; byte < size ; byte++ )
+    {
+        data[byte] = (guchar)(byte * seed + byte / 7);
+    }
+    return image;
+}
@@ -0,0 +1,61 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Disk Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DISK_CACHE_TEST_H__)
+#define __DISK_CACHE_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class DiskCacheTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (DiskCacheTest);
+        CPPUNIT_TEST (storeAndLookup);
+        CPPUNIT_TEST (missingEntry);
+        CPPUNIT_TEST (replaceEntry);
+        CPPUNIT_TEST (corruptedEntry);
+        CPPUNIT_TEST (pruneLeastRecentlyUsed);
+        CPPUNIT_TEST (documentKey);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void storeAndLookup (void);
+            void missingEntry (void);
+            void replaceEntry (void);
+            void corruptedEntry (void);
+            void pruneLeastRecentlyUsed (void);
+            void documentKey (void);
+
+        protected:
+            DiskCache *m_Cache;
+            gchar *m_Directory;
+
+            gchar *getEntryPath (const gchar *name);
+            void setUsedTime (const gchar *name, time_t usedTime);
+    };
+}
+
+#endif // !__DISK_CACHE_TEST_H__
@@ -0,0 +1,331 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Exporter Test Suite.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "Utils.h"
+#include "DocumentExporterTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (DocumentExporterTest);
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// Loads the five pages test document and creates a directory to
+/// export to.
+///
+void
+DocumentExporterTest::setUp ()
+{
+    m_Directory = g_dir_make_tmp ("epdfview-export-XXXXXX", NULL);
+    CPPUNIT_ASSERT (NULL != m_Directory);
+
+    m_Document = new PDFDocument ();
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    g_free (testFile);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+DocumentExporterTest::tearDown ()
+{
+    delete m_Document;
+    removeDirectory (m_Directory);
+    g_free (m_Directory);
+}
+
+///
+/// @brief Test replacing the page number in the output pattern.
+///
+void
+DocumentExporterTest::formatFileName ()
+{
+    gboolean hasPageNumber = FALSE;
+    gchar *fileName = DocumentExporter::formatFileName ("page-%d.png", 7,
+                                                        &hasPageNumber);
+    CPPUNIT_ASSERT (hasPageNumber);
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 ("page-7.png", fileName));
+    g_free (fileName);
+
+    fileName = DocumentExporter::formatFileName ("%03d-100%%.png", 7,
+                                                 &hasPageNumber);
+    CPPUNIT_ASSERT (hasPageNumber);
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 ("007-100%.png", fileName));
+    g_free (fileName);
+
+    fileName = DocumentExporter::formatFileName ("cover.png", 7,
+                                                 &hasPageNumber);
+    CPPUNIT_ASSERT (!hasPageNumber);
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 ("cover.png", fileName));
+    g_free (fileName);
+}
+
+///
+/// @brief Test validating the page range.
+///
+/// Ranges out of the document's pages or that can't be read must be
+/// refused with an error.
+///
+void
+DocumentExporterTest::pageRange ()
+{
+    DocumentExporter exporter (m_Document);
+    CPPUNIT_ASSERT (exporter.setPageRange ("1-2,5", NULL));
+    CPPUNIT_ASSERT (exporter.setPageRange ("3", NULL));
+
+    const gchar *invalidRanges[] = { "0", "6", "4-2", "1-", "a", "", NULL };
+    for ( const gchar **range = invalidRanges ; NULL != *range ; range++ )
+    {
+        GError *error = NULL;
+        CPPUNIT_ASSERT (!exporter.setPageRange (*range, &error));
+        CPPUNIT_ASSERT (NULL != error);
+        CPPUNIT_ASSERT_EQUAL ((gint)DocumentErrorBadPageNumber,
+                              error->code);
+        g_error_free (error);
+    }
+}
+
+///
+/// @brief Test validating the resolution.
+///
+/// Resolutions the document can't zoom to must be refused, instead of
+/// exporting images of another size.
+///
+void
+DocumentExporterTest::resolution ()
+{
+    DocumentExporter exporter (m_Document);
+    CPPUNIT_ASSERT (exporter.setResolution (7.2, NULL));
+    CPPUNIT_ASSERT (exporter.setResolution (576.0, NULL));
+
+    const gdouble invalidResolutions[] = { -1.0, 0.0, 7.0, 577.0, 1200.0 };
+    for ( guint index = 0 ; index < G_N_ELEMENTS (invalidResolutions) ;
+          index++ )
+    {
+        GError *error = NULL;
+        CPPUNIT_ASSERT (!exporter.setResolution (invalidResolutions[index],
+                                                 &error));
+        CPPUNIT_ASSERT (NULL != error);
+        g_error_free (error);
+    }
+}
+
+///
+/// @brief Test exporting pages as images from several threads.
+///
+/// Only the pages in the range must be written, each to its own file,
+/// with the size given by the resolution.
+///
+void
+DocumentExporterTest::exportImages ()
+{
+    gchar *pattern = g_build_filename (m_Directory, "page-%d.png", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setOutputPattern (pattern);
+    exporter.setNumThreads (3);
+    CPPUNIT_ASSERT (exporter.setResolution (36.0, NULL));
+    CPPUNIT_ASSERT (exporter.setPageRange ("2-5", NULL));
+    CPPUNIT_ASSERT (exporter.exportPages (NULL));
+    CPPUNIT_ASSERT_EQUAL ((guint)4, exporter.getNumPagesExported ());
+
+    for ( gint pageNum = 1 ; pageNum <= 5 ; pageNum++ )
+    {
+        gchar *fileName =
+            DocumentExporter::formatFileName (pattern, pageNum, NULL);
+        CPPUNIT_ASSERT_EQUAL (1 != pageNum,
+                              g_file_test (fileName, G_FILE_TEST_EXISTS));
+        if ( 1 != pageNum )
+        {
+            gdouble pageWidth;
+            gdouble pageHeight;
+            m_Document->getPageSizeForPage (pageNum, &pageWidth,
+                                            &pageHeight);
+            gint width = 0;
+            gint height = 0;
+            CPPUNIT_ASSERT (NULL != gdk_pixbuf_get_file_info (fileName,
+                                                              &width,
+                                                              &height));
+            CPPUNIT_ASSERT_EQUAL ((gint)(pageWidth / 2 + 0.5), width);
+        }
+        g_free (fileName);
+    }
+    g_free (pattern);
+}
+
+///
+/// @brief Test exporting several images to a single file name.
+///
+/// Every page would overwrite the previous one, so it must fail.
+///
+void
+DocumentExporterTest::exportImagesNeedPageNumber ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "page.png", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setOutputPattern (fileName);
+    GError *error = NULL;
+    CPPUNIT_ASSERT (!exporter.exportPages (&error));
+    CPPUNIT_ASSERT (NULL != error);
+    g_error_free (error);
+    CPPUNIT_ASSERT (!g_file_test (fileName, G_FILE_TEST_EXISTS));
+
+    // A single page doesn't need the page number.
+    CPPUNIT_ASSERT (exporter.setPageRange ("4", NULL));
+    CPPUNIT_ASSERT (exporter.exportPages (NULL));
+    CPPUNIT_ASSERT (g_file_test (fileName, G_FILE_TEST_EXISTS));
+    g_free (fileName);
+}
+
+///
+/// @brief Test exporting to a single PDF file.
+///
+/// The exported document must have the pages in the range, in order,
+/// with their original sizes.
+///
+void
+DocumentExporterTest::exportPdf ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "export.pdf", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setFormat (EXPORT_FORMAT_PDF);
+    exporter.setOutputPattern (fileName);
+    CPPUNIT_ASSERT (exporter.setPageRange ("5,1-2", NULL));
+    CPPUNIT_ASSERT (exporter.exportPages (NULL));
+    CPPUNIT_ASSERT_EQUAL ((guint)3, exporter.getNumPagesExported ());
+
+    PDFDocument exported;
+    CPPUNIT_ASSERT (exported.loadFile (fileName, NULL, NULL));
+    CPPUNIT_ASSERT_EQUAL (3, exported.getNumPages ());
+
+    gdouble width;
+    gdouble height;
+    gdouble exportedWidth;
+    gdouble exportedHeight;
+    m_Document->getPageSizeForPage (5, &width, &height);
+    exported.getPageSizeForPage (1, &exportedWidth, &exportedHeight);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (width, exportedWidth, 0.5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (height, exportedHeight, 0.5);
+    g_free (fileName);
+}
+
+///
+/// @brief Test exporting to a single PostScript file.
+///
+/// The file must be a PostScript document, and a file that can't be
+/// written must make the export fail.
+///
+void
+DocumentExporterTest::exportPostscript ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "export.ps", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setFormat (EXPORT_FORMAT_PS);
+    exporter.setOutputPattern (fileName);
+    CPPUNIT_ASSERT (exporter.setPageRange ("1-2", NULL));
+    CPPUNIT_ASSERT (exporter.exportPages (NULL));
+    CPPUNIT_ASSERT_EQUAL ((guint)2, exporter.getNumPagesExported ());
+
+    gchar *contents = NULL;
+    CPPUNIT_ASSERT (g_file_get_contents (fileName, &contents, NULL, NULL));
+    CPPUNIT_ASSERT (g_str_has_prefix (contents, "%!PS"));
+    g_free (contents);
+    g_free (fileName);
+
+    // Every write to /dev/full fails because the device is full.
+    if ( g_file_test ("/dev/full", G_FILE_TEST_EXISTS) )
+    {
+        exporter.setOutputPattern ("/dev/full");
+        GError *error = NULL;
+        CPPUNIT_ASSERT (!exporter.exportPages (&error));
+        CPPUNIT_ASSERT (NULL != error);
+        CPPUNIT_ASSERT_EQUAL ((gint)DocumentErrorFileIO, error->code);
+        g_error_free (error);
+    }
+}
+
+///
+/// @brief Test extracting the text from several threads.
+///
+/// The text must be written in the range's order, each page followed
+/// by a form feed, as if it was extracted by a single thread.
+///
+void
+DocumentExporterTest::exportText ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "export.txt", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setFormat (EXPORT_FORMAT_TEXT);
+    exporter.setOutputPattern (fileName);
+    exporter.setNumThreads (3);
+    CPPUNIT_ASSERT (exporter.setPageRange ("5,1-4", NULL));
+    CPPUNIT_ASSERT (exporter.exportPages (NULL));
+    CPPUNIT_ASSERT_EQUAL ((guint)5, exporter.getNumPagesExported ());
+
+    GString *expected = g_string_new (NULL);
+    const gint pages[] = { 5, 1, 2, 3, 4 };
+    for ( guint page = 0 ; page < G_N_ELEMENTS (pages) ; page++ )
+    {
+        gchar *text = m_Document->getPageText (pages[page]);
+        g_string_append (expected, text);
+        if ( 0 == expected->len || '\n' != expected->str[expected->len - 1] )
+        {
+            g_string_append_c (expected, '\n');
+        }
+        g_string_append_c (expected, '\f');
+        g_free (text);
+    }
+
+    gchar *contents = NULL;
+    CPPUNIT_ASSERT (g_file_get_contents (fileName, &contents, NULL, NULL));
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 (expected->str, contents));
+    g_free (contents);
+    g_string_free (expected, TRUE);
+    g_free (fileName);
+}
+
+///
+/// @brief Test cancelling an export.
+///
+/// The export must fail with G_IO_ERROR_CANCELLED and not leave a
+/// partial file behind.
+///
+void
+DocumentExporterTest::exportCancelled ()
+{
+    gchar *fileName = g_build_filename (m_Directory, "export.txt", NULL);
+    DocumentExporter exporter (m_Document);
+    exporter.setFormat (EXPORT_FORMAT_TEXT);
+    exporter.setOutputPattern (fileName);
+    exporter.cancel ();
+    GError *error = NULL;
+    CPPUNIT_ASSERT (!exporter.exportPages (&error));
+    CPPUNIT_ASSERT (g_error_matches (error, G_IO_ERROR,
+                                     G_IO_ERROR_CANCELLED));
+    g_error_free (error);
+    CPPUNIT_ASSERT (!g_file_test (fileName, G_FILE_TEST_EXISTS));
+    g_free (fileName);
+}
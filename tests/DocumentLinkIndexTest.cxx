@@ -0,0 +1,177 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Link Index Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "DocumentLinkIndexTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (DocumentLinkIndexTest);
+
+///
+/// @brief Sets up the environment for each test.
+///
+void
+DocumentLinkIndexTest::setUp ()
+{
+    m_Index = new DocumentLinkIndex ();
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+DocumentLinkIndexTest::tearDown ()
+{
+    delete m_Index;
+}
+
+///
+/// @brief Checks an index without links.
+///
+void
+DocumentLinkIndexTest::emptyIndex ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Index->getNumLinks ());
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (0, 0, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (-10, 250, 1.0));
+}
+
+///
+/// @brief Checks the bounds of a single link.
+///
+/// A pixel is over the link if any part of it overlaps the link's
+/// rectangle, just like IDocumentLink::positionIsOver().
+///
+void
+DocumentLinkIndexTest::singleLink ()
+{
+    IDocumentLink *link = new DocumentLinkGoto (10.5, 20.5, 30.5, 40.5, 2);
+    m_Index->addLink (link);
+
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Index->getNumLinks ());
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (10, 20, 1.0));
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (20, 30, 1.0));
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (30, 40, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (9, 30, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (31, 30, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (20, 19, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (20, 41, 1.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (500, 500, 1.0));
+}
+
+///
+/// @brief Checks a link on a scaled page.
+///
+/// The links are kept unscaled and the scale is applied on each query.
+///
+void
+DocumentLinkIndexTest::scaledLink ()
+{
+    IDocumentLink *link = new DocumentLinkGoto (10.0, 20.0, 30.0, 40.0, 2);
+    m_Index->addLink (link);
+
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (20, 40, 2.0));
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (60, 80, 2.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (19, 40, 2.0));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (61, 40, 2.0));
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (5, 10, 0.5));
+    CPPUNIT_ASSERT (link == m_Index->getLinkAtPosition (15, 20, 0.5));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (4, 10, 0.5));
+    CPPUNIT_ASSERT (NULL == m_Index->getLinkAtPosition (15, 21, 0.5));
+}
+
+///
+/// @brief Checks that the last added link wins when they overlap.
+///
+void
+DocumentLinkIndexTest::overlappingLinks ()
+{
+    IDocumentLink *bottom = new DocumentLinkGoto (0, 0, 100, 100, 1);
+    IDocumentLink *top = new DocumentLinkGoto (40, 40, 60, 60, 2);
+    m_Index->addLink (bottom);
+    m_Index->addLink (top);
+
+    CPPUNIT_ASSERT (bottom == m_Index->getLinkAtPosition (10, 10, 1.0));
+    CPPUNIT_ASSERT (top == m_Index->getLinkAtPosition (50, 50, 1.0));
+    CPPUNIT_ASSERT (bottom == m_Index->getLinkAtPosition (90, 90, 1.0));
+
+    // Adding links after a query must rebuild the index.
+    IDocumentLink *other = new DocumentLinkGoto (200, 200, 220, 220, 3);
+    m_Index->addLink (other);
+    CPPUNIT_ASSERT (other == m_Index->getLinkAtPosition (210, 210, 1.0));
+    CPPUNIT_ASSERT (top == m_Index->getLinkAtPosition (50, 50, 1.0));
+}
+
+///
+/// @brief Checks the index against a linear search with many links.
+///
+void
+DocumentLinkIndexTest::manyLinks ()
+{
+    const gint numColumns = 30;
+    const gint numRows = 40;
+    IDocumentLink *links[numColumns * numRows];
+    for ( gint row = 0 ; row < numRows ; row++ )
+    {
+        for ( gint column = 0 ; column < numColumns ; column++ )
+        {
+            // Leave a gap of 4 units between each link.
+            gdouble x = column * 20.0;
+            gdouble y = row * 15.0;
+            IDocumentLink *link =
+                new DocumentLinkGoto (x, y, x + 15.0, y + 10.0, 1);
+            links[row * numColumns + column] = link;
+            m_Index->addLink (link);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL ((guint)(numColumns * numRows),
+                          m_Index->getNumLinks ());
+
+    const gdouble scales[] = { 0.5, 1.0, 2.3 };
+    for ( guint scaleIndex = 0 ; scaleIndex < G_N_ELEMENTS (scales) ;
+          scaleIndex++ )
+    {
+        gdouble scale = scales[scaleIndex];
+        gint width = (gint)(numColumns * 20 * scale);
+        gint height = (gint)(numRows * 15 * scale);
+        for ( gint y = -5 ; y < height + 5 ; y += 3 )
+        {
+            for ( gint x = -5 ; x < width + 5 ; x += 3 )
+            {
+                IDocumentLink *expected = NULL;
+                for ( gint linkIndex = 0 ;
+                      linkIndex < numColumns * numRows ;
+                      linkIndex++ )
+                {
+                    if ( links[linkIndex]->positionIsOver (x, y, scale) )
+                    {
+                        expected = links[linkIndex];
+                    }
+                }
+                CPPUNIT_ASSERT (expected ==
+                                m_Index->getLinkAtPosition (x, y, scale));
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Link Index Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__DOCUMENT_LINK_INDEX_TEST_H__)
+#define __DOCUMENT_LINK_INDEX_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class DocumentLinkIndexTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (DocumentLinkIndexTest);
+        CPPUNIT_TEST (emptyIndex);
+        CPPUNIT_TEST (singleLink);
+        CPPUNIT_TEST (scaledLink);
+        CPPUNIT_TEST (overlappingLinks);
+        CPPUNIT_TEST (manyLinks);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void emptyIndex (void);
+            void singleLink (void);
+            void scaledLink (void);
+            void overlappingLinks (void);
+            void manyLinks (void);
+
+        protected:
+            DocumentLinkIndex *m_Index;
+    };
+}
+
+#endif // !__DOCUMENT_LINK_INDEX_TEST_H__
@@ -0,0 +1,163 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Outline Index Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "DocumentOutlineIndexTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (DocumentOutlineIndexTest);
+
+///
+/// @brief Sets up the environment for each test.
+///
+void
+DocumentOutlineIndexTest::setUp ()
+{
+    m_Outline = new DocumentOutline ();
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+DocumentOutlineIndexTest::tearDown ()
+{
+    delete m_Outline;
+}
+
+///
+/// @brief Adds a new item to an outline.
+///
+/// @param parent The outline to add the item to.
+/// @param title The item's title.
+/// @param page The page the item goes to.
+///
+/// @return The new item, owned by @a parent.
+///
+DocumentOutline *
+DocumentOutlineIndexTest::addItem (DocumentOutline *parent,
+                                   const gchar *title, gint page)
+{
+    DocumentOutline *item = new DocumentOutline ();
+    item->setParent (parent);
+    item->setTitle (title);
+    item->setDestination (page);
+    parent->addChild (item);
+    return item;
+}
+
+///
+/// @brief Checks an index of an outline without items.
+///
+void
+DocumentOutlineIndexTest::emptyOutline ()
+{
+    DocumentOutlineIndex index (m_Outline);
+    CPPUNIT_ASSERT_EQUAL ((guint)0, index.getNumEntries ());
+    CPPUNIT_ASSERT (NULL == index.findSection (1));
+    CPPUNIT_ASSERT (NULL == index.findSection (100));
+}
+
+///
+/// @brief Checks finding the section of nested outline items.
+///
+/// The outline is:
+///
+///  +- Chapter 1 / page 3
+///  |  |
+///  |  +- Section 1.1 / page 3
+///  |  |
+///  |  +- Section 1.2 / page 5
+///  |
+///  +- Chapter 2 / page 8
+///
+void
+DocumentOutlineIndexTest::nestedSections ()
+{
+    DocumentOutline *chapter1 = addItem (m_Outline, "Chapter 1", 3);
+    DocumentOutline *section11 = addItem (chapter1, "Section 1.1", 3);
+    DocumentOutline *section12 = addItem (chapter1, "Section 1.2", 5);
+    DocumentOutline *chapter2 = addItem (m_Outline, "Chapter 2", 8);
+
+    DocumentOutlineIndex index (m_Outline);
+    CPPUNIT_ASSERT_EQUAL ((guint)4, index.getNumEntries ());
+    // Before the first chapter there's no section.
+    CPPUNIT_ASSERT (NULL == index.findSection (1));
+    CPPUNIT_ASSERT (NULL == index.findSection (2));
+    // The chapter and its first section start at the same page, the
+    // section is the deepest one.
+    CPPUNIT_ASSERT (section11 == index.findSection (3));
+    CPPUNIT_ASSERT (section11 == index.findSection (4));
+    CPPUNIT_ASSERT (section12 == index.findSection (5));
+    CPPUNIT_ASSERT (section12 == index.findSection (7));
+    CPPUNIT_ASSERT (chapter2 == index.findSection (8));
+    CPPUNIT_ASSERT (chapter2 == index.findSection (100));
+}
+
+///
+/// @brief Checks an outline whose items don't follow the page order.
+///
+void
+DocumentOutlineIndexTest::unsortedOutline ()
+{
+    DocumentOutline *appendix = addItem (m_Outline, "Appendix", 20);
+    DocumentOutline *contents = addItem (m_Outline, "Contents", 2);
+    DocumentOutline *chapter = addItem (m_Outline, "Chapter", 10);
+
+    DocumentOutlineIndex index (m_Outline);
+    CPPUNIT_ASSERT (NULL == index.findSection (1));
+    CPPUNIT_ASSERT (contents == index.findSection (2));
+    CPPUNIT_ASSERT (contents == index.findSection (9));
+    CPPUNIT_ASSERT (chapter == index.findSection (10));
+    CPPUNIT_ASSERT (chapter == index.findSection (19));
+    CPPUNIT_ASSERT (appendix == index.findSection (20));
+}
+
+///
+/// @brief Checks an outline with lots of items.
+///
+/// Each page from 1 to 1000 has a chapter with two sections, so all
+/// of the index's entries are checked.
+///
+void
+DocumentOutlineIndexTest::manySections ()
+{
+    const gint numPages = 1000;
+    GPtrArray *lastSections = g_ptr_array_new ();
+    for ( gint page = 1 ; page <= numPages ; page++ )
+    {
+        DocumentOutline *chapter = addItem (m_Outline, "Chapter", page);
+        addItem (chapter, "First", page);
+        g_ptr_array_add (lastSections, addItem (chapter, "Second", page));
+    }
+
+    DocumentOutlineIndex index (m_Outline);
+    CPPUNIT_ASSERT_EQUAL ((guint)(numPages * 3), index.getNumEntries ());
+    for ( gint page = 1 ; page <= numPages ; page++ )
+    {
+        CPPUNIT_ASSERT (g_ptr_array_index (lastSections, page - 1) ==
+                        index.findSection (page));
+    }
+    g_ptr_array_free (lastSections, TRUE);
+}
@@ -97,12 +97,17 @@ DocumentOutlineTest::noOutline ()
 ///     |
 ///     + First Section / page 5
 ///
+/// The outline is empty until it's read after the load, as JobLoadOutline
+/// does.
+///
 void
 DocumentOutlineTest::hasOutline ()
 {
     gchar *testFile = getTestFile ("test1.pdf");
     CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
     CPPUNIT_ASSERT (m_Document->isLoaded ());
+    CPPUNIT_ASSERT_EQUAL (0, m_Document->getOutline ()->getNumChildren ());
+    m_Document->notifyOutlineLoaded (m_Document->loadOutline ());
     DocumentOutline *outline = m_Document->getOutline ();
     CPPUNIT_ASSERT ( NULL != outline );
     // The root outline must be the same empty one, except it has children.
@@ -153,3 +158,48 @@ DocumentOutlineTest::hasOutline ()
 
     g_free (testFile);
 }
+
+///
+/// @brief Test that the outline's children are read on demand.
+///
+/// Using the same document as hasOutline(), each item must tell if it
+/// has children before reading them, and getChild() must not change
+/// which child getNextChild() returns.
+///
+void
+DocumentOutlineTest::lazyChildren ()
+{
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    DocumentOutline *outline = m_Document->loadOutline ();
+    CPPUNIT_ASSERT ( NULL != outline );
+    CPPUNIT_ASSERT (outline->hasChildren ());
+
+    DocumentOutline *first = outline->getFirstChild ();
+    CPPUNIT_ASSERT ( NULL != first );
+    CPPUNIT_ASSERT (!first->hasChildren ());
+
+    DocumentOutline *chapter = outline->getChild (2);
+    CPPUNIT_ASSERT ( NULL != chapter );
+    CPPUNIT_ASSERT (chapter->hasChildren ());
+    CPPUNIT_ASSERT_EQUAL (0,
+                          g_ascii_strcasecmp ("Chapter 1. First Chapter",
+                                              chapter->getTitle ()));
+    CPPUNIT_ASSERT (NULL == outline->getChild (3));
+    CPPUNIT_ASSERT (NULL == outline->getChild (-1));
+
+    // getChild() didn't move the iteration.
+    DocumentOutline *second = outline->getNextChild ();
+    CPPUNIT_ASSERT ( NULL != second );
+    CPPUNIT_ASSERT_EQUAL (0, g_ascii_strcasecmp ("Table of Contents",
+                                                 second->getTitle ()));
+
+    DocumentOutline *section = chapter->getChild (0);
+    CPPUNIT_ASSERT ( NULL != section );
+    CPPUNIT_ASSERT (!section->hasChildren ());
+    CPPUNIT_ASSERT_EQUAL (5, section->getDestinationPage ());
+    CPPUNIT_ASSERT (chapter->hasChildren ());
+
+    delete outline;
+    g_free (testFile);
+}
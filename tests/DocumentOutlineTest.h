@@ -33,6 +33,7 @@ namespace ePDFView
         CPPUNIT_TEST (initialStatus);
         CPPUNIT_TEST (noOutline);
         CPPUNIT_TEST (hasOutline);
+        CPPUNIT_TEST (lazyChildren);
         CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -42,6 +43,7 @@ namespace ePDFView
             void initialStatus (void);
             void noOutline (void);
             void hasOutline (void);
+            void lazyChildren (void);
 
         protected:
             PDFDocument *m_Document;
@@ -0,0 +1,148 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Text Layout Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <epdfview.h>
+#include "DocumentTextLayoutTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (DocumentTextLayoutTest);
+
+// Constants.
+/// The width and height of each test glyph.
+static const gdouble GLYPH_SIZE = 10.0;
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// The layout has two lines, "Hello" and "World", each glyph being
+/// GLYPH_SIZE wide and tall and the lines GLYPH_SIZE apart.
+///
+void
+DocumentTextLayoutTest::setUp ()
+{
+    m_Layout = new DocumentTextLayout ("Hello\nWorld");
+    for ( gint glyph = 0 ; glyph < 5 ; glyph++ )
+    {
+        m_Layout->addGlyph (glyph * GLYPH_SIZE, 0,
+                            (glyph + 1) * GLYPH_SIZE, GLYPH_SIZE);
+    }
+    // The line break has no width.
+    m_Layout->addGlyph (5 * GLYPH_SIZE, 0, 5 * GLYPH_SIZE, GLYPH_SIZE);
+    for ( gint glyph = 0 ; glyph < 5 ; glyph++ )
+    {
+        m_Layout->addGlyph (glyph * GLYPH_SIZE, 2 * GLYPH_SIZE,
+                            (glyph + 1) * GLYPH_SIZE, 3 * GLYPH_SIZE);
+    }
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+DocumentTextLayoutTest::tearDown ()
+{
+    delete m_Layout;
+}
+
+///
+/// @brief Checks a page without text.
+///
+void
+DocumentTextLayoutTest::emptyLayout ()
+{
+    DocumentTextLayout layout (NULL);
+    CPPUNIT_ASSERT_EQUAL ((guint)0, layout.getNumGlyphs ());
+    CPPUNIT_ASSERT (NULL == layout.getSelectionText (0, 0, 100, 100));
+    cairo_region_t *region = layout.getSelectionRegion (0, 0, 100, 100, 1.0);
+    CPPUNIT_ASSERT (cairo_region_is_empty (region));
+    cairo_region_destroy (region);
+}
+
+///
+/// @brief Checks a selection inside a single line.
+///
+void
+DocumentTextLayoutTest::singleLineSelection ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)11, m_Layout->getNumGlyphs ());
+
+    // From before the middle of `e' to after the middle of the second `l'.
+    gchar *text = m_Layout->getSelectionText (12, 5, 38, 5);
+    CPPUNIT_ASSERT (0 == g_strcmp0 ("ell", text));
+    g_free (text);
+
+    cairo_region_t *region = m_Layout->getSelectionRegion (12, 5, 38, 5, 2.0);
+    CPPUNIT_ASSERT_EQUAL (1, cairo_region_num_rectangles (region));
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle (region, 0, &rect);
+    CPPUNIT_ASSERT_EQUAL (20, rect.x);
+    CPPUNIT_ASSERT_EQUAL (0, rect.y);
+    CPPUNIT_ASSERT_EQUAL (60, rect.width);
+    CPPUNIT_ASSERT_EQUAL (20, rect.height);
+    cairo_region_destroy (region);
+
+    // Not passing the middle of any glyph selects nothing.
+    CPPUNIT_ASSERT (NULL == m_Layout->getSelectionText (12, 5, 14, 5));
+}
+
+///
+/// @brief Checks a selection that spans two lines.
+///
+void
+DocumentTextLayoutTest::multiLineSelection ()
+{
+    gchar *text = m_Layout->getSelectionText (12, 5, 18, 25);
+    CPPUNIT_ASSERT (0 == g_strcmp0 ("ello\nWo", text));
+    g_free (text);
+
+    cairo_region_t *region = m_Layout->getSelectionRegion (12, 5, 18, 25, 1.0);
+    CPPUNIT_ASSERT (cairo_region_contains_point (region, 15, 5));
+    CPPUNIT_ASSERT (cairo_region_contains_point (region, 45, 5));
+    CPPUNIT_ASSERT (cairo_region_contains_point (region, 5, 25));
+    CPPUNIT_ASSERT (cairo_region_contains_point (region, 15, 25));
+    CPPUNIT_ASSERT (!cairo_region_contains_point (region, 5, 5));
+    CPPUNIT_ASSERT (!cairo_region_contains_point (region, 25, 25));
+    CPPUNIT_ASSERT (!cairo_region_contains_point (region, 15, 15));
+    cairo_region_destroy (region);
+}
+
+///
+/// @brief Checks that dragging backwards selects the same text.
+///
+void
+DocumentTextLayoutTest::reversedSelection ()
+{
+    gchar *forward = m_Layout->getSelectionText (12, 5, 18, 25);
+    gchar *backward = m_Layout->getSelectionText (18, 25, 12, 5);
+    CPPUNIT_ASSERT (0 == g_strcmp0 (forward, backward));
+    g_free (forward);
+    g_free (backward);
+
+    cairo_region_t *forwardRegion =
+        m_Layout->getSelectionRegion (12, 5, 18, 25, 1.5);
+    cairo_region_t *backwardRegion =
+        m_Layout->getSelectionRegion (18, 25, 12, 5, 1.5);
+    CPPUNIT_ASSERT (cairo_region_equal (forwardRegion, backwardRegion));
+    cairo_region_destroy (forwardRegion);
+    cairo_region_destroy (backwardRegion);
+}
@@ -0,0 +1,52 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Document Text Layout Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#if !defined (__DOCUMENT_TEXT_LAYOUT_TEST_H__)
+#define __DOCUMENT_TEXT_LAYOUT_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class DocumentTextLayoutTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (DocumentTextLayoutTest);
+        CPPUNIT_TEST (emptyLayout);
+        CPPUNIT_TEST (singleLineSelection);
+        CPPUNIT_TEST (multiLineSelection);
+        CPPUNIT_TEST (reversedSelection);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void emptyLayout (void);
+            void singleLineSelection (void);
+            void multiLineSelection (void);
+            void reversedSelection (void);
+
+        protected:
+            DocumentTextLayout *m_Layout;
+    };
+}
+
+#endif // !__DOCUMENT_TEXT_LAYOUT_TEST_H__
@@ -20,6 +20,7 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
+#include <unistd.h>
 #include <epdfview.h>
 #include "DumbDocument.h"
 
@@ -41,6 +42,7 @@ DumbDocument::DumbDocument ():
 
 DumbDocument::~DumbDocument ()
 {
+    stopJobs ();
     clearCache ();
     g_free (m_SavedFileName);
     g_free (m_TestPassword);
@@ -52,7 +54,7 @@ DumbDocument::copy () const
     return new DumbDocument ();
 }
 
-GList *
+GArray *
 DumbDocument::findTextInPage (gint pageNum, const gchar *textToFind)
 {
     return NULL;
@@ -91,6 +93,27 @@ DumbDocument::loadFile (const gchar *filename, const gchar *password,
     return m_Loaded;
 }
 
+void
+DumbDocument::getPageLinks (gint pageNum, DocumentLinkIndex *links)
+{
+}
+
+DocumentOutline *
+DumbDocument::loadOutline (void)
+{
+    return NULL;
+}
+
+void
+DumbDocument::loadPageFingerprint (gint pageNum)
+{
+}
+
+void
+DumbDocument::loadPageSizes (void)
+{
+}
+
 void
 DumbDocument::getPageSizeForPage (gint pageNum, gdouble *width, gdouble *height)
 {
@@ -107,9 +130,10 @@ DumbDocument::getPageSizeForPage (gint pageNum, gdouble *width, gdouble *height)
 }
 
 void
-DumbDocument::outputPostscriptBegin (const gchar *fileName, guint numberOfPages,
+DumbDocument::outputPostscriptBegin (gint fd, guint numberOfPages,
                                      gfloat pageWidth, gfloat pageHeight)
 {
+    close (fd);
 }
 
 void
@@ -122,12 +146,31 @@ DumbDocument::outputPostscriptPage (guint pageNumber)
 {
 }
 
+gchar *
+DumbDocument::getPageText (gint pageNum)
+{
+    return g_strdup_printf ("Page %d\n", pageNum);
+}
+
 DocumentPage *
 DumbDocument::renderPage (gint pageNum)
 {
     return new DocumentPage ();
 }
 
+void
+DumbDocument::renderPageForPrinting (gint pageNum, cairo_t *context)
+{
+}
+
+DocumentPage *
+DumbDocument::renderThumbnail (gint pageNum, gint size)
+{
+    DocumentPage *thumbnail = new DocumentPage ();
+    thumbnail->newPage (size, size);
+    return thumbnail;
+}
+
 gboolean
 DumbDocument::saveFile (const gchar *fileName, GError **error)
 {
@@ -140,6 +183,12 @@ DumbDocument::saveFile (const gchar *fileName, GError **error)
 // Tests Methods
 ////////////////////////////////////////////////////////////////
 
+void
+DumbDocument::addThumbnail (gint pageNum, DocumentPage *thumbnail)
+{
+    m_Thumbnails->add (pageNum, thumbnail);
+}
+
 const gchar *
 DumbDocument::getSavedFileName ()
 {
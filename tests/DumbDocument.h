@@ -33,19 +33,27 @@ namespace ePDFView
 
             // Interface methods.
             IDocument *copy (void) const;
-            GList *findTextInPage (gint pageNum, const gchar *text);
+            GArray *findTextInPage (gint pageNum, const gchar *text);
             gboolean isLoaded (void);
             gboolean loadFile (const gchar *filename, const gchar *password,
                                GError **error);
+            void getPageLinks (gint pageNum, DocumentLinkIndex *links);
+            DocumentOutline *loadOutline (void);
+            void loadPageFingerprint (gint pageNum);
+            void loadPageSizes (void);
             void getPageSizeForPage (gint pageNum, gdouble *width,
                                      gdouble *height);
-            void outputPostscriptBegin (const gchar *fileName, guint numberOfPages, gfloat pageWidth, gfloat pageHeight);
+            void outputPostscriptBegin (gint fd, guint numberOfPages, gfloat pageWidth, gfloat pageHeight);
             void outputPostscriptEnd (void);
             void outputPostscriptPage (guint pageNumber);
+            gchar *getPageText (gint pageNum);
             DocumentPage *renderPage (gint pageNum);
+            void renderPageForPrinting (gint pageNum, cairo_t *context);
+            DocumentPage *renderThumbnail (gint pageNum, gint size);
             gboolean saveFile (const gchar *fileName, GError **error);
 
             // Test functions.
+            void addThumbnail (gint pageNum, DocumentPage *thumbnail);
             const gchar *getSavedFileName (void);
             void setOpenError (DocumentError error);
             void setOutline (DocumentOutline *outline);
@@ -23,6 +23,7 @@
 #include <epdfview.h>
 #include "DumbDocumentObserver.h"
 
+G_LOCK_DEFINE_STATIC (Printing);
 G_LOCK_DEFINE_STATIC (Searching);
 
 using namespace ePDFView;
@@ -36,9 +37,15 @@ DumbDocumentObserver::DumbDocumentObserver ():
     m_NotifiedError = FALSE;
     m_NotifiedPassword = FALSE;
     m_NotifiedLoad = FALSE;
+    m_NotifiedLowMemory = FALSE;
     m_NotifiedPageRotated = FALSE;
     m_NotifiedPageZoomed = FALSE;
     m_NotifiedReload = FALSE;
+    G_LOCK (Printing);
+    m_NotifiedPrint = FALSE;
+    m_NotifiedPrintError = FALSE;
+    m_NumPagesPrinted = 0;
+    G_UNLOCK (Printing);
     G_LOCK (Searching);
     m_Searching = FALSE;
     G_UNLOCK (Searching);
@@ -99,6 +106,12 @@ DumbDocumentObserver::notifyLoadPassword (const gchar *fileName,
     m_NotifiedPassword = TRUE;
 }
 
+void
+DumbDocumentObserver::notifyLowMemory ()
+{
+    m_NotifiedLowMemory = TRUE;
+}
+
 void
 DumbDocumentObserver::notifyPageChanged (gint pageNum)
 {
@@ -118,6 +131,31 @@ DumbDocumentObserver::notifyPageZoomed (gdouble zoom)
     m_Zoom = zoom;
 }
 
+void
+DumbDocumentObserver::notifyPrint ()
+{
+    G_LOCK (Printing);
+    m_NotifiedPrint = TRUE;
+    G_UNLOCK (Printing);
+}
+
+void
+DumbDocumentObserver::notifyPrintError (const GError *error)
+{
+    G_LOCK (Printing);
+    m_NotifiedPrintError = TRUE;
+    G_UNLOCK (Printing);
+}
+
+void
+DumbDocumentObserver::notifyPrintProgress (guint numPagesPrinted,
+                                           guint numPagesToPrint)
+{
+    G_LOCK (Printing);
+    m_NumPagesPrinted = numPagesPrinted;
+    G_UNLOCK (Printing);
+}
+
 void
 DumbDocumentObserver::notifyReload (void)
 {
@@ -146,6 +184,15 @@ DumbDocumentObserver::getLoadError (void)
     return m_Error;
 }
 
+guint
+DumbDocumentObserver::getNumPagesPrinted (void)
+{
+    G_LOCK (Printing);
+    guint numPagesPrinted = m_NumPagesPrinted;
+    G_UNLOCK (Printing);
+    return numPagesPrinted;
+}
+
 gdouble
 DumbDocumentObserver::getZoom (void)
 {
@@ -184,6 +231,14 @@ DumbDocumentObserver::notifiedLoaded (void)
     return notified;
 }
 
+gboolean
+DumbDocumentObserver::notifiedLowMemory (void)
+{
+    gboolean notified = m_NotifiedLowMemory;
+    m_NotifiedLowMemory = FALSE;
+    return notified;
+}
+
 gboolean
 DumbDocumentObserver::notifiedPassword (void)
 {
@@ -192,6 +247,16 @@ DumbDocumentObserver::notifiedPassword (void)
     return notified;
 }
 
+gboolean
+DumbDocumentObserver::notifiedPrintError (void)
+{
+    G_LOCK (Printing);
+    gboolean notified = m_NotifiedPrintError;
+    m_NotifiedPrintError = FALSE;
+    G_UNLOCK (Printing);
+    return notified;
+}
+
 gboolean
 DumbDocumentObserver::notifiedRotation (void)
 {
@@ -208,6 +273,15 @@ DumbDocumentObserver::notifiedZoom (void)
     return notified;
 }
 
+gboolean
+DumbDocumentObserver::printFinished (void)
+{
+    G_LOCK (Printing);
+    gboolean finished = m_NotifiedPrint || m_NotifiedPrintError;
+    G_UNLOCK (Printing);
+    return finished;
+}
+
 void
 DumbDocumentObserver::setLoadError (const GError *error)
 {
@@ -38,23 +38,32 @@ namespace ePDFView
             void notifyLoadError (const GError *error);
             void notifyLoadPassword (const gchar *fileName, gboolean reload,
                                      const GError *error);
+            void notifyLowMemory (void);
             void notifyPageChanged (gint pageNum);
             void notifyPageRotated (gint rotation);
             void notifyPageZoomed (gdouble zoom);
+            void notifyPrint (void);
+            void notifyPrintError (const GError *error);
+            void notifyPrintProgress (guint numPagesPrinted,
+                                      guint numPagesToPrint);
             void notifyReload (void);
 
             // Functions for test only purposes.
             gint getCurrentPage (void);
             DocumentRectangle *getFindMatchRect (void);
             const GError *getLoadError (void);
+            guint getNumPagesPrinted (void);
             gdouble getZoom (void);
             gboolean isStillSearching (void);
             gboolean loadFinished (void);
             gboolean notifiedError (void);
             gboolean notifiedLoaded (void);
+            gboolean notifiedLowMemory (void);
             gboolean notifiedPassword (void);
+            gboolean notifiedPrintError (void);
             gboolean notifiedRotation (void);
             gboolean notifiedZoom (void);
+            gboolean printFinished (void);
             void setLoadError (const GError *error);
 
         protected:
@@ -63,10 +72,14 @@ namespace ePDFView
             DocumentRectangle *m_FindMatchRect;
             gboolean m_NotifiedError;
             gboolean m_NotifiedLoad;
+            gboolean m_NotifiedLowMemory;
             gboolean m_NotifiedPassword;
             gboolean m_NotifiedPageRotated;
             gboolean m_NotifiedPageZoomed;
+            volatile gboolean m_NotifiedPrint;
+            volatile gboolean m_NotifiedPrintError;
             gboolean m_NotifiedReload;
+            volatile guint m_NumPagesPrinted;
             volatile gboolean m_Searching;
             gdouble m_Zoom;
     };
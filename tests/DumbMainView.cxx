@@ -44,6 +44,10 @@ DumbMainView::DumbMainView (MainPter *pter):
     m_LastOpenFileFolder = NULL;
     m_LastSaveFileFolder = NULL;
     m_Outline = NULL;
+    m_SelectedOutline = NULL;
+    m_NumThumbnails = 0;
+    m_SelectedThumbnail = 0;
+    m_ShownThumbnail = 0;
     m_PageView = new DumbPageView ();
     m_Password = NULL;
     m_SaveFileName = g_strdup ("");
@@ -58,6 +62,7 @@ DumbMainView::DumbMainView (MainPter *pter):
     m_SensitiveRotateLeft = TRUE;
     m_SensitiveRotateRight = TRUE;
     m_SensitiveSave = TRUE;
+    m_SensitiveSaveText = TRUE;
     m_SensitiveZoom = TRUE;
     m_SensitiveZoomIn = TRUE;
     m_SensitiveZoomOut = TRUE;
@@ -67,6 +72,7 @@ DumbMainView::DumbMainView (MainPter *pter):
     m_ShownError = FALSE;
     m_ShownIndex = FALSE;
     m_ShownStatusbar = FALSE;
+    m_ShownThumbnails = FALSE;
     m_ShownToolbar = FALSE;
     m_Title = g_strdup ("");
     m_TimesShownPassword = 0;
@@ -152,6 +158,15 @@ DumbMainView::saveFileDialog (const gchar *lastFolder)
     return g_strdup (m_SaveFileName);
 }
 
+gchar *
+DumbMainView::saveTextFileDialog (const gchar *lastFolder,
+                                  const gchar *fileName)
+{
+    g_free (m_LastSaveFileFolder);
+    m_LastSaveFileFolder = g_strdup (lastFolder);
+    return g_strdup (m_SaveFileName);
+}
+
 void
 DumbMainView::sensitiveGoToFirstPage (gboolean sensitive)
 {
@@ -223,6 +238,12 @@ DumbMainView::sensitiveSave (gboolean sensitive)
     m_SensitiveSave = sensitive;
 }
 
+void
+DumbMainView::sensitiveSaveText (gboolean sensitive)
+{
+    m_SensitiveSaveText = sensitive;
+}
+
 void
 DumbMainView::sensitiveZoom (gboolean sensitive)
 {
@@ -301,6 +322,39 @@ void
 DumbMainView::setOutline (DocumentOutline *outline)
 {
     m_Outline = outline;
+    m_SelectedOutline = NULL;
+}
+
+void
+DumbMainView::selectOutline (DocumentOutline *outline)
+{
+    m_SelectedOutline = outline;
+}
+
+void
+DumbMainView::setThumbnails (gint numPages)
+{
+    m_NumThumbnails = numPages;
+    m_SelectedThumbnail = 0;
+    m_ShownThumbnail = 0;
+}
+
+void
+DumbMainView::showThumbnail (gint pageNum, DocumentPage *thumbnail)
+{
+    m_ShownThumbnail = pageNum;
+}
+
+void
+DumbMainView::selectThumbnail (gint pageNum)
+{
+    m_SelectedThumbnail = pageNum;
+}
+
+void
+DumbMainView::showThumbnails (gboolean show)
+{
+    m_ShownThumbnails = show;
 }
 
 void
@@ -380,6 +434,30 @@ DumbMainView::getOutline ()
     return m_Outline;
 }
 
+DocumentOutline *
+DumbMainView::getSelectedOutline ()
+{
+    return m_SelectedOutline;
+}
+
+gint
+DumbMainView::getSelectedThumbnail ()
+{
+    return m_SelectedThumbnail;
+}
+
+gint
+DumbMainView::getShownThumbnail ()
+{
+    return m_ShownThumbnail;
+}
+
+gint
+DumbMainView::getNumThumbnails ()
+{
+    return m_NumThumbnails;
+}
+
 const gchar *
 DumbMainView::getTitle ()
 {
@@ -452,6 +530,12 @@ DumbMainView::isSensitiveSave ()
     return m_SensitiveSave;
 }
 
+gboolean
+DumbMainView::isSensitiveSaveText ()
+{
+    return m_SensitiveSaveText;
+}
+
 gboolean
 DumbMainView::isSensitiveZoom ()
 {
@@ -500,6 +584,12 @@ DumbMainView::isShownStatusbar ()
     return m_ShownStatusbar;
 }
 
+gboolean
+DumbMainView::isShownThumbnails ()
+{
+    return m_ShownThumbnails;
+}
+
 gboolean
 DumbMainView::isShownToolbar ()
 {
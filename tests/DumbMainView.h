@@ -48,6 +48,8 @@ namespace ePDFView
             gchar *openFileDialog (const gchar *lastFolder);
             gchar *promptPasswordDialog (void);
             char *saveFileDialog (const gchar *lastFolder);
+            gchar *saveTextFileDialog (const gchar *lastFolder,
+                                       const gchar *fileName);
             void sensitiveFind (gboolean sensitive);
             void sensitiveGoToFirstPage (gboolean sensitive);
             void sensitiveGoToLastPage (gboolean sensitive);
@@ -60,6 +62,7 @@ namespace ePDFView
             void sensitiveRotateLeft (gboolean sensitive);
             void sensitiveRotateRight (gboolean sensitive);
             void sensitiveSave (gboolean sensitive);
+            void sensitiveSaveText (gboolean sensitive);
             void sensitiveZoom (gboolean sensitive);
             void sensitiveZoomIn (gboolean sensitive);
             void sensitiveZoomOut (gboolean sensitive);
@@ -72,6 +75,11 @@ namespace ePDFView
             void setGoToPageText (const gchar *text);
             void setTitle (const gchar *title);
             void setOutline (DocumentOutline *outline);
+            void selectOutline (DocumentOutline *outline);
+            void setThumbnails (gint numPages);
+            void showThumbnail (gint pageNum, DocumentPage *thumbnail);
+            void selectThumbnail (gint pageNum);
+            void showThumbnails (gboolean show);
             void setStatusBarText (const gchar *text);
             void setZoomText (const gchar *text);
             void show (void);
@@ -86,6 +94,10 @@ namespace ePDFView
             const gchar *getLastOpenFileFolder (void);
             const gchar *getLastSaveFileFolder (void);
             DocumentOutline *getOutline (void);
+            DocumentOutline *getSelectedOutline (void);
+            gint getSelectedThumbnail (void);
+            gint getShownThumbnail (void);
+            gint getNumThumbnails (void);
             const gchar *getTitle (void);
             gboolean isShown (void);
             gboolean isSensitiveFind (void);
@@ -99,6 +111,7 @@ namespace ePDFView
             gboolean isSensitiveRotateLeft (void);
             gboolean isSensitiveRotateRight (void);
             gboolean isSensitiveSave (void);
+            gboolean isSensitiveSaveText (void);
             gboolean isSensitiveZoom (void);
             gboolean isSensitiveZoomIn (void);
             gboolean isSensitiveZoomOut (void);
@@ -106,6 +119,7 @@ namespace ePDFView
             gboolean isSensitiveZoomWidth (void);
             gboolean isShownIndex (void);
             gboolean isShownStatusbar (void);
+            gboolean isShownThumbnails (void);
             gboolean isShownToolbar (void);
             gboolean isZoomToFitActive (void);
             gboolean isZoomToWidthActive (void);
@@ -123,6 +137,10 @@ namespace ePDFView
             gchar *m_LastSaveFileFolder;
             gchar *m_OpenFileName;
             DocumentOutline *m_Outline;
+            DocumentOutline *m_SelectedOutline;
+            gint m_NumThumbnails;
+            gint m_SelectedThumbnail;
+            gint m_ShownThumbnail;
             DumbPageView *m_PageView;
             gchar *m_Password;
             gchar *m_SaveFileName;
@@ -137,6 +155,7 @@ namespace ePDFView
             gboolean m_SensitiveRotateLeft;
             gboolean m_SensitiveRotateRight;
             gboolean m_SensitiveSave;
+            gboolean m_SensitiveSaveText;
             gboolean m_SensitiveZoom;
             gboolean m_SensitiveZoomIn;
             gboolean m_SensitiveZoomOut;
@@ -146,6 +165,7 @@ namespace ePDFView
             gboolean m_ShownError;
             gboolean m_ShownIndex;
             gboolean m_ShownStatusbar;
+            gboolean m_ShownThumbnails;
             gboolean m_ShownToolbar;
             gint m_TimesShownPassword;
             gchar *m_Title;
@@ -86,3 +86,8 @@ void
 DumbPageView::showText (const gchar *text)
 {
 }
+
+void
+DumbPageView::updatePageArea (DocumentPage *page, cairo_region_t *area)
+{
+}
@@ -41,6 +41,7 @@ namespace ePDFView
             void setCursor (PageCursor cursorType);
             void showPage (DocumentPage *page, PageScroll scroll);
             void showText (const gchar *text);
+            void updatePageArea (DocumentPage *page, cairo_region_t *area);
 
             
         private:
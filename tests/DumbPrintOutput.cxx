@@ -0,0 +1,84 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Dumb Test Print Output.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "DumbPrintOutput.h"
+
+using namespace ePDFView;
+
+DumbPrintOutput::DumbPrintOutput (GByteArray *stream):
+    IPrintOutput ()
+{
+    m_Stream = g_byte_array_ref (stream);
+    m_WriteError = FALSE;
+}
+
+DumbPrintOutput::~DumbPrintOutput ()
+{
+    g_byte_array_unref (m_Stream);
+}
+
+////////////////////////////////////////////////////////////////
+// Interface Methods
+////////////////////////////////////////////////////////////////
+
+gboolean
+DumbPrintOutput::begin (const gchar *printerName, const gchar *title,
+                        gint numOptions, cups_option_t *options,
+                        GError **error)
+{
+    return TRUE;
+}
+
+void
+DumbPrintOutput::cancel ()
+{
+}
+
+gboolean
+DumbPrintOutput::finish (GError **error)
+{
+    return TRUE;
+}
+
+gboolean
+DumbPrintOutput::write (const gchar *data, gsize length, GError **error)
+{
+    if ( m_WriteError )
+    {
+        g_set_error (error, EPDFVIEW_DOCUMENT_ERROR, DocumentErrorPrinting,
+                     "Write error");
+        return FALSE;
+    }
+    g_byte_array_append (m_Stream, (const guint8 *)data, length);
+    return TRUE;
+}
+
+////////////////////////////////////////////////////////////////
+// Tests Methods
+////////////////////////////////////////////////////////////////
+
+void
+DumbPrintOutput::setWriteError (gboolean writeError)
+{
+    m_WriteError = writeError;
+}
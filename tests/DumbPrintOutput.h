@@ -0,0 +1,51 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Dumb Test Print Output.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined(__DUMB_PRINT_OUTPUT_H__)
+#define __DUMB_PRINT_OUTPUT_H__
+
+namespace ePDFView
+{
+    class DumbPrintOutput: public IPrintOutput
+    {
+        public:
+            DumbPrintOutput (GByteArray *stream);
+            ~DumbPrintOutput ();
+
+            // Interface methods.
+            gboolean begin (const gchar *printerName, const gchar *title,
+                            gint numOptions, cups_option_t *options,
+                            GError **error);
+            void cancel (void);
+            gboolean finish (GError **error);
+            gboolean write (const gchar *data, gsize length, GError **error);
+
+            // Test functions.
+            void setWriteError (gboolean writeError);
+
+        private:
+            GByteArray *m_Stream;
+            gboolean m_WriteError;
+    };
+}
+
+#endif // !__DUMB_PRINT_OUTPUT_H__
@@ -30,12 +30,21 @@ DumbPrintView::DumbPrintView ():
 {
     m_AllPagesRangeOptionSelected = TRUE;
     m_NumberOfCopies = 1;
+    m_NumPageSizes = 0;
+    m_PrinterJobs = g_array_new (FALSE, FALSE, sizeof (gint));
+    m_PrinterNames = g_ptr_array_new_with_free_func (g_free);
+    m_PrinterStates = g_ptr_array_new_with_free_func (g_free);
+    m_SelectedPrinter = -1;
     m_SensitiveCollate = TRUE;
     m_SensitivePageRange = TRUE;
+    m_SensitivePrintButton = TRUE;
 }
 
 DumbPrintView::~DumbPrintView ()
 {
+    g_array_unref (m_PrinterJobs);
+    g_ptr_array_unref (m_PrinterNames);
+    g_ptr_array_unref (m_PrinterStates);
 }
 
 void
@@ -46,12 +55,16 @@ DumbPrintView::addColorModel (const gchar *name, const gchar *value)
 void
 DumbPrintView::addPageSize (const gchar *name, const gchar *value)
 {
+    m_NumPageSizes++;
 }
 
 void
 DumbPrintView::addPrinter (const gchar *name, int jobs, const gchar *state,
                            const gchar *location)
 {
+    g_array_append_val (m_PrinterJobs, jobs);
+    g_ptr_array_add (m_PrinterNames, g_strdup (name));
+    g_ptr_array_add (m_PrinterStates, g_strdup (state));
 }
 
 void
@@ -68,6 +81,7 @@ DumbPrintView::clearColorModelList ()
 void
 DumbPrintView::clearPageSizeList ()
 {
+    m_NumPageSizes = 0;
 }
 
 void
@@ -120,7 +134,11 @@ DumbPrintView::getPageSize ()
 gchar *
 DumbPrintView::getSelectedPrinterName (void)
 {
-    return NULL;
+    if ( -1 == m_SelectedPrinter )
+    {
+        return NULL;
+    }
+    return g_strdup (getPrinterName (m_SelectedPrinter));
 }
 
 gboolean
@@ -160,6 +178,7 @@ DumbPrintView::selectPageSize (guint pageSizeIndex)
 void
 DumbPrintView::selectPrinter (guint printerIndex)
 {
+    m_SelectedPrinter = printerIndex;
 }
 
 void
@@ -182,12 +201,59 @@ DumbPrintView::sensitivePageRange (gboolean sensitive)
 void
 DumbPrintView::sensitivePrintButton (gboolean sensitive)
 {
+    m_SensitivePrintButton = sensitive;
+}
+
+void
+DumbPrintView::setPrinterAttributes (guint printerIndex, gint jobs,
+                                     const gchar *state,
+                                     const gchar *location)
+{
+    g_array_index (m_PrinterJobs, gint, printerIndex) = jobs;
+    g_free (g_ptr_array_index (m_PrinterStates, printerIndex));
+    g_ptr_array_index (m_PrinterStates, printerIndex) = g_strdup (state);
 }
 
 ////////////////////////////////////////////////////////////////
 // Test Only Functions
 ////////////////////////////////////////////////////////////////
 
+guint
+DumbPrintView::getNumPageSizes ()
+{
+    return m_NumPageSizes;
+}
+
+guint
+DumbPrintView::getNumPrinters ()
+{
+    return m_PrinterNames->len;
+}
+
+gint
+DumbPrintView::getPrinterJobs (guint printerIndex)
+{
+    return g_array_index (m_PrinterJobs, gint, printerIndex);
+}
+
+const gchar *
+DumbPrintView::getPrinterName (guint printerIndex)
+{
+    return (const gchar *)g_ptr_array_index (m_PrinterNames, printerIndex);
+}
+
+const gchar *
+DumbPrintView::getPrinterState (guint printerIndex)
+{
+    return (const gchar *)g_ptr_array_index (m_PrinterStates, printerIndex);
+}
+
+gint
+DumbPrintView::getSelectedPrinter ()
+{
+    return m_SelectedPrinter;
+}
+
 gboolean
 DumbPrintView::isSensitiveCollate ()
 {
@@ -200,6 +266,12 @@ DumbPrintView::isSensitivePageRange ()
     return m_SensitivePageRange;
 }
 
+gboolean
+DumbPrintView::isSensitivePrintButton ()
+{
+    return m_SensitivePrintButton;
+}
+
 void
 DumbPrintView::selectAllPagesRangeOption ()
 {
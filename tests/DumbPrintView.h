@@ -58,10 +58,20 @@ namespace ePDFView
             virtual void sensitiveCollate (gboolean sensitive);
             virtual void sensitivePageRange (gboolean sensitive);
             virtual void sensitivePrintButton (gboolean sensitive);
+            virtual void setPrinterAttributes (guint printerIndex, gint jobs,
+                                               const gchar *state,
+                                               const gchar *location);
 
             // Test only functions.
+            guint getNumPageSizes (void);
+            guint getNumPrinters (void);
+            gint getPrinterJobs (guint printerIndex);
+            const gchar *getPrinterName (guint printerIndex);
+            const gchar *getPrinterState (guint printerIndex);
+            gint getSelectedPrinter (void);
             gboolean isSensitiveCollate (void);
             gboolean isSensitivePageRange (void);
+            gboolean isSensitivePrintButton (void);
             void selectAllPagesRangeOption (void);
             void selectCustomPagesRangeOption (void);
             void setNumberOfCopies (unsigned int copies);
@@ -69,8 +79,14 @@ namespace ePDFView
         protected:
             gboolean m_AllPagesRangeOptionSelected;
             guint m_NumberOfCopies;
+            guint m_NumPageSizes;
+            GArray *m_PrinterJobs;
+            GPtrArray *m_PrinterNames;
+            GPtrArray *m_PrinterStates;
+            gint m_SelectedPrinter;
             gboolean m_SensitiveCollate;
             gboolean m_SensitivePageRange;
+            gboolean m_SensitivePrintButton;
     };
 }
 
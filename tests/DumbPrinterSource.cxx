@@ -0,0 +1,111 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Dumb Test Printer Source.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <stdlib.h>
+#include <string.h>
+#include <epdfview.h>
+#include "DumbPrinterSource.h"
+
+using namespace ePDFView;
+
+DumbPrinterSource::DumbPrinterSource (guint numPrinters,
+                                      gint defaultPrinter):
+    IPrinterSource ()
+{
+    m_DefaultPrinter = defaultPrinter;
+    m_NumAttributesQueries = 0;
+    m_NumOptionsQueries = 0;
+    m_NumPrinters = numPrinters;
+    m_NumPrintersQueries = 0;
+}
+
+DumbPrinterSource::~DumbPrinterSource ()
+{
+}
+
+////////////////////////////////////////////////////////////////
+// Interface Methods
+////////////////////////////////////////////////////////////////
+
+///
+/// @brief Each printer has as many jobs as its index.
+///
+void
+DumbPrinterSource::getPrinterAttributes (const gchar *printerName,
+                                         gint *numJobs, gchar **state,
+                                         gchar **location)
+{
+    g_atomic_int_inc (&m_NumAttributesQueries);
+    *numJobs = atoi (printerName + strlen ("printer"));
+    *state = g_strdup ("Idle");
+    *location = g_strdup ("Here");
+}
+
+///
+/// @brief All printers have two page sizes, with "Letter" as default.
+///
+PrinterOptions *
+DumbPrinterSource::getPrinterOptions (const gchar *printerName)
+{
+    g_atomic_int_inc (&m_NumOptionsQueries);
+    PrinterOptions *options = new PrinterOptions ();
+    options->addChoice (PRINTER_OPTION_PAGE_SIZE, "A4", "A4", FALSE);
+    options->addChoice (PRINTER_OPTION_PAGE_SIZE, "Letter", "Letter", TRUE);
+    options->addPageSize ("A4", 595.0f, 842.0f);
+    options->addPageSize ("Letter", 612.0f, 792.0f);
+    return options;
+}
+
+gchar **
+DumbPrinterSource::getPrinters (gint *defaultPrinter)
+{
+    g_atomic_int_inc (&m_NumPrintersQueries);
+    gchar **printers = g_new0 (gchar *, m_NumPrinters + 1);
+    for ( guint printer = 0 ; printer < m_NumPrinters ; printer++ )
+    {
+        printers[printer] = g_strdup_printf ("printer%u", printer);
+    }
+    *defaultPrinter = m_DefaultPrinter;
+    return printers;
+}
+
+////////////////////////////////////////////////////////////////
+// Tests Methods
+////////////////////////////////////////////////////////////////
+
+guint
+DumbPrinterSource::getNumAttributesQueries ()
+{
+    return g_atomic_int_get (&m_NumAttributesQueries);
+}
+
+guint
+DumbPrinterSource::getNumOptionsQueries ()
+{
+    return g_atomic_int_get (&m_NumOptionsQueries);
+}
+
+guint
+DumbPrinterSource::getNumPrintersQueries ()
+{
+    return g_atomic_int_get (&m_NumPrintersQueries);
+}
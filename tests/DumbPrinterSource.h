@@ -0,0 +1,55 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Dumb Test Printer Source.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined(__DUMB_PRINTER_SOURCE_H__)
+#define __DUMB_PRINTER_SOURCE_H__
+
+namespace ePDFView
+{
+    class DumbPrinterSource: public IPrinterSource
+    {
+        public:
+            DumbPrinterSource (guint numPrinters, gint defaultPrinter);
+            ~DumbPrinterSource ();
+
+            // Interface methods.
+            void getPrinterAttributes (const gchar *printerName,
+                                       gint *numJobs, gchar **state,
+                                       gchar **location);
+            PrinterOptions *getPrinterOptions (const gchar *printerName);
+            gchar **getPrinters (gint *defaultPrinter);
+
+            // Test functions.
+            guint getNumAttributesQueries (void);
+            guint getNumOptionsQueries (void);
+            guint getNumPrintersQueries (void);
+
+        private:
+            gint m_DefaultPrinter;
+            volatile gint m_NumAttributesQueries;
+            volatile gint m_NumOptionsQueries;
+            guint m_NumPrinters;
+            volatile gint m_NumPrintersQueries;
+    };
+}
+
+#endif // !__DUMB_PRINTER_SOURCE_H__
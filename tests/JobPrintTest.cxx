@@ -0,0 +1,199 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Print Job Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <string.h>
+#include <epdfview.h>
+#include "Utils.h"
+#include "DumbDocumentObserver.h"
+#include "DumbPrintOutput.h"
+#include "JobPrintTest.h"
+
+using namespace ePDFView;
+
+// Constants.
+/// The microseconds to wait for a print before giving up.
+static const gint64 PRINT_TIMEOUT = 30 * G_USEC_PER_SEC;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (JobPrintTest);
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// Loads the five pages test document.
+///
+void
+JobPrintTest::setUp ()
+{
+    m_Document = new PDFDocument ();
+    m_Observer = new DumbDocumentObserver ();
+    m_Document->attach (m_Observer);
+    m_Stream = g_byte_array_new ();
+
+    gchar *testFile = getTestFile ("test1.pdf");
+    m_Document->load (testFile, NULL);
+    g_free (testFile);
+    while ( !m_Observer->loadFinished () ) { }
+    CPPUNIT_ASSERT (m_Observer->notifiedLoaded ());
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+JobPrintTest::tearDown ()
+{
+    g_byte_array_unref (m_Stream);
+    m_Document->detach (m_Observer);
+    delete m_Observer;
+    delete m_Document;
+}
+
+///
+/// @brief Creates a job that prints the test document.
+///
+/// @param output The output to stream the print to.
+///
+/// @return The job to enqueue.
+///
+JobPrint *
+JobPrintTest::createJob (DumbPrintOutput *output)
+{
+    JobPrint *job = new JobPrint ();
+    job->setDocument (m_Document);
+    job->setPrinterName ("test");
+    job->setPageSize (595.0f, 842.0f);
+    job->setOutput (output);
+
+    return job;
+}
+
+///
+/// @brief Counts the pages in the streamed PostScript.
+///
+/// @return The number of %%Page: comments in the stream.
+///
+guint
+JobPrintTest::countPages ()
+{
+    gchar *postscript = g_strndup ((const gchar *)m_Stream->data,
+                                   m_Stream->len);
+    guint numPages = 0;
+    for ( const gchar *page = strstr (postscript, "\n%%Page:") ;
+          NULL != page ;
+          page = strstr (page + 1, "\n%%Page:") )
+    {
+        numPages++;
+    }
+    g_free (postscript);
+
+    return numPages;
+}
+
+///
+/// @brief Waits until the document is notified that the print ended.
+///
+/// @return TRUE if the print ended, FALSE if it timed out.
+///
+gboolean
+JobPrintTest::waitForPrint ()
+{
+    gint64 endTime = g_get_monotonic_time () + PRINT_TIMEOUT;
+    while ( !m_Observer->printFinished () &&
+            g_get_monotonic_time () < endTime )
+    {
+        // The notifications are idle callbacks when not debugging.
+        g_main_context_iteration (NULL, FALSE);
+        g_usleep (1000);
+    }
+
+    return m_Observer->printFinished ();
+}
+
+///
+/// @brief Test streaming the whole document.
+///
+/// All pages must be streamed to the output as a single PostScript
+/// document, and the progress must reach the last page.
+///
+void
+JobPrintTest::streamAllPages ()
+{
+    IJob::enqueue (createJob (new DumbPrintOutput (m_Stream)));
+    CPPUNIT_ASSERT (waitForPrint ());
+    CPPUNIT_ASSERT (!m_Observer->notifiedPrintError ());
+    CPPUNIT_ASSERT (4 < m_Stream->len);
+    CPPUNIT_ASSERT_EQUAL (0, memcmp ("%!PS", m_Stream->data, 4));
+    CPPUNIT_ASSERT_EQUAL ((guint)5, countPages ());
+    CPPUNIT_ASSERT_EQUAL ((guint)5, m_Observer->getNumPagesPrinted ());
+}
+
+///
+/// @brief Test streaming only a range of pages.
+///
+void
+JobPrintTest::streamPageRange ()
+{
+    JobPrint *job = createJob (new DumbPrintOutput (m_Stream));
+    job->setPageRange ("2-3");
+    IJob::enqueue (job);
+    CPPUNIT_ASSERT (waitForPrint ());
+    CPPUNIT_ASSERT (!m_Observer->notifiedPrintError ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, countPages ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_Observer->getNumPagesPrinted ());
+}
+
+///
+/// @brief Test streaming the document imposed four pages per sheet.
+///
+/// The five pages must fit on two sheets, but the progress still
+/// counts the document's pages.
+///
+void
+JobPrintTest::streamImposedPages ()
+{
+    JobPrint *job = createJob (new DumbPrintOutput (m_Stream));
+    job->setPageLayout (PRINT_PAGE_LAYOUT_4IN1);
+    IJob::enqueue (job);
+    CPPUNIT_ASSERT (waitForPrint ());
+    CPPUNIT_ASSERT (!m_Observer->notifiedPrintError ());
+    CPPUNIT_ASSERT_EQUAL (0, memcmp ("%!PS", m_Stream->data, 4));
+    CPPUNIT_ASSERT_EQUAL ((guint)2, countPages ());
+    CPPUNIT_ASSERT_EQUAL ((guint)5, m_Observer->getNumPagesPrinted ());
+}
+
+///
+/// @brief Test an output that fails.
+///
+/// The document must be notified about the error, and the print must
+/// end even though the pipe isn't read anymore.
+///
+void
+JobPrintTest::outputError ()
+{
+    DumbPrintOutput *output = new DumbPrintOutput (m_Stream);
+    output->setWriteError (TRUE);
+    IJob::enqueue (createJob (output));
+    CPPUNIT_ASSERT (waitForPrint ());
+    CPPUNIT_ASSERT (m_Observer->notifiedPrintError ());
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Stream->len);
+}
@@ -0,0 +1,59 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Print Job Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__JOB_PRINT_TEST_H__)
+#define __JOB_PRINT_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class JobPrintTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (JobPrintTest);
+        CPPUNIT_TEST (streamAllPages);
+        CPPUNIT_TEST (streamPageRange);
+        CPPUNIT_TEST (streamImposedPages);
+        CPPUNIT_TEST (outputError);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void streamAllPages (void);
+            void streamPageRange (void);
+            void streamImposedPages (void);
+            void outputError (void);
+
+        protected:
+            PDFDocument *m_Document;
+            DumbDocumentObserver *m_Observer;
+            GByteArray *m_Stream;
+
+            JobPrint *createJob (DumbPrintOutput *output);
+            guint countPages (void);
+            gboolean waitForPrint (void);
+    };
+}
+
+#endif // !__JOB_PRINT_TEST_H__
@@ -89,6 +89,7 @@ MainPterTest::initialStatus ()
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (!m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (!m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomOut ());
@@ -128,6 +129,7 @@ MainPterTest::loadDocument ()
     CPPUNIT_ASSERT (m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomOut ());
@@ -153,6 +155,7 @@ MainPterTest::loadDocument ()
     CPPUNIT_ASSERT (m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomOut ());
@@ -186,6 +189,7 @@ MainPterTest::loadCanceled ()
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (!m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (!m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomOut ());
@@ -223,6 +227,7 @@ MainPterTest::loadFailed ()
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (!m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (!m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomOut ());
@@ -261,6 +266,7 @@ MainPterTest::canceledPassword ()
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (!m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (!m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomOut ());
@@ -299,6 +305,7 @@ MainPterTest::badPassword ()
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (!m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (!m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (!m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (!m_View->isSensitiveZoomOut ());
@@ -337,6 +344,7 @@ MainPterTest::goodPassword ()
     CPPUNIT_ASSERT (m_View->isSensitiveRotateLeft ());
     CPPUNIT_ASSERT (m_View->isSensitiveRotateRight ());
     CPPUNIT_ASSERT (m_View->isSensitiveSave ());
+    CPPUNIT_ASSERT (m_View->isSensitiveSaveText ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoom ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomIn ());
     CPPUNIT_ASSERT (m_View->isSensitiveZoomOut ());
@@ -938,6 +946,82 @@ MainPterTest::showIndex ()
     CPPUNIT_ASSERT (m_View->isShownIndex ());
 }
 
+///
+/// @brief Checks that the outline's item of the current page is selected.
+///
+/// The outline is shown as soon as JobLoadOutline reads it, and once
+/// JobIndexOutline indexes it the presenter tells the view which outline
+/// item has the current page every time the page changes.
+///
+void
+MainPterTest::currentSection ()
+{
+    m_Document->setOutline (new DocumentOutline ());
+    m_Document->setNumPages (6);
+    m_View->setOpenFileName ("/tmp/test.pdf");
+    m_MainPter->openFileActivated ();
+    m_MainPter->waitForFileLoaded ();
+    CPPUNIT_ASSERT (NULL == m_View->getSelectedOutline ());
+
+    DocumentOutline *outline = new DocumentOutline ();
+    DocumentOutline *chapter = new DocumentOutline ();
+    chapter->setParent (outline);
+    chapter->setTitle ("Chapter 1");
+    chapter->setDestination (2);
+    outline->addChild (chapter);
+    DocumentOutline *section = new DocumentOutline ();
+    section->setParent (chapter);
+    section->setTitle ("Section 1.1");
+    section->setDestination (4);
+    chapter->addChild (section);
+    m_Document->notifyOutlineLoaded (outline);
+    CPPUNIT_ASSERT (outline == m_View->getOutline ());
+    // The outline is shown before it's indexed, so there's no section yet.
+    m_Document->goToPage (3);
+    CPPUNIT_ASSERT (NULL == m_View->getSelectedOutline ());
+    // Once indexed, the current page's section is selected.
+    CPPUNIT_ASSERT (m_Document->indexOutline (outline));
+    m_Document->notifyOutlineIndexed ();
+    CPPUNIT_ASSERT (chapter == m_View->getSelectedOutline ());
+    // An outline that's no longer the document's isn't indexed.
+    CPPUNIT_ASSERT (!m_Document->indexOutline (chapter));
+
+    m_Document->goToPage (3);
+    CPPUNIT_ASSERT (chapter == m_View->getSelectedOutline ());
+    m_Document->goToPage (6);
+    CPPUNIT_ASSERT (section == m_View->getSelectedOutline ());
+    m_Document->goToPage (1);
+    CPPUNIT_ASSERT (NULL == m_View->getSelectedOutline ());
+}
+
+///
+/// @brief Checks the thumbnails' sidebar.
+///
+/// The view gets a thumbnail for each page, and the current page's
+/// thumbnail is selected. A document that asks to show the thumbnails
+/// opens the sidebar in them.
+///
+void
+MainPterTest::thumbnails ()
+{
+    m_Document->setPageMode (PageModeThumbs);
+    m_Document->setNumPages (5);
+    m_View->setOpenFileName ("/tmp/test.pdf");
+    m_MainPter->openFileActivated ();
+    m_MainPter->waitForFileLoaded ();
+    CPPUNIT_ASSERT (m_View->isShownIndex ());
+    CPPUNIT_ASSERT (m_View->isShownThumbnails ());
+    CPPUNIT_ASSERT_EQUAL (5, m_View->getNumThumbnails ());
+    CPPUNIT_ASSERT_EQUAL (1, m_View->getSelectedThumbnail ());
+
+    // Clicking on a thumbnail goes to its page.
+    m_MainPter->thumbnailActivated (4);
+    CPPUNIT_ASSERT_EQUAL (4, m_View->getCurrentPage ());
+    CPPUNIT_ASSERT_EQUAL (4, m_View->getSelectedThumbnail ());
+    m_Document->goToPage (2);
+    CPPUNIT_ASSERT_EQUAL (2, m_View->getSelectedThumbnail ());
+}
+
 ///
 /// @brief Checks showing and hidding the tool bar and status bar.
 ///
@@ -53,6 +53,8 @@ namespace ePDFView
         CPPUNIT_TEST (reloadEncrypted);
         CPPUNIT_TEST (reloadChangedPassword);
         CPPUNIT_TEST (showIndex);
+        CPPUNIT_TEST (currentSection);
+        CPPUNIT_TEST (thumbnails);
         CPPUNIT_TEST (showToolAndStatusBars);
         CPPUNIT_TEST_SUITE_END();
 
@@ -83,6 +85,8 @@ namespace ePDFView
             void reloadEncrypted (void);
             void reloadChangedPassword (void);
             void showIndex (void);
+            void currentSection (void);
+            void thumbnails (void);
             void showToolAndStatusBars (void);
 
         private:
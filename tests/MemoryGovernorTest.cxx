@@ -0,0 +1,138 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Memory Governor Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "DumbDocument.h"
+#include "DumbDocumentObserver.h"
+#include "MemoryGovernorTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (MemoryGovernorTest);
+
+// Forward declarations.
+static void addThumbnails (DumbDocument *document);
+
+// Constants.
+/// The width and height of the test thumbnails.
+static const gint TEST_THUMBNAIL_SIZE = 16;
+/// How many thumbnails each test document has.
+static const gint TEST_NUM_THUMBNAILS = 3;
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// Two documents get thumbnails, and the first has an observer.
+///
+void
+MemoryGovernorTest::setUp ()
+{
+    m_Document = new DumbDocument ();
+    m_OtherDocument = new DumbDocument ();
+    m_Observer = new DumbDocumentObserver ();
+    m_Document->attach (m_Observer);
+    addThumbnails (m_Document);
+    addThumbnails (m_OtherDocument);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+MemoryGovernorTest::tearDown ()
+{
+    m_Document->detach (m_Observer);
+    delete m_Observer;
+    delete m_Document;
+    delete m_OtherDocument;
+    MemoryGovernor::destroy ();
+}
+
+///
+/// @brief Checks that a low warning keeps the compressed tier.
+///
+void
+MemoryGovernorTest::lowWarning ()
+{
+    gsize size = m_Document->getCacheSize ();
+    MemoryGovernor &governor = MemoryGovernor::getGovernor ();
+    CPPUNIT_ASSERT_EQUAL ((guint)0, governor.getNumWarnings ());
+
+    governor.notifyLowMemory (G_MEMORY_MONITOR_WARNING_LEVEL_LOW);
+    CPPUNIT_ASSERT_EQUAL ((guint)1, governor.getNumWarnings ());
+    CPPUNIT_ASSERT_EQUAL (G_MEMORY_MONITOR_WARNING_LEVEL_LOW,
+                          governor.getLastLevel ());
+    CPPUNIT_ASSERT_EQUAL (size, m_Document->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL (size, m_OtherDocument->getCacheSize ());
+    CPPUNIT_ASSERT (!m_Observer->notifiedLowMemory ());
+}
+
+///
+/// @brief Checks that a medium warning frees all documents' caches.
+///
+void
+MemoryGovernorTest::mediumWarning ()
+{
+    gsize size = m_Document->getCacheSize () +
+                 m_OtherDocument->getCacheSize ();
+    MemoryGovernor &governor = MemoryGovernor::getGovernor ();
+    gsize released =
+        governor.notifyLowMemory (G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM);
+
+    CPPUNIT_ASSERT (size <= released);
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Document->getCacheSize ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_OtherDocument->getCacheSize ());
+    CPPUNIT_ASSERT (NULL == m_Document->getThumbnail (1));
+    CPPUNIT_ASSERT (!m_Observer->notifiedLowMemory ());
+}
+
+///
+/// @brief Checks that a critical warning tells the views to free memory.
+///
+void
+MemoryGovernorTest::criticalWarning ()
+{
+    MemoryGovernor &governor = MemoryGovernor::getGovernor ();
+    governor.notifyLowMemory (G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL);
+
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Document->getCacheSize ());
+    CPPUNIT_ASSERT (m_Observer->notifiedLowMemory ());
+    CPPUNIT_ASSERT_EQUAL (G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL,
+                          governor.getLastLevel ());
+}
+
+///
+/// @brief Adds TEST_NUM_THUMBNAILS test thumbnails to a document.
+///
+/// @param document The document to add the thumbnails to.
+///
+void
+addThumbnails (DumbDocument *document)
+{
+    for ( gint pageNum = 1 ; pageNum <= TEST_NUM_THUMBNAILS ; pageNum++ )
+    {
+        DocumentPage *thumbnail = new DocumentPage ();
+        thumbnail->newPage (TEST_THUMBNAIL_SIZE, TEST_THUMBNAIL_SIZE);
+        document->addThumbnail (pageNum, thumbnail);
+    }
+}
@@ -0,0 +1,57 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Memory Governor Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__MEMORY_GOVERNOR_TEST_H__)
+#define __MEMORY_GOVERNOR_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    // Forward declarations.
+    class DumbDocument;
+    class DumbDocumentObserver;
+
+    class MemoryGovernorTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (MemoryGovernorTest);
+        CPPUNIT_TEST (lowWarning);
+        CPPUNIT_TEST (mediumWarning);
+        CPPUNIT_TEST (criticalWarning);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void lowWarning (void);
+            void mediumWarning (void);
+            void criticalWarning (void);
+
+        protected:
+            DumbDocument *m_Document;
+            DumbDocumentObserver *m_Observer;
+            DumbDocument *m_OtherDocument;
+    };
+}
+
+#endif // !__MEMORY_GOVERNOR_TEST_H__
@@ -0,0 +1,102 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Thumbnail Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "Utils.h"
+#include "PDFDocumentCoreTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (PDFDocumentCoreTest);
+
+///
+/// @brief Sets up the environment for each test.
+///
+/// The core parses the test document by its file name.
+///
+void
+PDFDocumentCoreTest::setUp ()
+{
+    gchar *testFile = getTestFile ("test1.pdf");
+    gchar *uri = g_filename_to_uri (testFile, NULL, NULL);
+    CPPUNIT_ASSERT (NULL != uri);
+    m_Core = new PDFDocumentCore (NULL, uri, NULL);
+    g_free (uri);
+    g_free (testFile);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+PDFDocumentCoreTest::tearDown ()
+{
+    m_Core->unref ();
+}
+
+///
+/// @brief Checks that each thread gets its own parsed document.
+///
+void
+PDFDocumentCoreTest::parseFromFile ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Core->getNumIdle ());
+    PopplerDocument *first = m_Core->acquire ();
+    PopplerDocument *second = m_Core->acquire ();
+    CPPUNIT_ASSERT (NULL != first);
+    CPPUNIT_ASSERT (NULL != second);
+    CPPUNIT_ASSERT (first != second);
+    m_Core->release (first);
+    m_Core->release (second);
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_Core->getNumIdle ());
+}
+
+///
+/// @brief Checks that a released document is taken again without
+///        parsing it.
+///
+void
+PDFDocumentCoreTest::reuseReleased ()
+{
+    PopplerDocument *document = m_Core->acquire ();
+    m_Core->release (document);
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Core->getNumIdle ());
+
+    CPPUNIT_ASSERT (document == m_Core->acquire ());
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Core->getNumIdle ());
+    m_Core->release (document);
+}
+
+///
+/// @brief Checks that the core lives while it has references.
+///
+void
+PDFDocumentCoreTest::keepRefCount ()
+{
+    CPPUNIT_ASSERT (m_Core == m_Core->ref ());
+    PopplerDocument *document = m_Core->acquire ();
+    m_Core->unref ();
+    // The reference of the fixture still keeps the core.
+    m_Core->release (document);
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Core->getNumIdle ());
+}
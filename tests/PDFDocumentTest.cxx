@@ -20,6 +20,8 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
+#include <utime.h>
+#include <glib/gstdio.h>
 #include <epdfview.h>
 #include "Utils.h"
 #include "DumbDocumentObserver.h"
@@ -686,31 +688,276 @@ PDFDocumentTest::pageFindText ()
     g_free (testFile);
     while ( !m_Observer->loadFinished () ) { }
 
-    // If a text doesn't exist on a page the list of found text is
+    // If a text doesn't exist on a page the array of found text is
     // empty.
     CPPUNIT_ASSERT (NULL == m_Document->findTextInPage (4, "nothing"));
-    // On the other hand, if something is found the list is filled with
+    // On the other hand, if something is found the array is filled with
     // the rectangles the text is found.
-    GList *results = m_Document->findTextInPage (4, "first");
+    GArray *results = m_Document->findTextInPage (4, "first");
     CPPUNIT_ASSERT (NULL != results);
     // In this case it should have found 2 results.
-    CPPUNIT_ASSERT_EQUAL ((guint)2, g_list_length (results));
+    CPPUNIT_ASSERT_EQUAL ((guint)2, results->len);
 
-    GList *firstResult = g_list_first (results);
     {
-        DocumentRectangle *rect = (DocumentRectangle *)firstResult->data;
+        DocumentRectangle *rect =
+            &g_array_index (results, DocumentRectangle, 0);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (82.00, rect->getX1 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (137.11, rect->getY1 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (100.34, rect->getX2 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (146.11, rect->getY2 (), 0.0001);
     }
-    GList *secondResult = g_list_next (firstResult);
     {
-        DocumentRectangle *rect = (DocumentRectangle *)secondResult->data;
+        DocumentRectangle *rect =
+            &g_array_index (results, DocumentRectangle, 1);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (96.00, rect->getX1 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (148.11, rect->getY1 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (114.34, rect->getX2 (), 0.0001);
         CPPUNIT_ASSERT_DOUBLES_EQUAL (157.11, rect->getY2 (), 0.0001);
     }
-    g_list_free (results);
+    g_array_free (results, TRUE);
+}
+
+///
+/// @brief Checks which pages a reload finds unchanged.
+///
+void
+PDFDocumentTest::reloadUnchangedPages ()
+{
+    // The queued renders do nothing, so the test gives the images.
+    G_LOCK (JobRender);
+    JobRender::m_CanProcessJobs = FALSE;
+    G_UNLOCK (JobRender);
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    CPPUNIT_ASSERT (!m_Document->isPageUnchanged (4));
+    CPPUNIT_ASSERT (!m_Document->isWatched ());
+
+    // Only the pages with a fingerprint and an image cached are compared.
+    m_Document->notifyLoad ();
+    // The first page cached has age 0.
+    m_Document->notifyPageRendered (1, 0, m_Document->renderPage (1));
+    m_Document->loadPageFingerprint (1);
+    m_Document->loadPageFingerprint (4);
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    CPPUNIT_ASSERT (m_Document->isPageUnchanged (1));
+    CPPUNIT_ASSERT (!m_Document->isPageUnchanged (2));
+    CPPUNIT_ASSERT (!m_Document->isPageUnchanged (4));
+
+    // Another file isn't a reload.
+    gchar *otherFile = getTestFile ("test2.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (otherFile, NULL, NULL));
+    CPPUNIT_ASSERT (!m_Document->isPageUnchanged (4));
+    g_free (otherFile);
+    g_free (testFile);
+}
+
+///
+/// @brief Checks that a copy keeps working after the document changes.
+///
+void
+PDFDocumentTest::copyDocument ()
+{
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    m_Document->loadPageSizes ();
+    gdouble width;
+    gdouble height;
+    m_Document->getPageSizeForPage (1, &width, &height);
+
+    IDocument *copy = m_Document->copy ();
+    CPPUNIT_ASSERT (copy->isLoaded ());
+    CPPUNIT_ASSERT_EQUAL (m_Document->getNumPages (), copy->getNumPages ());
+    CPPUNIT_ASSERT (0 == g_ascii_strcasecmp (testFile, copy->getFileName ()));
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 (m_Document->getTitle (),
+                                        copy->getTitle ()));
+    // Another copy at the same time gets its own parsed document.
+    IDocument *otherCopy = m_Document->copy ();
+    CPPUNIT_ASSERT (NULL != otherCopy);
+    DocumentPage *otherPage = otherCopy->renderPage (1);
+    CPPUNIT_ASSERT (NULL != otherPage);
+    delete otherPage;
+    delete otherCopy;
+
+    // Opening another file leaves the copy as it was.
+    gchar *otherFile = getTestFile ("test2.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (otherFile, NULL, NULL));
+    g_free (otherFile);
+    gdouble copyWidth;
+    gdouble copyHeight;
+    copy->getPageSizeForPage (1, &copyWidth, &copyHeight);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (width, copyWidth, 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (height, copyHeight, 0.0001);
+    DocumentPage *page = copy->renderPage (1);
+    CPPUNIT_ASSERT (NULL != page);
+    delete page;
+    delete copy;
+    g_free (testFile);
+}
+
+///
+/// @brief Checks saving a copy of a document whose file didn't change.
+///
+/// The copy must have the same bytes of the original file, also after
+/// the file is touched and Poppler writes it, and saving over the
+/// original file must leave it as it was.
+///
+void
+PDFDocumentTest::saveUnchangedFile ()
+{
+    gchar *directory = g_dir_make_tmp ("epdfview-save-XXXXXX", NULL);
+    gchar *testFile = getTestFile ("test1.pdf");
+    gchar *original = NULL;
+    gsize originalLength = 0;
+    CPPUNIT_ASSERT (g_file_get_contents (testFile, &original,
+                                         &originalLength, NULL));
+    gchar *sourceFile = g_build_filename (directory, "source.pdf", NULL);
+    CPPUNIT_ASSERT (g_file_set_contents (sourceFile, original,
+                                         originalLength, NULL));
+    CPPUNIT_ASSERT (m_Document->loadFile (sourceFile, NULL, NULL));
+
+    gchar *copyFile = g_build_filename (directory, "copy.pdf", NULL);
+    CPPUNIT_ASSERT (m_Document->saveFile (copyFile, NULL));
+    gchar *copied = NULL;
+    gsize copiedLength = 0;
+    CPPUNIT_ASSERT (g_file_get_contents (copyFile, &copied, &copiedLength,
+                                         NULL));
+    CPPUNIT_ASSERT_EQUAL (originalLength, copiedLength);
+    CPPUNIT_ASSERT (0 == memcmp (original, copied, originalLength));
+    g_free (copied);
+
+    CPPUNIT_ASSERT (m_Document->saveFile (sourceFile, NULL));
+    CPPUNIT_ASSERT (g_file_get_contents (sourceFile, &copied, &copiedLength,
+                                         NULL));
+    CPPUNIT_ASSERT_EQUAL (originalLength, copiedLength);
+    g_free (copied);
+
+    // Once the file changes, the copy is written by Poppler.
+    struct utimbuf times = { 0, 0 };
+    CPPUNIT_ASSERT (0 == g_utime (sourceFile, &times));
+    CPPUNIT_ASSERT (m_Document->saveFile (copyFile, NULL));
+    PDFDocument *saved = new PDFDocument ();
+    CPPUNIT_ASSERT (saved->loadFile (copyFile, NULL, NULL));
+    CPPUNIT_ASSERT_EQUAL (m_Document->getNumPages (), saved->getNumPages ());
+    delete saved;
+
+    g_free (copyFile);
+    g_free (sourceFile);
+    g_free (original);
+    g_free (testFile);
+    removeDirectory (directory);
+    g_free (directory);
+}
+
+///
+/// @brief Checks the page sizes read before and after loading them all.
+///
+void
+PDFDocumentTest::pageSizes ()
+{
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    g_free (testFile);
+
+    gdouble width;
+    gdouble height;
+    m_Document->getPageSizeForPage (1, &width, &height);
+    CPPUNIT_ASSERT (0.0 < width);
+    CPPUNIT_ASSERT (0.0 < height);
+    m_Document->loadPageSizes ();
+    for ( gint pageNum = 1 ; pageNum <= m_Document->getNumPages () ;
+          pageNum++ )
+    {
+        gdouble pageWidth;
+        gdouble pageHeight;
+        m_Document->getPageSizeForPage (pageNum, &pageWidth, &pageHeight);
+        CPPUNIT_ASSERT (0.0 < pageWidth);
+        CPPUNIT_ASSERT (0.0 < pageHeight);
+    }
+    gdouble loadedWidth;
+    gdouble loadedHeight;
+    m_Document->getPageSizeForPage (1, &loadedWidth, &loadedHeight);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (width, loadedWidth, 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (height, loadedHeight, 0.0001);
+
+    // The rotated size is the same size swapped.
+    m_Document->setRotation (90);
+    m_Document->getPageSizeForPage (1, &loadedWidth, &loadedHeight);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (height, loadedWidth, 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (width, loadedHeight, 0.0001);
+    m_Document->setRotation (180);
+    m_Document->getPageSizeForPage (1, &loadedWidth, &loadedHeight);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (width, loadedWidth, 0.0001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (height, loadedHeight, 0.0001);
+}
+
+///
+/// @brief Checks keeping the thumbnails in the disk cache.
+///
+/// The first time a thumbnail is rendered it's stored, and the next
+/// time the same document is opened it's read back.
+///
+void
+PDFDocumentTest::diskCache ()
+{
+    gchar *directory = g_dir_make_tmp ("epdfview-cache-XXXXXX", NULL);
+    DiskCache *cache = new DiskCache (directory, 1024 * 1024);
+    IDocument::setDiskCache (cache);
+
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    m_Document->openDiskCache ();
+    DocumentPage *thumbnail = m_Document->loadThumbnail (1, 64);
+    CPPUNIT_ASSERT (NULL != thumbnail);
+    CPPUNIT_ASSERT (64 >= thumbnail->getWidth ());
+    CPPUNIT_ASSERT (64 >= thumbnail->getHeight ());
+    gsize size = cache->getSize ();
+    CPPUNIT_ASSERT (0 < size);
+
+    PDFDocument *reopened = new PDFDocument ();
+    CPPUNIT_ASSERT (reopened->loadFile (testFile, NULL, NULL));
+    reopened->openDiskCache ();
+    DocumentPage *cached = reopened->loadThumbnail (1, 64);
+    CPPUNIT_ASSERT (NULL != cached);
+    CPPUNIT_ASSERT_EQUAL (size, cache->getSize ());
+    CPPUNIT_ASSERT_EQUAL (thumbnail->getWidth (), cached->getWidth ());
+    CPPUNIT_ASSERT_EQUAL (thumbnail->getHeight (), cached->getHeight ());
+    CPPUNIT_ASSERT (0 == memcmp (thumbnail->getData (), cached->getData (),
+                                 thumbnail->getRowStride () *
+                                 thumbnail->getHeight ()));
+    delete cached;
+    delete reopened;
+    delete thumbnail;
+    g_free (testFile);
+
+    IDocument::setDiskCache (NULL);
+    delete cache;
+    removeDirectory (directory);
+    g_free (directory);
+}
+
+///
+/// @brief Checks that the rotation doesn't change the thumbnails.
+///
+/// The thumbnails are drawn unrotated and cached without the rotation,
+/// so they must have the page's own size.
+///
+void
+PDFDocumentTest::rotatedThumbnail ()
+{
+    gchar *testFile = getTestFile ("test1.pdf");
+    CPPUNIT_ASSERT (m_Document->loadFile (testFile, NULL, NULL));
+    g_free (testFile);
+
+    DocumentPage *thumbnail = m_Document->renderThumbnail (1, 64);
+    CPPUNIT_ASSERT (NULL != thumbnail);
+    m_Document->rotateRight ();
+    DocumentPage *rotated = m_Document->renderThumbnail (1, 64);
+    CPPUNIT_ASSERT (NULL != rotated);
+    CPPUNIT_ASSERT_EQUAL (thumbnail->getWidth (), rotated->getWidth ());
+    CPPUNIT_ASSERT_EQUAL (thumbnail->getHeight (), rotated->getHeight ());
+    CPPUNIT_ASSERT (0 == memcmp (thumbnail->getData (), rotated->getData (),
+                                 thumbnail->getRowStride () *
+                                 thumbnail->getHeight ()));
+    delete rotated;
+    delete thumbnail;
 }
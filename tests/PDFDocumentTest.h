@@ -42,6 +42,12 @@ namespace ePDFView
         CPPUNIT_TEST (pageRender);
         CPPUNIT_TEST (pageLinks);
         CPPUNIT_TEST (pageFindText);
+        CPPUNIT_TEST (reloadUnchangedPages);
+        CPPUNIT_TEST (copyDocument);
+        CPPUNIT_TEST (saveUnchangedFile);
+        CPPUNIT_TEST (pageSizes);
+        CPPUNIT_TEST (diskCache);
+        CPPUNIT_TEST (rotatedThumbnail);
         CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -60,6 +66,12 @@ namespace ePDFView
             void pageRender (void);
             void pageLinks (void);
             void pageFindText (void);
+            void reloadUnchangedPages (void);
+            void copyDocument (void);
+            void saveUnchangedFile (void);
+            void pageSizes (void);
+            void diskCache (void);
+            void rotatedThumbnail (void);
             
         private:
             PDFDocument *m_Document;
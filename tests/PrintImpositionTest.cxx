@@ -0,0 +1,207 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Print Imposition Test Suite.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "PrintImpositionTest.h"
+
+using namespace ePDFView;
+
+// Constants.
+/// The width of an A4 sheet, in points.
+static const gdouble A4_WIDTH = 595.0;
+/// The height of an A4 sheet, in points.
+static const gdouble A4_HEIGHT = 842.0;
+/// The tolerance when comparing positions, in points.
+static const gdouble POSITION_DELTA = 0.5;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (PrintImpositionTest);
+
+///
+/// @brief Checks where an A4 page is placed on the sheet.
+///
+/// The page's top left corner must map to (@a left, @a top) and its
+/// bottom right corner to (@a right, @a bottom), in sheet coordinates.
+///
+/// @param imposition The imposition to check.
+/// @param slot The slot to check.
+/// @param left The expected X coordinate of the page's top left corner.
+/// @param top The expected Y coordinate of the page's top left corner.
+/// @param right The expected X coordinate of the page's bottom right corner.
+/// @param bottom The expected Y coordinate of the page's bottom right
+///               corner.
+///
+void
+PrintImpositionTest::assertPlacement (PrintImposition &imposition,
+                                      guint slot, gdouble left, gdouble top,
+                                      gdouble right, gdouble bottom)
+{
+    cairo_matrix_t matrix;
+    imposition.getPageTransform (slot, A4_WIDTH, A4_HEIGHT, &matrix);
+
+    gdouble x = 0.0;
+    gdouble y = 0.0;
+    cairo_matrix_transform_point (&matrix, &x, &y);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (left, x, POSITION_DELTA);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (top, y, POSITION_DELTA);
+
+    x = A4_WIDTH;
+    y = A4_HEIGHT;
+    cairo_matrix_transform_point (&matrix, &x, &y);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (right, x, POSITION_DELTA);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (bottom, y, POSITION_DELTA);
+}
+
+///
+/// @brief Test the plain layout.
+///
+/// Each page must fill its own sheet, unscaled.
+///
+void
+PrintImpositionTest::plain ()
+{
+    PrintImposition imposition (PRINT_PAGE_LAYOUT_PLAIN, 5,
+                                A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (!imposition.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)1, imposition.getPagesPerSheet ());
+    CPPUNIT_ASSERT_EQUAL ((guint)5, imposition.getNumSheets ());
+    CPPUNIT_ASSERT_EQUAL (4, imposition.getPage (4, 0));
+    assertPlacement (imposition, 0, 0.0, 0.0, A4_WIDTH, A4_HEIGHT);
+}
+
+///
+/// @brief Test two pages per sheet.
+///
+/// The sheet must be turned to landscape, with two pages side by side,
+/// so each page is rotated and scaled by 1/sqrt(2). The first page's top
+/// is on the sheet's left edge, starting from the bottom.
+///
+void
+PrintImpositionTest::twoUp ()
+{
+    PrintImposition imposition (PRINT_PAGE_LAYOUT_2IN1, 5,
+                                A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (imposition.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, imposition.getNumColumns ());
+    CPPUNIT_ASSERT_EQUAL ((guint)1, imposition.getNumRows ());
+    CPPUNIT_ASSERT_EQUAL ((guint)3, imposition.getNumSheets ());
+    CPPUNIT_ASSERT_EQUAL (3, imposition.getPage (1, 1));
+    CPPUNIT_ASSERT_EQUAL (-1, imposition.getPage (2, 1));
+
+    assertPlacement (imposition, 0, 0.0, 841.7, 595.0, 421.3);
+    assertPlacement (imposition, 1, 0.0, 420.7, 595.0, 0.3);
+}
+
+///
+/// @brief Test four pages per sheet.
+///
+/// The pages must be placed in a 2x2 grid, at half their size and
+/// without rotating the sheet.
+///
+void
+PrintImpositionTest::fourUp ()
+{
+    PrintImposition imposition (PRINT_PAGE_LAYOUT_4IN1, 5,
+                                A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (!imposition.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, imposition.getNumColumns ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, imposition.getNumRows ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, imposition.getNumSheets ());
+    CPPUNIT_ASSERT_EQUAL (4, imposition.getPage (1, 0));
+
+    gdouble halfWidth = A4_WIDTH / 2;
+    gdouble halfHeight = A4_HEIGHT / 2;
+    assertPlacement (imposition, 0, 0.0, 0.0, halfWidth, halfHeight);
+    assertPlacement (imposition, 1, halfWidth, 0.0, A4_WIDTH, halfHeight);
+    assertPlacement (imposition, 2, 0.0, halfHeight, halfWidth, A4_HEIGHT);
+    assertPlacement (imposition, 3, halfWidth, halfHeight,
+                     A4_WIDTH, A4_HEIGHT);
+}
+
+///
+/// @brief Test six and eight pages per sheet.
+///
+/// Both must turn the sheet to landscape and use two rows.
+///
+void
+PrintImpositionTest::sixAndEightUp ()
+{
+    PrintImposition six (PRINT_PAGE_LAYOUT_6IN1, 5, A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (six.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)3, six.getNumColumns ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, six.getNumRows ());
+    CPPUNIT_ASSERT_EQUAL ((guint)1, six.getNumSheets ());
+    CPPUNIT_ASSERT_EQUAL (-1, six.getPage (0, 5));
+    assertPlacement (six, 4, 297.5, 526.1, 595.0, 315.9);
+
+    PrintImposition eight (PRINT_PAGE_LAYOUT_8IN1, 17, A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (eight.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)4, eight.getNumColumns ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, eight.getNumRows ());
+    CPPUNIT_ASSERT_EQUAL ((guint)3, eight.getNumSheets ());
+    CPPUNIT_ASSERT_EQUAL (16, eight.getPage (2, 0));
+    assertPlacement (eight, 7, 297.5, 210.4, 595.0, 0.1);
+}
+
+///
+/// @brief Test the order of the pages in a booklet.
+///
+/// Printed on both sides and folded, the eight pages must read in
+/// order: the first sheet has the last and first pages on its front
+/// and the second and next to last on its back.
+///
+void
+PrintImpositionTest::bookletOrder ()
+{
+    PrintImposition imposition (PRINT_PAGE_LAYOUT_BOOKLET, 8,
+                                A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT (imposition.isLandscape ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, imposition.getPagesPerSheet ());
+    CPPUNIT_ASSERT_EQUAL ((guint)4, imposition.getNumSheets ());
+
+    const gint order[][2] = { { 7, 0 }, { 1, 6 }, { 5, 2 }, { 3, 4 } };
+    for ( guint side = 0 ; side < 4 ; side++ )
+    {
+        CPPUNIT_ASSERT_EQUAL (order[side][0], imposition.getPage (side, 0));
+        CPPUNIT_ASSERT_EQUAL (order[side][1], imposition.getPage (side, 1));
+    }
+}
+
+///
+/// @brief Test a booklet whose pages aren't a multiple of four.
+///
+/// The missing pages must be left blank at the end of the booklet.
+///
+void
+PrintImpositionTest::bookletBlanks ()
+{
+    PrintImposition imposition (PRINT_PAGE_LAYOUT_BOOKLET, 5,
+                                A4_WIDTH, A4_HEIGHT);
+    CPPUNIT_ASSERT_EQUAL ((guint)4, imposition.getNumSheets ());
+
+    const gint order[][2] = { { -1, 0 }, { 1, -1 }, { -1, 2 }, { 3, 4 } };
+    for ( guint side = 0 ; side < 4 ; side++ )
+    {
+        CPPUNIT_ASSERT_EQUAL (order[side][0], imposition.getPage (side, 0));
+        CPPUNIT_ASSERT_EQUAL (order[side][1], imposition.getPage (side, 1));
+    }
+}
@@ -0,0 +1,56 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Print Imposition Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__PRINT_IMPOSITION_TEST_H__)
+#define __PRINT_IMPOSITION_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class PrintImpositionTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (PrintImpositionTest);
+        CPPUNIT_TEST (plain);
+        CPPUNIT_TEST (twoUp);
+        CPPUNIT_TEST (fourUp);
+        CPPUNIT_TEST (sixAndEightUp);
+        CPPUNIT_TEST (bookletOrder);
+        CPPUNIT_TEST (bookletBlanks);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void plain (void);
+            void twoUp (void);
+            void fourUp (void);
+            void sixAndEightUp (void);
+            void bookletOrder (void);
+            void bookletBlanks (void);
+
+        protected:
+            void assertPlacement (PrintImposition &imposition, guint slot,
+                                  gdouble left, gdouble top,
+                                  gdouble right, gdouble bottom);
+    };
+}
+
+#endif // !__PRINT_IMPOSITION_TEST_H__
@@ -22,11 +22,20 @@
 
 #include <epdfview.h>
 #include "DumbDocument.h"
+#include "DumbPrinterSource.h"
 #include "DumbPrintView.h"
 #include "PrintPterTest.h"
 
 using namespace ePDFView;
 
+// Constants.
+/// The microseconds to wait for the printers before giving up.
+static const gint64 PRINTERS_TIMEOUT = 10 * G_USEC_PER_SEC;
+/// The number of printers the test source has.
+static const guint NUM_PRINTERS = 5;
+/// The index of the test source's default printer.
+static const gint DEFAULT_PRINTER = 3;
+
 // Register the test suite into the `registry'.
 CPPUNIT_TEST_SUITE_REGISTRATION (PrintPterTest);
 
@@ -38,9 +47,11 @@ PrintPterTest::setUp ()
 {
     Config::loadFile (FALSE);
     m_Document = new DumbDocument ();
-    m_PrintPter = new PrintPter (m_Document);
-    m_View = new DumbPrintView ();
-    m_PrintPter->setView (m_View);
+    m_Source = new DumbPrinterSource (NUM_PRINTERS, DEFAULT_PRINTER);
+    PrinterCache::getCache ().setSource (m_Source);
+    m_PrintPter = NULL;
+    m_View = NULL;
+    openPresenter ();
 }
 
 ///
@@ -50,6 +61,19 @@ void
 PrintPterTest::tearDown ()
 {
     Config::destroy ();
+    closePresenter ();
+    // The jobs use the source, so they must end before it's deleted.
+    waitForPrinters ();
+    PrinterCache::destroy ();
+    delete m_Document;
+}
+
+///
+/// @brief Closes the print dialog.
+///
+void
+PrintPterTest::closePresenter ()
+{
     // Telling the presenter to cancel will delete the view and the
     // presenter.
     if ( NULL != m_PrintPter )
@@ -58,7 +82,38 @@ PrintPterTest::tearDown ()
         m_PrintPter = NULL;
         m_View = NULL;
     }
-    delete m_Document;
+}
+
+///
+/// @brief Opens the print dialog and waits for its printers.
+///
+void
+PrintPterTest::openPresenter ()
+{
+    m_PrintPter = new PrintPter (m_Document);
+    m_View = new DumbPrintView ();
+    m_PrintPter->setView (m_View);
+    CPPUNIT_ASSERT (waitForPrinters ());
+}
+
+///
+/// @brief Waits until no job is loading printers.
+///
+/// @return TRUE if the printers were loaded, FALSE if it timed out.
+///
+gboolean
+PrintPterTest::waitForPrinters ()
+{
+    PrinterCache &cache = PrinterCache::getCache ();
+    gint64 endTime = g_get_monotonic_time () + PRINTERS_TIMEOUT;
+    while ( cache.isLoading () && g_get_monotonic_time () < endTime )
+    {
+        // The notifications are idle callbacks when not debugging.
+        g_main_context_iteration (NULL, FALSE);
+        g_usleep (1000);
+    }
+
+    return !cache.isLoading ();
 }
 
 ///
@@ -130,3 +185,73 @@ PrintPterTest::pageRangeSensitivity ()
     m_PrintPter->pageRangeOptionChanged ();
     CPPUNIT_ASSERT ( m_View->isSensitivePageRange ());
 }
+
+///
+/// @brief Check the printers listed in the background.
+///
+/// All printers must be listed with their state, the default printer
+/// selected and its options shown.
+///
+void
+PrintPterTest::listPrinters ()
+{
+    CPPUNIT_ASSERT_EQUAL (NUM_PRINTERS, m_View->getNumPrinters ());
+    for ( guint printer = 0 ; printer < NUM_PRINTERS ; printer++ )
+    {
+        CPPUNIT_ASSERT_EQUAL ((gint)printer,
+                              m_View->getPrinterJobs (printer));
+        CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 ("Idle",
+                                            m_View->getPrinterState (printer)));
+    }
+    CPPUNIT_ASSERT_EQUAL (DEFAULT_PRINTER, m_View->getSelectedPrinter ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_View->getNumPageSizes ());
+    CPPUNIT_ASSERT (m_View->isSensitivePrintButton ());
+}
+
+///
+/// @brief Check that the printers are only asked once per session.
+///
+/// Opening the dialog again must show the same printers without
+/// asking the source again.
+///
+void
+PrintPterTest::cachedPrinters ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Source->getNumPrintersQueries ());
+    CPPUNIT_ASSERT_EQUAL (NUM_PRINTERS, m_Source->getNumAttributesQueries ());
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Source->getNumOptionsQueries ());
+
+    closePresenter ();
+    openPresenter ();
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Source->getNumPrintersQueries ());
+    CPPUNIT_ASSERT_EQUAL (NUM_PRINTERS, m_Source->getNumAttributesQueries ());
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Source->getNumOptionsQueries ());
+    CPPUNIT_ASSERT_EQUAL (NUM_PRINTERS, m_View->getNumPrinters ());
+    CPPUNIT_ASSERT_EQUAL (0, g_strcmp0 ("Idle", m_View->getPrinterState (0)));
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_View->getNumPageSizes ());
+
+    // Selecting another printer only asks for its options.
+    m_View->selectPrinter (0);
+    m_PrintPter->printerSelectionChanged ();
+    CPPUNIT_ASSERT (waitForPrinters ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_Source->getNumOptionsQueries ());
+    CPPUNIT_ASSERT_EQUAL ((guint)2, m_View->getNumPageSizes ());
+}
+
+///
+/// @brief Check the dialog without printers.
+///
+/// Nothing can be printed if there is no printer.
+///
+void
+PrintPterTest::noPrinters ()
+{
+    closePresenter ();
+    waitForPrinters ();
+    PrinterCache::destroy ();
+    m_Source = new DumbPrinterSource (0, -1);
+    PrinterCache::getCache ().setSource (m_Source);
+    openPresenter ();
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_View->getNumPrinters ());
+    CPPUNIT_ASSERT (!m_View->isSensitivePrintButton ());
+}
@@ -33,6 +33,9 @@ namespace ePDFView
         CPPUNIT_TEST (initialSensitivity);
         CPPUNIT_TEST (collateSensitivity);
         CPPUNIT_TEST (pageRangeSensitivity);
+        CPPUNIT_TEST (listPrinters);
+        CPPUNIT_TEST (cachedPrinters);
+        CPPUNIT_TEST (noPrinters);
         CPPUNIT_TEST_SUITE_END ();
 
         public:
@@ -42,11 +45,19 @@ namespace ePDFView
             void initialSensitivity (void);
             void collateSensitivity (void);
             void pageRangeSensitivity (void);
+            void listPrinters (void);
+            void cachedPrinters (void);
+            void noPrinters (void);
 
         protected:
             DumbDocument *m_Document;
             PrintPter *m_PrintPter;
+            DumbPrinterSource *m_Source;
             DumbPrintView *m_View;
+
+            void closePresenter (void);
+            void openPresenter (void);
+            gboolean waitForPrinters (void);
     };
 }
 
@@ -0,0 +1,197 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Thumbnail Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "ThumbnailCacheTest.h"
+
+using namespace ePDFView;
+
+// Register the test suite into the `registry'.
+CPPUNIT_TEST_SUITE_REGISTRATION (ThumbnailCacheTest);
+
+// Forward declarations.
+static DocumentPage *newThumbnail (void);
+
+// Constants.
+/// The width and height of the test thumbnails.
+static const gint TEST_THUMBNAIL_SIZE = 16;
+/// How many test thumbnails fit in the cache.
+static const gint TEST_CACHE_THUMBNAILS = 3;
+
+///
+/// @brief Sets up the environment for each test.
+///
+void
+ThumbnailCacheTest::setUp ()
+{
+    DocumentPage *thumbnail = newThumbnail ();
+    gsize size = thumbnail->getRowStride () * thumbnail->getHeight ();
+    delete thumbnail;
+    m_Cache = new ThumbnailCache (TEST_CACHE_THUMBNAILS * size);
+}
+
+///
+/// @brief Cleans up after each test.
+///
+void
+ThumbnailCacheTest::tearDown ()
+{
+    delete m_Cache;
+}
+
+///
+/// @brief Checks a cache without thumbnails.
+///
+void
+ThumbnailCacheTest::emptyCache ()
+{
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+    CPPUNIT_ASSERT (NULL == m_Cache->get (1));
+    // Removing a missing thumbnail does nothing.
+    m_Cache->remove (1);
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumThumbnails ());
+}
+
+///
+/// @brief Checks that the oldest thumbnail is deleted when full.
+///
+void
+ThumbnailCacheTest::evictLeastRecentlyUsed ()
+{
+    for ( gint pageNum = 1 ; pageNum <= TEST_CACHE_THUMBNAILS ; pageNum++ )
+    {
+        m_Cache->add (pageNum, newThumbnail ());
+    }
+    CPPUNIT_ASSERT_EQUAL ((guint)TEST_CACHE_THUMBNAILS,
+                          m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT_EQUAL (m_Cache->getBudget (), m_Cache->getSize ());
+
+    m_Cache->add (TEST_CACHE_THUMBNAILS + 1, newThumbnail ());
+    CPPUNIT_ASSERT_EQUAL ((guint)TEST_CACHE_THUMBNAILS,
+                          m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT (NULL == m_Cache->get (1));
+    for ( gint pageNum = 2 ; pageNum <= TEST_CACHE_THUMBNAILS + 1 ;
+          pageNum++ )
+    {
+        CPPUNIT_ASSERT (NULL != m_Cache->get (pageNum));
+    }
+}
+
+///
+/// @brief Checks that getting a thumbnail keeps it in the cache.
+///
+void
+ThumbnailCacheTest::touchOnGet ()
+{
+    for ( gint pageNum = 1 ; pageNum <= TEST_CACHE_THUMBNAILS ; pageNum++ )
+    {
+        m_Cache->add (pageNum, newThumbnail ());
+    }
+    // The first page is now the most recently used, so the second goes.
+    CPPUNIT_ASSERT (NULL != m_Cache->get (1));
+    m_Cache->add (TEST_CACHE_THUMBNAILS + 1, newThumbnail ());
+
+    CPPUNIT_ASSERT (NULL != m_Cache->get (1));
+    CPPUNIT_ASSERT (NULL == m_Cache->get (2));
+}
+
+///
+/// @brief Checks that releasing memory deletes the oldest thumbnails.
+///
+void
+ThumbnailCacheTest::releaseThumbnails ()
+{
+    m_Cache->add (1, newThumbnail ());
+    gsize size = m_Cache->getSize ();
+    m_Cache->add (2, newThumbnail ());
+    m_Cache->add (3, newThumbnail ());
+    // The first page is now the most recently used, so the second goes.
+    m_Cache->get (1);
+
+    CPPUNIT_ASSERT_EQUAL (size, m_Cache->release (size));
+    CPPUNIT_ASSERT (NULL == m_Cache->get (2));
+    CPPUNIT_ASSERT_EQUAL (2 * size, m_Cache->release (size + 1));
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumThumbnails ());
+}
+
+///
+/// @brief Checks that adding a page's thumbnail again replaces it.
+///
+void
+ThumbnailCacheTest::replaceThumbnail ()
+{
+    m_Cache->add (1, newThumbnail ());
+    gsize size = m_Cache->getSize ();
+    DocumentPage *thumbnail = newThumbnail ();
+    m_Cache->add (1, thumbnail);
+
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT_EQUAL (size, m_Cache->getSize ());
+    CPPUNIT_ASSERT (thumbnail == m_Cache->get (1));
+}
+
+///
+/// @brief Checks that a thumbnail bigger than the budget is still kept.
+///
+void
+ThumbnailCacheTest::keepOversizedThumbnail ()
+{
+    m_Cache->add (1, newThumbnail ());
+    DocumentPage *thumbnail = new DocumentPage ();
+    thumbnail->newPage (TEST_THUMBNAIL_SIZE * TEST_CACHE_THUMBNAILS,
+                        TEST_THUMBNAIL_SIZE * TEST_CACHE_THUMBNAILS);
+    m_Cache->add (2, thumbnail);
+
+    CPPUNIT_ASSERT_EQUAL ((guint)1, m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT (NULL == m_Cache->get (1));
+    CPPUNIT_ASSERT (thumbnail == m_Cache->get (2));
+}
+
+///
+/// @brief Checks that clearing the cache deletes all thumbnails.
+///
+void
+ThumbnailCacheTest::clearCache ()
+{
+    m_Cache->add (1, newThumbnail ());
+    m_Cache->add (2, newThumbnail ());
+    m_Cache->clear ();
+
+    CPPUNIT_ASSERT_EQUAL ((guint)0, m_Cache->getNumThumbnails ());
+    CPPUNIT_ASSERT_EQUAL ((gsize)0, m_Cache->getSize ());
+    CPPUNIT_ASSERT (NULL == m_Cache->get (1));
+    CPPUNIT_ASSERT (NULL == m_Cache->get (2));
+}
+
+///
+/// @brief Creates a test thumbnail.
+///
+/// @return A new TEST_THUMBNAIL_SIZE square page.
+///
+DocumentPage *
+newThumbnail ()
+{
+    DocumentPage *thumbnail = new DocumentPage ();
+    thumbnail->newPage (TEST_THUMBNAIL_SIZE, TEST_THUMBNAIL_SIZE);
+    return thumbnail;
+}
@@ -0,0 +1,59 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Thumbnail Cache Test Fixture.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__THUMBNAIL_CACHE_TEST_H__)
+#define __THUMBNAIL_CACHE_TEST_H__
+
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace ePDFView
+{
+    class ThumbnailCacheTest: public CppUnit::TestFixture
+    {
+        CPPUNIT_TEST_SUITE (ThumbnailCacheTest);
+        CPPUNIT_TEST (emptyCache);
+        CPPUNIT_TEST (evictLeastRecentlyUsed);
+        CPPUNIT_TEST (touchOnGet);
+        CPPUNIT_TEST (releaseThumbnails);
+        CPPUNIT_TEST (replaceThumbnail);
+        CPPUNIT_TEST (keepOversizedThumbnail);
+        CPPUNIT_TEST (clearCache);
+        CPPUNIT_TEST_SUITE_END ();
+
+        public:
+            void setUp (void);
+            void tearDown (void);
+
+            void emptyCache (void);
+            void evictLeastRecentlyUsed (void);
+            void touchOnGet (void);
+            void releaseThumbnails (void);
+            void replaceThumbnail (void);
+            void keepOversizedThumbnail (void);
+            void clearCache (void);
+
+        protected:
+            ThumbnailCache *m_Cache;
+    };
+}
+
+#endif // !__THUMBNAIL_CACHE_TEST_H__
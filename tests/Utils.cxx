@@ -21,6 +21,7 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include "Utils.h"
 
 ///
@@ -39,3 +40,26 @@ getTestFile (const gchar *fileName)
 
     return filePath;
 }
+
+///
+/// @brief Deletes a temporary directory and the files in it.
+///
+/// @param path The directory to delete.
+///
+void
+removeDirectory (const gchar *path)
+{
+    GDir *directory = g_dir_open (path, 0, NULL);
+    if ( NULL != directory )
+    {
+        const gchar *fileName;
+        while ( NULL != (fileName = g_dir_read_name (directory)) )
+        {
+            gchar *filePath = g_build_filename (path, fileName, NULL);
+            g_unlink (filePath);
+            g_free (filePath);
+        }
+        g_dir_close (directory);
+    }
+    g_rmdir (path);
+}
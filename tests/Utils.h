@@ -24,5 +24,6 @@
 #define __UTILS_TEST_H__
 
 gchar *getTestFile (const gchar *fileName);
+void removeDirectory (const gchar *path);
 
 #endif // !__UTILS_TEST_H__
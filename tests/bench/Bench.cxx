@@ -0,0 +1,90 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+///
+/// @brief Measures how long a function takes.
+///
+/// Runs @a func once to warm up and then @a iterations times more,
+/// measuring the wall clock time.
+///
+/// @param func The function to measure.
+/// @param data The data to pass to @a func.
+/// @param iterations The number of times to call @a func.
+///
+/// @return The mean time of a single call, in microseconds.
+///
+gdouble
+ePDFView::benchTime (BenchFunc func, gpointer data, guint iterations)
+{
+    g_assert (NULL != func && "Tried to measure a NULL function.");
+    g_assert (0 < iterations && "Tried to measure zero iterations.");
+
+    func (data);
+    gint64 start = g_get_monotonic_time ();
+    for ( guint iteration = 0 ; iteration < iterations ; iteration++ )
+    {
+        func (data);
+    }
+    gint64 end = g_get_monotonic_time ();
+
+    return (gdouble)(end - start) / (gdouble)iterations;
+}
+
+///
+/// @brief Prints a benchmark's result.
+///
+/// All results are printed in the same column format, so the output
+/// of two runs can be compared with diff.
+///
+/// @param benchName The name of the benchmark.
+/// @param caseName The name of the case measured inside the benchmark.
+/// @param microSeconds The measured time, in microseconds.
+/// @param extra Additional information to print, or NULL.
+///
+void
+ePDFView::benchReport (const gchar *benchName, const gchar *caseName,
+                       gdouble microSeconds, const gchar *extra)
+{
+    g_print ("%-16s %-28s %14.2f us  %s\n", benchName, caseName,
+             microSeconds, NULL != extra ? extra : "");
+}
+
+///
+/// @brief Returns the path to a benchmark's data file.
+///
+/// The benchmarks use the same documents that the test suite,
+/// whose directory is given at compile time by BENCH_DATA_DIR.
+///
+/// @param fileName The name of the data file.
+///
+/// @return The absolute path to @a fileName. It must be freed with g_free().
+///
+gchar *
+ePDFView::getBenchFile (const gchar *fileName)
+{
+    return g_build_filename (BENCH_DATA_DIR, fileName, NULL);
+}
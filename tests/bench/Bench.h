@@ -0,0 +1,51 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#if !defined (__BENCH_H__)
+#define __BENCH_H__
+
+namespace ePDFView
+{
+    ///
+    /// @brief A function to measure.
+    ///
+    /// @param data The data passed to benchTime().
+    ///
+    typedef void (*BenchFunc) (gpointer data);
+
+    gdouble benchTime (BenchFunc func, gpointer data, guint iterations);
+    void benchReport (const gchar *benchName, const gchar *caseName,
+                      gdouble microSeconds, const gchar *extra);
+    gchar *getBenchFile (const gchar *fileName);
+
+    // Benchmarks.
+    void benchCompressedPages (void);
+    void benchDocumentCopy (void);
+    void benchExport (void);
+    void benchFindResults (void);
+    void benchFirstPage (void);
+    void benchNamedDestinations (void);
+    void benchPipedLoad (void);
+    void benchSave (void);
+}
+
+#endif // !__BENCH_H__
@@ -0,0 +1,159 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const guint RENDER_ITERATIONS = 5;
+static const guint COMPRESS_ITERATIONS = 20;
+
+///
+/// @brief The data shared by all compressed pages cases.
+///
+typedef struct
+{
+    /// The cache to compress the pages to.
+    CompressedPageCache *cache;
+    /// The loaded document.
+    PDFDocument *document;
+    /// The rendered images of the document's pages.
+    GPtrArray *pages;
+} CompressedPagesData;
+
+///
+/// @brief Renders all pages of the document, as going back to a page
+///        dropped from the cache did before.
+///
+static void
+renderPages (gpointer user)
+{
+    CompressedPagesData *data = (CompressedPagesData *)user;
+    for ( gint pageNum = 1 ; pageNum <= data->document->getNumPages () ;
+          pageNum++ )
+    {
+        delete data->document->renderPage (pageNum);
+    }
+}
+
+///
+/// @brief Compresses the images of all pages, as done when they are
+///        dropped from the cache.
+///
+static void
+compressPages (gpointer user)
+{
+    CompressedPagesData *data = (CompressedPagesData *)user;
+    for ( guint page = 0 ; page < data->pages->len ; page++ )
+    {
+        data->cache->add (page + 1,
+                          (DocumentPage *)g_ptr_array_index (data->pages,
+                                                             page));
+    }
+}
+
+///
+/// @brief Compresses and then restores the images of all pages.
+///
+static void
+restorePages (gpointer user)
+{
+    CompressedPagesData *data = (CompressedPagesData *)user;
+    compressPages (user);
+    for ( guint page = 0 ; page < data->pages->len ; page++ )
+    {
+        delete data->cache->take (page + 1);
+    }
+}
+
+///
+/// @brief Compares rendering the pages again with restoring them from
+///        their compressed images.
+///
+/// All pages of test1.pdf are rendered, compressed as the document does
+/// with the pages dropped from its cache, and decompressed. The size
+/// of the compressed pages and the time to decompress each page are
+/// the same figures given by IDocument::getCacheCompressionRatio() and
+/// IDocument::getCacheDecodeTime().
+///
+void
+ePDFView::benchCompressedPages ()
+{
+    CompressedPagesData data;
+    data.cache = new CompressedPageCache (G_MAXSIZE);
+    data.document = new PDFDocument ();
+    data.pages = g_ptr_array_new ();
+    gchar *testFile = getBenchFile ("test1.pdf");
+    if ( !data.document->loadFile (testFile, NULL, NULL) )
+    {
+        g_printerr ("compressed-pages: couldn't load %s\n", testFile);
+        g_free (testFile);
+        g_ptr_array_free (data.pages, TRUE);
+        delete data.document;
+        delete data.cache;
+        return;
+    }
+    g_free (testFile);
+
+    gsize rawSize = 0;
+    for ( gint pageNum = 1 ; pageNum <= data.document->getNumPages () ;
+          pageNum++ )
+    {
+        DocumentPage *page = data.document->renderPage (pageNum);
+        rawSize += page->getRowStride () * page->getHeight ();
+        g_ptr_array_add (data.pages, page);
+    }
+
+    gdouble renderTime = benchTime (renderPages, &data, RENDER_ITERATIONS);
+    gchar *extra = g_strdup_printf ("%u pages, %" G_GSIZE_FORMAT " KiB",
+                                    data.pages->len, rawSize / 1024);
+    benchReport ("compressed-pages", "render-all-pages", renderTime, extra);
+    g_free (extra);
+
+    gdouble compressTime = benchTime (compressPages, &data,
+                                      COMPRESS_ITERATIONS);
+    extra = g_strdup_printf ("%" G_GSIZE_FORMAT " KiB, %.1fx smaller",
+                             data.cache->getSize () / 1024,
+                             data.cache->getCompressionRatio ());
+    benchReport ("compressed-pages", "compress-all-pages", compressTime,
+                 extra);
+    g_free (extra);
+
+    benchTime (restorePages, &data, COMPRESS_ITERATIONS);
+    gdouble decodeTime = data.cache->getDecodeTime () * 1000.0;
+    extra = g_strdup_printf ("%.1fx faster than rendering",
+                             0.0 < decodeTime ?
+                             renderTime / data.pages->len / decodeTime :
+                             0.0);
+    benchReport ("compressed-pages", "restore-one-page", decodeTime, extra);
+    g_free (extra);
+
+    for ( guint page = 0 ; page < data.pages->len ; page++ )
+    {
+        delete (DocumentPage *)g_ptr_array_index (data.pages, page);
+    }
+    g_ptr_array_free (data.pages, TRUE);
+    delete data.document;
+    delete data.cache;
+}
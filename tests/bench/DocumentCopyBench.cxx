@@ -0,0 +1,156 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <poppler.h>
+#include <cairo-pdf.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint SYNTHETIC_PAGES = 2000;
+static const guint COPY_ITERATIONS = 20;
+
+///
+/// @brief The data shared by all copy cases.
+///
+typedef struct
+{
+    /// The loaded document to copy.
+    PDFDocument *document;
+    /// The synthetic document's file name.
+    gchar *fileName;
+} CopyData;
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+///
+/// @brief Writes a long document.
+///
+/// @return The temporary file name of the document. Must be removed and
+///         freed when no longer needed. NULL on error.
+///
+static gchar *
+createDocument (void)
+{
+    gchar *fileName = NULL;
+    gint fd = g_file_open_tmp ("epdfview-benchXXXXXX.pdf", &fileName, NULL);
+    if ( -1 == fd )
+    {
+        return NULL;
+    }
+    close (fd);
+
+    cairo_surface_t *surface = cairo_pdf_surface_create (fileName, 612, 792);
+    cairo_t *context = cairo_create (surface);
+    for ( gint page = 0 ; page < SYNTHETIC_PAGES ; page++ )
+    {
+        gchar *text = g_strdup_printf ("Page %d", page + 1);
+        cairo_move_to (context, 72, 72);
+        cairo_show_text (context, text);
+        cairo_show_page (context);
+        g_free (text);
+    }
+    cairo_destroy (context);
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+
+    return fileName;
+}
+#endif // CAIRO_VERSION >= 1.16.0
+
+///
+/// @brief Gets a document to print by opening the file again, as
+///        PDFDocument::copy() did before.
+///
+static void
+copyByReloading (gpointer user)
+{
+    CopyData *data = (CopyData *)user;
+    PDFDocument *document = new PDFDocument ();
+    document->loadFile (data->fileName, NULL, NULL);
+    delete document;
+}
+
+///
+/// @brief Gets a document to print from the shared core.
+///
+/// After the first copy, each copy takes the parsed document that the
+/// previous one gave back when deleted.
+///
+static void
+copyBySharing (gpointer user)
+{
+    CopyData *data = (CopyData *)user;
+    delete data->document->copy ();
+}
+
+///
+/// @brief Compares the cost of copying a document to print it.
+///
+/// A synthetic document with thousands of pages is written with cairo,
+/// loaded and then copied by opening the file again and by taking the
+/// parsed documents the earlier copies gave back to the shared core.
+///
+void
+ePDFView::benchDocumentCopy ()
+{
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+    CopyData data;
+    data.fileName = createDocument ();
+    if ( NULL == data.fileName )
+    {
+        g_printerr ("document-copy: couldn't create the test document\n");
+        return;
+    }
+    data.document = new PDFDocument ();
+    if ( !data.document->loadFile (data.fileName, NULL, NULL) )
+    {
+        g_printerr ("document-copy: couldn't load the test document\n");
+        delete data.document;
+        g_unlink (data.fileName);
+        g_free (data.fileName);
+        return;
+    }
+    data.document->loadPageSizes ();
+
+    gdouble reloadTime = benchTime (copyByReloading, &data,
+                                    COPY_ITERATIONS);
+    gchar *extra = g_strdup_printf ("%d pages", SYNTHETIC_PAGES);
+    benchReport ("document-copy", "reload-file", reloadTime, extra);
+    g_free (extra);
+
+    gdouble shareTime = benchTime (copyBySharing, &data, COPY_ITERATIONS);
+    extra = g_strdup_printf ("%.1fx faster",
+                             0.0 < shareTime ? reloadTime / shareTime : 0.0);
+    benchReport ("document-copy", "shared-core", shareTime, extra);
+    g_free (extra);
+
+    delete data.document;
+    g_unlink (data.fileName);
+    g_free (data.fileName);
+#else // CAIRO_VERSION < 1.16.0
+    g_printerr ("document-copy: needs cairo 1.16 to write the test document\n");
+#endif // CAIRO_VERSION >= 1.16.0
+}
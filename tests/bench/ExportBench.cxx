@@ -0,0 +1,113 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <glib/gstdio.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gdouble EXPORT_RESOLUTION = 150.0;
+static const guint EXPORT_ITERATIONS = 3;
+
+///
+/// @brief The data shared by all export cases.
+///
+typedef struct
+{
+    /// The loaded document to export.
+    PDFDocument *document;
+    /// The output pattern of the images.
+    gchar *pattern;
+    /// The number of rendering threads.
+    guint numThreads;
+} ExportData;
+
+///
+/// @brief Exports all pages as images.
+///
+static void
+exportImages (gpointer user)
+{
+    ExportData *data = (ExportData *)user;
+    DocumentExporter exporter (data->document);
+    exporter.setOutputPattern (data->pattern);
+    exporter.setResolution (EXPORT_RESOLUTION, NULL);
+    exporter.setNumThreads (data->numThreads);
+    exporter.exportPages (NULL);
+}
+
+///
+/// @brief Compares exporting the pages as images from one thread and
+///        from a thread per processor.
+///
+void
+ePDFView::benchExport ()
+{
+    gchar *directory = g_dir_make_tmp ("epdfview-benchXXXXXX", NULL);
+    if ( NULL == directory )
+    {
+        g_printerr ("export: couldn't create the output directory\n");
+        return;
+    }
+    ExportData data;
+    data.document = new PDFDocument ();
+    data.pattern = g_build_filename (directory, "page-%d.png", NULL);
+    gchar *fileName = getBenchFile ("test1.pdf");
+    if ( data.document->loadFile (fileName, NULL, NULL) )
+    {
+        gint numPages = data.document->getNumPages ();
+        data.numThreads = 1;
+        gdouble serialTime = benchTime (exportImages, &data,
+                                        EXPORT_ITERATIONS);
+        gchar *extra = g_strdup_printf ("%d pages", numPages);
+        benchReport ("export", "png-1-thread", serialTime, extra);
+        g_free (extra);
+
+        data.numThreads = g_get_num_processors ();
+        gdouble parallelTime = benchTime (exportImages, &data,
+                                          EXPORT_ITERATIONS);
+        extra = g_strdup_printf ("%u threads, %.1fx faster", data.numThreads,
+                                 0.0 < parallelTime ?
+                                 serialTime / parallelTime : 0.0);
+        benchReport ("export", "png-per-processor", parallelTime, extra);
+        g_free (extra);
+
+        for ( gint pageNum = 1 ; pageNum <= numPages ; pageNum++ )
+        {
+            gchar *image =
+                DocumentExporter::formatFileName (data.pattern, pageNum, NULL);
+            g_unlink (image);
+            g_free (image);
+        }
+    }
+    else
+    {
+        g_printerr ("export: couldn't load %s\n", fileName);
+    }
+    g_free (fileName);
+    delete data.document;
+    g_free (data.pattern);
+    g_rmdir (directory);
+    g_free (directory);
+}
@@ -0,0 +1,216 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const guint SYNTHETIC_MATCHES = 100000;
+static const guint SYNTHETIC_ITERATIONS = 20;
+static const guint DOCUMENT_ITERATIONS = 10;
+
+///
+/// @brief Raw match coordinates, as Poppler would give them.
+///
+typedef struct
+{
+    gdouble x1;
+    gdouble y1;
+    gdouble x2;
+    gdouble y2;
+} RawMatch;
+
+///
+/// @brief The data shared by the synthetic find results cases.
+///
+typedef struct
+{
+    /// The matches to store.
+    RawMatch *matches;
+    /// The number of matches.
+    guint numMatches;
+    /// A sum of the stored coordinates, to keep the walk from being
+    /// optimised away.
+    gdouble checksum;
+} SyntheticData;
+
+///
+/// @brief The data for the real document case.
+///
+typedef struct
+{
+    /// The loaded document to search into.
+    PDFDocument *document;
+    /// The text to find in all pages.
+    const gchar *textToFind;
+    /// The total number of matches found on the last pass.
+    guint numMatches;
+} DocumentData;
+
+///
+/// @brief Stores the results the way it was done before.
+///
+/// This allocates a DocumentRectangle for each match, prepends it to a
+/// GList, reverses the list, walks it as the presenter does when going
+/// to the next match and finally deletes each rectangle.
+///
+static void
+storeInList (gpointer user)
+{
+    SyntheticData *data = (SyntheticData *)user;
+    GList *results = NULL;
+    for ( guint match = 0 ; match < data->numMatches ; match++ )
+    {
+        RawMatch *raw = &data->matches[match];
+        results = g_list_prepend (results,
+                new DocumentRectangle (raw->x1, raw->y1, raw->x2, raw->y2));
+    }
+    results = g_list_reverse (results);
+
+    for ( GList *item = g_list_first (results) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        data->checksum += ((DocumentRectangle *)item->data)->getX1 ();
+    }
+
+    for ( GList *item = g_list_first (results) ; NULL != item ;
+          item = g_list_next (item) )
+    {
+        delete (DocumentRectangle *)item->data;
+    }
+    g_list_free (results);
+}
+
+///
+/// @brief Stores the results as IDocument::findTextInPage() does now.
+///
+/// All rectangles are stored by value in a single array sized for the
+/// number of matches.
+///
+static void
+storeInArray (gpointer user)
+{
+    SyntheticData *data = (SyntheticData *)user;
+    GArray *results = g_array_sized_new (FALSE, FALSE,
+                                         sizeof (DocumentRectangle),
+                                         data->numMatches);
+    for ( guint match = 0 ; match < data->numMatches ; match++ )
+    {
+        RawMatch *raw = &data->matches[match];
+        DocumentRectangle rect (raw->x1, raw->y1, raw->x2, raw->y2);
+        g_array_append_val (results, rect);
+    }
+
+    for ( guint match = 0 ; match < results->len ; match++ )
+    {
+        data->checksum +=
+            g_array_index (results, DocumentRectangle, match).getX1 ();
+    }
+
+    g_array_free (results, TRUE);
+}
+
+///
+/// @brief Searches a text in all pages of a real document.
+///
+static void
+findInDocument (gpointer user)
+{
+    DocumentData *data = (DocumentData *)user;
+    data->numMatches = 0;
+    gint numPages = data->document->getNumPages ();
+    for ( gint pageNum = 1 ; pageNum <= numPages ; pageNum++ )
+    {
+        GArray *results =
+            data->document->findTextInPage (pageNum, data->textToFind);
+        if ( NULL != results )
+        {
+            data->numMatches += results->len;
+            g_array_free (results, TRUE);
+        }
+    }
+}
+
+///
+/// @brief Compares the find results storage.
+///
+/// The synthetic cases store a large number of matches, as a common word
+/// on a large document would give, with the old list of heap allocated
+/// rectangles and with the contiguous array. The last case measures
+/// a real search on the test document.
+///
+void
+ePDFView::benchFindResults ()
+{
+    SyntheticData synthetic;
+    synthetic.numMatches = SYNTHETIC_MATCHES;
+    synthetic.matches = g_new (RawMatch, SYNTHETIC_MATCHES);
+    synthetic.checksum = 0.0;
+    for ( guint match = 0 ; match < SYNTHETIC_MATCHES ; match++ )
+    {
+        synthetic.matches[match].x1 = (gdouble)(match % 500);
+        synthetic.matches[match].y1 = (gdouble)(match % 700);
+        synthetic.matches[match].x2 = synthetic.matches[match].x1 + 20.0;
+        synthetic.matches[match].y2 = synthetic.matches[match].y1 + 9.0;
+    }
+
+    gchar *extra = NULL;
+    gdouble listTime = benchTime (storeInList, &synthetic,
+                                  SYNTHETIC_ITERATIONS);
+    extra = g_strdup_printf ("%u matches, %u allocations",
+                             SYNTHETIC_MATCHES, 2 * SYNTHETIC_MATCHES);
+    benchReport ("find-results", "glist-of-rectangles", listTime, extra);
+    g_free (extra);
+
+    gdouble arrayTime = benchTime (storeInArray, &synthetic,
+                                   SYNTHETIC_ITERATIONS);
+    extra = g_strdup_printf ("%u matches, 2 allocations, %.1fx faster",
+                             SYNTHETIC_MATCHES,
+                             0.0 < arrayTime ? listTime / arrayTime : 0.0);
+    benchReport ("find-results", "array-of-rectangles", arrayTime, extra);
+    g_free (extra);
+    g_free (synthetic.matches);
+
+    DocumentData document;
+    document.document = new PDFDocument ();
+    document.textToFind = "e";
+    document.numMatches = 0;
+    gchar *testFile = getBenchFile ("test1.pdf");
+    if ( document.document->loadFile (testFile, NULL, NULL) )
+    {
+        gdouble findTime = benchTime (findInDocument, &document,
+                                      DOCUMENT_ITERATIONS);
+        extra = g_strdup_printf ("%u matches of '%s' in %d pages",
+                                 document.numMatches, document.textToFind,
+                                 document.document->getNumPages ());
+        benchReport ("find-results", "test1.pdf-all-pages", findTime, extra);
+        g_free (extra);
+    }
+    else
+    {
+        g_printerr ("find-results: couldn't load %s\n", testFile);
+    }
+    g_free (testFile);
+    delete document.document;
+}
@@ -0,0 +1,196 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <poppler.h>
+#include <cairo-pdf.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint SYNTHETIC_PAGES = 2000;
+static const gint SECTIONS_PER_PAGE = 5;
+static const guint OPEN_ITERATIONS = 5;
+
+///
+/// @brief The data shared by all first page cases.
+///
+typedef struct
+{
+    /// The synthetic document's file name.
+    gchar *fileName;
+    /// The number of outline items read on the last pass.
+    gint numOutlineItems;
+} FirstPageData;
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+///
+/// @brief Writes a long document with a large outline.
+///
+/// @return The temporary file name of the document. Must be removed and
+///         freed when no longer needed. NULL on error.
+///
+static gchar *
+createDocument (void)
+{
+    gchar *fileName = NULL;
+    gint fd = g_file_open_tmp ("epdfview-benchXXXXXX.pdf", &fileName, NULL);
+    if ( -1 == fd )
+    {
+        return NULL;
+    }
+    close (fd);
+
+    cairo_surface_t *surface = cairo_pdf_surface_create (fileName, 612, 792);
+    cairo_t *context = cairo_create (surface);
+    for ( gint page = 0 ; page < SYNTHETIC_PAGES ; page++ )
+    {
+        gchar *title = g_strdup_printf ("Chapter %d", page + 1);
+        gchar *attributes = g_strdup_printf ("page=%d", page + 1);
+        gint chapter =
+            cairo_pdf_surface_add_outline (surface, CAIRO_PDF_OUTLINE_ROOT,
+                                           title, attributes,
+                                           (cairo_pdf_outline_flags_t)0);
+        g_free (attributes);
+        g_free (title);
+        for ( gint section = 0 ; section < SECTIONS_PER_PAGE ; section++ )
+        {
+            title = g_strdup_printf ("Section %d.%d", page + 1, section);
+            attributes = g_strdup_printf ("page=%d pos=[72 %d]", page + 1,
+                                          72 + section * 100);
+            cairo_pdf_surface_add_outline (surface, chapter, title,
+                                           attributes,
+                                           (cairo_pdf_outline_flags_t)0);
+            g_free (attributes);
+            g_free (title);
+        }
+        cairo_move_to (context, 72, 72);
+        cairo_show_text (context, "Page");
+        cairo_show_page (context);
+    }
+    cairo_destroy (context);
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+
+    return fileName;
+}
+#endif // CAIRO_VERSION >= 1.16.0
+
+///
+/// @brief Counts all the items in an outline.
+///
+/// @param outline The outline to count its items.
+///
+/// @return The number of items below @a outline.
+///
+static gint
+countOutlineItems (DocumentOutline *outline)
+{
+    gint items = 0;
+    for ( DocumentOutline *child = outline->getFirstChild () ;
+          NULL != child ; child = outline->getNextChild () )
+    {
+        items += 1 + countOutlineItems (child);
+    }
+    return items;
+}
+
+///
+/// @brief Opens the document and renders the first page after reading
+///        its outline and page sizes, as the document was opened before.
+///
+static void
+openOutlineFirst (gpointer user)
+{
+    FirstPageData *data = (FirstPageData *)user;
+    PDFDocument *document = new PDFDocument ();
+    document->loadFile (data->fileName, NULL, NULL);
+    DocumentOutline *outline = document->loadOutline ();
+    data->numOutlineItems = countOutlineItems (outline);
+    document->loadPageSizes ();
+    delete document->renderPage (1);
+    delete outline;
+    delete document;
+}
+
+///
+/// @brief Opens the document and renders the first page only, as the
+///        document is opened now before JobLoadOutline is run.
+///
+static void
+openFirstPage (gpointer user)
+{
+    FirstPageData *data = (FirstPageData *)user;
+    PDFDocument *document = new PDFDocument ();
+    document->loadFile (data->fileName, NULL, NULL);
+    delete document->renderPage (1);
+    delete document;
+}
+
+///
+/// @brief Compares the time to first page reading the outline before
+///        or after rendering it.
+///
+/// A synthetic document with thousands of pages and outline items is
+/// written with cairo. It's then opened and its first page rendered
+/// reading the outline and the page sizes before, the way it was done
+/// before, and reading only what the first page needs, as now the
+/// outline and page sizes are read by background jobs.
+///
+void
+ePDFView::benchFirstPage ()
+{
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+    FirstPageData data;
+    data.fileName = createDocument ();
+    data.numOutlineItems = 0;
+    if ( NULL == data.fileName )
+    {
+        g_printerr ("first-page: couldn't create the test document\n");
+        return;
+    }
+
+    gdouble outlineFirstTime = benchTime (openOutlineFirst, &data,
+                                          OPEN_ITERATIONS);
+    gchar *extra = g_strdup_printf ("%d pages, %d outline items",
+                                    SYNTHETIC_PAGES, data.numOutlineItems);
+    benchReport ("first-page", "outline-then-first-page", outlineFirstTime,
+                 extra);
+    g_free (extra);
+
+    gdouble firstPageTime = benchTime (openFirstPage, &data,
+                                       OPEN_ITERATIONS);
+    extra = g_strdup_printf ("%.1fx faster",
+                             0.0 < firstPageTime ?
+                             outlineFirstTime / firstPageTime : 0.0);
+    benchReport ("first-page", "first-page-only", firstPageTime, extra);
+    g_free (extra);
+
+    g_unlink (data.fileName);
+    g_free (data.fileName);
+#else // CAIRO_VERSION < 1.16.0
+    g_printerr ("first-page: needs cairo 1.16 to write the test document\n");
+#endif // CAIRO_VERSION >= 1.16.0
+}
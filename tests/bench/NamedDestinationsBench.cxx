@@ -0,0 +1,312 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <poppler.h>
+#include <cairo-pdf.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint SYNTHETIC_PAGES = 200;
+static const gint SECTIONS_PER_PAGE = 50;
+static const guint LOAD_ITERATIONS = 5;
+static const guint LINKS_ITERATIONS = 5;
+
+///
+/// @brief The data shared by all named destinations cases.
+///
+typedef struct
+{
+    /// The synthetic document's file name.
+    gchar *fileName;
+    /// The loaded document, for the links cases.
+    PDFDocument *document;
+    /// The same document loaded straight with Poppler.
+    PopplerDocument *popplerDocument;
+    /// The number of named destinations resolved on the last pass.
+    guint numResolved;
+} NamedDestData;
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+///
+/// @brief Writes a document with lots of named destinations.
+///
+/// This mimics what LaTeX's hyperref does: every section has a named
+/// destination, an outline entry and a link pointing to it by name.
+///
+/// @return The temporary file name of the document. Must be removed and
+///         freed when no longer needed. NULL on error.
+///
+static gchar *
+createDocument (void)
+{
+    gchar *fileName = NULL;
+    gint fd = g_file_open_tmp ("epdfview-benchXXXXXX.pdf", &fileName, NULL);
+    if ( -1 == fd )
+    {
+        return NULL;
+    }
+    close (fd);
+
+    cairo_surface_t *surface = cairo_pdf_surface_create (fileName, 612, 792);
+    cairo_t *context = cairo_create (surface);
+    for ( gint page = 0 ; page < SYNTHETIC_PAGES ; page++ )
+    {
+        for ( gint section = 0 ; section < SECTIONS_PER_PAGE ; section++ )
+        {
+            gint y = 20 + section * 15;
+            gchar *attributes =
+                g_strdup_printf ("name='section.%d.%d' x=72 y=%d",
+                                 page, section, y);
+            cairo_tag_begin (context, CAIRO_TAG_DEST, attributes);
+            cairo_tag_end (context, CAIRO_TAG_DEST);
+            g_free (attributes);
+
+            gchar *title = g_strdup_printf ("Section %d.%d", page, section);
+            attributes = g_strdup_printf ("dest='section.%d.%d'",
+                                          page, section);
+            cairo_pdf_surface_add_outline (surface, CAIRO_PDF_OUTLINE_ROOT,
+                                           title, attributes,
+                                           (cairo_pdf_outline_flags_t)0);
+            g_free (attributes);
+            g_free (title);
+
+            // Link to the same section on the next page.
+            attributes =
+                g_strdup_printf ("rect=[300 %d 200 10] dest='section.%d.%d'",
+                                 y, (page + 1) % SYNTHETIC_PAGES, section);
+            cairo_tag_begin (context, CAIRO_TAG_LINK, attributes);
+            cairo_tag_end (context, CAIRO_TAG_LINK);
+            g_free (attributes);
+        }
+        cairo_show_page (context);
+    }
+    cairo_destroy (context);
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+
+    return fileName;
+}
+#endif // CAIRO_VERSION >= 1.16.0
+
+///
+/// @brief Looks each outline's named destination up, as loading used to.
+///
+/// @param document The document to look the names in.
+/// @param iter The outline level to walk. It is freed.
+///
+/// @return The number of named destinations found.
+///
+static guint
+findOutlineDestinations (PopplerDocument *document, PopplerIndexIter *iter)
+{
+    guint found = 0;
+    if ( NULL == iter )
+    {
+        return found;
+    }
+
+    do
+    {
+        PopplerAction *action = poppler_index_iter_get_action (iter);
+        if ( POPPLER_ACTION_GOTO_DEST == action->type )
+        {
+            PopplerDest *destination = ((PopplerActionGotoDest *)action)->dest;
+            if ( POPPLER_DEST_NAMED == destination->type )
+            {
+                PopplerDest *named =
+                    poppler_document_find_dest (document,
+                                                destination->named_dest);
+                if ( NULL != named )
+                {
+                    found++;
+                    poppler_dest_free (named);
+                }
+            }
+        }
+        poppler_action_free (action);
+        found += findOutlineDestinations (document,
+                                          poppler_index_iter_get_child (iter));
+    }
+    while ( poppler_index_iter_next (iter) );
+    poppler_index_iter_free (iter);
+
+    return found;
+}
+
+///
+/// @brief Opens the document and resolves the outline name by name.
+///
+static void
+loadPerName (gpointer user)
+{
+    NamedDestData *data = (NamedDestData *)user;
+    gchar *uri = g_filename_to_uri (data->fileName, NULL, NULL);
+    PopplerDocument *document = poppler_document_new_from_file (uri, NULL,
+                                                                NULL);
+    g_free (uri);
+    data->numResolved =
+        findOutlineDestinations (document, poppler_index_iter_new (document));
+    g_object_unref (G_OBJECT (document));
+}
+
+///
+/// @brief Opens the document and reads the outline as PDFDocument does now.
+///
+static void
+loadWithTable (gpointer user)
+{
+    NamedDestData *data = (NamedDestData *)user;
+    PDFDocument *document = new PDFDocument ();
+    document->loadFile (data->fileName, NULL, NULL);
+    DocumentOutline *outline = document->loadOutline ();
+    data->numResolved = outline->getNumChildren ();
+    delete outline;
+    delete document;
+}
+
+///
+/// @brief Extracts all links resolving each name, as rendering used to.
+///
+static void
+linksPerName (gpointer user)
+{
+    NamedDestData *data = (NamedDestData *)user;
+    PopplerDocument *document = data->popplerDocument;
+    data->numResolved = 0;
+    gint numPages = poppler_document_get_n_pages (document);
+    for ( gint pageNum = 0 ; pageNum < numPages ; pageNum++ )
+    {
+        PopplerPage *page = poppler_document_get_page (document, pageNum);
+        GList *links = poppler_page_get_link_mapping (page);
+        for ( GList *item = g_list_first (links) ; NULL != item ;
+              item = g_list_next (item) )
+        {
+            PopplerAction *action = ((PopplerLinkMapping *)item->data)->action;
+            if ( POPPLER_ACTION_GOTO_DEST != action->type )
+            {
+                continue;
+            }
+            PopplerDest *destination = ((PopplerActionGotoDest *)action)->dest;
+            if ( POPPLER_DEST_NAMED == destination->type )
+            {
+                PopplerDest *named =
+                    poppler_document_find_dest (document,
+                                                destination->named_dest);
+                if ( NULL != named )
+                {
+                    data->numResolved++;
+                    poppler_dest_free (named);
+                }
+            }
+        }
+        poppler_page_free_link_mapping (links);
+        g_object_unref (G_OBJECT (page));
+    }
+}
+
+///
+/// @brief Extracts all links through the document's named table.
+///
+static void
+linksWithTable (gpointer user)
+{
+    NamedDestData *data = (NamedDestData *)user;
+    data->numResolved = 0;
+    gint numPages = data->document->getNumPages ();
+    for ( gint pageNum = 1 ; pageNum <= numPages ; pageNum++ )
+    {
+        DocumentLinkIndex links;
+        data->document->getPageLinks (pageNum, &links);
+        data->numResolved += links.getNumLinks ();
+    }
+}
+
+///
+/// @brief Compares resolving named destinations one by one and the table.
+///
+/// A synthetic document with as many named destinations as a large
+/// hyperref document is written with cairo. Then it is loaded and all of
+/// its links extracted by looking each name up in the document, as it
+/// was done before, and through PDFDocument's named destinations table.
+///
+void
+ePDFView::benchNamedDestinations ()
+{
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+    NamedDestData data;
+    data.fileName = createDocument ();
+    data.document = NULL;
+    data.popplerDocument = NULL;
+    data.numResolved = 0;
+    if ( NULL == data.fileName )
+    {
+        g_printerr ("named-dests: couldn't create the test document\n");
+        return;
+    }
+
+    gchar *extra = NULL;
+    gdouble perNameTime = benchTime (loadPerName, &data, LOAD_ITERATIONS);
+    extra = g_strdup_printf ("%d pages, %u outline names resolved",
+                             SYNTHETIC_PAGES, data.numResolved);
+    benchReport ("named-dests", "load-find-dest-per-name", perNameTime, extra);
+    g_free (extra);
+
+    gdouble tableTime = benchTime (loadWithTable, &data, LOAD_ITERATIONS);
+    extra = g_strdup_printf ("%u outline entries, %.1fx faster",
+                             data.numResolved,
+                             0.0 < tableTime ? perNameTime / tableTime : 0.0);
+    benchReport ("named-dests", "load-names-table", tableTime, extra);
+    g_free (extra);
+
+    gchar *uri = g_filename_to_uri (data.fileName, NULL, NULL);
+    data.popplerDocument = poppler_document_new_from_file (uri, NULL, NULL);
+    g_free (uri);
+    perNameTime = benchTime (linksPerName, &data, LINKS_ITERATIONS);
+    extra = g_strdup_printf ("%u link names resolved", data.numResolved);
+    benchReport ("named-dests", "links-find-dest-per-name", perNameTime,
+                 extra);
+    g_free (extra);
+    g_object_unref (G_OBJECT (data.popplerDocument));
+
+    data.document = new PDFDocument ();
+    if ( data.document->loadFile (data.fileName, NULL, NULL) )
+    {
+        tableTime = benchTime (linksWithTable, &data, LINKS_ITERATIONS);
+        extra = g_strdup_printf ("%u links, %.1fx faster", data.numResolved,
+                                 0.0 < tableTime ?
+                                 perNameTime / tableTime : 0.0);
+        benchReport ("named-dests", "links-names-table", tableTime, extra);
+        g_free (extra);
+    }
+    delete data.document;
+
+    g_unlink (data.fileName);
+    g_free (data.fileName);
+#else // CAIRO_VERSION < 1.16.0
+    g_printerr ("named-dests: needs cairo 1.16 to write the test document\n");
+#endif // CAIRO_VERSION >= 1.16.0
+}
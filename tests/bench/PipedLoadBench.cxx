@@ -0,0 +1,267 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#include <stdio.h>
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <poppler.h>
+#include <cairo-pdf.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint SYNTHETIC_PAGES = 32;
+static const gint IMAGE_SIZE = 768;
+static const guint LOAD_ITERATIONS = 3;
+/// The chunk size that the old standard input copy used.
+static const gsize OLD_CHUNK_SIZE = 512;
+
+///
+/// @brief The data shared by all piped load cases.
+///
+typedef struct
+{
+    /// The synthetic document's file name.
+    gchar *fileName;
+    /// The synthetic document's contents, to write to the pipe.
+    gchar *contents;
+    /// The size of contents.
+    gsize length;
+    /// The pipe's end to write the contents to.
+    gint writeEnd;
+    /// The number of pages of the last loaded document.
+    gint numPages;
+} PipedLoadData;
+
+///
+/// @brief Writes a large document whose images don't compress.
+///
+/// @return The temporary file name of the document. Must be removed and
+///         freed when no longer needed. NULL on error.
+///
+static gchar *
+createDocument (void)
+{
+    gchar *fileName = NULL;
+    gint fd = g_file_open_tmp ("epdfview-benchXXXXXX.pdf", &fileName, NULL);
+    if ( -1 == fd )
+    {
+        return NULL;
+    }
+    close (fd);
+
+    cairo_surface_t *image =
+        cairo_image_surface_create (CAIRO_FORMAT_RGB24, IMAGE_SIZE, IMAGE_SIZE);
+    cairo_surface_t *surface = cairo_pdf_surface_create (fileName,
+                                                         IMAGE_SIZE,
+                                                         IMAGE_SIZE);
+    cairo_t *context = cairo_create (surface);
+    for ( gint page = 0 ; page < SYNTHETIC_PAGES ; page++ )
+    {
+        cairo_surface_flush (image);
+        guint32 *pixels = (guint32 *)cairo_image_surface_get_data (image);
+        gint stride = cairo_image_surface_get_stride (image) / sizeof (guint32);
+        for ( gint pixel = 0 ; pixel < stride * IMAGE_SIZE ; pixel++ )
+        {
+            pixels[pixel] = g_random_int ();
+        }
+        cairo_surface_mark_dirty (image);
+
+        cairo_set_source_surface (context, image, 0, 0);
+        cairo_paint (context);
+        cairo_show_page (context);
+    }
+    cairo_destroy (context);
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+    cairo_surface_destroy (image);
+
+    return fileName;
+}
+
+///
+/// @brief Writes the document to the pipe, as a PDF generator would.
+///
+/// @param user The PipedLoadData with the contents and the pipe's end.
+///
+/// @return NULL.
+///
+static gpointer
+writeToPipe (gpointer user)
+{
+    PipedLoadData *data = (PipedLoadData *)user;
+    gsize written = 0;
+    while ( written < data->length )
+    {
+        ssize_t writeBytes = write (data->writeEnd, data->contents + written,
+                                    data->length - written);
+        if ( 0 > writeBytes )
+        {
+            break;
+        }
+        written += writeBytes;
+    }
+    close (data->writeEnd);
+
+    return NULL;
+}
+
+///
+/// @brief Runs a load function with the document piped to stdin.
+///
+/// @param load The function to load the document from stdin.
+/// @param data The data to pass to @a load.
+///
+static void
+withPipedInput (BenchFunc load, PipedLoadData *data)
+{
+    gint ends[2];
+    if ( 0 != pipe (ends) )
+    {
+        return;
+    }
+    gint savedInput = dup (STDIN_FILENO);
+    dup2 (ends[0], STDIN_FILENO);
+    close (ends[0]);
+    data->writeEnd = ends[1];
+    GThread *writer = g_thread_new ("bench-writer", writeToPipe, data);
+
+    load (data);
+
+    g_thread_join (writer);
+    dup2 (savedInput, STDIN_FILENO);
+    close (savedInput);
+    clearerr (stdin);
+}
+
+///
+/// @brief Copies stdin to a temporary file and opens it, as it was done.
+///
+static void
+loadTemporaryCopy (gpointer user)
+{
+    PipedLoadData *data = (PipedLoadData *)user;
+    gchar *tmpFileName;
+    gint fd = g_file_open_tmp ("epdfviewXXXXXX", &tmpFileName, NULL);
+    if ( -1 == fd )
+    {
+        return;
+    }
+    while ( !feof (stdin) )
+    {
+        gchar inputLine[OLD_CHUNK_SIZE];
+        size_t readBytes = fread (inputLine, sizeof (char),
+                                  sizeof (inputLine), stdin);
+        if ( readBytes != (size_t)write (fd, inputLine, readBytes) )
+        {
+            break;
+        }
+    }
+    close (fd);
+
+    gchar *uri = g_filename_to_uri (tmpFileName, NULL, NULL);
+    PopplerDocument *document = poppler_document_new_from_file (uri, NULL,
+                                                                NULL);
+    g_free (uri);
+    data->numPages = 0;
+    if ( NULL != document )
+    {
+        data->numPages = poppler_document_get_n_pages (document);
+        g_object_unref (G_OBJECT (document));
+    }
+    g_unlink (tmpFileName);
+    g_free (tmpFileName);
+}
+
+///
+/// @brief Loads stdin as PDFDocument::loadFile() does now.
+///
+static void
+loadStandardInput (gpointer user)
+{
+    PipedLoadData *data = (PipedLoadData *)user;
+    PDFDocument *document = new PDFDocument ();
+    data->numPages = 0;
+    if ( document->loadFile ("-", NULL, NULL) )
+    {
+        data->numPages = document->getNumPages ();
+    }
+    delete document;
+}
+
+static void
+pipedTemporaryCopy (gpointer user)
+{
+    withPipedInput (loadTemporaryCopy, (PipedLoadData *)user);
+}
+
+static void
+pipedStandardInput (gpointer user)
+{
+    withPipedInput (loadStandardInput, (PipedLoadData *)user);
+}
+
+///
+/// @brief Compares the ways of loading a large document.
+///
+/// A synthetic document with incompressible images is written with
+/// cairo and then piped to the standard input, as a PDF generator
+/// would do, and loaded by copying it to a temporary file, as it was
+/// done before, and by reading it to memory.
+///
+void
+ePDFView::benchPipedLoad ()
+{
+    PipedLoadData data;
+    data.fileName = createDocument ();
+    data.contents = NULL;
+    data.length = 0;
+    data.writeEnd = -1;
+    data.numPages = 0;
+    if ( NULL == data.fileName ||
+         !g_file_get_contents (data.fileName, &data.contents, &data.length,
+                               NULL) )
+    {
+        g_printerr ("piped-load: couldn't create the test document\n");
+        g_free (data.fileName);
+        return;
+    }
+
+    gchar *extra = NULL;
+    gdouble copyTime = benchTime (pipedTemporaryCopy, &data, LOAD_ITERATIONS);
+    extra = g_strdup_printf ("%.1f MiB, %d pages",
+                             data.length / (1024.0 * 1024.0), data.numPages);
+    benchReport ("piped-load", "stdin-temporary-file", copyTime, extra);
+    g_free (extra);
+
+    gdouble memoryTime = benchTime (pipedStandardInput, &data,
+                                    LOAD_ITERATIONS);
+    extra = g_strdup_printf ("%d pages, %.1fx faster", data.numPages,
+                             0.0 < memoryTime ? copyTime / memoryTime : 0.0);
+    benchReport ("piped-load", "stdin-memory", memoryTime, extra);
+    g_free (extra);
+
+    g_free (data.contents);
+    g_unlink (data.fileName);
+    g_free (data.fileName);
+}
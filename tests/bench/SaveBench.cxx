@@ -0,0 +1,188 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <poppler.h>
+#include <cairo-pdf.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+// Constants.
+static const gint SYNTHETIC_PAGES = 32;
+static const gint IMAGE_SIZE = 1024;
+static const guint SAVE_ITERATIONS = 3;
+
+///
+/// @brief The data shared by all save cases.
+///
+typedef struct
+{
+    /// The loaded document to save.
+    PDFDocument *document;
+    /// The same document, read by Poppler.
+    PopplerDocument *popplerDocument;
+    /// The file name to save to.
+    gchar *copyFileName;
+    /// The URI of copyFileName.
+    gchar *copyUri;
+} SaveData;
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+///
+/// @brief Writes a large document, like a scan.
+///
+/// Each page is an image of noise, that can't be compressed.
+///
+/// @param directory The directory to write the document to.
+///
+/// @return The file name of the document. Must be freed.
+///
+static gchar *
+createDocument (const gchar *directory)
+{
+    gchar *fileName = g_build_filename (directory, "scan.pdf", NULL);
+    cairo_surface_t *surface = cairo_pdf_surface_create (fileName, 612, 792);
+    cairo_t *context = cairo_create (surface);
+    cairo_surface_t *image = cairo_image_surface_create (CAIRO_FORMAT_RGB24,
+                                                         IMAGE_SIZE,
+                                                         IMAGE_SIZE);
+    GRand *random = g_rand_new_with_seed (1);
+    for ( gint page = 0 ; page < SYNTHETIC_PAGES ; page++ )
+    {
+        cairo_surface_flush (image);
+        guint32 *pixels = (guint32 *)cairo_image_surface_get_data (image);
+        gint stride = cairo_image_surface_get_stride (image) / 4;
+        for ( gint y = 0 ; y < IMAGE_SIZE ; y++ )
+        {
+            for ( gint x = 0 ; x < IMAGE_SIZE ; x++ )
+            {
+                pixels[y * stride + x] = g_rand_int (random);
+            }
+        }
+        cairo_surface_mark_dirty (image);
+        cairo_save (context);
+        cairo_scale (context, 612.0 / IMAGE_SIZE, 792.0 / IMAGE_SIZE);
+        cairo_set_source_surface (context, image, 0, 0);
+        cairo_paint (context);
+        cairo_restore (context);
+        cairo_show_page (context);
+    }
+    g_rand_free (random);
+    cairo_surface_destroy (image);
+    cairo_destroy (context);
+    cairo_surface_finish (surface);
+    cairo_surface_destroy (surface);
+
+    return fileName;
+}
+#endif // CAIRO_VERSION >= 1.16.0
+
+///
+/// @brief Saves the document letting Poppler write it again, as
+///        PDFDocument::saveFile() always did before.
+///
+static void
+saveWithPoppler (gpointer user)
+{
+    SaveData *data = (SaveData *)user;
+    poppler_document_save_a_copy (data->popplerDocument, data->copyUri,
+                                  NULL);
+}
+
+///
+/// @brief Saves the document copying its unchanged file.
+///
+static void
+saveUnchangedFile (gpointer user)
+{
+    SaveData *data = (SaveData *)user;
+    data->document->saveFile (data->copyFileName, NULL);
+}
+
+///
+/// @brief Compares the cost of saving a copy of a large document.
+///
+/// A synthetic scan is written with cairo to a temporary directory and
+/// saved on the same file system, by Poppler and by copying the file.
+///
+void
+ePDFView::benchSave ()
+{
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE (1, 16, 0)
+    gchar *directory = g_dir_make_tmp ("epdfview-bench-XXXXXX", NULL);
+    if ( NULL == directory )
+    {
+        g_printerr ("save: couldn't create the test directory\n");
+        return;
+    }
+    gchar *fileName = createDocument (directory);
+    gchar *uri = g_filename_to_uri (fileName, NULL, NULL);
+    SaveData data;
+    data.document = new PDFDocument ();
+    data.popplerDocument = poppler_document_new_from_file (uri, NULL, NULL);
+    data.copyFileName = g_build_filename (directory, "copy.pdf", NULL);
+    data.copyUri = g_filename_to_uri (data.copyFileName, NULL, NULL);
+    if ( NULL != data.popplerDocument &&
+         data.document->loadFile (fileName, NULL, NULL) )
+    {
+        GStatBuf info;
+        g_stat (fileName, &info);
+        gchar *extra = g_strdup_printf ("%d pages, %.1f MB", SYNTHETIC_PAGES,
+                                        info.st_size / (1024.0 * 1024.0));
+        gdouble popplerTime = benchTime (saveWithPoppler, &data,
+                                         SAVE_ITERATIONS);
+        benchReport ("save", "poppler-save-a-copy", popplerTime, extra);
+        g_free (extra);
+
+        gdouble copyTime = benchTime (saveUnchangedFile, &data,
+                                      SAVE_ITERATIONS);
+        extra = g_strdup_printf ("%.1fx faster",
+                                 0.0 < copyTime ? popplerTime / copyTime
+                                                : 0.0);
+        benchReport ("save", "copy-unchanged-file", copyTime, extra);
+        g_free (extra);
+    }
+    else
+    {
+        g_printerr ("save: couldn't load the test document\n");
+    }
+
+    if ( NULL != data.popplerDocument )
+    {
+        g_object_unref (data.popplerDocument);
+    }
+    delete data.document;
+    g_unlink (data.copyFileName);
+    g_unlink (fileName);
+    g_rmdir (directory);
+    g_free (data.copyUri);
+    g_free (data.copyFileName);
+    g_free (uri);
+    g_free (fileName);
+    g_free (directory);
+#else // CAIRO_VERSION < 1.16.0
+    g_printerr ("save: needs cairo 1.16 to write the test document\n");
+#endif // CAIRO_VERSION >= 1.16.0
+}
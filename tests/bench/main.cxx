@@ -0,0 +1,87 @@
+﻿// ePDFView - A lightweight PDF Viewer.
+// Copyright (C) 2006-2011 Emma's Software.
+// Copyright (C) 2014-2025 Pablo Lezaeta
+// Copyright (C) 2014 Pedro A. Aranda GutiÃ©rrez
+
+// ePDFView - Benchmarks.
+// 
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#include <stdlib.h>
+#include <glib-object.h>
+#include <epdfview.h>
+#include "Bench.h"
+
+using namespace ePDFView;
+
+///
+/// @brief A registered benchmark.
+///
+typedef struct
+{
+    /// The name used to select the benchmark from the command line.
+    const gchar *name;
+    /// The function that runs the benchmark.
+    void (*run) (void);
+} Benchmark;
+
+static const Benchmark g_Benchmarks[] =
+{
+    { "compressed-pages", benchCompressedPages },
+    { "document-copy", benchDocumentCopy },
+    { "export", benchExport },
+    { "find-results", benchFindResults },
+    { "first-page", benchFirstPage },
+    { "named-dests", benchNamedDestinations },
+    { "piped-load", benchPipedLoad },
+    { "save", benchSave },
+    { NULL, NULL }
+};
+
+int
+main (int argc, char **argv)
+{
+    gboolean found = (1 == argc);
+    for ( const Benchmark *benchmark = g_Benchmarks ;
+          NULL != benchmark->name ;
+          benchmark++ )
+    {
+        gboolean selected = (1 == argc);
+        for ( gint arg = 1 ; arg < argc && !selected ; arg++ )
+        {
+            selected = (0 == g_ascii_strcasecmp (argv[arg], benchmark->name));
+        }
+        if ( selected )
+        {
+            found = TRUE;
+            benchmark->run ();
+        }
+    }
+
+    if ( !found )
+    {
+        g_printerr ("Unknown benchmark. Available benchmarks:\n");
+        for ( const Benchmark *benchmark = g_Benchmarks ;
+              NULL != benchmark->name ;
+              benchmark++ )
+        {
+            g_printerr ("  %s\n", benchmark->name);
+        }
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}